@@ -0,0 +1,177 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#include <string.h>
+#include "Media/Cartridge.hpp"
+
+/* Offset of the internal header of each map in the ROM image. */
+static const uint32 HEADER_OFFSET[CARTRIDGE_MAP_COUNT] = {
+    0, 0x007FC0, 0x00FFC0, 0x40FFC0
+};
+
+/* Low nibble of the map mode byte expected for each map. */
+static const uint8 MAP_MODE[CARTRIDGE_MAP_COUNT] = {
+    0xFF, 0x00, 0x01, 0x05
+};
+
+/* Read a little endian word from the ROM image. */
+static uint16 imageWord(const uint8 *image, uint32 offset)
+{
+    return (uint16)(image[offset] | (image[offset + 1] << 8));
+}
+
+/* Convert a bank 0 address to an offset in the ROM image for a map. */
+static uint32 bankZeroOffset(int map, uint16 addr)
+{
+    switch (map) {
+        case CARTRIDGE_MAP_LOROM:
+            return addr - 0x8000;
+        case CARTRIDGE_MAP_EXHIROM:
+            return 0x400000 + addr;
+        default:
+            return addr;
+    }
+}
+
+/* Score the candidate header of a map, higher is more likely. */
+static int scoreHeader(LPMEDIA pMedia, int map)
+{
+    uint32 offset = HEADER_OFFSET[map];
+    if (offset + CARTRIDGE_HEADER_SIZE > pMedia->size || !mediaEnsure(pMedia, offset + CARTRIDGE_HEADER_SIZE)) {
+        return -1000;
+    }
+
+    const uint8 *header = pMedia->image + offset;
+    int score = 0;
+
+    /* Map mode: $20 + map for slow ROM, $30 + map for fast ROM. */
+    uint8 mode = header[CARTRIDGE_HEADER_MAP_MODE];
+    if (0x20 == (mode & 0xE0)) {
+        score += ((mode & 0x0F) == MAP_MODE[map]) ? 4 : 1;
+    } else {
+        score -= 2;
+    }
+
+    /* Checksum and complement always add up to $FFFF in a clean dump. */
+    uint16 complement = imageWord(header, CARTRIDGE_HEADER_COMPLEMENT);
+    uint16 checksum = imageWord(header, CARTRIDGE_HEADER_CHECKSUM);
+    if (0xFFFF == (uint16)(checksum + complement)) {
+        score += 4;
+    }
+
+    /* ROM sizes run from 256KB ($08) to 8MB ($0D), RAM up to 128KB ($07). */
+    uint8 romSize = header[CARTRIDGE_HEADER_ROM_SIZE];
+    score += (romSize >= 0x08 && romSize <= 0x0D) ? 1 : -1;
+    score += (header[CARTRIDGE_HEADER_RAM_SIZE] <= 0x07) ? 1 : -1;
+
+    /* The reset vector points into ROM at a typical first op: sei, clc, sep, rep, jmp or jml. */
+    uint16 reset = imageWord(header, CARTRIDGE_HEADER_RESET);
+    if (reset < 0x8000) {
+        score -= 4;
+    } else {
+        score += 2;
+        uint32 entry = bankZeroOffset(map, reset);
+        if (entry < pMedia->size && mediaEnsure(pMedia, entry + 1)) {
+            switch (pMedia->image[entry]) {
+                case 0x78: case 0x18: case 0xE2: case 0xC2: case 0x4C: case 0x5C:
+                    score += 2;
+                    break;
+                case 0x00: case 0xFF:
+                    score -= 2;
+                    break;
+            }
+        }
+    }
+
+    /* Titles are padded ASCII. */
+    int printable = 0;
+    for (uint32 i = 0; i < CARTRIDGE_TITLE_SIZE; ++i) {
+        printable += (header[CARTRIDGE_HEADER_TITLE + i] >= 0x20 && header[CARTRIDGE_HEADER_TITLE + i] < 0x7F);
+    }
+    if (CARTRIDGE_TITLE_SIZE == printable) {
+        score += 1;
+    }
+
+    return score;
+}
+
+/* Identify a cartridge by scoring its candidate internal headers. */
+int analyzeCartridge(LPMEDIA pMedia, LPCARTRIDGE pCart)
+{
+    memset(pCart, 0x00, sizeof(*pCart));
+    if (NULL == pMedia->image) {
+        return FALSE;
+    }
+
+    int best = CARTRIDGE_MAP_UNKNOWN;
+    int bestScore = 0;
+    for (int map = CARTRIDGE_MAP_LOROM; map < CARTRIDGE_MAP_COUNT; ++map) {
+        int score = scoreHeader(pMedia, map);
+        if (score > bestScore) {
+            best = map;
+            bestScore = score;
+        }
+    }
+    if (CARTRIDGE_MAP_UNKNOWN == best) {
+        return FALSE;
+    }
+
+    const uint8 *header = pMedia->image + HEADER_OFFSET[best];
+    pCart->map = best;
+    pCart->score = bestScore;
+    pCart->headerOffset = HEADER_OFFSET[best];
+    memcpy(pCart->title, header + CARTRIDGE_HEADER_TITLE, CARTRIDGE_TITLE_SIZE);
+    pCart->title[CARTRIDGE_TITLE_SIZE] = '\0';
+    pCart->mapMode = header[CARTRIDGE_HEADER_MAP_MODE];
+    pCart->romType = header[CARTRIDGE_HEADER_ROM_TYPE];
+    uint8 romSize = header[CARTRIDGE_HEADER_ROM_SIZE];
+    uint8 ramSize = header[CARTRIDGE_HEADER_RAM_SIZE];
+    pCart->romSize = (romSize < 0x10) ? (0x400u << romSize) : 0;
+    pCart->ramSize = (ramSize && ramSize < 0x10) ? (0x400u << ramSize) : 0;
+    pCart->region = header[CARTRIDGE_HEADER_REGION];
+    pCart->complement = imageWord(header, CARTRIDGE_HEADER_COMPLEMENT);
+    pCart->checksum = imageWord(header, CARTRIDGE_HEADER_CHECKSUM);
+    pCart->resetVector = imageWord(header, CARTRIDGE_HEADER_RESET);
+    return TRUE;
+}
+
+/* Sum the bytes of part of the ROM image. */
+static uint32 imageSum(const uint8 *image, uint32 size)
+{
+    uint32 sum = 0;
+    for (uint32 i = 0; i < size; ++i) {
+        sum += image[i];
+    }
+    return sum;
+}
+
+/* Calculate the checksum of a ROM image the way the internal header does. */
+uint16 cartridgeChecksum(LPMEDIA pMedia)
+{
+    if (NULL == pMedia->image || 0 == pMedia->size || !mediaEnsure(pMedia, pMedia->size)) {
+        return 0;
+    }
+
+    uint32 base = 1;
+    while (base * 2 <= pMedia->size) {
+        base *= 2;
+    }
+    uint32 sum = imageSum(pMedia->image, base);
+    uint32 rest = pMedia->size - base;
+    if (rest > 0) {
+        sum += imageSum(pMedia->image + base, rest) * (base / rest);
+    }
+    return (uint16)sum;
+}
+
+/* Get the name of a memory map. */
+const char *cartridgeMapName(int map)
+{
+    switch (map) {
+        case CARTRIDGE_MAP_LOROM:   return "LoROM";
+        case CARTRIDGE_MAP_HIROM:   return "HiROM";
+        case CARTRIDGE_MAP_EXHIROM: return "ExHiROM";
+        default:                    return "Unknown";
+    }
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#ifndef SINES_CARTRIDGE_H           /* START: HEADER GUARD */
+#define SINES_CARTRIDGE_H
+
+#include "Media/Media.hpp"
+
+/* Memory maps of SNES cartridges. */
+#define CARTRIDGE_MAP_UNKNOWN       0
+#define CARTRIDGE_MAP_LOROM         1   /* 32KB banks at $8000-$FFFF, header at $7FC0. */
+#define CARTRIDGE_MAP_HIROM         2   /* 64KB banks, header at $FFC0. */
+#define CARTRIDGE_MAP_EXHIROM       3   /* 64KB banks beyond 4MB, header at $40FFC0. */
+#define CARTRIDGE_MAP_COUNT         4
+
+/* Offsets within the internal header. */
+#define CARTRIDGE_HEADER_SIZE       0x40
+#define CARTRIDGE_TITLE_SIZE        21
+#define CARTRIDGE_HEADER_TITLE      0x00
+#define CARTRIDGE_HEADER_MAP_MODE   0x15
+#define CARTRIDGE_HEADER_ROM_TYPE   0x16
+#define CARTRIDGE_HEADER_ROM_SIZE   0x17
+#define CARTRIDGE_HEADER_RAM_SIZE   0x18
+#define CARTRIDGE_HEADER_REGION     0x19
+#define CARTRIDGE_HEADER_COMPLEMENT 0x1C
+#define CARTRIDGE_HEADER_CHECKSUM   0x1E
+#define CARTRIDGE_HEADER_RESET      0x3C
+
+/**
+ * The internal header of a SNES cartridge and the memory map chosen for it.
+ */
+typedef struct _CARTRIDGE {
+    int     map;            // CARTRIDGE_MAP_*.
+    int     score;          // Score of the chosen header, higher is more certain.
+    uint32  headerOffset;   // Offset of the internal header in the ROM image.
+    char    title[CARTRIDGE_TITLE_SIZE + 1];
+    uint8   mapMode;        // Map mode byte.
+    uint8   romType;        // Cartridge type byte (coprocessors, battery).
+    uint32  romSize;        // ROM size in bytes claimed by the header.
+    uint32  ramSize;        // Cartridge RAM size in bytes.
+    uint8   region;         // Destination code, 0x00 Japan, 0x01 North America, 0x02 Europe...
+    uint16  checksum;       // Checksum claimed by the header.
+    uint16  complement;     // Complement of the checksum.
+    uint16  resetVector;    // Emulation mode reset vector.
+} CARTRIDGE, FAR * LPCARTRIDGE;
+
+/**
+ * Identify a cartridge by scoring its candidate internal headers.  Only the header and reset vector pages of
+ * each candidate are read, the image is never scanned.
+ *
+ * @param pMedia : LPMEDIA          [IN]    The media.
+ * @param pCart : LPCARTRIDGE       [OUT]   The cartridge.
+ *
+ * @return TRUE if a header was found, FALSE if no candidate looks valid.
+ */
+int analyzeCartridge(LPMEDIA pMedia, LPCARTRIDGE pCart);
+
+/**
+ * Calculate the checksum of a ROM image the way the internal header does: the sum of every byte, with the part
+ * beyond the largest power of two mirrored up to the next one.  Reads the whole image.
+ *
+ * @param pMedia : LPMEDIA  [IN]    The media.
+ *
+ * @return The checksum.
+ */
+uint16 cartridgeChecksum(LPMEDIA pMedia);
+
+/**
+ * Get the name of a memory map.
+ *
+ * @param map : int     [IN]    The CARTRIDGE_MAP_*.
+ *
+ * @return The name.
+ */
+const char *cartridgeMapName(int map);
+
+#endif                              /* END: HEADER GUARD */
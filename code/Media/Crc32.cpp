@@ -0,0 +1,56 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#include "Media/Crc32.hpp"
+
+/* Reflected polynomial of CRC-32. */
+#define CRC32_POLYNOMIAL    0xEDB88320
+
+/* CRC32_TABLE[k][b] is the CRC of byte b followed by k zero bytes. */
+static uint32 CRC32_TABLE[8][256];
+
+/**
+ * Builds the slice-by-8 tables before main runs.
+ */
+static class Crc32TableBuilder {
+public:
+    Crc32TableBuilder() {
+        for (uint32 b = 0; b < 256; ++b) {
+            uint32 crc = b;
+            for (uint32 bit = 0; bit < 8; ++bit) {
+                crc = (crc >> 1) ^ ((crc & 1) ? CRC32_POLYNOMIAL : 0);
+            }
+            CRC32_TABLE[0][b] = crc;
+        }
+        for (uint32 b = 0; b < 256; ++b) {
+            for (uint32 k = 1; k < 8; ++k) {
+                uint32 crc = CRC32_TABLE[k - 1][b];
+                CRC32_TABLE[k][b] = (crc >> 8) ^ CRC32_TABLE[0][crc & 0xFF];
+            }
+        }
+    }
+} crc32TableBuilder;
+
+/* Update the CRC-32 of a buffer. */
+uint32 crc32(uint32 crc, const uint8 *data, uint32 size)
+{
+    crc = ~crc;
+
+    /* Fold eight bytes at a time, each byte through its own table. */
+    while (size >= 8) {
+        uint32 lo = crc ^ (data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32)data[3] << 24));
+        uint32 hi = data[4] | (data[5] << 8) | (data[6] << 16) | ((uint32)data[7] << 24);
+        crc = CRC32_TABLE[7][lo & 0xFF] ^ CRC32_TABLE[6][(lo >> 8) & 0xFF]
+            ^ CRC32_TABLE[5][(lo >> 16) & 0xFF] ^ CRC32_TABLE[4][lo >> 24]
+            ^ CRC32_TABLE[3][hi & 0xFF] ^ CRC32_TABLE[2][(hi >> 8) & 0xFF]
+            ^ CRC32_TABLE[1][(hi >> 16) & 0xFF] ^ CRC32_TABLE[0][hi >> 24];
+        data += 8;
+        size -= 8;
+    }
+    while (size--) {
+        crc = (crc >> 8) ^ CRC32_TABLE[0][(crc ^ *data++) & 0xFF];
+    }
+
+    return ~crc;
+}
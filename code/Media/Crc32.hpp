@@ -0,0 +1,22 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#ifndef SINES_CRC32_H               /* START: HEADER GUARD */
+#define SINES_CRC32_H
+
+#include "xplat/types.hpp"
+
+/**
+ * Update the CRC-32 (IEEE 802.3, as used by zip, gzip and IPS/BPS patches) of a buffer.  Eight bytes are folded
+ * per step through slice-by-8 tables.
+ *
+ * @param crc : uint32          [IN]    The CRC of the data so far, 0 to start.
+ * @param data : const uint8*   [IN]    The data.
+ * @param size : uint32         [IN]    The size of the data in bytes.
+ *
+ * @return The CRC including the data.
+ */
+uint32 crc32(uint32 crc, const uint8 *data, uint32 size);
+
+#endif                              /* END: HEADER GUARD */
@@ -0,0 +1,348 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#include <string.h>
+#include "Media/Inflate.hpp"
+
+/* Base lengths and extra bits of the length symbols 257..285. */
+static const uint16 LENGTH_BASE[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const uint8 LENGTH_EXTRA[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+/* Base distances and extra bits of the distance symbols 0..29. */
+static const uint16 DIST_BASE[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+static const uint8 DIST_EXTRA[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+/* Order the code length code lengths are sent in. */
+static const uint8 CODE_LENGTH_ORDER[19] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+
+/* Top up the bit buffer with as many whole bytes as fit. */
+static void refill(LPINFLATE pInflate)
+{
+    while (pInflate->bitCount <= 56 && pInflate->srcPos < pInflate->srcSize) {
+        pInflate->bitBuf |= (uint64)pInflate->src[pInflate->srcPos++] << pInflate->bitCount;
+        pInflate->bitCount += 8;
+    }
+}
+
+/* Read up to 16 bits, -1 past the end of the stream. */
+static int getBits(LPINFLATE pInflate, uint32 count)
+{
+    if (pInflate->bitCount < count) {
+        refill(pInflate);
+        if (pInflate->bitCount < count) {
+            return -1;
+        }
+    }
+    int value = (int)(pInflate->bitBuf & ((1u << count) - 1));
+    pInflate->bitBuf >>= count;
+    pInflate->bitCount -= count;
+    return value;
+}
+
+/* Reverse the low bits of a code, Huffman codes are sent most significant bit first. */
+static uint32 reverseBits(uint32 code, uint32 length)
+{
+    uint32 reversed = 0;
+    for (uint32 i = 0; i < length; ++i) {
+        reversed = (reversed << 1) | ((code >> i) & 0x01);
+    }
+    return reversed;
+}
+
+/*
+ * Build a canonical Huffman code from code lengths.  Returns 0 for a complete code, negative if the lengths are
+ * over subscribed and positive if the code is incomplete.
+ */
+static int buildHuffman(LPINFLATE_HUFFMAN pHuffman, const uint16 *length, int count)
+{
+    memset(pHuffman->count, 0x00, sizeof(pHuffman->count));
+    memset(pHuffman->fast, 0x00, sizeof(pHuffman->fast));
+    for (int sym = 0; sym < count; ++sym) {
+        pHuffman->count[length[sym]]++;
+    }
+    if (pHuffman->count[0] == count) {
+        return 0;
+    }
+
+    int left = 1;
+    for (int len = 1; len <= INFLATE_MAX_BITS; ++len) {
+        left <<= 1;
+        left -= pHuffman->count[len];
+        if (left < 0) {
+            return left;
+        }
+    }
+
+    uint16 offset[INFLATE_MAX_BITS + 1];
+    offset[1] = 0;
+    for (int len = 1; len < INFLATE_MAX_BITS; ++len) {
+        offset[len + 1] = offset[len] + pHuffman->count[len];
+    }
+    for (int sym = 0; sym < count; ++sym) {
+        if (0 != length[sym]) {
+            pHuffman->symbol[offset[length[sym]]++] = (uint16)sym;
+        }
+    }
+
+    /* Every index whose low bits hold a short code maps straight to its symbol. */
+    uint32 code = 0;
+    int index = 0;
+    for (uint32 len = 1; len <= INFLATE_FAST_BITS; ++len) {
+        for (int i = 0; i < pHuffman->count[len]; ++i) {
+            uint16 entry = (uint16)((pHuffman->symbol[index++] << 4) | len);
+            for (uint32 fill = reverseBits(code++, len); fill < (1u << INFLATE_FAST_BITS); fill += 1u << len) {
+                pHuffman->fast[fill] = entry;
+            }
+        }
+        code <<= 1;
+    }
+    return left;
+}
+
+/* Decode a symbol, -1 for an invalid code or the end of the stream. */
+static int decode(LPINFLATE pInflate, const INFLATE_HUFFMAN *pHuffman)
+{
+    refill(pInflate);
+    uint16 entry = pHuffman->fast[pInflate->bitBuf & ((1u << INFLATE_FAST_BITS) - 1)];
+    if (0 != entry) {
+        uint32 len = entry & 0x0F;
+        if (len > pInflate->bitCount) {
+            return -1;
+        }
+        pInflate->bitBuf >>= len;
+        pInflate->bitCount -= len;
+        return entry >> 4;
+    }
+
+    /* Longer codes walk the canonical code one bit at a time. */
+    int code = 0, first = 0, index = 0;
+    for (uint32 len = 1; len <= INFLATE_MAX_BITS && len <= pInflate->bitCount; ++len) {
+        code |= (int)((pInflate->bitBuf >> (len - 1)) & 0x01);
+        int count = pHuffman->count[len];
+        if (code - count < first) {
+            pInflate->bitBuf >>= len;
+            pInflate->bitCount -= len;
+            return pHuffman->symbol[index + (code - first)];
+        }
+        index += count;
+        first = (first + count) << 1;
+        code <<= 1;
+    }
+    return -1;
+}
+
+/* Copy a stored block. */
+static int storedBlock(LPINFLATE pInflate)
+{
+    /* Stored data starts on a byte boundary. */
+    pInflate->bitBuf >>= pInflate->bitCount & 0x07;
+    pInflate->bitCount &= ~0x07u;
+    int len = getBits(pInflate, 16);
+    int nlen = getBits(pInflate, 16);
+    if (len < 0 || nlen < 0 || len != (~nlen & 0xFFFF) || (uint32)len > pInflate->outSize - pInflate->outPos) {
+        return INFLATE_STATE_ERROR;
+    }
+
+    /* Whole bytes still in the bit buffer come first. */
+    while (len > 0 && pInflate->bitCount >= 8) {
+        pInflate->out[pInflate->outPos++] = (uint8)pInflate->bitBuf;
+        pInflate->bitBuf >>= 8;
+        pInflate->bitCount -= 8;
+        --len;
+    }
+    if ((uint32)len > pInflate->srcSize - pInflate->srcPos) {
+        return INFLATE_STATE_ERROR;
+    }
+    memcpy(pInflate->out + pInflate->outPos, pInflate->src + pInflate->srcPos, len);
+    pInflate->outPos += len;
+    pInflate->srcPos += len;
+    return pInflate->last ? INFLATE_STATE_DONE : INFLATE_STATE_HEADER;
+}
+
+/* Set up the fixed codes. */
+static int fixedBlock(LPINFLATE pInflate)
+{
+    uint16 lengths[INFLATE_MAX_LCODES];
+    int sym = 0;
+    for (; sym < 144; ++sym) lengths[sym] = 8;
+    for (; sym < 256; ++sym) lengths[sym] = 9;
+    for (; sym < 280; ++sym) lengths[sym] = 7;
+    for (; sym < INFLATE_MAX_LCODES; ++sym) lengths[sym] = 8;
+    buildHuffman(&pInflate->lencode, lengths, INFLATE_MAX_LCODES);
+    for (sym = 0; sym < INFLATE_MAX_DCODES; ++sym) lengths[sym] = 5;
+    buildHuffman(&pInflate->distcode, lengths, INFLATE_MAX_DCODES);
+    return INFLATE_STATE_CODES;
+}
+
+/* Read the codes of a dynamic block. */
+static int dynamicBlock(LPINFLATE pInflate)
+{
+    int nlen = getBits(pInflate, 5) + 257;
+    int ndist = getBits(pInflate, 5) + 1;
+    int ncode = getBits(pInflate, 4) + 4;
+    if (nlen > 286 || ndist > INFLATE_MAX_DCODES || ncode < 4) {
+        return INFLATE_STATE_ERROR;
+    }
+
+    /* The literal/length code doubles as the code length code while the lengths are read. */
+    uint16 lengths[INFLATE_MAX_LCODES + INFLATE_MAX_DCODES];
+    memset(lengths, 0x00, sizeof(lengths));
+    for (int i = 0; i < ncode; ++i) {
+        int len = getBits(pInflate, 3);
+        if (len < 0) {
+            return INFLATE_STATE_ERROR;
+        }
+        lengths[CODE_LENGTH_ORDER[i]] = (uint16)len;
+    }
+    if (0 != buildHuffman(&pInflate->lencode, lengths, 19)) {
+        return INFLATE_STATE_ERROR;
+    }
+
+    int index = 0;
+    while (index < nlen + ndist) {
+        int sym = decode(pInflate, &pInflate->lencode);
+        if (sym < 0) {
+            return INFLATE_STATE_ERROR;
+        }
+        if (sym < 16) {
+            lengths[index++] = (uint16)sym;
+            continue;
+        }
+
+        uint16 len = 0;
+        int repeat;
+        if (16 == sym) {
+            if (0 == index) {
+                return INFLATE_STATE_ERROR;
+            }
+            len = lengths[index - 1];
+            repeat = 3 + getBits(pInflate, 2);
+        } else if (17 == sym) {
+            repeat = 3 + getBits(pInflate, 3);
+        } else {
+            repeat = 11 + getBits(pInflate, 7);
+        }
+        if (repeat < 3 || index + repeat > nlen + ndist) {
+            return INFLATE_STATE_ERROR;
+        }
+        while (repeat--) {
+            lengths[index++] = len;
+        }
+    }
+
+    /* Only a single code may be left incomplete, and the block needs its end code. */
+    if (0 == lengths[256]) {
+        return INFLATE_STATE_ERROR;
+    }
+    int err = buildHuffman(&pInflate->lencode, lengths, nlen);
+    if (err < 0 || (err > 0 && nlen - pInflate->lencode.count[0] != 1)) {
+        return INFLATE_STATE_ERROR;
+    }
+    err = buildHuffman(&pInflate->distcode, lengths + nlen, ndist);
+    if (err < 0 || (err > 0 && ndist - pInflate->distcode.count[0] != 1)) {
+        return INFLATE_STATE_ERROR;
+    }
+    return INFLATE_STATE_CODES;
+}
+
+/* Inflate symbols of a Huffman block until the target is reached or the block ends. */
+static int codes(LPINFLATE pInflate, uint32 target)
+{
+    uint8 *out = pInflate->out;
+    bool finish = (target == pInflate->outSize);
+    while (pInflate->outPos < target || finish) {
+        int sym = decode(pInflate, &pInflate->lencode);
+        if (sym < 256) {
+            if (sym < 0 || pInflate->outPos >= pInflate->outSize) {
+                return INFLATE_STATE_ERROR;
+            }
+            out[pInflate->outPos++] = (uint8)sym;
+            continue;
+        }
+        if (256 == sym) {
+            return pInflate->last ? INFLATE_STATE_DONE : INFLATE_STATE_HEADER;
+        }
+
+        sym -= 257;
+        if (sym >= 29) {
+            return INFLATE_STATE_ERROR;
+        }
+        int len = LENGTH_BASE[sym] + getBits(pInflate, LENGTH_EXTRA[sym]);
+        int dsym = decode(pInflate, &pInflate->distcode);
+        if (dsym < 0 || dsym >= INFLATE_MAX_DCODES) {
+            return INFLATE_STATE_ERROR;
+        }
+        int dist = DIST_BASE[dsym] + getBits(pInflate, DIST_EXTRA[dsym]);
+        if (len < LENGTH_BASE[sym] || dist < DIST_BASE[dsym]
+            || (uint32)dist > pInflate->outPos || (uint32)len > pInflate->outSize - pInflate->outPos) {
+            return INFLATE_STATE_ERROR;
+        }
+
+        /* Matches copy from the output, overlapping copies repeat the last dist bytes. */
+        uint8 *dst = out + pInflate->outPos;
+        const uint8 *from = dst - dist;
+        if (dist >= len) {
+            memcpy(dst, from, len);
+        } else {
+            for (int i = 0; i < len; ++i) {
+                dst[i] = from[i];
+            }
+        }
+        pInflate->outPos += len;
+    }
+    return INFLATE_STATE_CODES;
+}
+
+/* Start inflating a raw DEFLATE stream. */
+void inflateInit(LPINFLATE pInflate, const uint8 *src, uint32 srcSize, uint8 *out, uint32 outSize)
+{
+    memset(pInflate, 0x00, sizeof(*pInflate));
+    pInflate->src = src;
+    pInflate->srcSize = srcSize;
+    pInflate->out = out;
+    pInflate->outSize = outSize;
+    pInflate->state = INFLATE_STATE_HEADER;
+}
+
+/* Inflate until at least a number of bytes of output are complete or the stream ends. */
+int inflateTo(LPINFLATE pInflate, uint32 target)
+{
+    /* Asking for the whole output also reads the end of the last block, so completion is reported. */
+    if (target > pInflate->outSize) {
+        target = pInflate->outSize;
+    }
+    bool finish = (target == pInflate->outSize);
+    while (pInflate->outPos < target || finish) {
+        if (INFLATE_STATE_HEADER == pInflate->state) {
+            int last = getBits(pInflate, 1);
+            int type = getBits(pInflate, 2);
+            pInflate->last = (1 == last);
+            switch (type) {
+                case 0:  pInflate->state = storedBlock(pInflate);  break;
+                case 1:  pInflate->state = fixedBlock(pInflate);   break;
+                case 2:  pInflate->state = dynamicBlock(pInflate); break;
+                default: pInflate->state = INFLATE_STATE_ERROR;    break;
+            }
+        } else if (INFLATE_STATE_CODES == pInflate->state) {
+            pInflate->state = codes(pInflate, target);
+        } else {
+            break;
+        }
+    }
+    return pInflate->state;
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#ifndef SINES_INFLATE_H             /* START: HEADER GUARD */
+#define SINES_INFLATE_H
+
+#include "xplat/platform.hpp"
+#include "xplat/types.hpp"
+
+/* Limits of the DEFLATE format (RFC 1951). */
+#define INFLATE_MAX_BITS        15      // Longest code.
+#define INFLATE_MAX_LCODES      288     // Literal/length codes.
+#define INFLATE_MAX_DCODES      30      // Distance codes.
+#define INFLATE_FAST_BITS       9       // Codes up to this long are decoded by a single table lookup.
+
+/* Inflater states, also returned by inflateTo. */
+#define INFLATE_STATE_HEADER    0       // Next is a block header.
+#define INFLATE_STATE_CODES     1       // Inside a fixed or dynamic Huffman block.
+#define INFLATE_STATE_DONE      2       // The last block is complete.
+#define INFLATE_STATE_ERROR     3       // The stream is corrupt or overruns the output.
+
+/**
+ * A canonical Huffman code.
+ */
+typedef struct _INFLATE_HUFFMAN {
+    uint16  count[INFLATE_MAX_BITS + 1];        // Number of codes of each length.
+    uint16  symbol[INFLATE_MAX_LCODES];         // Symbols ordered by code.
+    uint16  fast[1 << INFLATE_FAST_BITS];       // Symbol << 4 | length by the next bits, 0 if the code is longer.
+} INFLATE_HUFFMAN, FAR * LPINFLATE_HUFFMAN;
+
+/**
+ * A resumable raw DEFLATE stream inflating into a buffer sized for the whole output.  Matches copy from the
+ * output itself, so no separate window is kept, and a stream stopped at any output position picks up where it
+ * left off.
+ */
+typedef struct _INFLATE {
+    /* Compressed input. */
+    const uint8    *src;        // The compressed stream.
+    uint32          srcSize;    // Size of the compressed stream in bytes.
+    uint32          srcPos;     // Next byte to read into the bit buffer.
+    uint64          bitBuf;     // Unread bits, least significant first.
+    uint32          bitCount;   // Number of bits in the bit buffer.
+
+    /* Output. */
+    uint8          *out;        // The output buffer.
+    uint32          outSize;    // Size of the output buffer in bytes.
+    uint32          outPos;     // Bytes inflated so far.
+
+    /* Block state. */
+    int             state;      // INFLATE_STATE_*.
+    int             last;       // Non zero once the last block has started.
+    INFLATE_HUFFMAN lencode;    // Literal/length code of the current block.
+    INFLATE_HUFFMAN distcode;   // Distance code of the current block.
+} INFLATE, FAR * LPINFLATE;
+
+/**
+ * Start inflating a raw DEFLATE stream.
+ *
+ * @param pInflate : LPINFLATE  [OUT]   The inflater.
+ * @param src : const uint8*    [IN]    The compressed stream.
+ * @param srcSize : uint32      [IN]    Size of the compressed stream in bytes.
+ * @param out : uint8*          [IN]    The output buffer.
+ * @param outSize : uint32      [IN]    Size of the output buffer in bytes.
+ */
+void inflateInit(LPINFLATE pInflate, const uint8 *src, uint32 srcSize, uint8 *out, uint32 outSize);
+
+/**
+ * Inflate until at least a number of bytes of output are complete or the stream ends.  The last match may
+ * carry the output past the target.
+ *
+ * @param pInflate : LPINFLATE  [IN/OUT]    The inflater.
+ * @param target : uint32       [IN]        Output bytes required.
+ *
+ * @return The INFLATE_STATE_* the inflater stopped in.
+ */
+int inflateTo(LPINFLATE pInflate, uint32 target);
+
+#endif                              /* END: HEADER GUARD */
@@ -0,0 +1,404 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#include <new>
+#include <string.h>
+#include "Media/Crc32.hpp"
+#include "Media/Media.hpp"
+#include "Media/Patch.hpp"
+#ifdef WIN32
+    #include <psapi.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <time.h>
+#endif
+
+/* Read a monotonic clock in milliseconds. */
+static double clockMs()
+{
+#ifdef WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart * 1000.0 / (double)frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1000.0 + (double)now.tv_nsec / 1000000.0;
+#endif
+}
+
+/* Read little endian values from a container. */
+static uint16 readWord(const uint8 *data)
+{
+    return (uint16)(data[0] | (data[1] << 8));
+}
+static uint32 readLong(const uint8 *data)
+{
+    return (uint32)data[0] | ((uint32)data[1] << 8) | ((uint32)data[2] << 16) | ((uint32)data[3] << 24);
+}
+
+/*
+ * Find the deflate stream of a gzip member.  Returns FALSE if the header is invalid.
+ */
+static int findGzipStream(LPMEDIA pMedia, const uint8 **pStream, uint32 *pStreamSize, uint32 *pSize)
+{
+    const uint8 *view = pMedia->view;
+    uint32 viewSize = pMedia->viewSize;
+    if (viewSize < 18 || 8 != view[2]) {
+        return FALSE;
+    }
+
+    /* Skip the optional extra field, name, comment and header CRC. */
+    uint8 flags = view[3];
+    uint32 pos = 10;
+    if (flags & 0x04) {
+        pos += 2 + readWord(view + pos);
+    }
+    for (uint8 field = 0x08; field <= 0x10; field <<= 1) {
+        if (flags & field) {
+            while (pos < viewSize && 0 != view[pos]) {
+                ++pos;
+            }
+            ++pos;
+        }
+    }
+    if (flags & 0x02) {
+        pos += 2;
+    }
+    if (pos > viewSize - 8) {
+        return FALSE;
+    }
+
+    /* The trailer holds the CRC and size of the inflated file. */
+    *pStream = view + pos;
+    *pStreamSize = viewSize - 8 - pos;
+    pMedia->crc = readLong(view + viewSize - 8);
+    *pSize = readLong(view + viewSize - 4);
+    return TRUE;
+}
+
+/*
+ * Find the largest entry of a zip, the ROM beside any notes.  Returns the compression method, -1 if the archive
+ * is invalid.
+ */
+static int findZipEntry(LPMEDIA pMedia, const uint8 **pStream, uint32 *pStreamSize, uint32 *pSize)
+{
+    const uint8 *view = pMedia->view;
+    uint32 viewSize = pMedia->viewSize;
+    if (viewSize < 22) {
+        return -1;
+    }
+
+    /* The end of central directory record sits before a comment of up to 64KB. */
+    uint32 end = viewSize - 22;
+    uint32 stop = (end > 0xFFFF) ? end - 0xFFFF : 0;
+    while (0x06054B50 != readLong(view + end)) {
+        if (end == stop) {
+            return -1;
+        }
+        --end;
+    }
+
+    uint32 entries = readWord(view + end + 10);
+    uint32 pos = readLong(view + end + 16);
+    const uint8 *best = NULL;
+    for (uint32 i = 0; i < entries; ++i) {
+        if (viewSize < 46 || pos > viewSize - 46 || 0x02014B50 != readLong(view + pos)) {
+            return -1;
+        }
+        if (NULL == best || readLong(view + pos + 24) > readLong(best + 24)) {
+            best = view + pos;
+        }
+        pos += 46 + readWord(view + pos + 28) + readWord(view + pos + 30) + readWord(view + pos + 32);
+    }
+    if (NULL == best) {
+        return -1;
+    }
+
+    /* The local header repeats the name with its own extra field. */
+    uint32 local = readLong(best + 42);
+    if (viewSize < 30 || local > viewSize - 30 || 0x04034B50 != readLong(view + local)) {
+        return -1;
+    }
+    uint32 data = local + 30 + readWord(view + local + 26) + readWord(view + local + 28);
+    uint32 streamSize = readLong(best + 20);
+    if (data > viewSize || streamSize > viewSize - data) {
+        return -1;
+    }
+    *pStream = view + data;
+    *pStreamSize = streamSize;
+    pMedia->crc = readLong(best + 16);
+    *pSize = readLong(best + 24);
+    return readWord(best + 10);
+}
+
+/* Load media. */
+MEDIA loadMedia(usz szPath)
+{
+    return loadMediaEx(szPath, 0);
+}
+
+/* Load media, raw, gzip or zip. */
+MEDIA loadMediaEx(usz szPath, uint32 flags)
+{
+    MEDIA newMedia;
+    memset(&newMedia, 0x00, sizeof(newMedia));
+    double start = clockMs();
+
+#ifdef WIN32
+    newMedia.hFile = CreateFileA((char*)szPath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (INVALID_HANDLE_VALUE == newMedia.hFile) {
+        newMedia.hFile = NULL;
+        return newMedia;
+    }
+    newMedia.viewSize = GetFileSize(newMedia.hFile, NULL);
+    int isPrivate = flags & MEDIA_LOAD_PRIVATE;
+    newMedia.hMapping = CreateFileMappingA(newMedia.hFile, NULL, isPrivate ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, NULL);
+    if (NULL != newMedia.hMapping) {
+        newMedia.view = (const uint8 *)MapViewOfFile(newMedia.hMapping, isPrivate ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+    }
+#else
+    int fd = open((char*)szPath, O_RDONLY);
+    if (fd < 0) {
+        return newMedia;
+    }
+    struct stat info;
+    if (0 == fstat(fd, &info) && info.st_size > 0) {
+        newMedia.viewSize = (uint32)info.st_size;
+        void *view = (flags & MEDIA_LOAD_PRIVATE)
+                     ? mmap(NULL, newMedia.viewSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0)
+                     : mmap(NULL, newMedia.viewSize, PROT_READ, MAP_SHARED, fd, 0);
+        newMedia.view = (MAP_FAILED == view) ? NULL : (const uint8 *)view;
+    }
+    close(fd);
+#endif
+    if (NULL == newMedia.view) {
+        unloadMedia(&newMedia);
+        return newMedia;
+    }
+
+    /* Find the file inside its container, the stream is NULL for a raw image. */
+    const uint8 *file = newMedia.view;
+    uint32 fileSize = newMedia.viewSize;
+    const uint8 *stream = NULL;
+    uint32 streamSize = 0;
+    if (newMedia.viewSize >= 4 && 0x1F == newMedia.view[0] && 0x8B == newMedia.view[1]) {
+        newMedia.format = MEDIA_FORMAT_GZIP;
+        if (!findGzipStream(&newMedia, &stream, &streamSize, &fileSize)) {
+            unloadMedia(&newMedia);
+            return newMedia;
+        }
+    } else if (newMedia.viewSize >= 4 && 0x04034B50 == readLong(newMedia.view)) {
+        newMedia.format = MEDIA_FORMAT_ZIP;
+        int method = findZipEntry(&newMedia, &stream, &streamSize, &fileSize);
+        if (0 == method && streamSize == fileSize) {
+            /* Stored entries are served from the mapping like a raw image. */
+            file = stream;
+            stream = NULL;
+        } else if (8 != method) {
+            unloadMedia(&newMedia);
+            return newMedia;
+        }
+    }
+
+    /* Compressed files inflate into one buffer sized from the container, which is not trusted past what the
+       stream can hold. */
+    if (NULL != stream) {
+        if (fileSize > MEDIA_MAX_SIZE || fileSize > (uint64)streamSize * MEDIA_MAX_RATIO) {
+            unloadMedia(&newMedia);
+            return newMedia;
+        }
+        newMedia.buffer = new (std::nothrow) uint8[fileSize ? fileSize : 1];
+        if (NULL == newMedia.buffer) {
+            unloadMedia(&newMedia);
+            return newMedia;
+        }
+        file = newMedia.buffer;
+    }
+
+    /* Copier headers pad the image to a multiple of 1KB plus 512 bytes. */
+    newMedia.hasHeader = !(flags & MEDIA_LOAD_WHOLE) && MEDIA_COPIER_HEADER_SIZE == fileSize % 1024;
+    newMedia.image = file + (newMedia.hasHeader ? MEDIA_COPIER_HEADER_SIZE : 0);
+    newMedia.size = fileSize - (newMedia.hasHeader ? MEDIA_COPIER_HEADER_SIZE : 0);
+    newMedia.ready = newMedia.size;
+
+    if (NULL != stream) {
+        newMedia.ready = 0;
+        newMedia.pInflate = new INFLATE;
+        inflateInit(newMedia.pInflate, stream, streamSize, newMedia.buffer, fileSize);
+        if (!(flags & MEDIA_LOAD_LAZY) && !mediaEnsure(&newMedia, newMedia.size)) {
+            unloadMedia(&newMedia);
+            return newMedia;
+        }
+    }
+    newMedia.loadMs = clockMs() - start;
+
+    return newMedia;
+}
+
+/* Load media with a patch applied. */
+MEDIA loadPatchedMedia(usz szPath, usz szPatch, uint32 flags)
+{
+    double start = clockMs();
+    MEDIA base = loadMediaEx(szPath, flags & MEDIA_LOAD_WHOLE);
+    MEDIA patch = loadMediaEx(szPatch, MEDIA_LOAD_WHOLE);
+    MEDIA newMedia;
+    memset(&newMedia, 0x00, sizeof(newMedia));
+
+    PATCH_INFO info;
+    if (NULL == base.image || NULL == patch.image || !inspectPatch(patch.image, patch.size, base.size, &info)
+        || (info.hasCrc && crc32(0, base.image, base.size) != info.sourceCrc)) {
+        unloadMedia(&patch);
+        unloadMedia(&base);
+        return newMedia;
+    }
+
+    uint8 *target = NULL;
+    if (NULL == base.buffer && info.targetSize <= base.size) {
+        /*
+         * A second, copy on write, mapping of the file already holds the source.  Only the pages the patch
+         * writes are copied, the rest stay shared with the page cache and every other variant of the base.
+         */
+        newMedia = loadMediaEx(szPath, (flags & MEDIA_LOAD_WHOLE) | MEDIA_LOAD_PRIVATE);
+        target = (uint8 *)newMedia.image;
+    } else {
+        /* Inflated or growing images are patched into a buffer of the patched size. */
+        newMedia = base;
+        memset(&base, 0x00, sizeof(base));
+        target = new uint8[info.targetSize ? info.targetSize : 1];
+        uint32 keep = (newMedia.size < info.targetSize) ? newMedia.size : info.targetSize;
+        memcpy(target, newMedia.image, keep);
+        memset(target + keep, 0x00, info.targetSize - keep);
+    }
+
+    const uint8 *source = (NULL != base.image) ? base.image : newMedia.image;
+    uint32 sourceSize = (NULL != base.image) ? base.size : newMedia.size;
+    int valid = NULL != target && applyPatch(patch.image, patch.size, source, sourceSize, target, info.targetSize)
+                && (!info.hasCrc || crc32(0, target, info.targetSize) == info.targetCrc);
+    if (NULL != target && target != newMedia.image) {
+        delete[] newMedia.buffer;
+        newMedia.buffer = target;
+        newMedia.image = target;
+    }
+    newMedia.size = info.targetSize;
+    newMedia.ready = info.targetSize;
+    newMedia.loadMs = clockMs() - start;
+    unloadMedia(&patch);
+    unloadMedia(&base);
+    if (!valid) {
+        unloadMedia(&newMedia);
+    }
+    return newMedia;
+}
+
+/* Make sure the start of the image is valid. */
+int mediaEnsure(LPMEDIA pMedia, uint32 end)
+{
+    if (end > pMedia->size) {
+        end = pMedia->size;
+    }
+    if (end <= pMedia->ready) {
+        return TRUE;
+    }
+    if (NULL == pMedia->pInflate) {
+        return FALSE;
+    }
+
+    /* Inflate whole banks so neighbouring reads do not resume the stream again. */
+    LPINFLATE pInflate = pMedia->pInflate;
+    uint32 headerSize = (uint32)(pMedia->image - pMedia->buffer);
+    uint32 target = (end + MEDIA_BANK_SIZE - 1) & ~(MEDIA_BANK_SIZE - 1);
+    target = (target >= pMedia->size) ? pInflate->outSize : headerSize + target;
+    int state = inflateTo(pInflate, target);
+
+    if (INFLATE_STATE_DONE == state || INFLATE_STATE_ERROR == state) {
+        /* A complete file must fill the buffer and match the container CRC. */
+        int valid = INFLATE_STATE_DONE == state && pInflate->outPos == pInflate->outSize
+                    && crc32(0, pMedia->buffer, pInflate->outSize) == pMedia->crc;
+        delete pInflate;
+        pMedia->pInflate = NULL;
+        pMedia->ready = valid ? pMedia->size : 0;
+        return valid;
+    }
+    pMedia->ready = (pInflate->outPos > headerSize) ? pInflate->outPos - headerSize : 0;
+    if (pMedia->ready > pMedia->size) {
+        pMedia->ready = pMedia->size;
+    }
+    return end <= pMedia->ready;
+}
+
+/* Get a bank of the image, inflating it on first touch. */
+const uint8 *mediaBank(LPMEDIA pMedia, uint32 bank)
+{
+    uint32 offset = bank * MEDIA_BANK_SIZE;
+    if (NULL == pMedia->image || offset >= pMedia->size || !mediaEnsure(pMedia, offset + MEDIA_BANK_SIZE)) {
+        return NULL;
+    }
+    return pMedia->image + offset;
+}
+
+/* Unload media. */
+void unloadMedia(LPMEDIA pMedia)
+{
+    delete pMedia->pInflate;
+    delete[] pMedia->buffer;
+#ifdef WIN32
+    if (NULL != pMedia->view) {
+        UnmapViewOfFile(pMedia->view);
+    }
+    if (NULL != pMedia->hMapping) {
+        CloseHandle(pMedia->hMapping);
+    }
+    if (NULL != pMedia->hFile) {
+        CloseHandle(pMedia->hFile);
+    }
+#else
+    if (NULL != pMedia->view) {
+        munmap((void *)pMedia->view, pMedia->viewSize);
+    }
+#endif
+    memset(pMedia, 0x00, sizeof(*pMedia));
+}
+
+/* Count the bytes of the media resident in memory. */
+uint32 mediaResident(LPMEDIA pMedia)
+{
+    if (NULL == pMedia->view) {
+        return 0;
+    }
+
+    uint32 resident = 0;
+#ifdef WIN32
+    SYSTEM_INFO system;
+    GetSystemInfo(&system);
+    uint32 pageSize = system.dwPageSize;
+    PSAPI_WORKING_SET_EX_INFORMATION page;
+    for (uint32 offset = 0; offset < pMedia->viewSize; offset += pageSize) {
+        page.VirtualAddress = (PVOID)(pMedia->view + offset);
+        if (QueryWorkingSetEx(GetCurrentProcess(), &page, sizeof(page)) && page.VirtualAttributes.Valid) {
+            resident += pageSize;
+        }
+    }
+#else
+    uint32 pageSize = (uint32)sysconf(_SC_PAGESIZE);
+    uint32 pages = (pMedia->viewSize + pageSize - 1) / pageSize;
+    unsigned char *vec = new unsigned char[pages];
+    if (0 == mincore((void *)pMedia->view, pMedia->viewSize, vec)) {
+        for (uint32 i = 0; i < pages; ++i) {
+            resident += (vec[i] & 0x01) ? pageSize : 0;
+        }
+    }
+    delete[] vec;
+#endif
+    if (resident > pMedia->viewSize) {
+        resident = pMedia->viewSize;
+    }
+    if (NULL != pMedia->buffer) {
+        resident += (uint32)(pMedia->image - pMedia->buffer) + pMedia->ready;
+    }
+    return resident;
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#ifndef SINES_MEDIA_H               /* START: HEADER GUARD */
+#define SINES_MEDIA_H
+
+#include "xplat/platform.hpp"
+#include "xplat/types.hpp"
+#include "Media/Inflate.hpp"
+
+/* Size of the header some copiers put in front of the ROM image. */
+#define MEDIA_COPIER_HEADER_SIZE    512
+
+/* Size of the banks a lazily inflated image is completed in. */
+#define MEDIA_BANK_SIZE             0x8000
+
+/* Bounds on the inflated size a container claims, larger claims fail the load rather than the allocation. */
+#define MEDIA_MAX_SIZE              0x01000000  // Largest image inflated, well past any cartridge.
+#define MEDIA_MAX_RATIO             1032        // Most bytes DEFLATE expands one stream byte into.
+
+/* Containers an image may be wrapped in. */
+#define MEDIA_FORMAT_RAW            0
+#define MEDIA_FORMAT_GZIP           1
+#define MEDIA_FORMAT_ZIP            2
+
+/* Flags for loadMediaEx. */
+#define MEDIA_LOAD_LAZY             (0x01 << 0) // Inflate a compressed image a bank at a time as it is touched.
+#define MEDIA_LOAD_PRIVATE          (0x01 << 1) // Map the file copy on write so the image may be written.
+#define MEDIA_LOAD_WHOLE            (0x01 << 2) // Keep any copier header in the image.
+
+/**
+ * A ROM image mapped into memory.  A raw image, or one stored uncompressed in a zip, points straight
+ * into the mapping, so processes and instances loading the same file share its page cache pages and hold no copy
+ * of their own.  A gzip or deflated zip image is inflated into a single buffer sized from its container, either
+ * at load or, with MEDIA_LOAD_LAZY, a bank at a time through mediaEnsure and mediaBank.  A container claiming
+ * more than MEDIA_MAX_SIZE or more than the stream can inflate to is not loaded.
+ */
+typedef struct _MEDIA {
+    const uint8    *image;      // ROM image, past any copier header. NULL if loading failed.
+    uint32          size;       // Size of the ROM image in bytes.
+    int             hasHeader;  // Non zero if a copier header was skipped.
+    uint32          ready;      // Bytes at the start of the image that are valid, size unless inflated lazily.
+    int             format;     // MEDIA_FORMAT_* of the file.
+
+    /* Compressed images. */
+    uint8          *buffer;     // The inflated file, NULL if the image is served from the mapping.
+    LPINFLATE       pInflate;   // Inflater of a lazily inflated image, NULL once it is complete.
+    uint32          crc;        // CRC-32 of the inflated file recorded by its container.
+
+    /* Mapping of the whole file. */
+    const uint8    *view;       // Start of the mapping.
+    uint32          viewSize;   // Size of the mapping in bytes.
+#ifdef WIN32
+    HANDLE          hFile;      // The image file.
+    HANDLE          hMapping;   // The file mapping object.
+#endif
+
+    /* Load statistics. */
+    double          loadMs;     // Milliseconds spent opening, mapping and inflating the file.
+} MEDIA, FAR * LPMEDIA;
+
+/**
+ * Load media.
+ *
+ * @param szPath : usz    [IN]    The path to the image.
+ *
+ * @return The media, image is NULL if the file could not be mapped or inflated.
+ */
+MEDIA loadMedia(usz szPath);
+
+/**
+ * Load media, raw, gzip or zip.  A zip loads its largest entry.
+ *
+ * @param szPath : usz      [IN]    The path to the image.
+ * @param flags : uint32    [IN]    MEDIA_LOAD_* flags.
+ *
+ * @return The media, image is NULL if the file could not be mapped or inflated.
+ */
+MEDIA loadMediaEx(usz szPath, uint32 flags);
+
+/**
+ * Load media with an IPS or BPS patch applied.  The patch applies to the image past any copier header, it may
+ * itself be gzip or zip wrapped.  A raw image the patch does not grow is patched in a copy on write mapping of
+ * the file, so variants of one base ROM share every page the patch leaves alone.  Other images are patched into
+ * a buffer.  BPS patches have their own, source and target CRC-32 checked.
+ *
+ * @param szPath : usz      [IN]    The path to the image.
+ * @param szPatch : usz     [IN]    The path to the patch.
+ * @param flags : uint32    [IN]    MEDIA_LOAD_* flags, MEDIA_LOAD_LAZY is ignored.
+ *
+ * @return The patched media, image is NULL if either file could not be loaded or the patch does not apply.
+ */
+MEDIA loadPatchedMedia(usz szPath, usz szPatch, uint32 flags);
+
+/**
+ * Make sure the start of the image is valid, inflating whole banks of a lazily inflated image.  DEFLATE matches
+ * reach back through the stream, so every bank before the end is inflated as well.  The CRC-32 of the file is
+ * checked when the last bank is inflated.
+ *
+ * @param pMedia : LPMEDIA  [IN/OUT]    The media.
+ * @param end : uint32      [IN]        Offset in the image the bytes before must be valid, clipped to the size.
+ *
+ * @return TRUE if the bytes are valid, FALSE if the stream is corrupt.
+ */
+int mediaEnsure(LPMEDIA pMedia, uint32 end);
+
+/**
+ * Get a bank of the image, inflating it on first touch.
+ *
+ * @param pMedia : LPMEDIA  [IN/OUT]    The media.
+ * @param bank : uint32     [IN]        Index of the MEDIA_BANK_SIZE bank.
+ *
+ * @return The bank, NULL if it is past the image or the stream is corrupt.
+ */
+const uint8 *mediaBank(LPMEDIA pMedia, uint32 bank);
+
+/**
+ * Unload media, unmapping the image.
+ *
+ * @param pMedia : LPMEDIA  [IN/OUT]    The media.
+ */
+void unloadMedia(LPMEDIA pMedia);
+
+/**
+ * Count the bytes of the media resident in memory.  The pages of the mapping belong to the page cache and are
+ * shared by every instance mapping the same file.  An inflated image adds the private bytes inflated so far.
+ *
+ * @param pMedia : LPMEDIA  [IN]    The media.
+ *
+ * @return The resident bytes of the mapping and inflated image.
+ */
+uint32 mediaResident(LPMEDIA pMedia);
+
+#endif                              /* END: HEADER GUARD */
@@ -0,0 +1,229 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#include <string.h>
+#include "Media/Crc32.hpp"
+#include "Media/Patch.hpp"
+
+/* IPS: "PATCH", records of a 24 bit offset and 16 bit size, "EOF" and an optional 24 bit truncated size. */
+#define IPS_MAGIC_SIZE      5
+#define IPS_EOF             0x454F46
+
+/* BPS: "BPS1", variable length sizes and actions, then the source, target and patch CRCs. */
+#define BPS_MAGIC_SIZE      4
+#define BPS_FOOTER_SIZE     12
+#define BPS_SOURCE_READ     0
+#define BPS_TARGET_READ     1
+#define BPS_SOURCE_COPY     2
+#define BPS_TARGET_COPY     3
+
+/* Write bytes to the target, skipping unchanged runs so their copy on write pages stay shared. */
+static void writeTarget(uint8 *target, const uint8 *data, uint32 length)
+{
+    if (0 != memcmp(target, data, length)) {
+        memcpy(target, data, length);
+    }
+}
+
+/* Read big endian IPS values. */
+static uint32 ipsWord(const uint8 *data)
+{
+    return (uint32)((data[0] << 8) | data[1]);
+}
+static uint32 ipsOffset(const uint8 *data)
+{
+    return (uint32)((data[0] << 16) | (data[1] << 8) | data[2]);
+}
+
+/* Read a little endian BPS CRC. */
+static uint32 bpsLong(const uint8 *data)
+{
+    return (uint32)data[0] | ((uint32)data[1] << 8) | ((uint32)data[2] << 16) | ((uint32)data[3] << 24);
+}
+
+/* Read a BPS variable length number, FALSE if it runs past the actions or overflows. */
+static int bpsNumber(const uint8 *patch, uint32 end, uint32 *pPos, uint32 *pValue)
+{
+    uint64 value = 0, shift = 1;
+    while (*pPos < end && shift <= 0x100000000ULL) {
+        uint8 x = patch[(*pPos)++];
+        value += (x & 0x7F) * shift;
+        if (x & 0x80) {
+            if (value > 0xFFFFFFFF) {
+                return FALSE;
+            }
+            *pValue = (uint32)value;
+            return TRUE;
+        }
+        shift <<= 7;
+        value += shift;
+    }
+    return FALSE;
+}
+
+/*
+ * Walk the records of an IPS patch, writing them to the target if there is one.  Reports the end of the last
+ * record and the truncated size, 0 if there is none.
+ */
+static int walkIps(const uint8 *patch, uint32 patchSize, uint8 *target, uint32 targetSize,
+                   uint32 *pEnd, uint32 *pTruncate)
+{
+    uint32 pos = IPS_MAGIC_SIZE;
+    uint32 end = 0;
+    while (pos + 3 <= patchSize) {
+        uint32 offset = ipsOffset(patch + pos);
+        pos += 3;
+        if (IPS_EOF == offset) {
+            *pTruncate = (pos + 3 <= patchSize) ? ipsOffset(patch + pos) : 0;
+            *pEnd = end;
+            return TRUE;
+        }
+        if (pos + 2 > patchSize) {
+            return FALSE;
+        }
+
+        /* A zero size marks a run of one byte. */
+        uint32 size = ipsWord(patch + pos);
+        pos += 2;
+        const uint8 *data = patch + pos;
+        int run = (0 == size);
+        if (run) {
+            if (pos + 3 > patchSize) {
+                return FALSE;
+            }
+            size = ipsWord(patch + pos);
+            data = patch + pos + 2;
+            pos += 3;
+        } else if (size > patchSize - pos) {
+            return FALSE;
+        } else {
+            pos += size;
+        }
+
+        if (NULL == target) {
+            end = (offset + size > end) ? offset + size : end;
+        } else if (offset < targetSize) {
+            uint32 count = (size > targetSize - offset) ? targetSize - offset : size;
+            if (run) {
+                memset(target + offset, *data, count);
+            } else {
+                writeTarget(target + offset, data, count);
+            }
+        }
+    }
+    return FALSE;
+}
+
+/* Identify and validate a patch. */
+int inspectPatch(const uint8 *patch, uint32 patchSize, uint32 sourceSize, LPPATCH_INFO pInfo)
+{
+    memset(pInfo, 0x00, sizeof(*pInfo));
+
+    if (patchSize >= IPS_MAGIC_SIZE && 0 == memcmp(patch, "PATCH", IPS_MAGIC_SIZE)) {
+        uint32 end, truncate;
+        if (!walkIps(patch, patchSize, NULL, 0, &end, &truncate)) {
+            return FALSE;
+        }
+
+        /* The patch grows the image to its last record, unless it ends with a truncated size. */
+        pInfo->format = PATCH_FORMAT_IPS;
+        pInfo->targetSize = truncate ? truncate : (end > sourceSize ? end : sourceSize);
+        return TRUE;
+    }
+
+    if (patchSize >= BPS_MAGIC_SIZE + BPS_FOOTER_SIZE && 0 == memcmp(patch, "BPS1", BPS_MAGIC_SIZE)) {
+        uint32 end = patchSize - BPS_FOOTER_SIZE;
+        uint32 pos = BPS_MAGIC_SIZE;
+        uint32 patchSource, metadata;
+        if (!bpsNumber(patch, end, &pos, &patchSource) || !bpsNumber(patch, end, &pos, &pInfo->targetSize)
+            || !bpsNumber(patch, end, &pos, &metadata) || metadata > end - pos || patchSource != sourceSize) {
+            return FALSE;
+        }
+        if (crc32(0, patch, patchSize - 4) != bpsLong(patch + patchSize - 4)) {
+            return FALSE;
+        }
+        pInfo->format = PATCH_FORMAT_BPS;
+        pInfo->hasCrc = TRUE;
+        pInfo->sourceCrc = bpsLong(patch + end);
+        pInfo->targetCrc = bpsLong(patch + end + 4);
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+/* Apply a patch. */
+int applyPatch(const uint8 *patch, uint32 patchSize, const uint8 *source, uint32 sourceSize,
+               uint8 *target, uint32 targetSize)
+{
+    if (patchSize >= IPS_MAGIC_SIZE && 0 == memcmp(patch, "PATCH", IPS_MAGIC_SIZE)) {
+        uint32 end, truncate;
+        return walkIps(patch, patchSize, target, targetSize, &end, &truncate);
+    }
+
+    uint32 end = patchSize - BPS_FOOTER_SIZE;
+    uint32 pos = BPS_MAGIC_SIZE;
+    uint32 value, metadata;
+    bpsNumber(patch, end, &pos, &value);
+    bpsNumber(patch, end, &pos, &value);
+    bpsNumber(patch, end, &pos, &metadata);
+    pos += metadata;
+
+    uint32 out = 0, sourceRel = 0, targetRel = 0;
+    while (pos < end) {
+        uint32 action;
+        if (!bpsNumber(patch, end, &pos, &action)) {
+            return FALSE;
+        }
+        uint32 length = (action >> 2) + 1;
+        if (length > targetSize - out) {
+            return FALSE;
+        }
+
+        switch (action & 0x03) {
+            case BPS_SOURCE_READ:
+                /* The target already holds the source, so the bytes are left alone and their pages shared. */
+                if (out + length > sourceSize) {
+                    return FALSE;
+                }
+                break;
+
+            case BPS_TARGET_READ:
+                if (length > end - pos) {
+                    return FALSE;
+                }
+                writeTarget(target + out, patch + pos, length);
+                pos += length;
+                break;
+
+            case BPS_SOURCE_COPY:
+            case BPS_TARGET_COPY: {
+                uint32 offset;
+                if (!bpsNumber(patch, end, &pos, &offset)) {
+                    return FALSE;
+                }
+                uint32 *pRel = (BPS_SOURCE_COPY == (action & 0x03)) ? &sourceRel : &targetRel;
+                *pRel = (offset & 0x01) ? *pRel - (offset >> 1) : *pRel + (offset >> 1);
+                if (BPS_SOURCE_COPY == (action & 0x03)) {
+                    if (sourceRel > sourceSize || length > sourceSize - sourceRel) {
+                        return FALSE;
+                    }
+                    writeTarget(target + out, source + sourceRel, length);
+                } else {
+                    /* Target copies may overlap the bytes they produce, repeating a pattern. */
+                    if (targetRel >= out) {
+                        return FALSE;
+                    }
+                    for (uint32 i = 0; i < length; ++i) {
+                        target[out + i] = target[targetRel + i];
+                    }
+                }
+                *pRel += length;
+                break;
+            }
+        }
+        out += length;
+    }
+    return out == targetSize;
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#ifndef SINES_PATCH_H               /* START: HEADER GUARD */
+#define SINES_PATCH_H
+
+#include "xplat/platform.hpp"
+#include "xplat/types.hpp"
+
+/* Patch formats. */
+#define PATCH_FORMAT_NONE       0
+#define PATCH_FORMAT_IPS        1
+#define PATCH_FORMAT_BPS        2
+
+/**
+ * What a patch needs and produces, read from the patch before it is applied.
+ */
+typedef struct _PATCH_INFO {
+    int             format;     // PATCH_FORMAT_*.
+    uint32          targetSize; // Size of the patched image in bytes.
+    int             hasCrc;     // Non zero if the patch records the CRCs below.
+    uint32          sourceCrc;  // CRC-32 of the image the patch applies to.
+    uint32          targetCrc;  // CRC-32 of the patched image.
+} PATCH_INFO, FAR * LPPATCH_INFO;
+
+/**
+ * Identify and validate a patch.  An IPS patch is scanned for the size it grows the image to, a BPS patch has
+ * its header read and its own CRC-32 checked.
+ *
+ * @param patch : const uint8*      [IN]    The patch.
+ * @param patchSize : uint32        [IN]    Size of the patch in bytes.
+ * @param sourceSize : uint32       [IN]    Size of the image the patch applies to.
+ * @param pInfo : LPPATCH_INFO      [OUT]   What the patch needs and produces.
+ *
+ * @return TRUE if the patch is valid for an image of the size.
+ */
+int inspectPatch(const uint8 *patch, uint32 patchSize, uint32 sourceSize, LPPATCH_INFO pInfo);
+
+/**
+ * Apply a patch.  The target must already hold the source, zero filled past its end, so bytes the patch keeps
+ * are never written.  Over a copy on write mapping only the pages the patch changes get copied.  The source
+ * must stay unmodified, BPS patches copy from anywhere in it.
+ *
+ * @param patch : const uint8*      [IN]        The patch, checked by inspectPatch.
+ * @param patchSize : uint32        [IN]        Size of the patch in bytes.
+ * @param source : const uint8*     [IN]        The image the patch applies to.
+ * @param sourceSize : uint32       [IN]        Size of the source in bytes.
+ * @param target : uint8*           [IN/OUT]    The patched image.
+ * @param targetSize : uint32       [IN]        Size of the target from inspectPatch.
+ *
+ * @return TRUE if the patch applied, FALSE if it reaches outside the source or target.
+ */
+int applyPatch(const uint8 *patch, uint32 patchSize, const uint8 *source, uint32 sourceSize,
+               uint8 *target, uint32 targetSize);
+
+#endif                              /* END: HEADER GUARD */
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Media/Crc32.hpp"
+#include "Media/RomIndex.hpp"
+
+/* Order entries by path. */
+static int compareEntries(const void *a, const void *b)
+{
+    return strcmp(((const ROM_INDEX_ENTRY *)a)->path, ((const ROM_INDEX_ENTRY *)b)->path);
+}
+
+/* Map an index file. */
+int openRomIndex(usz szPath, LPROM_INDEX pIndex)
+{
+    memset(pIndex, 0x00, sizeof(*pIndex));
+    pIndex->file = loadMedia(szPath);
+    if (NULL == pIndex->file.view) {
+        return FALSE;
+    }
+
+    /* The whole mapping is the index, a copier header is meaningless here. */
+    const ROM_INDEX_HEADER *header = (const ROM_INDEX_HEADER *)pIndex->file.view;
+    if (pIndex->file.viewSize < sizeof(ROM_INDEX_HEADER)
+        || ROM_INDEX_MAGIC != header->magic
+        || ROM_INDEX_VERSION != header->version
+        || sizeof(ROM_INDEX_ENTRY) != header->entrySize
+        || pIndex->file.viewSize < sizeof(ROM_INDEX_HEADER) + header->count * sizeof(ROM_INDEX_ENTRY)) {
+        closeRomIndex(pIndex);
+        return FALSE;
+    }
+    pIndex->entries = (const ROM_INDEX_ENTRY *)(header + 1);
+    pIndex->count = header->count;
+    return TRUE;
+}
+
+/* Unmap an index file. */
+void closeRomIndex(LPROM_INDEX pIndex)
+{
+    unloadMedia(&pIndex->file);
+    pIndex->entries = NULL;
+    pIndex->count = 0;
+}
+
+/* Find the entry of a path. */
+const ROM_INDEX_ENTRY *findRomIndex(LPROM_INDEX pIndex, const char *path)
+{
+    uint32 lo = 0;
+    uint32 hi = pIndex->count;
+    while (lo < hi) {
+        uint32 mid = lo + (hi - lo) / 2;
+        int order = strcmp(pIndex->entries[mid].path, path);
+        if (0 == order) {
+            return pIndex->entries[mid].valid ? &pIndex->entries[mid] : NULL;
+        }
+        if (order < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return NULL;
+}
+
+/* Fill an index entry from a loaded ROM. */
+void indexMedia(LPMEDIA pMedia, LPROM_INDEX_ENTRY pEntry, int analyze)
+{
+    CARTRIDGE cart;
+    if (!mediaEnsure(pMedia, pMedia->size)) {
+        return;
+    }
+    pEntry->crc32 = crc32(0, pMedia->image, pMedia->size);
+    pEntry->hasHeader = pMedia->hasHeader ? 1 : 0;
+    pEntry->valid = 1;
+    if (analyze && analyzeCartridge(pMedia, &cart)) {
+        memcpy(pEntry->title, cart.title, sizeof(pEntry->title));
+        pEntry->map = (uint8)cart.map;
+        pEntry->mapMode = cart.mapMode;
+        pEntry->region = cart.region;
+        pEntry->romSize = cart.romSize;
+        pEntry->ramSize = cart.ramSize;
+        pEntry->checksumValid = (0xFFFF == (uint16)(cart.checksum + cart.complement)
+                                 && cart.checksum == cartridgeChecksum(pMedia)) ? 1 : 0;
+    }
+}
+
+/* Sort entries by path and write them as an index file. */
+int writeRomIndex(usz szPath, LPROM_INDEX_ENTRY entries, uint32 count)
+{
+    qsort(entries, count, sizeof(ROM_INDEX_ENTRY), compareEntries);
+
+    /* Write beside the index and swap it in, a mapped old index stays intact until then.  The index path is
+       absolute or under the library directory, so it may be longer than the relative paths of the entries. */
+    size_t pathLength = strlen((char*)szPath);
+    char *tempPath = new char[pathLength + 5];
+    memcpy(tempPath, (char*)szPath, pathLength);
+    memcpy(tempPath + pathLength, ".tmp", 5);
+    FILE *pfIndex = fopen(tempPath, "wb");
+    if (NULL == pfIndex) {
+        delete[] tempPath;
+        return FALSE;
+    }
+
+    ROM_INDEX_HEADER header;
+    header.magic = ROM_INDEX_MAGIC;
+    header.version = ROM_INDEX_VERSION;
+    header.entrySize = sizeof(ROM_INDEX_ENTRY);
+    header.count = count;
+    int written = 1 == fwrite(&header, sizeof(header), 1, pfIndex)
+                  && count == fwrite(entries, sizeof(ROM_INDEX_ENTRY), count, pfIndex);
+    written = (0 == fclose(pfIndex)) && written;
+
+#ifdef WIN32
+    written = written && MoveFileExA(tempPath, (char*)szPath, MOVEFILE_REPLACE_EXISTING);
+#else
+    written = written && 0 == rename(tempPath, (char*)szPath);
+#endif
+    if (!written) {
+        remove(tempPath);
+    }
+    delete[] tempPath;
+    return written ? TRUE : FALSE;
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#ifndef SINES_ROM_INDEX_H           /* START: HEADER GUARD */
+#define SINES_ROM_INDEX_H
+
+#include "Media/Cartridge.hpp"
+#include "Media/Media.hpp"
+
+/*
+On disk index of a ROM library, written by the sines-index tool.
+
+The file is a ROM_INDEX_HEADER followed by fixed size ROM_INDEX_ENTRY records sorted by path, so it is mapped
+as is and searched in place without opening any ROM.  An entry is valid while the path, modification time and
+size of its file are unchanged.  A file that failed to load keeps an entry without the valid mark, so it is not
+found and is hashed again on the next run.
+*/
+
+#define ROM_INDEX_MAGIC         0x58444953  /* "SIDX" */
+#define ROM_INDEX_VERSION       2
+#define ROM_INDEX_PATH_SIZE     256
+
+typedef struct _ROM_INDEX_HEADER {
+    uint32  magic;      // ROM_INDEX_MAGIC.
+    uint32  version;    // ROM_INDEX_VERSION.
+    uint32  entrySize;  // sizeof(ROM_INDEX_ENTRY).
+    uint32  count;      // Number of entries.
+} ROM_INDEX_HEADER;
+
+typedef struct _ROM_INDEX_ENTRY {
+    uint64  mtime;          // Modification time of the file.
+    uint32  size;           // Size of the file in bytes.
+    uint32  crc32;          // CRC-32 of the ROM image, past any copier header.
+    uint32  romSize;        // ROM size claimed by the internal header.
+    uint32  ramSize;        // Cartridge RAM size.
+    char    path[ROM_INDEX_PATH_SIZE];          // Path relative to the library directory.
+    char    title[CARTRIDGE_TITLE_SIZE + 1];    // Internal title.
+    uint8   map;            // CARTRIDGE_MAP_*.
+    uint8   mapMode;        // Map mode byte.
+    uint8   region;         // Destination code.
+    uint8   checksumValid;  // Non zero if the image matches the internal checksum.
+    uint8   hasHeader;      // Non zero if the file has a copier header.
+    uint8   valid;          // Non zero if the file loaded and was hashed.
+    uint8   reserved[4];
+} ROM_INDEX_ENTRY, FAR * LPROM_INDEX_ENTRY;
+
+/**
+ * A mapped index.
+ */
+typedef struct _ROM_INDEX {
+    MEDIA                   file;       // Mapping of the index file.
+    const ROM_INDEX_ENTRY  *entries;    // Entries sorted by path, NULL if no index is open.
+    uint32                  count;      // Number of entries.
+} ROM_INDEX, FAR * LPROM_INDEX;
+
+/**
+ * Map an index file.
+ *
+ * @param szPath : usz          [IN]    The path to the index.
+ * @param pIndex : LPROM_INDEX  [OUT]   The index.
+ *
+ * @return TRUE if the index was mapped, FALSE if it is missing or of another version.
+ */
+int openRomIndex(usz szPath, LPROM_INDEX pIndex);
+
+/**
+ * Unmap an index file.
+ *
+ * @param pIndex : LPROM_INDEX  [IN/OUT]    The index.
+ */
+void closeRomIndex(LPROM_INDEX pIndex);
+
+/**
+ * Find the entry of a path.
+ *
+ * @param pIndex : LPROM_INDEX  [IN]    The index.
+ * @param path : const char*    [IN]    The path relative to the library directory.
+ *
+ * @return The entry, NULL if the path is not indexed or its file failed to load.
+ */
+const ROM_INDEX_ENTRY *findRomIndex(LPROM_INDEX pIndex, const char *path);
+
+/**
+ * Fill an index entry from a loaded ROM: hash the image, record the header analysis and mark the entry valid.
+ *
+ * @param pMedia : LPMEDIA          [IN]    The media.
+ * @param pEntry : LPROM_INDEX_ENTRY [OUT]  The entry, path, mtime and size are left to the caller.
+ * @param analyze : int             [IN]    Non zero to analyze the SNES cartridge header, zero to leave the
+ *                                          header fields empty for images of other systems.
+ */
+void indexMedia(LPMEDIA pMedia, LPROM_INDEX_ENTRY pEntry, int analyze);
+
+/**
+ * Sort entries by path and write them as an index file.
+ *
+ * @param szPath : usz                  [IN]    The path to the index.
+ * @param entries : LPROM_INDEX_ENTRY   [IN]    The entries, sorted in place.
+ * @param count : uint32                [IN]    The number of entries.
+ *
+ * @return TRUE if the index was written.
+ */
+int writeRomIndex(usz szPath, LPROM_INDEX_ENTRY entries, uint32 count);
+
+#endif                              /* END: HEADER GUARD */
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#include <string.h>
+#include "Media/Title.hpp"
+#ifndef WIN32
+    #include <sched.h>
+#endif
+
+/* Loaded titles, guarded by the title lock. */
+static LPTITLE titles = NULL;
+static volatile long titleLock = 0;
+
+/* Take the title lock.  It only guards the list and the reference counts, never a load, so a spin lock is
+   enough. */
+static void lockTitles()
+{
+#ifdef WIN32
+    while (InterlockedExchange(&titleLock, 1)) {
+        Sleep(0);
+    }
+#else
+    while (__sync_lock_test_and_set(&titleLock, 1)) {
+        sched_yield();
+    }
+#endif
+}
+
+/* Drop the title lock. */
+static void unlockTitles()
+{
+#ifdef WIN32
+    InterlockedExchange(&titleLock, 0);
+#else
+    __sync_lock_release(&titleLock);
+#endif
+}
+
+/* Find a loaded title by image and patch path, under the title lock. */
+static LPTITLE findTitle(const char *path, const char *patch)
+{
+    LPTITLE pTitle = titles;
+    while (NULL != pTitle && (0 != strcmp(pTitle->path, path) || 0 != strcmp(pTitle->patch, patch))) {
+        pTitle = pTitle->pNext;
+    }
+    return pTitle;
+}
+
+/* Acquire a title, loading it if no instance holds it yet. */
+LPTITLE acquireTitle(usz szPath, usz szPatch)
+{
+    const char *path = (const char *)szPath;
+    const char *patch = (NULL != szPatch) ? (const char *)szPatch : "";
+    if (strlen(path) >= TITLE_PATH_SIZE || strlen(patch) >= TITLE_PATH_SIZE) {
+        return NULL;
+    }
+
+    lockTitles();
+    LPTITLE pTitle = findTitle(path, patch);
+    if (NULL != pTitle) {
+        ++pTitle->refs;
+    }
+    unlockTitles();
+    if (NULL != pTitle) {
+        return pTitle;
+    }
+
+    /* Load and inflate outside the lock, so other titles are acquired and released meanwhile.  Shared titles are
+       loaded completely, lazy inflation would write to them. */
+    MEDIA media = (NULL != szPatch) ? loadPatchedMedia(szPath, szPatch, 0) : loadMediaEx(szPath, 0);
+    if (NULL == media.image) {
+        return NULL;
+    }
+    LPTITLE pNewTitle = new TITLE;
+    memset(pNewTitle, 0x00, sizeof(*pNewTitle));
+    strcpy(pNewTitle->path, path);
+    strcpy(pNewTitle->patch, patch);
+    pNewTitle->media = media;
+    pNewTitle->hasCart = analyzeCartridge(&pNewTitle->media, &pNewTitle->cart);
+
+    /* Another thread may have loaded the title meanwhile, the first one in is shared. */
+    lockTitles();
+    pTitle = findTitle(path, patch);
+    if (NULL == pTitle) {
+        pTitle = pNewTitle;
+        pTitle->pNext = titles;
+        titles = pTitle;
+        pNewTitle = NULL;
+    }
+    ++pTitle->refs;
+    unlockTitles();
+    if (NULL != pNewTitle) {
+        unloadMedia(&pNewTitle->media);
+        delete pNewTitle;
+    }
+    return pTitle;
+}
+
+/* Release a title, unloading it once the last holder releases it. */
+void releaseTitle(LPTITLE pTitle)
+{
+    lockTitles();
+    if (0 == --pTitle->refs) {
+        LPTITLE *ppTitle = &titles;
+        while (*ppTitle != pTitle) {
+            ppTitle = &(*ppTitle)->pNext;
+        }
+        *ppTitle = pTitle->pNext;
+        unloadMedia(&pTitle->media);
+        delete pTitle;
+    }
+    unlockTitles();
+}
+
+/* Count the bytes of a title resident in memory. */
+uint32 titleBytes(LPTITLE pTitle)
+{
+    return (uint32)sizeof(TITLE) + mediaResident(&pTitle->media);
+}
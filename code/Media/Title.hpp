@@ -0,0 +1,59 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#ifndef SINES_TITLE_H               /* START: HEADER GUARD */
+#define SINES_TITLE_H
+
+#include "xplat/platform.hpp"
+#include "xplat/types.hpp"
+#include "Media/Cartridge.hpp"
+#include "Media/Media.hpp"
+
+/* Longest path of an image or patch. */
+#define TITLE_PATH_SIZE             260
+
+/**
+ * The read only state of a title, shared by every instance running it: the ROM image and its cartridge
+ * metadata.  A title is loaded completely once and never written after, so instances on any thread read it
+ * without locking.  Titles are reference counted and found by image and patch path, the last release unloads
+ * the title.
+ */
+typedef struct _TITLE {
+    char            path[TITLE_PATH_SIZE];  // Path of the image.
+    char            patch[TITLE_PATH_SIZE]; // Path of the patch, empty for none.
+    MEDIA           media;      // The image, completely loaded.
+    CARTRIDGE       cart;       // Cartridge metadata.
+    int             hasCart;    // Non zero if the cartridge header was identified.
+    long            refs;       // Number of holders of the title.
+    struct _TITLE  *pNext;      // Next loaded title.
+} TITLE, FAR * LPTITLE;
+
+/**
+ * Acquire a title, loading it if no instance holds it yet.  The load runs outside the title lock, threads
+ * acquiring the same new title at once may each load it, and all but the first to finish drop their copy.
+ *
+ * @param szPath : usz      [IN]    The path to the image.
+ * @param szPatch : usz     [IN]    The path to an IPS or BPS patch, NULL for none.
+ *
+ * @return The title, NULL if it could not be loaded.
+ */
+LPTITLE acquireTitle(usz szPath, usz szPatch);
+
+/**
+ * Release a title, unloading it once the last holder releases it.
+ *
+ * @param pTitle : LPTITLE  [IN]    The title.
+ */
+void releaseTitle(LPTITLE pTitle);
+
+/**
+ * Count the bytes of a title resident in memory.  These are paid once however many instances run the title.
+ *
+ * @param pTitle : LPTITLE  [IN]    The title.
+ *
+ * @return The resident bytes of the title.
+ */
+uint32 titleBytes(LPTITLE pTitle);
+
+#endif                              /* END: HEADER GUARD */
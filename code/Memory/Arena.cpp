@@ -0,0 +1,119 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#include <string.h>
+#include "Memory/Arena.hpp"
+#ifdef WIN32
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+#endif
+
+namespace SiNES { namespace Memory {
+    /* Constructor for an empty arena. */
+    Arena::Arena() {
+        this->base = NULL;
+        this->size = 0;
+        this->top = 0;
+        this->backing = ARENA_PAGES_NORMAL;
+    }
+
+    /* Destructor for an arena. */
+    Arena::~Arena() {
+        this->destroy();
+    }
+
+    /* Reserve and commit the memory of the arena. */
+    bool Arena::create(uint32 size, bool hugePages) {
+        this->destroy();
+        if (hugePages) {
+            size = (size + ARENA_HUGE_PAGE_SIZE - 1) & ~(ARENA_HUGE_PAGE_SIZE - 1);
+        }
+
+#ifdef WIN32
+        /* Large pages need SeLockMemoryPrivilege and a multiple of the large page size. */
+        SIZE_T large = GetLargePageMinimum();
+        if (hugePages && 0 != large && 0 == size % large) {
+            this->base = (uint8 *)VirtualAlloc(NULL, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+            this->backing = ARENA_PAGES_HUGE;
+        }
+        if (NULL == this->base) {
+            this->base = (uint8 *)VirtualAlloc(NULL, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+            this->backing = ARENA_PAGES_NORMAL;
+        }
+#else
+        void *memory = MAP_FAILED;
+    #ifdef MAP_HUGETLB
+        if (hugePages) {
+            memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            this->backing = ARENA_PAGES_HUGE;
+        }
+    #endif
+        if (MAP_FAILED == memory) {
+            memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            this->backing = ARENA_PAGES_NORMAL;
+    #ifdef MADV_HUGEPAGE
+            if (hugePages && MAP_FAILED != memory && 0 == madvise(memory, size, MADV_HUGEPAGE)) {
+                this->backing = ARENA_PAGES_TRANSPARENT;
+            }
+    #endif
+        }
+        this->base = (MAP_FAILED == memory) ? NULL : (uint8 *)memory;
+#endif
+
+        this->size = (NULL != this->base) ? size : 0;
+        return NULL != this->base;
+    }
+
+    /* Release the memory of the arena. */
+    void Arena::destroy() {
+        if (NULL != this->base) {
+#ifdef WIN32
+            VirtualFree(this->base, 0, MEM_RELEASE);
+#else
+            munmap(this->base, this->size);
+#endif
+        }
+        this->base = NULL;
+        this->size = 0;
+        this->top = 0;
+        this->backing = ARENA_PAGES_NORMAL;
+    }
+
+    /* Carve zero filled memory out of the arena. */
+    void *Arena::alloc(uint32 size) {
+        uint32 start = (this->top + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+        if (NULL == this->base || start > this->size || size > this->size - start) {
+            return NULL;
+        }
+        this->top = start + size;
+        return this->base + start;
+    }
+
+    /* Get the bytes allocated so far. */
+    uint32 Arena::used() const {
+        return this->top;
+    }
+
+    /* Get the size of the arena. */
+    uint32 Arena::capacity() const {
+        return this->size;
+    }
+
+    /* Get how the arena memory is backed. */
+    int Arena::pages() const {
+        return this->backing;
+    }
+
+    /* Copy the used bytes of the arena. */
+    void Arena::snapshot(void *snapshot) const {
+        memcpy(snapshot, this->base, this->top);
+    }
+
+    /* Copy a snapshot of this arena back into it. */
+    void Arena::restore(const void *snapshot) {
+        memcpy(this->base, snapshot, this->top);
+    }
+
+} /* END: Memory */ } /* END: SiNES */
@@ -0,0 +1,116 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#ifndef SINES_MEMORY_ARENA_H        /* START: HEADER GUARD */
+#define SINES_MEMORY_ARENA_H
+
+#include <stddef.h>
+#include "xplat/types.hpp"
+
+namespace SiNES { namespace Memory {
+    /* Every allocation starts on a cache line. */
+    #define ARENA_ALIGN             64
+
+    /* Size of the huge pages an arena is rounded up to when huge pages are asked for. */
+    #define ARENA_HUGE_PAGE_SIZE    (2 * 1024 * 1024)
+
+    /* How the arena memory is backed. */
+    #define ARENA_PAGES_NORMAL      0   // Normal pages.
+    #define ARENA_PAGES_TRANSPARENT 1   // Normal pages the kernel was advised to back with huge pages.
+    #define ARENA_PAGES_HUGE        2   // Explicit huge (large) pages.
+
+    /**
+     * One contiguous, aligned block holding all the mutable state of a session.
+     *
+     * Allocations are carved out in order and never freed on their own, so state allocated first shares the
+     * first cache lines and the whole session spans as few pages (and TLB entries) as possible.  Everything in
+     * the arena is plain memory, a snapshot is one copy of the used bytes and restoring it one copy back into
+     * the same arena, where any pointers between allocations stay valid.
+     */
+    class Arena {
+    public:
+        /**
+         * Constructor for an empty arena.
+         */
+        Arena();
+
+        /**
+         * Destructor for an arena, releasing its memory.
+         */
+        ~Arena();
+
+        /**
+         * Reserve and commit the memory of the arena.  Huge pages are tried explicitly first, then advised to
+         * the kernel, and normal pages are used when neither is available.
+         *
+         * @param size      [IN]        Size of the arena in bytes.
+         * @param hugePages [IN]        True to back the arena with huge pages.
+         *
+         * @return True if the memory was committed.
+         */
+        bool create(uint32 size, bool hugePages);
+
+        /**
+         * Release the memory of the arena, every allocation becomes invalid.
+         */
+        void destroy();
+
+        /**
+         * Carve zero filled memory out of the arena.
+         *
+         * @param size      [IN]        Size of the allocation in bytes.
+         *
+         * @return The ARENA_ALIGN aligned allocation, NULL if the arena is full.
+         */
+        void *alloc(uint32 size);
+
+        /**
+         * Get the bytes allocated so far, the size of a snapshot.
+         *
+         * @return The used bytes.
+         */
+        uint32 used() const;
+
+        /**
+         * Get the size of the arena.
+         *
+         * @return The committed bytes.
+         */
+        uint32 capacity() const;
+
+        /**
+         * Get how the arena memory is backed.
+         *
+         * @return The ARENA_PAGES_* backing.
+         */
+        int pages() const;
+
+        /**
+         * Copy the used bytes of the arena.
+         *
+         * @param snapshot  [OUT]       used() bytes to copy the arena to.
+         */
+        void snapshot(void *snapshot) const;
+
+        /**
+         * Copy a snapshot of this arena back into it.
+         *
+         * @param snapshot  [IN]        A snapshot taken from this arena.
+         */
+        void restore(const void *snapshot);
+
+    private:
+        uint8  *base;       // Start of the arena, NULL if none is committed.
+        uint32  size;       // Committed bytes.
+        uint32  top;        // Bytes allocated.
+        int     backing;    // ARENA_PAGES_* backing of the memory.
+
+        /* Arenas own their memory, they are not copied. */
+        Arena(const Arena &);
+        Arena &operator=(const Arena &);
+    };
+
+} /* END: Memory */ } /* END: SiNES */
+
+#endif                              /* END: HEADER GUARD */
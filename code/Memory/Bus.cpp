@@ -0,0 +1,119 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#include <string.h>
+#include "Memory/Bus.hpp"
+
+namespace SiNES { namespace Memory {
+    /* Constructor for an empty bus. */
+    Bus::Bus() {
+        memset(this->pages, 0x00, sizeof(this->pages));
+        for (uint32 i = 0; i < BUS_PAGE_COUNT; ++i) {
+            this->readPages[i] = NULL;
+            this->writePages[i] = NULL;
+        }
+        this->watchFn = NULL;
+        this->watchContext = NULL;
+    }
+
+    /* Map host memory into a run of pages. */
+    void Bus::map(uint8 first, uint32 count, uint8 *host, bool writable) {
+        for (uint32 i = 0; i < count && first + i < BUS_PAGE_COUNT; ++i) {
+            PAGE &page = this->pages[first + i];
+            if (page.watched) {
+                if (NULL != this->watchFn) {
+                    this->watchFn(this->watchContext, (uint8)(first + i));
+                }
+                page.watched = false;
+            }
+            page.host = (NULL != host) ? host + i * BUS_PAGE_SIZE : NULL;
+            page.writable = writable;
+            this->update((uint8)(first + i));
+        }
+    }
+
+    /* Route a run of pages through handlers. */
+    void Bus::mapHandlers(uint8 first, uint32 count, BUS_READ_FN read, BUS_WRITE_FN write, void *context) {
+        for (uint32 i = 0; i < count && first + i < BUS_PAGE_COUNT; ++i) {
+            PAGE &page = this->pages[first + i];
+            page.read = read;
+            page.write = write;
+            page.context = context;
+            this->update((uint8)(first + i));
+        }
+    }
+
+    /* Get the host memory mapped to a page. */
+    uint8 *Bus::hostPage(uint8 page) const {
+        return this->pages[page].host;
+    }
+
+    /* Set the handler called before the first write to a watched page. */
+    void Bus::setWatchHandler(BUS_WATCH_FN watch, void *context) {
+        this->watchFn = watch;
+        this->watchContext = context;
+    }
+
+    /* Send writes to a page and its mirrors through the watch handler. */
+    void Bus::watch(uint8 page) {
+        if (!this->pages[page].watched) {
+            this->setWatched(page, true);
+        }
+    }
+
+    /* Return a watched page and its mirrors to their normal write path. */
+    void Bus::unwatch(uint8 page) {
+        if (this->pages[page].watched) {
+            this->setWatched(page, false);
+        }
+    }
+
+    /* Set the watch state of a page and every page mapped to the same host memory. */
+    void Bus::setWatched(uint8 page, bool watched) {
+        /* A write through any mirror changes the memory the watched page reads. */
+        const uint8 *host = this->pages[page].host;
+        if (NULL == host) {
+            this->pages[page].watched = watched;
+            this->update(page);
+            return;
+        }
+        for (uint32 i = 0; i < BUS_PAGE_COUNT; ++i) {
+            if (this->pages[i].host == host) {
+                this->pages[i].watched = watched;
+                this->update((uint8)i);
+            }
+        }
+    }
+
+    /* Rebuild the fast path pointers of a page. */
+    void Bus::update(uint8 page) {
+        const PAGE &p = this->pages[page];
+        this->readPages[page] = (NULL == p.read) ? p.host : NULL;
+        this->writePages[page] = (NULL == p.write && p.writable && !p.watched) ? p.host : NULL;
+    }
+
+    /* Read a byte from a page without a fast path. */
+    uint8 Bus::readSlow(uint16 addr) {
+        const PAGE &page = this->pages[addr >> BUS_PAGE_SHIFT];
+        if (NULL != page.read) {
+            return page.read(page.context, addr);
+        }
+        return BUS_OPEN_BUS;
+    }
+
+    /* Write a byte to a page without a fast path. */
+    void Bus::writeSlow(uint16 addr, uint8 value) {
+        uint8 index = (uint8)(addr >> BUS_PAGE_SHIFT);
+        const PAGE &page = this->pages[index];
+        if (page.watched && NULL != this->watchFn) {
+            this->watchFn(this->watchContext, index);
+        }
+        if (NULL != page.write) {
+            page.write(page.context, addr, value);
+        } else if (page.writable && NULL != page.host) {
+            page.host[addr & (BUS_PAGE_SIZE - 1)] = value;
+        }
+    }
+
+} /* END: Memory */ } /* END: SiNES */
@@ -0,0 +1,244 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#ifndef SINES_MEMORY_BUS_H          /* START: HEADER GUARD */
+#define SINES_MEMORY_BUS_H
+
+#include <stddef.h>
+#include "xplat/types.hpp"
+
+namespace SiNES { namespace Memory {
+    /* Handlers for pages without host memory behind them (I/O registers, cartridge controllers). */
+    typedef uint8 (*BUS_READ_FN)(void *context, uint16 addr);
+    typedef void (*BUS_WRITE_FN)(void *context, uint16 addr, uint8 value);
+
+    /* Called before the first write to a watched page, or before the page is mapped to other memory, the handler is
+       expected to unwatch it. */
+    typedef void (*BUS_WATCH_FN)(void *context, uint8 page);
+
+    /* The 16 bit address space is split into 256 byte pages. */
+    #define BUS_PAGE_SHIFT      8
+    #define BUS_PAGE_SIZE       (0x01 << BUS_PAGE_SHIFT)
+    #define BUS_PAGE_COUNT      256
+
+    /* Value read from a page with neither host memory nor a handler. */
+    #define BUS_OPEN_BUS        0xFF
+
+    /**
+     * Page table memory bus for a 16 bit address space.
+     *
+     * Plain ROM and RAM pages point straight into host memory, so an access is one table load and an indexed
+     * access.  Pages without a host pointer (I/O, read only pages being written, watched pages) take the slow
+     * path through their handlers.  Bank switching only re-points table entries.  Mirrors are pages pointing at
+     * the same host memory, and are watched together.
+     */
+    class Bus {
+    public:
+        /**
+         * Constructor for an empty bus, every page reads as BUS_OPEN_BUS and drops writes.
+         */
+        Bus();
+
+        /**
+         * Map host memory into a run of pages.  The memory behind a watched page changes as if written, so the watch
+         * handler is called for it first and the page is no longer watched.
+         *
+         * @param first     [IN]        The first page.
+         * @param count     [IN]        The number of pages.
+         * @param host      [IN]        Host memory, count * BUS_PAGE_SIZE bytes.
+         * @param writable  [IN]        False for ROM, writes then go to the page's write handler.
+         */
+        void map(uint8 first, uint32 count, uint8 *host, bool writable);
+
+        /**
+         * Route a run of pages through handlers.  Host memory mapped to the pages stays readable by the
+         * handlers through hostPage.
+         *
+         * @param first     [IN]        The first page.
+         * @param count     [IN]        The number of pages.
+         * @param read      [IN]        Read handler, NULL to read from host memory.
+         * @param write     [IN]        Write handler, NULL to write to host memory (or drop the write for ROM).
+         * @param context   [IN]        Passed to the handlers.
+         */
+        void mapHandlers(uint8 first, uint32 count, BUS_READ_FN read, BUS_WRITE_FN write, void *context);
+
+        /**
+         * Get the host memory mapped to a page.
+         *
+         * @param page      [IN]        The page.
+         *
+         * @return The host memory of the page, NULL if none is mapped.
+         */
+        uint8 *hostPage(uint8 page) const;
+
+        /**
+         * Get the fast path memory of a page for reads, for bulk access to plain memory.
+         *
+         * @param page      [IN]        The page.
+         *
+         * @return The host memory reads of the page go to, NULL if they take the slow path.
+         */
+        const uint8 *readPage(uint8 page) const;
+
+        /**
+         * Get the fast path memory of a page for writes, for bulk access to plain memory.
+         *
+         * @param page      [IN]        The page.
+         *
+         * @return The host memory writes to the page go to, NULL if they take the slow path.
+         */
+        uint8 *writePage(uint8 page) const;
+
+        /**
+         * Get the fast path table for reads, indexed by page, for translated code that inlines the fast path.
+         *
+         * @return The fast path pointer of every page, NULL for pages that take the slow path.
+         */
+        uint8 *const *readTable() const;
+
+        /**
+         * Get the fast path table for writes, indexed by page, for translated code that inlines the fast path.
+         *
+         * @return The fast path pointer of every page, NULL for pages that take the slow path.
+         */
+        uint8 *const *writeTable() const;
+
+        /**
+         * Set the handler called before the first write to a watched page.
+         *
+         * @param watch     [IN]        The handler.
+         * @param context   [IN]        Passed to the handler.
+         */
+        void setWatchHandler(BUS_WATCH_FN watch, void *context);
+
+        /**
+         * Send writes to a page and every mirror of its host memory through the watch handler.
+         *
+         * @param page      [IN]        The page.
+         */
+        void watch(uint8 page);
+
+        /**
+         * Return a watched page and its mirrors to their normal write path.
+         *
+         * @param page      [IN]        The page.
+         */
+        void unwatch(uint8 page);
+
+        /**
+         * Read a byte.
+         *
+         * @param addr      [IN]        The address to read.
+         *
+         * @return The value at the address.
+         */
+        uint8 read8(uint16 addr);
+
+        /**
+         * Write a byte.
+         *
+         * @param addr      [IN]        The address to write.
+         * @param value     [IN]        The value to write.
+         */
+        void write8(uint16 addr, uint8 value);
+
+    private:
+        uint8  *readPages[BUS_PAGE_COUNT];  // Fast path for reads, NULL to use the read handler.
+        uint8  *writePages[BUS_PAGE_COUNT]; // Fast path for writes, NULL to use the slow path.
+
+        /* Slow path state of each page. */
+        typedef struct _PAGE {
+            uint8          *host;       // Host memory mapped to the page.
+            bool            writable;   // Host memory accepts writes.
+            bool            watched;    // Writes call the watch handler first.
+            BUS_READ_FN     read;       // Read handler.
+            BUS_WRITE_FN    write;      // Write handler.
+            void           *context;    // Passed to the handlers.
+        } PAGE;
+        PAGE pages[BUS_PAGE_COUNT];
+
+        BUS_WATCH_FN    watchFn;        // Called before the first write to a watched page.
+        void           *watchContext;   // Passed to the watch handler.
+
+        /**
+         * Set the watch state of a page and every page mapped to the same host memory.
+         *
+         * @param page      [IN]        The page.
+         * @param watched   [IN]        True to send writes through the watch handler.
+         */
+        void setWatched(uint8 page, bool watched);
+
+        /**
+         * Rebuild the fast path pointers of a page from its slow path state.
+         *
+         * @param page      [IN]        The page.
+         */
+        void update(uint8 page);
+
+        /**
+         * Read a byte from a page without a fast path.
+         *
+         * @param addr      [IN]        The address to read.
+         *
+         * @return The value at the address.
+         */
+        uint8 readSlow(uint16 addr);
+
+        /**
+         * Write a byte to a page without a fast path.
+         *
+         * @param addr      [IN]        The address to write.
+         * @param value     [IN]        The value to write.
+         */
+        void writeSlow(uint16 addr, uint8 value);
+    };
+
+    /* Get the fast path memory of a page for reads. */
+    inline const uint8 *Bus::readPage(uint8 page) const
+    {
+        return this->readPages[page];
+    }
+
+    /* Get the fast path memory of a page for writes. */
+    inline uint8 *Bus::writePage(uint8 page) const
+    {
+        return this->writePages[page];
+    }
+
+    /* Get the fast path table for reads. */
+    inline uint8 *const *Bus::readTable() const
+    {
+        return this->readPages;
+    }
+
+    /* Get the fast path table for writes. */
+    inline uint8 *const *Bus::writeTable() const
+    {
+        return this->writePages;
+    }
+
+    /* Read a byte. */
+    inline uint8 Bus::read8(uint16 addr)
+    {
+        const uint8 *host = this->readPages[addr >> BUS_PAGE_SHIFT];
+        if (NULL != host) {
+            return host[addr & (BUS_PAGE_SIZE - 1)];
+        }
+        return this->readSlow(addr);
+    }
+
+    /* Write a byte. */
+    inline void Bus::write8(uint16 addr, uint8 value)
+    {
+        uint8 *host = this->writePages[addr >> BUS_PAGE_SHIFT];
+        if (NULL != host) {
+            host[addr & (BUS_PAGE_SIZE - 1)] = value;
+            return;
+        }
+        this->writeSlow(addr, value);
+    }
+
+} /* END: Memory */ } /* END: SiNES */
+
+#endif                              /* END: HEADER GUARD */
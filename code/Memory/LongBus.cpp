@@ -0,0 +1,139 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#include <string.h>
+#include "Memory/LongBus.hpp"
+
+namespace SiNES { namespace Memory {
+    /* Constructor for an empty bus. */
+    LongBus::LongBus() {
+        memset(this->pages, 0x00, sizeof(this->pages));
+        for (uint32 i = 0; i < LONG_BUS_PAGE_COUNT; ++i) {
+            this->readPages[i] = NULL;
+            this->writePages[i] = NULL;
+        }
+        for (uint32 i = 0; i < LONG_BUS_WATCH_COUNT; ++i) {
+            this->watchFn[i] = NULL;
+            this->watchContext[i] = NULL;
+        }
+    }
+
+    /* Map host memory into a run of pages. */
+    void LongBus::map(uint16 first, uint32 count, uint8 *host, bool writable) {
+        for (uint32 i = 0; i < count && first + i < LONG_BUS_PAGE_COUNT; ++i) {
+            PAGE &page = this->pages[first + i];
+            if (page.watched) {
+                this->notify((uint16)(first + i));
+                page.watched = 0;
+            }
+            page.host = (NULL != host) ? host + i * LONG_BUS_PAGE_SIZE : NULL;
+            page.writable = writable;
+            this->update((uint16)(first + i));
+        }
+    }
+
+    /* Route a run of pages through handlers. */
+    void LongBus::mapHandlers(uint16 first, uint32 count, LONG_BUS_READ_FN read, LONG_BUS_WRITE_FN write,
+                              void *context) {
+        for (uint32 i = 0; i < count && first + i < LONG_BUS_PAGE_COUNT; ++i) {
+            PAGE &page = this->pages[first + i];
+            page.read = read;
+            page.write = write;
+            page.context = context;
+            this->update((uint16)(first + i));
+        }
+    }
+
+    /* Get the host memory mapped to a page. */
+    uint8 *LongBus::hostPage(uint16 page) const {
+        return this->pages[page].host;
+    }
+
+    /* Check if writes to a page can reach memory or a handler. */
+    bool LongBus::isWritable(uint16 page) const {
+        const PAGE &p = this->pages[page];
+        return (p.writable && NULL != p.host) || NULL != p.write;
+    }
+
+    /* Set the handler of a watcher. */
+    void LongBus::setWatchHandler(uint8 watcher, LONG_BUS_WATCH_FN watch, void *context) {
+        this->watchFn[watcher] = watch;
+        this->watchContext[watcher] = context;
+    }
+
+    /* Send writes to a page and its mirrors through the handler of a watcher. */
+    void LongBus::watch(uint16 page, uint8 watcher) {
+        uint8 watched = this->pages[page].watched;
+        if (!(watched & (0x01 << watcher))) {
+            this->setWatched(page, (uint8)(watched | (0x01 << watcher)));
+        }
+    }
+
+    /* Stop a watcher watching a page and its mirrors. */
+    void LongBus::unwatch(uint16 page, uint8 watcher) {
+        uint8 watched = this->pages[page].watched;
+        if (watched & (0x01 << watcher)) {
+            this->setWatched(page, (uint8)(watched & ~(0x01 << watcher)));
+        }
+    }
+
+    /* Set the watchers of a page and every page mapped to the same host memory. */
+    void LongBus::setWatched(uint16 page, uint8 watched) {
+        /* A write through any mirror changes the memory the watched page reads. */
+        const uint8 *host = this->pages[page].host;
+        if (NULL == host) {
+            this->pages[page].watched = watched;
+            this->update(page);
+            return;
+        }
+        for (uint32 i = 0; i < LONG_BUS_PAGE_COUNT; ++i) {
+            if (this->pages[i].host == host) {
+                this->pages[i].watched = watched;
+                this->update((uint16)i);
+            }
+        }
+    }
+
+    /* Rebuild the fast path pointers of a page. */
+    void LongBus::update(uint16 page) {
+        const PAGE &p = this->pages[page];
+        this->readPages[page] = (NULL == p.read) ? p.host : NULL;
+        this->writePages[page] = (NULL == p.write && p.writable && 0 == p.watched) ? p.host : NULL;
+    }
+
+    /* Read a byte from a page without a fast path. */
+    uint8 LongBus::readSlow(uint32 addr) {
+        const PAGE &page = this->pages[addr >> LONG_BUS_PAGE_SHIFT];
+        if (NULL != page.read) {
+            return page.read(page.context, addr);
+        }
+        return LONG_BUS_OPEN_BUS;
+    }
+
+    /* Call the handlers of every watcher of a page. */
+    void LongBus::notify(uint16 page) {
+        /* The handlers unwatch the page as they run. */
+        uint8 watched = this->pages[page].watched;
+        for (uint32 i = 0; i < LONG_BUS_WATCH_COUNT; ++i) {
+            if ((watched & (0x01 << i)) && NULL != this->watchFn[i]) {
+                this->watchFn[i](this->watchContext[i], page);
+            }
+        }
+    }
+
+    /* Write a byte to a page without a fast path. */
+    void LongBus::writeSlow(uint32 addr, uint8 value) {
+        uint16 index = (uint16)(addr >> LONG_BUS_PAGE_SHIFT);
+        const PAGE &page = this->pages[index];
+        if (page.watched) {
+            this->notify(index);
+        }
+        if (NULL != page.write) {
+            page.write(page.context, addr, value);
+        } else if (page.writable && NULL != page.host) {
+            page.host[addr & (LONG_BUS_PAGE_SIZE - 1)] = value;
+        }
+    }
+
+} /* END: Memory */ } /* END: SiNES */
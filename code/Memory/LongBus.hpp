@@ -0,0 +1,246 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#ifndef SINES_MEMORY_LONG_BUS_H     /* START: HEADER GUARD */
+#define SINES_MEMORY_LONG_BUS_H
+
+#include <stddef.h>
+#include "xplat/types.hpp"
+
+namespace SiNES { namespace Memory {
+    /* Handlers for pages without host memory behind them (I/O registers, coprocessors). */
+    typedef uint8 (*LONG_BUS_READ_FN)(void *context, uint32 addr);
+    typedef void (*LONG_BUS_WRITE_FN)(void *context, uint32 addr, uint8 value);
+
+    /* Called before the first write to a watched page, or before the page is mapped to other memory, the handler is
+       expected to unwatch it. */
+    typedef void (*LONG_BUS_WATCH_FN)(void *context, uint16 page);
+
+    /* Each watcher has its own handler and watches pages independently of the others. */
+    #define LONG_BUS_WATCH_CODE     0   // Decoded code, see W65C816.
+    #define LONG_BUS_WATCH_TABLES   1   // Tables read ahead of time, see the HDMA of DMA.
+    #define LONG_BUS_WATCH_COUNT    2
+
+    /* The 24 bit address space is split into 4KB pages, 16 per bank. */
+    #define LONG_BUS_PAGE_SHIFT     12
+    #define LONG_BUS_PAGE_SIZE      (0x01 << LONG_BUS_PAGE_SHIFT)
+    #define LONG_BUS_PAGE_COUNT     4096
+    #define LONG_BUS_ADDR_MASK      0xFFFFFF
+
+    /* Page of a bank and 16 bit address. */
+    #define LONG_BUS_PAGE(BANK, ADDR)   ((uint16)(((BANK) << 4) | ((ADDR) >> LONG_BUS_PAGE_SHIFT)))
+
+    /* Value read from a page with neither host memory nor a handler. */
+    #define LONG_BUS_OPEN_BUS       0xFF
+
+    /**
+     * Page table memory bus for a 24 bit address space.
+     *
+     * The same design as Bus for a bigger space: plain ROM and RAM pages point straight into host memory, pages
+     * without a host pointer (I/O, read only pages being written, watched pages) take the slow path through
+     * their handlers.  Mirrors are pages pointing at the same host memory, and are watched together.
+     */
+    class LongBus {
+    public:
+        /**
+         * Constructor for an empty bus, every page reads as LONG_BUS_OPEN_BUS and drops writes.
+         */
+        LongBus();
+
+        /**
+         * Map host memory into a run of pages.  The memory behind a watched page changes as if written, so the
+         * handlers of its watchers are called first and the page is no longer watched.
+         *
+         * @param first     [IN]        The first page.
+         * @param count     [IN]        The number of pages.
+         * @param host      [IN]        Host memory, count * LONG_BUS_PAGE_SIZE bytes.
+         * @param writable  [IN]        False for ROM, writes then go to the page's write handler.
+         */
+        void map(uint16 first, uint32 count, uint8 *host, bool writable);
+
+        /**
+         * Route a run of pages through handlers.  Host memory mapped to the pages stays readable by the
+         * handlers through hostPage.
+         *
+         * @param first     [IN]        The first page.
+         * @param count     [IN]        The number of pages.
+         * @param read      [IN]        Read handler, NULL to read from host memory.
+         * @param write     [IN]        Write handler, NULL to write to host memory (or drop the write for ROM).
+         * @param context   [IN]        Passed to the handlers.
+         */
+        void mapHandlers(uint16 first, uint32 count, LONG_BUS_READ_FN read, LONG_BUS_WRITE_FN write, void *context);
+
+        /**
+         * Get the host memory mapped to a page.
+         *
+         * @param page      [IN]        The page.
+         *
+         * @return The host memory of the page, NULL if none is mapped.
+         */
+        uint8 *hostPage(uint16 page) const;
+
+        /**
+         * Get the fast path memory of a page for reads, for bulk access to plain memory.
+         *
+         * @param page      [IN]        The page.
+         *
+         * @return The host memory reads of the page go to, NULL if they take the slow path.
+         */
+        const uint8 *readPage(uint16 page) const;
+
+        /**
+         * Get the fast path memory of a page for writes, for bulk access to plain memory.
+         *
+         * @param page      [IN]        The page.
+         *
+         * @return The host memory writes to the page go to, NULL if they take the slow path.
+         */
+        uint8 *writePage(uint16 page) const;
+
+        /**
+         * Check if writes to a page can reach memory or a handler, the pages decoded code has to be watched on.
+         *
+         * @param page      [IN]        The page.
+         *
+         * @return True for RAM and handler written pages, false for ROM and unmapped pages.
+         */
+        bool isWritable(uint16 page) const;
+
+        /**
+         * Set the handler of a watcher, called before the first write to a page it watches.
+         *
+         * @param watcher   [IN]        The LONG_BUS_WATCH_* watcher.
+         * @param watch     [IN]        The handler.
+         * @param context   [IN]        Passed to the handler.
+         */
+        void setWatchHandler(uint8 watcher, LONG_BUS_WATCH_FN watch, void *context);
+
+        /**
+         * Send writes to a page and every mirror of its host memory through the handler of a watcher.
+         *
+         * @param page      [IN]        The page.
+         * @param watcher   [IN]        The LONG_BUS_WATCH_* watcher.
+         */
+        void watch(uint16 page, uint8 watcher);
+
+        /**
+         * Stop a watcher watching a page and its mirrors, the page returns to its normal write path when no
+         * watcher is left.
+         *
+         * @param page      [IN]        The page.
+         * @param watcher   [IN]        The LONG_BUS_WATCH_* watcher.
+         */
+        void unwatch(uint16 page, uint8 watcher);
+
+        /**
+         * Read a byte.
+         *
+         * @param addr      [IN]        The 24 bit address to read.
+         *
+         * @return The value at the address.
+         */
+        uint8 read8(uint32 addr);
+
+        /**
+         * Write a byte.
+         *
+         * @param addr      [IN]        The 24 bit address to write.
+         * @param value     [IN]        The value to write.
+         */
+        void write8(uint32 addr, uint8 value);
+
+    private:
+        uint8  *readPages[LONG_BUS_PAGE_COUNT];     // Fast path for reads, NULL to use the read handler.
+        uint8  *writePages[LONG_BUS_PAGE_COUNT];    // Fast path for writes, NULL to use the slow path.
+
+        /* Slow path state of each page. */
+        typedef struct _PAGE {
+            uint8              *host;       // Host memory mapped to the page.
+            bool                writable;   // Host memory accepts writes.
+            uint8               watched;    // Bit n set while watcher n watches the page.
+            LONG_BUS_READ_FN    read;       // Read handler.
+            LONG_BUS_WRITE_FN   write;      // Write handler.
+            void               *context;    // Passed to the handlers.
+        } PAGE;
+        PAGE pages[LONG_BUS_PAGE_COUNT];
+
+        LONG_BUS_WATCH_FN   watchFn[LONG_BUS_WATCH_COUNT];      // Called before the first write to a watched page.
+        void               *watchContext[LONG_BUS_WATCH_COUNT]; // Passed to the watch handlers.
+
+        /**
+         * Call the handlers of every watcher of a page.
+         *
+         * @param page      [IN]        The page.
+         */
+        void notify(uint16 page);
+
+        /**
+         * Rebuild the fast path pointers of a page from its slow path state.
+         *
+         * @param page      [IN]        The page.
+         */
+        void update(uint16 page);
+
+        /**
+         * Set the watchers of a page and every page mapped to the same host memory.
+         *
+         * @param page      [IN]        The page.
+         * @param watched   [IN]        Bit n set for watcher n.
+         */
+        void setWatched(uint16 page, uint8 watched);
+
+        /**
+         * Read a byte from a page without a fast path.
+         *
+         * @param addr      [IN]        The address to read.
+         *
+         * @return The value at the address.
+         */
+        uint8 readSlow(uint32 addr);
+
+        /**
+         * Write a byte to a page without a fast path.
+         *
+         * @param addr      [IN]        The address to write.
+         * @param value     [IN]        The value to write.
+         */
+        void writeSlow(uint32 addr, uint8 value);
+    };
+
+    /* Get the fast path memory of a page for reads. */
+    inline const uint8 *LongBus::readPage(uint16 page) const
+    {
+        return this->readPages[page];
+    }
+
+    /* Get the fast path memory of a page for writes. */
+    inline uint8 *LongBus::writePage(uint16 page) const
+    {
+        return this->writePages[page];
+    }
+
+    /* Read a byte. */
+    inline uint8 LongBus::read8(uint32 addr)
+    {
+        const uint8 *host = this->readPages[(addr & LONG_BUS_ADDR_MASK) >> LONG_BUS_PAGE_SHIFT];
+        if (NULL != host) {
+            return host[addr & (LONG_BUS_PAGE_SIZE - 1)];
+        }
+        return this->readSlow(addr & LONG_BUS_ADDR_MASK);
+    }
+
+    /* Write a byte. */
+    inline void LongBus::write8(uint32 addr, uint8 value)
+    {
+        uint8 *host = this->writePages[(addr & LONG_BUS_ADDR_MASK) >> LONG_BUS_PAGE_SHIFT];
+        if (NULL != host) {
+            host[addr & (LONG_BUS_PAGE_SIZE - 1)] = value;
+            return;
+        }
+        this->writeSlow(addr & LONG_BUS_ADDR_MASK, value);
+    }
+
+} /* END: Memory */ } /* END: SiNES */
+
+#endif                              /* END: HEADER GUARD */
@@ -1,9 +0,0 @@
-/*
- * Copyright 2013 Jason M. Baker
- */
-
-void exec() {
-
-    switch () {
-    }
-}
@@ -0,0 +1,181 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#include <string.h>
+#include "Processors/Nintendo/5A22/65c816.hpp"
+
+namespace SiNES { namespace Processors { namespace Nintendo {
+    #include "opcodes.cpp"
+    #include "dispatch.cpp"
+    #include "block.cpp"
+
+    /* Constructor for a 65c816 processor. */
+    W65C816::W65C816(SiNES::Memory::Arena *arena) {
+        memset(&this->r, 0x00, sizeof(this->r));
+        this->r.e = true;
+        this->r.p = W65C816_FLAG_MEMORY | W65C816_FLAG_INDEX | W65C816_FLAG_IRQ;
+        this->r.s = (uint16)(0x0100 | (this->r.s & 0xFF));
+        this->imm = 0;
+        this->mode = W65C816_MODE_EMULATION;
+        this->ops = MODES[W65C816_MODE_EMULATION].ops;
+        this->info = MODES[W65C816_MODE_EMULATION].info;
+        this->cycles = 0;
+        this->nmiPending = false;
+        this->irqLine = false;
+        this->waiting = false;
+        this->stopped = false;
+        memset(&this->stats, 0x00, sizeof(this->stats));
+        this->blockCache = (NULL != arena) ? (W65C816_BLOCK_CACHE *)arena->alloc(sizeof(W65C816_BLOCK_CACHE)) : NULL;
+        this->ownsBlockCache = (NULL == this->blockCache);
+        if (this->ownsBlockCache) {
+            this->blockCache = new W65C816_BLOCK_CACHE;
+        }
+        this->flushBlocks();
+        this->fastRom = false;
+#if W65C816_TIMING == W65C816_TIMING_ACCESS
+        this->buildAccessTimes();
+#endif
+        this->bus.setWatchHandler(LONG_BUS_WATCH_CODE, &W65C816::watchedWrite, this);
+    }
+
+    /* Destructor for a 65c816 processor. */
+    W65C816::~W65C816() {
+        if (this->ownsBlockCache) {
+            delete this->blockCache;
+        }
+    }
+
+    /* Reset the processor into emulation mode and jump through the reset vector. */
+    void W65C816::reset() {
+        this->setMemsel(0x00);
+        this->r.e = true;
+        this->r.d = 0x0000;
+        this->r.dbr = 0x00;
+        this->r.pbr = 0x00;
+        this->r.s = (uint16)(0x0100 | (this->r.s & 0xFF));
+        this->setP((uint8)((this->r.p | W65C816_FLAG_IRQ) & ~W65C816_FLAG_DECIMAL));
+        this->r.pc = this->read16(W65C816_VECTOR_RESET);
+        this->nmiPending = false;
+        this->waiting = false;
+        this->stopped = false;
+    }
+
+    /* Signal a non maskable interrupt. */
+    void W65C816::nmi() {
+        this->nmiPending = true;
+    }
+
+    /* Set the level of the IRQ line. */
+    void W65C816::setIrq(bool asserted) {
+        this->irqLine = asserted;
+    }
+
+    /* Write the MEMSEL register. */
+    void W65C816::setMemsel(uint8 value) {
+        bool fastRom = 0 != (value & W65C816_MEMSEL_FASTROM);
+        if (fastRom == this->fastRom) {
+            return;
+        }
+        this->fastRom = fastRom;
+#if W65C816_TIMING == W65C816_TIMING_ACCESS
+        this->buildAccessTimes();
+        this->flushBlocks();
+#endif
+    }
+
+    /* Stall the processor while another bus master holds the bus. */
+    void W65C816::stall(uint32 cycles) {
+        this->cycles += cycles;
+    }
+
+#if W65C816_TIMING == W65C816_TIMING_ACCESS
+    /* Rebuild the access time table from the memory map of the 5A22 and the FastROM bit. */
+    void W65C816::buildAccessTimes() {
+        for (uint32 bank = 0; bank < 0x100; ++bank) {
+            /* ROM above $8000 and in banks $40-$7F and $C0-$FF is 8 cycles, 6 with FastROM from bank $80 up. */
+            uint8 rom = (this->fastRom && (bank & 0x80)) ? 0 : 2;
+            for (uint32 page = 0; page < 0x10; ++page) {
+                uint8 extra = rom;
+                if (!(bank & 0x40) && page < 0x08) {
+                    /* The system area of banks $00-$3F and $80-$BF. */
+                    switch (page) {
+                        case 0x0: case 0x1: extra = 2; break;                   // WRAM mirror
+                        case 0x2: case 0x3: extra = 0; break;                   // PPU and APU ports, expansion
+                        case 0x4: extra = W65C816_SPEED_MIXED; break;           // Joypad serial ports, CPU registers
+                        case 0x5: extra = 0; break;                             // Unmapped
+                        default: extra = 2; break;                              // Expansion, SRAM
+                    }
+                }
+                this->accessTime[(bank << 4) | page] = extra;
+            }
+        }
+    }
+#endif
+
+    /* Get the memory bus of the processor. */
+    SiNES::Memory::LongBus &W65C816::getBus() {
+        return this->bus;
+    }
+
+    /* Get the cycle counter. */
+    uint64 W65C816::cycleCount() const {
+        return this->cycles;
+    }
+
+    /* Get the instrumentation counters. */
+    const W65C816_STATS &W65C816::getStats() const {
+        return this->stats;
+    }
+
+    /* Account for the memory held by the processor. */
+    void W65C816::memoryUsage(PROCESSOR_MEMORY &usage) const {
+        usage.instance = (uint32)(sizeof(*this) + sizeof(*this->blockCache));
+        usage.shared = (uint32)(sizeof(MODES) + W65C816_MODE_COUNT * (sizeof(Mode<true, true, true>::OPS)
+                                                                       + sizeof(Mode<true, true, true>::INFO)));
+    }
+
+    /* Execute an operation in the processor. */
+    void W65C816::execOp() {
+        if (this->stopped) {
+            return;
+        }
+        if ((this->nmiPending || this->irqLine) && this->serviceInterrupts()) {
+            return;
+        }
+        if (this->waiting) {
+            W65C816_ADD_CYCLES(1);
+            return;
+        }
+        uint8 op = this->fetchOp();
+        W65C816_ADD_CYCLES(this->info[op].cycles);
+        (this->*this->ops[op])();
+    }
+
+    /* Run decoded blocks until one of a set of events is raised or a cycle budget is spent. */
+    uint32 W65C816::runUntil(uint32 events, uint32 cycles) {
+        uint64 start = this->cycles;
+        uint64 end = start + cycles;
+        this->raised = 0;
+        while (this->cycles < end) {
+            /* Only a reset ends a stop and only an interrupt from the host ends a wait, nothing runs until then. */
+            if (this->stopped) {
+                this->cycles = end;
+                break;
+            }
+            if ((this->nmiPending || this->irqLine) && this->serviceInterrupts()) {
+                this->raiseEvents(PROCESSOR_EVENT_INTERRUPT);
+            }
+            if (this->raised & events) {
+                break;
+            }
+            if (this->waiting) {
+                this->cycles = end;
+                break;
+            }
+            this->execBlock();
+        }
+        return (uint32)(this->cycles - start);
+    }
+
+} /* END: Nintendo */ } /* END: Processors */ } /* END: SiNES */
@@ -1,4 +0,0 @@
-/*
- * Copyright 2013 Jason M. Baker
- */
-
@@ -0,0 +1,745 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#ifndef SINES_65C816_H              /* START: HEADER GUARD */
+#define SINES_65C816_H
+
+#include "xplat/types.hpp"
+#include "Memory/Arena.hpp"
+#include "Memory/LongBus.hpp"
+#include "Processors/Processor.hpp"
+#include "Processors/Nintendo/5A22/config.hpp"
+#include "Processors/Nintendo/5A22/block.hpp"
+
+namespace SiNES { namespace Processors { namespace Nintendo {
+    /* Register width modes, each with its own dispatch table.  Emulation mode forces 8 bit registers. */
+    #define W65C816_MODE_M16_X16        0   // Native, 16 bit accumulator and index registers.
+    #define W65C816_MODE_M16_X8         1   // Native, 16 bit accumulator and 8 bit index registers.
+    #define W65C816_MODE_M8_X16         2   // Native, 8 bit accumulator and 16 bit index registers.
+    #define W65C816_MODE_M8_X8          3   // Native, 8 bit accumulator and index registers.
+    #define W65C816_MODE_EMULATION      4   // 6502 emulation mode.
+    #define W65C816_MODE_COUNT          5
+
+    /* Addressing modes baked into the handlers. */
+    #define W65C816_AM_IMM              0   // #
+    #define W65C816_AM_ACC              1   // A
+    #define W65C816_AM_DP               2   // d
+    #define W65C816_AM_DPX              3   // d,x
+    #define W65C816_AM_DPY              4   // d,y
+    #define W65C816_AM_DPI              5   // (d)
+    #define W65C816_AM_DPIX             6   // (d,x)
+    #define W65C816_AM_DPIY             7   // (d),y
+    #define W65C816_AM_DPIL             8   // [d]
+    #define W65C816_AM_DPILY            9   // [d],y
+    #define W65C816_AM_ABS              10  // a
+    #define W65C816_AM_ABSX             11  // a,x
+    #define W65C816_AM_ABSY             12  // a,y
+    #define W65C816_AM_ABSL             13  // al
+    #define W65C816_AM_ABSLX            14  // al,x
+    #define W65C816_AM_SR               15  // d,s
+    #define W65C816_AM_SRIY             16  // (d,s),y
+
+    /* Operations of the accumulator group, in op code order (bits 5-7). */
+    #define W65C816_ALU_ORA             0
+    #define W65C816_ALU_AND             1
+    #define W65C816_ALU_EOR             2
+    #define W65C816_ALU_ADC             3
+    #define W65C816_ALU_LDA             5
+    #define W65C816_ALU_CMP             6
+    #define W65C816_ALU_SBC             7
+
+    /* Read-modify-write operations. */
+    #define W65C816_RMW_ASL             0
+    #define W65C816_RMW_ROL             1
+    #define W65C816_RMW_LSR             2
+    #define W65C816_RMW_ROR             3
+    #define W65C816_RMW_INC             4
+    #define W65C816_RMW_DEC             5
+    #define W65C816_RMW_TSB             6
+    #define W65C816_RMW_TRB             7
+
+    /* Register sources of the store ops. */
+    #define W65C816_SRC_A               0
+    #define W65C816_SRC_X               1
+    #define W65C816_SRC_Y               2
+    #define W65C816_SRC_Z               3   // stz, stores zero at the accumulator width.
+
+    /* Width of a register transfer or stack op. */
+    #define W65C816_WIDTH_M             0   // The accumulator width.
+    #define W65C816_WIDTH_X             1   // The index width.
+    #define W65C816_WIDTH_16            2   // Always 16 bit.
+
+    /* Interrupt vectors in bank 0. */
+    #define W65C816_VECTOR_COP          0xFFE4
+    #define W65C816_VECTOR_BRK          0xFFE6
+    #define W65C816_VECTOR_NMI          0xFFEA
+    #define W65C816_VECTOR_IRQ          0xFFEE
+    #define W65C816_VECTOR_E_COP        0xFFF4
+    #define W65C816_VECTOR_E_NMI        0xFFFA
+    #define W65C816_VECTOR_RESET        0xFFFC
+    #define W65C816_VECTOR_E_IRQ        0xFFFE  // Shared by brk in emulation mode.
+
+    /* Master cycles of an internal cycle, a memory access adds the access time of its address on top. */
+#if W65C816_TIMING == W65C816_TIMING_ACCESS
+    #define W65C816_CYCLE               6
+#else
+    #define W65C816_CYCLE               W65C816_FIXED_SPEED
+#endif
+
+    /* MEMSEL ($420D) bit selecting 6 cycle FastROM access to $80-$BF:8000-FFFF and $C0-$FF. */
+    #define W65C816_MEMSEL_FASTROM      (0x01 << 0)
+
+    /* Run time instrumentation counters. */
+    typedef struct _W65C816_STATS {
+        uint64  modeSwitches;   // Swaps of the dispatch table by rep, sep, xce, plp and rti.
+        uint64  interrupts;     // NMIs and IRQs taken.
+        uint64  blockDecodes;   // Blocks decoded into the block cache.
+        uint64  codeWrites;     // Writes that dropped decoded blocks.
+    } W65C816_STATS;
+
+    /**
+     * The 65c816 Processor class, the core of the 5A22.
+     *
+     * Every handler is a template instantiated once per register width mode, so the accumulator width (M),
+     * the index width (X) and emulation mode (E) are compile time constants inside it.  The five instantiations
+     * of the op code table are built at compile time and rep, sep, xce, plp and rti swap the active one, the
+     * width checks never run per op.
+     *
+     * runUntil runs ops from a cache of decoded blocks keyed by the mode, the program bank and the PC, since the
+     * same bytes decode to different handlers and operand widths in each mode (see block.cpp).
+     */
+    class W65C816 : public SiNES::Processors::Processor {
+    public:
+        /**
+         * Constructor for a 65c816 processor in its power on state, emulation mode with an empty bus.
+         *
+         * @param arena     [IN]        Arena to carve the block cache out of, NULL to allocate it.  Construct
+         *                              the processor itself in the arena first so its hot fields lead it.
+         */
+        explicit W65C816(SiNES::Memory::Arena *arena = NULL);
+
+        /**
+         * Destructor for a 65c816 processor.
+         */
+        virtual ~W65C816();
+
+        /**
+         * Execute the next processor level operation, taking a pending interrupt first.
+         */
+        virtual void execOp();
+
+        /**
+         * Execute the decoded block starting at the PC from the block cache, decoding it first if needed.
+         * Interrupts are taken between blocks.
+         *
+         * @return The number of master cycles taken by the executed ops.
+         */
+        uint32 execBlock();
+
+        /**
+         * Run decoded blocks until one of a set of events is raised or a cycle budget is spent.  A taken interrupt
+         * raises PROCESSOR_EVENT_INTERRUPT, a processor waiting in wai or stopped by stp spends the rest of the
+         * budget.
+         *
+         * @param events    [IN]        Mask of PROCESSOR_EVENT_* that end the run.
+         * @param cycles    [IN]        The budget in master cycles.
+         *
+         * @return The number of master cycles consumed, the last op may overrun the budget.
+         */
+        virtual uint32 runUntil(uint32 events, uint32 cycles);
+
+        /**
+         * Reset the processor into emulation mode and jump through the reset vector.
+         */
+        void reset();
+
+        /**
+         * Signal a non maskable interrupt, taken before the next op.
+         */
+        void nmi();
+
+        /**
+         * Set the level of the IRQ line, the interrupt is taken before each op while it is asserted and the
+         * I flag is clear.
+         *
+         * @param asserted  [IN]        True while a source holds the line.
+         */
+        void setIrq(bool asserted);
+
+        /**
+         * Write the MEMSEL register ($420D).  The access time table is rebuilt and the decoded blocks, which hold
+         * their fetch times, are dropped only when the FastROM bit changes.
+         *
+         * @param value     [IN]        The value written, W65C816_MEMSEL_FASTROM for 6 cycle ROM in banks $80-$FF.
+         */
+        void setMemsel(uint8 value);
+
+        /**
+         * Stall the processor while another bus master (DMA) holds the bus.
+         *
+         * @param cycles    [IN]        The master cycles to stall for.
+         */
+        void stall(uint32 cycles);
+
+        /**
+         * Get the memory bus of the processor, for mapping ROM, RAM and I/O handlers.
+         *
+         * @return The bus.
+         */
+        SiNES::Memory::LongBus &getBus();
+
+        /**
+         * Get the cycle counter.
+         *
+         * @return The number of master cycles run since the processor was created.
+         */
+        uint64 cycleCount() const;
+
+        /**
+         * Get the instrumentation counters.
+         *
+         * @return The counters since the processor was created.
+         */
+        const W65C816_STATS &getStats() const;
+
+        /**
+         * Account for the memory held by the processor: the object with its page table and the block cache are
+         * per instance, the dispatch and decode tables of every mode are shared.
+         *
+         * @param usage     [OUT]       The instance and shared bytes.
+         */
+        virtual void memoryUsage(PROCESSOR_MEMORY &usage) const;
+
+    private:
+        /************************\
+        |* Data Types           *|
+        \************************/
+
+        /* Registers in the cpu, the 8 bit halves of the 16 bit registers are masked out where an op needs them. */
+        struct _REGISTERS {
+            uint16  c;                  // Accumulator, A is the low half and B the high half.
+            uint16  x;                  // Index X, the high half is 0 while X is set.
+            uint16  y;                  // Index Y, the high half is 0 while X is set.
+            uint16  s;                  // Stack pointer, the high half is 0x01 in emulation mode.
+            uint16  d;                  // Direct page.
+            uint16  pc;                 // Program counter.
+            uint8   pbr;                // Program bank.
+            uint8   dbr;                // Data bank.
+            uint8   p;                  // Processor status: Bits [NVMXDIZC]
+            #define W65C816_FLAG_CARRY      (0x01 << 0)
+            #define W65C816_FLAG_ZERO       (0x01 << 1)
+            #define W65C816_FLAG_IRQ        (0x01 << 2) // IRQs are masked.
+            #define W65C816_FLAG_DECIMAL    (0x01 << 3)
+            #define W65C816_FLAG_INDEX      (0x01 << 4) // 8 bit index registers, the break flag in emulation mode.
+            #define W65C816_FLAG_MEMORY     (0x01 << 5) // 8 bit accumulator and memory.
+            #define W65C816_FLAG_OVERFLOW   (0x01 << 6)
+            #define W65C816_FLAG_NEGATIVE   (0x01 << 7)
+            bool    e;                  // Emulation mode.
+        } r;
+
+        uint32  imm;        // Operand bytes of the executing op.
+        uint8   mode;       // W65C816_MODE_* of the active table.
+        const W65C816_OP_FN    *ops;    // Dispatch table of the active mode.
+        const W65C816_OP_INFO  *info;   // Decode information of the active mode.
+
+        uint64  cycles;     // Master cycle counter, advanced once per op and once per memory access.
+    #define W65C816_ADD_CYCLES(N)   (this->cycles += (N) * W65C816_CYCLE)
+        bool    nmiPending; // An NMI edge is waiting to be taken.
+        bool    irqLine;    // The IRQ line is asserted.
+        bool    waiting;    // Waiting for an interrupt after wai.
+        bool    stopped;    // Stopped by stp until reset.
+        W65C816_STATS stats;
+
+        /* Decoded block cache, allocated with the processor or from its arena. */
+        W65C816_BLOCK_CACHE *blockCache;
+        bool    ownsBlockCache; // The block cache was allocated with the processor.
+
+        bool    fastRom;    // The MEMSEL FastROM bit.
+#if W65C816_TIMING == W65C816_TIMING_ACCESS
+        /* Master cycles a memory access adds to an internal cycle, by bus page, rebuilt by setMemsel.  The $4000
+           pages of the system banks mix 12 cycle ($4000-$41FF) and 6 cycle registers and hold W65C816_SPEED_MIXED. */
+        uint8   accessTime[LONG_BUS_PAGE_COUNT];
+        #define W65C816_SPEED_MIXED     0xFF
+#endif
+
+        /* The page table follows the hot state. */
+        SiNES::Memory::LongBus bus;
+
+        /************************\
+        |* Memory Access        *|
+        \************************/
+
+        /**
+         * Read a byte from the address space without timing it, for op fetches.
+         *
+         * @param addr      [IN]        The 24 bit address to read.
+         *
+         * @return The value at the address.
+         */
+        uint8 peek8(uint32 addr);
+
+        /**
+         * Get the master cycles a memory access adds to an internal cycle.
+         *
+         * @param addr      [IN]        The 24 bit address accessed.
+         *
+         * @return 0 for 6 cycle, 2 for 8 cycle and 6 for 12 cycle memory, 0 without access timing.
+         */
+        uint8 accessExtra(uint32 addr) const;
+
+#if W65C816_TIMING == W65C816_TIMING_ACCESS
+        /**
+         * Rebuild the access time table from the memory map of the 5A22 and the FastROM bit.
+         */
+        void buildAccessTimes();
+#endif
+
+        /**
+         * Read a byte from the address space.
+         *
+         * @param addr      [IN]        The 24 bit address to read.
+         *
+         * @return The value at the address.
+         */
+        uint8 read8(uint32 addr);
+
+        /**
+         * Write a byte to the address space.
+         *
+         * @param addr      [IN]        The 24 bit address to write.
+         * @param value     [IN]        The value to write.
+         */
+        void write8(uint32 addr, uint8 value);
+
+        /**
+         * Read a little endian word from bank 0, wrapping within the bank.
+         *
+         * @param addr      [IN]        The address to read.
+         *
+         * @return The value at the address.
+         */
+        uint16 read16(uint16 addr);
+
+        /**
+         * Fetch the op code at the PC into imm with its operand and advance the PC past it.
+         *
+         * @return The op code.
+         */
+        uint8 fetchOp();
+
+        /**
+         * Push a byte onto the stack, the stack stays in page 1 in emulation mode.
+         *
+         * @param value     [IN]        The value to push.
+         */
+        template <bool E> void push8(uint8 value);
+
+        /**
+         * Pull a byte from the stack.
+         *
+         * @return The value pulled.
+         */
+        template <bool E> uint8 pull8();
+
+        /**
+         * Push a word onto the stack, high byte first.
+         *
+         * @param value     [IN]        The value to push.
+         */
+        template <bool E> void push16(uint16 value);
+
+        /**
+         * Pull a word from the stack.
+         *
+         * @return The value pulled.
+         */
+        template <bool E> uint16 pull16();
+
+        /************************\
+        |* Block Cache          *|
+        \************************/
+
+        /**
+         * Decode the ops starting at the PC into a block in the active mode.
+         *
+         * @param block     [OUT]       The block to decode into.
+         * @param key       [IN]        The W65C816_BLOCK_KEY of the block.
+         */
+        void decodeBlock(W65C816_BLOCK &block, uint32 key);
+
+        /**
+         * Drop every decoded block.
+         */
+        void flushBlocks();
+
+        /**
+         * Drop every block that holds ops from a page or one of its mirrors.
+         *
+         * @param page      [IN]        The bus page that was written.
+         */
+        void invalidatePage(uint16 page);
+
+        /**
+         * Bus watch handler, drops the blocks decoded from a page before it is written.
+         *
+         * @param context   [IN]        The processor.
+         * @param page      [IN]        The page being written.
+         */
+        static void watchedWrite(void *context, uint16 page);
+
+        /************************\
+        |* Addressing           *|
+        \************************/
+
+        /**
+         * Get the bank 0 address of a direct page offset.  In emulation mode with a page aligned direct page
+         * the address wraps within the page.
+         *
+         * @param offset    [IN]        The offset, including any index.
+         *
+         * @return The address.
+         */
+        template <bool E> uint16 direct(uint16 offset);
+
+        /**
+         * Resolve the effective address of the executing op, charging the direct page and page crossing
+         * penalties.
+         *
+         * @param read      [IN]        True for a read only access, which pays for crossing a page with 8 bit
+         *                              index registers.
+         *
+         * @return The 24 bit address.
+         */
+        template <bool X, bool E, uint8 AM> uint32 ea(bool read);
+
+        /**
+         * Get the address of the high byte of a word operand, direct page and stack relative operands wrap
+         * within bank 0.
+         *
+         * @param addr      [IN]        Address of the low byte.
+         *
+         * @return Address of the high byte.
+         */
+        template <uint8 AM> uint32 next(uint32 addr);
+
+        /**
+         * Read an operand of a width.
+         *
+         * @param addr      [IN]        The address of the operand.
+         *
+         * @return The value.
+         */
+        template <bool W8, uint8 AM> uint16 load(uint32 addr);
+
+        /**
+         * Write an operand of a width.
+         *
+         * @param addr      [IN]        The address of the operand.
+         * @param value     [IN]        The value.
+         */
+        template <bool W8, uint8 AM> void store(uint32 addr, uint16 value);
+
+        /**
+         * Read the operand of the executing op, the immediate or the value at its effective address.
+         *
+         * @return The value.
+         */
+        template <bool W8, bool X, bool E, uint8 AM> uint16 operand();
+
+        /************************\
+        |* Flags and Modes      *|
+        \************************/
+
+        /**
+         * Set the N and Z flags from a value.
+         *
+         * @param value     [IN]        The value.
+         */
+        template <bool W8> void setNZ(uint16 value);
+
+        /**
+         * Write a register at a width, an 8 bit write leaves the high half alone.
+         *
+         * @param reg       [IN/OUT]    The register.
+         * @param value     [IN]        The value.
+         */
+        template <bool W8> void put(uint16 &reg, uint16 value);
+
+        /**
+         * Add to the accumulator with carry, in binary or decimal.
+         *
+         * @param value     [IN]        The value to add, or to subtract for SUB.
+         */
+        template <bool W8, bool SUB> void add(uint16 value);
+
+        /**
+         * Compare a register with a value.
+         *
+         * @param reg       [IN]        The register.
+         * @param value     [IN]        The value.
+         */
+        template <bool W8> void compare(uint16 reg, uint16 value);
+
+        /**
+         * Run the operation of a read-modify-write op.
+         *
+         * @param value     [IN]        The value read.
+         *
+         * @return The value to write back.
+         */
+        template <bool W8, uint8 OP> uint16 modify(uint16 value);
+
+        /**
+         * Load the P register, forcing 8 bit registers in emulation mode and clearing the index high halves
+         * when X is set, and swap in the dispatch table of the new mode.
+         *
+         * @param value     [IN]        The new P register.
+         */
+        void setP(uint8 value);
+
+        /**
+         * Swap in the dispatch table of the mode selected by P and E.
+         */
+        void updateMode();
+
+        /**
+         * Push the state and jump through an interrupt vector.
+         *
+         * @param vector    [IN]        The native mode vector.
+         * @param eVector   [IN]        The emulation mode vector.
+         * @param brk       [IN]        True for brk and cop, false for NMI and IRQ which push B clear.
+         */
+        void interrupt(uint16 vector, uint16 eVector, bool brk);
+
+        /**
+         * Take a pending NMI, or an IRQ when the line is asserted and the I flag is clear, ending any wai.
+         *
+         * @return True if an interrupt was taken.
+         */
+        bool serviceInterrupts();
+
+        /************************\
+        |* Op Code Functions    *|
+        \************************/
+        /*
+        FORMAT for processor operation functions: <mnemonic> [#1 |    #2] [N V M X D I Z C]
+        Where:
+            mnemonic            : The ops run by the handler.
+            #1                  : The length in bytes, m and x are one more for a 16 bit immediate.
+            #2                  : The base duration in clock cycles, see the decode tables in dispatch.cpp.
+        N,V,M,X,D,I,Z,C are flags that were affected by the operation.
+            * If the flag is marked by a "0" it is reset after instruction run.
+            * If the flag is marked by a "1" it is set after instruction run.
+            * If the flag is marked by a "-" it is unchanged.
+            * If the flag is marked by the corresponding symbol it is affected by the function as normal.
+
+        Every handler is instantiated with the M, X and E of its mode, the register operands are pointers to
+        members and the operations and addressing modes are the W65C816_* constants above.
+        */
+        typedef uint8  _REGISTERS::*REG8;
+        typedef uint16 _REGISTERS::*REG16;
+
+        /**
+         * Accumulator group.
+         * ora and eor adc lda cmp sbc  [2-4 |   2-7] [N V - - - - Z C]
+         */
+        template <bool M, bool X, bool E, uint8 AM, uint8 OP>   void alu();
+
+        /**
+         * Store a register or zero.
+         * sta stx sty stz              [2-4 |   3-7] [- - - - - - - -]
+         */
+        template <bool M, bool X, bool E, uint8 AM, uint8 SRC>  void st();
+
+        /**
+         * Read-modify-write group, on the accumulator or memory.
+         * asl rol lsr ror inc dec tsb trb  [1-3 |   2-9] [N - - - - - Z C]
+         */
+        template <bool M, bool X, bool E, uint8 AM, uint8 OP>   void rmw();
+
+        /**
+         * Test bits of the accumulator, the immediate form only sets Z.
+         * bit                          [2-3 |   2-6] [N V - - - - Z -]
+         */
+        template <bool M, bool X, bool E, uint8 AM>             void bit();
+
+        /**
+         * Load an index register.
+         * ldx ldy                      [2-3 |   2-6] [N - - - - - Z -]
+         */
+        template <bool M, bool X, bool E, uint8 AM, REG16 REG>  void ld_i();
+
+        /**
+         * Compare an index register.
+         * cpx cpy                      [2-3 |   2-5] [N - - - - - Z C]
+         */
+        template <bool M, bool X, bool E, uint8 AM, REG16 REG>  void cp_i();
+
+        /**
+         * Increment an index register.
+         * inx iny                      [1  |     2] [N - - - - - Z -]
+         */
+        template <bool M, bool X, bool E, REG16 REG>            void inc_i();
+
+        /**
+         * Decrement an index register.
+         * dex dey                      [1  |     2] [N - - - - - Z -]
+         */
+        template <bool M, bool X, bool E, REG16 REG>            void dec_i();
+
+        /**
+         * Transfer between registers, the stack pointer destinations leave the flags alone.
+         * tax tay txa tya txs tsx txy tyx tcd tdc tcs tsc  [1 | 2] [N - - - - - Z -]
+         */
+        template <bool M, bool X, bool E, REG16 SRC, REG16 DST, uint8 WIDTH>  void tr();
+
+        /**
+         * Exchange the halves of the accumulator.
+         * xba                          [1  |     3] [N - - - - - Z -]
+         */
+        template <bool M, bool X, bool E>                       void xba();
+
+        /**
+         * Branch on a flag, bra with no flag.
+         * bpl bmi bvc bvs bcc bcs bne beq bra  [2 | 2/3/4] [- - - - - - - -]
+         */
+        template <bool M, bool X, bool E, uint8 FLAG, bool SET> void branch();
+
+        /**
+         * Branch long.
+         * brl                          [3  |     4] [- - - - - - - -]
+         */
+        template <bool M, bool X, bool E>                       void brl();
+
+        /**
+         * Jump.
+         * jmp a, jmp al, jmp (a), jmp (a,x), jmp [a]  [3-4 | 3-6] [- - - - - - - -]
+         */
+        template <bool M, bool X, bool E>                       void jmp_a();
+        template <bool M, bool X, bool E>                       void jmp_al();
+        template <bool M, bool X, bool E>                       void jmp_ai();
+        template <bool M, bool X, bool E>                       void jmp_aix();
+        template <bool M, bool X, bool E>                       void jmp_ail();
+
+        /**
+         * Jump to a subroutine.
+         * jsr a, jsr (a,x), jsl        [3-4 |   6-8] [- - - - - - - -]
+         */
+        template <bool M, bool X, bool E>                       void jsr_a();
+        template <bool M, bool X, bool E>                       void jsr_aix();
+        template <bool M, bool X, bool E>                       void jsl();
+
+        /**
+         * Return from a subroutine or an interrupt.
+         * rts rtl rti                  [1  |   6-7] [- - - - - - - -] (rti [N V M X D I Z C])
+         */
+        template <bool M, bool X, bool E>                       void rts();
+        template <bool M, bool X, bool E>                       void rtl();
+        template <bool M, bool X, bool E>                       void rti();
+
+        /**
+         * Software interrupts.
+         * brk cop                      [2  |   7-8] [- - - - 0 1 - -]
+         */
+        template <bool M, bool X, bool E>                       void brk();
+        template <bool M, bool X, bool E>                       void cop();
+
+        /**
+         * Clear or set a flag.
+         * clc sec cli sei clv cld sed  [1  |     2] [- V - - D I - C]
+         */
+        template <bool M, bool X, bool E, uint8 FLAG, bool SET> void flag();
+
+        /**
+         * Clear or set flags of P, swapping the dispatch table when M or X change.
+         * rep sep                      [2  |     3] [N V M X D I Z C]
+         */
+        template <bool M, bool X, bool E>                       void rep();
+        template <bool M, bool X, bool E>                       void sep();
+
+        /**
+         * Exchange the carry and emulation flags, swapping the dispatch table.
+         * xce                          [1  |     2] [- - M X - - - C]
+         */
+        template <bool M, bool X, bool E>                       void xce();
+
+        /**
+         * Push a 16 bit register at a width.
+         * pha phx phy phd              [1  |   3-4] [- - - - - - - -]
+         */
+        template <bool M, bool X, bool E, REG16 REG, uint8 WIDTH>  void push_r();
+
+        /**
+         * Pull a 16 bit register at a width.
+         * pla plx ply pld              [1  |   4-5] [N - - - - - Z -]
+         */
+        template <bool M, bool X, bool E, REG16 REG, uint8 WIDTH>  void pull_r();
+
+        /**
+         * Push an 8 bit register.
+         * phb phk php                  [1  |     3] [- - - - - - - -]
+         */
+        template <bool M, bool X, bool E, REG8 REG>             void push_r8();
+
+        /**
+         * Pull the data bank or the P register.
+         * plb plp                      [1  |     4] [N V M X D I Z C] (plb [N - - - - - Z -])
+         */
+        template <bool M, bool X, bool E>                       void plb();
+        template <bool M, bool X, bool E>                       void plp();
+
+        /**
+         * Push an effective address.
+         * pea pei per                  [2-3 |    5-6] [- - - - - - - -]
+         */
+        template <bool M, bool X, bool E>                       void pea();
+        template <bool M, bool X, bool E>                       void pei();
+        template <bool M, bool X, bool E>                       void per();
+
+        /**
+         * Move one byte of a block and repeat the op until C wraps to 0xFFFF.
+         * mvp mvn                      [3  |     7] [- - - - - - - -]
+         */
+        template <bool M, bool X, bool E, bool DOWN>            void move();
+
+        /**
+         * The no operation ops, wdm skips its signature byte.
+         * nop wdm                      [1-2 |    2] [- - - - - - - -]
+         */
+        template <bool M, bool X, bool E>                       void nop();
+
+        /**
+         * Wait for an interrupt.
+         * wai                          [1  |     3] [- - - - - - - -]
+         */
+        template <bool M, bool X, bool E>                       void wai();
+
+        /**
+         * Stop the clock until reset.
+         * stp                          [1  |     3] [- - - - - - - -]
+         */
+        template <bool M, bool X, bool E>                       void stp();
+
+        /************************\
+        |* Dispatch Tables      *|
+        \************************/
+
+        /* Handler and decode tables of one mode, generated at compile time in dispatch.cpp. */
+        template <bool M, bool X, bool E>
+        struct Mode {
+            static const W65C816_OP_FN      OPS[256];
+            static const W65C816_OP_INFO    INFO[256];
+        };
+
+        /* The tables of every mode, indexed by W65C816_MODE_*. */
+        typedef struct _MODE_TABLES {
+            const W65C816_OP_FN    *ops;
+            const W65C816_OP_INFO  *info;
+        } MODE_TABLES;
+        static const MODE_TABLES MODES[W65C816_MODE_COUNT];
+    };
+
+} /* END: Nintendo */ } /* END: Processors */ } /* END: SiNES */
+
+#endif                              /* END: HEADER GUARD */
@@ -0,0 +1,118 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+/*
+Cached interpreter for the 65c816.
+
+A block is the straight run of ops starting at a PC up to and including the first op that may change the PC,
+the mode or the I flag (W65C816_OP_ENDS_BLOCK).  Each op is decoded once into a W65C816_UOP holding its handler,
+operand bytes and cycles, so running the block again skips the fetch and decode entirely.  The cycles are master
+cycles including the access times of the fetched bytes, so blocks are dropped when MEMSEL changes them.
+
+The same bytes decode to different handlers and operand lengths in each mode, so blocks are keyed by the mode
+as well as the program bank and PC.  Every op that changes the mode ends its block, so all ops of a block run in
+the mode they were decoded in.  Interrupts are taken between blocks.
+
+Blocks decoded from writable pages (WRAM, SRAM) watch their pages and every mirror of them on the bus, and a
+write to a watched page drops every block holding ops from the same memory.  ROM pages are never watched.
+*/
+
+/* Decode the ops starting at the PC into a block in the active mode. */
+void W65C816::decodeBlock(W65C816_BLOCK &block, uint32 key)
+{
+    const MODE_TABLES &tables = MODES[key >> 24];
+    uint8 pbr = (uint8)(key >> 16);
+    uint32 bank = (uint32)pbr << 16;
+    uint16 pc = (uint16)key;
+
+    block.key = key;
+    block.firstPage = LONG_BUS_PAGE(pbr, pc);
+    block.count = 0;
+    while (block.count < W65C816_BLOCK_MAX_UOPS) {
+        W65C816_UOP &uop = block.uops[block.count++];
+        uint8 op = this->peek8(bank | pc);
+        const W65C816_OP_INFO &info = tables.info[op];
+
+        uop.fn = tables.ops[op];
+        uop.length = info.length;
+        uop.cycles = (uint8)(info.cycles * W65C816_CYCLE + this->accessExtra(bank | pc));
+        uop.imm = 0;
+        for (uint32 i = 1; i < info.length; ++i) {
+            uop.imm |= (uint32)this->peek8(bank | (uint16)(pc + i)) << (8 * (i - 1));
+            uop.cycles += this->accessExtra(bank | (uint16)(pc + i));
+        }
+
+        uint16 first = LONG_BUS_PAGE(pbr, pc);
+        uint16 last = LONG_BUS_PAGE(pbr, (uint16)(pc + info.length - 1));
+        if (this->bus.isWritable(first)) {
+            this->bus.watch(first, LONG_BUS_WATCH_CODE);
+        }
+        if (this->bus.isWritable(last)) {
+            this->bus.watch(last, LONG_BUS_WATCH_CODE);
+        }
+        pc += info.length;
+
+        if (info.flags & W65C816_OP_ENDS_BLOCK) {
+            break;
+        }
+    }
+    block.lastPage = LONG_BUS_PAGE(pbr, (uint16)(pc - 1));
+    ++this->stats.blockDecodes;
+}
+
+/* Drop every decoded block. */
+void W65C816::flushBlocks()
+{
+    for (uint32 i = 0; i < W65C816_BLOCK_CACHE_SIZE; ++i) {
+        this->blockCache->blocks[i].key = W65C816_BLOCK_INVALID;
+    }
+}
+
+/* Drop every block that holds ops from a page or one of its mirrors. */
+void W65C816::invalidatePage(uint16 page)
+{
+    /* A block of at most W65C816_BLOCK_MAX_UOPS ops spans no more than two pages. */
+    const uint8 *host = this->bus.hostPage(page);
+    for (uint32 i = 0; i < W65C816_BLOCK_CACHE_SIZE; ++i) {
+        W65C816_BLOCK &block = this->blockCache->blocks[i];
+        if (W65C816_BLOCK_INVALID == block.key) {
+            continue;
+        }
+        bool first = block.firstPage == page || (NULL != host && this->bus.hostPage(block.firstPage) == host);
+        bool last = block.lastPage == page || (NULL != host && this->bus.hostPage(block.lastPage) == host);
+        if (first || last) {
+            block.key = W65C816_BLOCK_INVALID;
+        }
+    }
+    this->bus.unwatch(page, LONG_BUS_WATCH_CODE);
+    ++this->stats.codeWrites;
+}
+
+/* Bus watch handler, drops the blocks decoded from a page before it is written. */
+void W65C816::watchedWrite(void *context, uint16 page)
+{
+    ((W65C816 *)context)->invalidatePage(page);
+}
+
+/* Execute the decoded block starting at the PC. */
+uint32 W65C816::execBlock()
+{
+    uint32 key = W65C816_BLOCK_KEY(this->mode, this->r.pbr, this->r.pc);
+    W65C816_BLOCK &block = this->blockCache->blocks[W65C816_BLOCK_CACHE_INDEX(key)];
+    if (block.key != key) {
+        this->decodeBlock(block, key);
+    }
+
+    /* A write into the block's own pages drops it, the remaining ops are then left to the next block. */
+    uint64 start = this->cycles;
+    const W65C816_UOP *uop = block.uops;
+    const W65C816_UOP *end = uop + block.count;
+    for (; uop != end && block.key == key; ++uop) {
+        this->imm = uop->imm;
+        this->r.pc += uop->length;
+        this->cycles += uop->cycles;
+        (this->*uop->fn)();
+    }
+    return (uint32)(this->cycles - start);
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#ifndef SINES_65C816_BLOCK_H        /* START: HEADER GUARD */
+#define SINES_65C816_BLOCK_H
+
+#include "xplat/types.hpp"
+
+namespace SiNES { namespace Processors { namespace Nintendo {
+    class W65C816;
+
+    /* Pointer to an op code handler of the 65c816. */
+    typedef void (W65C816::*W65C816_OP_FN)();
+
+    /* Static decode information for an op code in one register width mode. */
+    typedef struct _W65C816_OP_INFO {
+        uint8   length; // Length in bytes including the op code, immediates sized for the mode.
+        uint8   cycles; // Duration in clock cycles without the direct page, page crossing and branch penalties.
+        uint8   flags;  // Decode flags.
+        #define W65C816_OP_ENDS_BLOCK       (0x01 << 0) // May change the PC, the mode or the I flag, ends a block.
+    } W65C816_OP_INFO;
+
+    /* A pre-decoded op ready to run from the block cache. */
+    typedef struct _W65C816_UOP {
+        W65C816_OP_FN   fn;     // Handler for the op in the mode of its block.
+        uint32          imm;    // Operand bytes, sized for the mode of the block.
+        uint8           length; // Bytes to advance the PC by before the handler runs.
+        uint8           cycles; // Master cycles of the op and its fetch, without the penalties resolved as it runs.
+    } W65C816_UOP;
+
+    /* Decoded basic block: a straight run of ops in one mode ending at a branch or W65C816_BLOCK_MAX_UOPS. */
+    #define W65C816_BLOCK_MAX_UOPS      16
+    #define W65C816_BLOCK_INVALID       0xFFFFFFFF
+    #define W65C816_BLOCK_KEY(MODE, PBR, PC)    (((uint32)(MODE) << 24) | ((uint32)(PBR) << 16) | (PC))
+    typedef struct _W65C816_BLOCK {
+        uint32      key;        // W65C816_BLOCK_KEY of the first op, W65C816_BLOCK_INVALID if empty.
+        uint16      firstPage;  // Bus page of the first byte of the block.
+        uint16      lastPage;   // Bus page of the last byte of the block.
+        uint8       count;      // Number of decoded ops.
+        W65C816_UOP uops[W65C816_BLOCK_MAX_UOPS];
+    } W65C816_BLOCK;
+
+    /* Direct mapped cache of decoded blocks, indexed by a hash of the block key.  Writable pages holding decoded
+       ops are watched on the bus. */
+    #define W65C816_BLOCK_CACHE_SIZE    1024
+    #define W65C816_BLOCK_CACHE_INDEX(KEY) ((((KEY) >> 16) * 0x9E37 + (KEY)) & (W65C816_BLOCK_CACHE_SIZE - 1))
+    typedef struct _W65C816_BLOCK_CACHE {
+        W65C816_BLOCK   blocks[W65C816_BLOCK_CACHE_SIZE];
+    } W65C816_BLOCK_CACHE;
+
+} /* END: Nintendo */ } /* END: Processors */ } /* END: SiNES */
+
+#endif                              /* END: HEADER GUARD */
@@ -0,0 +1,30 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#ifndef SINES_65C816_CONFIG_H       /* START: HEADER GUARD */
+#define SINES_65C816_CONFIG_H
+
+/*
+ * Build time options for the 65c816 core.  Each option may be overridden on the
+ * compiler command line (see CMakeLists.txt), otherwise the defaults below are used.
+ */
+
+/* Clock cycle accounting, the cycle counter runs in master cycles either way. */
+#define W65C816_TIMING_FIXED        0   /* Every cycle costs W65C816_FIXED_SPEED master cycles. */
+#define W65C816_TIMING_ACCESS       1   /* Internal cycles cost 6, memory accesses 6, 8 or 12 by address. */
+
+#ifndef W65C816_TIMING
+    #define W65C816_TIMING W65C816_TIMING_ACCESS
+#endif
+
+/* Master cycles of every cycle under W65C816_TIMING_FIXED, the SlowROM access time by default. */
+#ifndef W65C816_FIXED_SPEED
+    #define W65C816_FIXED_SPEED 8
+#endif
+
+#if W65C816_FIXED_SPEED < 6 || W65C816_FIXED_SPEED > 12
+    #error W65C816_FIXED_SPEED must lie between the fastest and slowest access times (6 to 12)
+#endif
+
+#endif                              /* END: HEADER GUARD */
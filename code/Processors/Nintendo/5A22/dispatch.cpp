@@ -0,0 +1,600 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+/*
+Compile time generated dispatch for the 65c816.
+
+The handler and decode tables are static members of W65C816::Mode, a template on the register widths, so the
+tables below are written once and instantiated for each of the five modes.  Every handler in a table is the
+instantiation for its mode, with the widths, the addressing mode and any register operand baked in, and the
+decode table holds the immediate lengths and base cycles of that mode.  rep, sep, xce, plp and rti swap the
+active pair through MODES.
+*/
+
+/*********************************************************************************************************************\
+| Handler Tables                                                                                                      |
+\*********************************************************************************************************************/
+
+#define R(NAME)                 &W65C816::_REGISTERS::NAME
+#define OP(NAME)                &W65C816::NAME<M, X, E>
+#define ALU(AM, OP)             &W65C816::alu<M, X, E, W65C816_AM_##AM, W65C816_ALU_##OP>
+#define ST(AM, SRC)             &W65C816::st<M, X, E, W65C816_AM_##AM, W65C816_SRC_##SRC>
+#define RMW(AM, OP)             &W65C816::rmw<M, X, E, W65C816_AM_##AM, W65C816_RMW_##OP>
+#define BIT(AM)                 &W65C816::bit<M, X, E, W65C816_AM_##AM>
+#define LD(AM, REG)             &W65C816::ld_i<M, X, E, W65C816_AM_##AM, R(REG)>
+#define CP(AM, REG)             &W65C816::cp_i<M, X, E, W65C816_AM_##AM, R(REG)>
+#define INC_I(REG)              &W65C816::inc_i<M, X, E, R(REG)>
+#define DEC_I(REG)              &W65C816::dec_i<M, X, E, R(REG)>
+#define TR(SRC, DST, WIDTH)     &W65C816::tr<M, X, E, R(SRC), R(DST), W65C816_WIDTH_##WIDTH>
+#define BRANCH(FLAG, SET)       &W65C816::branch<M, X, E, FLAG, SET>
+#define FLAG(FLAG, SET)         &W65C816::flag<M, X, E, FLAG, SET>
+#define PUSH(REG, WIDTH)        &W65C816::push_r<M, X, E, R(REG), W65C816_WIDTH_##WIDTH>
+#define PULL(REG, WIDTH)        &W65C816::pull_r<M, X, E, R(REG), W65C816_WIDTH_##WIDTH>
+#define PUSH8(REG)              &W65C816::push_r8<M, X, E, R(REG)>
+#define MOVE(DOWN)              &W65C816::move<M, X, E, DOWN>
+
+template <bool M, bool X, bool E>
+const W65C816_OP_FN W65C816::Mode<M, X, E>::OPS[256] = {
+        /* 0x00 */ OP(brk),                                         // brk
+        /* 0x01 */ ALU(DPIX, ORA),                                  // ora (d,x)
+        /* 0x02 */ OP(cop),                                         // cop
+        /* 0x03 */ ALU(SR, ORA),                                    // ora d,s
+        /* 0x04 */ RMW(DP, TSB),                                    // tsb d
+        /* 0x05 */ ALU(DP, ORA),                                    // ora d
+        /* 0x06 */ RMW(DP, ASL),                                    // asl d
+        /* 0x07 */ ALU(DPIL, ORA),                                  // ora [d]
+        /* 0x08 */ PUSH8(p),                                        // php
+        /* 0x09 */ ALU(IMM, ORA),                                   // ora #
+        /* 0x0A */ RMW(ACC, ASL),                                   // asl
+        /* 0x0B */ PUSH(d, 16),                                     // phd
+        /* 0x0C */ RMW(ABS, TSB),                                   // tsb a
+        /* 0x0D */ ALU(ABS, ORA),                                   // ora a
+        /* 0x0E */ RMW(ABS, ASL),                                   // asl a
+        /* 0x0F */ ALU(ABSL, ORA),                                  // ora al
+        /* 0x10 */ BRANCH(W65C816_FLAG_NEGATIVE, false),            // bpl
+        /* 0x11 */ ALU(DPIY, ORA),                                  // ora (d),y
+        /* 0x12 */ ALU(DPI, ORA),                                   // ora (d)
+        /* 0x13 */ ALU(SRIY, ORA),                                  // ora (d,s),y
+        /* 0x14 */ RMW(DP, TRB),                                    // trb d
+        /* 0x15 */ ALU(DPX, ORA),                                   // ora d,x
+        /* 0x16 */ RMW(DPX, ASL),                                   // asl d,x
+        /* 0x17 */ ALU(DPILY, ORA),                                 // ora [d],y
+        /* 0x18 */ FLAG(W65C816_FLAG_CARRY, false),                 // clc
+        /* 0x19 */ ALU(ABSY, ORA),                                  // ora a,y
+        /* 0x1A */ RMW(ACC, INC),                                   // inc
+        /* 0x1B */ TR(c, s, 16),                                    // tcs
+        /* 0x1C */ RMW(ABS, TRB),                                   // trb a
+        /* 0x1D */ ALU(ABSX, ORA),                                  // ora a,x
+        /* 0x1E */ RMW(ABSX, ASL),                                  // asl a,x
+        /* 0x1F */ ALU(ABSLX, ORA),                                 // ora al,x
+        /* 0x20 */ OP(jsr_a),                                       // jsr a
+        /* 0x21 */ ALU(DPIX, AND),                                  // and (d,x)
+        /* 0x22 */ OP(jsl),                                         // jsl al
+        /* 0x23 */ ALU(SR, AND),                                    // and d,s
+        /* 0x24 */ BIT(DP),                                         // bit d
+        /* 0x25 */ ALU(DP, AND),                                    // and d
+        /* 0x26 */ RMW(DP, ROL),                                    // rol d
+        /* 0x27 */ ALU(DPIL, AND),                                  // and [d]
+        /* 0x28 */ OP(plp),                                         // plp
+        /* 0x29 */ ALU(IMM, AND),                                   // and #
+        /* 0x2A */ RMW(ACC, ROL),                                   // rol
+        /* 0x2B */ PULL(d, 16),                                     // pld
+        /* 0x2C */ BIT(ABS),                                        // bit a
+        /* 0x2D */ ALU(ABS, AND),                                   // and a
+        /* 0x2E */ RMW(ABS, ROL),                                   // rol a
+        /* 0x2F */ ALU(ABSL, AND),                                  // and al
+        /* 0x30 */ BRANCH(W65C816_FLAG_NEGATIVE, true),             // bmi
+        /* 0x31 */ ALU(DPIY, AND),                                  // and (d),y
+        /* 0x32 */ ALU(DPI, AND),                                   // and (d)
+        /* 0x33 */ ALU(SRIY, AND),                                  // and (d,s),y
+        /* 0x34 */ BIT(DPX),                                        // bit d,x
+        /* 0x35 */ ALU(DPX, AND),                                   // and d,x
+        /* 0x36 */ RMW(DPX, ROL),                                   // rol d,x
+        /* 0x37 */ ALU(DPILY, AND),                                 // and [d],y
+        /* 0x38 */ FLAG(W65C816_FLAG_CARRY, true),                  // sec
+        /* 0x39 */ ALU(ABSY, AND),                                  // and a,y
+        /* 0x3A */ RMW(ACC, DEC),                                   // dec
+        /* 0x3B */ TR(s, c, 16),                                    // tsc
+        /* 0x3C */ BIT(ABSX),                                       // bit a,x
+        /* 0x3D */ ALU(ABSX, AND),                                  // and a,x
+        /* 0x3E */ RMW(ABSX, ROL),                                  // rol a,x
+        /* 0x3F */ ALU(ABSLX, AND),                                 // and al,x
+        /* 0x40 */ OP(rti),                                         // rti
+        /* 0x41 */ ALU(DPIX, EOR),                                  // eor (d,x)
+        /* 0x42 */ OP(nop),                                         // wdm
+        /* 0x43 */ ALU(SR, EOR),                                    // eor d,s
+        /* 0x44 */ MOVE(true),                                      // mvp
+        /* 0x45 */ ALU(DP, EOR),                                    // eor d
+        /* 0x46 */ RMW(DP, LSR),                                    // lsr d
+        /* 0x47 */ ALU(DPIL, EOR),                                  // eor [d]
+        /* 0x48 */ PUSH(c, M),                                      // pha
+        /* 0x49 */ ALU(IMM, EOR),                                   // eor #
+        /* 0x4A */ RMW(ACC, LSR),                                   // lsr
+        /* 0x4B */ PUSH8(pbr),                                      // phk
+        /* 0x4C */ OP(jmp_a),                                       // jmp a
+        /* 0x4D */ ALU(ABS, EOR),                                   // eor a
+        /* 0x4E */ RMW(ABS, LSR),                                   // lsr a
+        /* 0x4F */ ALU(ABSL, EOR),                                  // eor al
+        /* 0x50 */ BRANCH(W65C816_FLAG_OVERFLOW, false),            // bvc
+        /* 0x51 */ ALU(DPIY, EOR),                                  // eor (d),y
+        /* 0x52 */ ALU(DPI, EOR),                                   // eor (d)
+        /* 0x53 */ ALU(SRIY, EOR),                                  // eor (d,s),y
+        /* 0x54 */ MOVE(false),                                     // mvn
+        /* 0x55 */ ALU(DPX, EOR),                                   // eor d,x
+        /* 0x56 */ RMW(DPX, LSR),                                   // lsr d,x
+        /* 0x57 */ ALU(DPILY, EOR),                                 // eor [d],y
+        /* 0x58 */ FLAG(W65C816_FLAG_IRQ, false),                   // cli
+        /* 0x59 */ ALU(ABSY, EOR),                                  // eor a,y
+        /* 0x5A */ PUSH(y, X),                                      // phy
+        /* 0x5B */ TR(c, d, 16),                                    // tcd
+        /* 0x5C */ OP(jmp_al),                                      // jmp al
+        /* 0x5D */ ALU(ABSX, EOR),                                  // eor a,x
+        /* 0x5E */ RMW(ABSX, LSR),                                  // lsr a,x
+        /* 0x5F */ ALU(ABSLX, EOR),                                 // eor al,x
+        /* 0x60 */ OP(rts),                                         // rts
+        /* 0x61 */ ALU(DPIX, ADC),                                  // adc (d,x)
+        /* 0x62 */ OP(per),                                         // per rl
+        /* 0x63 */ ALU(SR, ADC),                                    // adc d,s
+        /* 0x64 */ ST(DP, Z),                                       // stz d
+        /* 0x65 */ ALU(DP, ADC),                                    // adc d
+        /* 0x66 */ RMW(DP, ROR),                                    // ror d
+        /* 0x67 */ ALU(DPIL, ADC),                                  // adc [d]
+        /* 0x68 */ PULL(c, M),                                      // pla
+        /* 0x69 */ ALU(IMM, ADC),                                   // adc #
+        /* 0x6A */ RMW(ACC, ROR),                                   // ror
+        /* 0x6B */ OP(rtl),                                         // rtl
+        /* 0x6C */ OP(jmp_ai),                                      // jmp (a)
+        /* 0x6D */ ALU(ABS, ADC),                                   // adc a
+        /* 0x6E */ RMW(ABS, ROR),                                   // ror a
+        /* 0x6F */ ALU(ABSL, ADC),                                  // adc al
+        /* 0x70 */ BRANCH(W65C816_FLAG_OVERFLOW, true),             // bvs
+        /* 0x71 */ ALU(DPIY, ADC),                                  // adc (d),y
+        /* 0x72 */ ALU(DPI, ADC),                                   // adc (d)
+        /* 0x73 */ ALU(SRIY, ADC),                                  // adc (d,s),y
+        /* 0x74 */ ST(DPX, Z),                                      // stz d,x
+        /* 0x75 */ ALU(DPX, ADC),                                   // adc d,x
+        /* 0x76 */ RMW(DPX, ROR),                                   // ror d,x
+        /* 0x77 */ ALU(DPILY, ADC),                                 // adc [d],y
+        /* 0x78 */ FLAG(W65C816_FLAG_IRQ, true),                    // sei
+        /* 0x79 */ ALU(ABSY, ADC),                                  // adc a,y
+        /* 0x7A */ PULL(y, X),                                      // ply
+        /* 0x7B */ TR(d, c, 16),                                    // tdc
+        /* 0x7C */ OP(jmp_aix),                                     // jmp (a,x)
+        /* 0x7D */ ALU(ABSX, ADC),                                  // adc a,x
+        /* 0x7E */ RMW(ABSX, ROR),                                  // ror a,x
+        /* 0x7F */ ALU(ABSLX, ADC),                                 // adc al,x
+        /* 0x80 */ BRANCH(0, false),                                // bra
+        /* 0x81 */ ST(DPIX, A),                                     // sta (d,x)
+        /* 0x82 */ OP(brl),                                         // brl
+        /* 0x83 */ ST(SR, A),                                       // sta d,s
+        /* 0x84 */ ST(DP, Y),                                       // sty d
+        /* 0x85 */ ST(DP, A),                                       // sta d
+        /* 0x86 */ ST(DP, X),                                       // stx d
+        /* 0x87 */ ST(DPIL, A),                                     // sta [d]
+        /* 0x88 */ DEC_I(y),                                        // dey
+        /* 0x89 */ BIT(IMM),                                        // bit #
+        /* 0x8A */ TR(x, c, M),                                     // txa
+        /* 0x8B */ PUSH8(dbr),                                      // phb
+        /* 0x8C */ ST(ABS, Y),                                      // sty a
+        /* 0x8D */ ST(ABS, A),                                      // sta a
+        /* 0x8E */ ST(ABS, X),                                      // stx a
+        /* 0x8F */ ST(ABSL, A),                                     // sta al
+        /* 0x90 */ BRANCH(W65C816_FLAG_CARRY, false),               // bcc
+        /* 0x91 */ ST(DPIY, A),                                     // sta (d),y
+        /* 0x92 */ ST(DPI, A),                                      // sta (d)
+        /* 0x93 */ ST(SRIY, A),                                     // sta (d,s),y
+        /* 0x94 */ ST(DPX, Y),                                      // sty d,x
+        /* 0x95 */ ST(DPX, A),                                      // sta d,x
+        /* 0x96 */ ST(DPY, X),                                      // stx d,y
+        /* 0x97 */ ST(DPILY, A),                                    // sta [d],y
+        /* 0x98 */ TR(y, c, M),                                     // tya
+        /* 0x99 */ ST(ABSY, A),                                     // sta a,y
+        /* 0x9A */ TR(x, s, 16),                                    // txs
+        /* 0x9B */ TR(x, y, X),                                     // txy
+        /* 0x9C */ ST(ABS, Z),                                      // stz a
+        /* 0x9D */ ST(ABSX, A),                                     // sta a,x
+        /* 0x9E */ ST(ABSX, Z),                                     // stz a,x
+        /* 0x9F */ ST(ABSLX, A),                                    // sta al,x
+        /* 0xA0 */ LD(IMM, y),                                      // ldy #
+        /* 0xA1 */ ALU(DPIX, LDA),                                  // lda (d,x)
+        /* 0xA2 */ LD(IMM, x),                                      // ldx #
+        /* 0xA3 */ ALU(SR, LDA),                                    // lda d,s
+        /* 0xA4 */ LD(DP, y),                                       // ldy d
+        /* 0xA5 */ ALU(DP, LDA),                                    // lda d
+        /* 0xA6 */ LD(DP, x),                                       // ldx d
+        /* 0xA7 */ ALU(DPIL, LDA),                                  // lda [d]
+        /* 0xA8 */ TR(c, y, X),                                     // tay
+        /* 0xA9 */ ALU(IMM, LDA),                                   // lda #
+        /* 0xAA */ TR(c, x, X),                                     // tax
+        /* 0xAB */ OP(plb),                                         // plb
+        /* 0xAC */ LD(ABS, y),                                      // ldy a
+        /* 0xAD */ ALU(ABS, LDA),                                   // lda a
+        /* 0xAE */ LD(ABS, x),                                      // ldx a
+        /* 0xAF */ ALU(ABSL, LDA),                                  // lda al
+        /* 0xB0 */ BRANCH(W65C816_FLAG_CARRY, true),                // bcs
+        /* 0xB1 */ ALU(DPIY, LDA),                                  // lda (d),y
+        /* 0xB2 */ ALU(DPI, LDA),                                   // lda (d)
+        /* 0xB3 */ ALU(SRIY, LDA),                                  // lda (d,s),y
+        /* 0xB4 */ LD(DPX, y),                                      // ldy d,x
+        /* 0xB5 */ ALU(DPX, LDA),                                   // lda d,x
+        /* 0xB6 */ LD(DPY, x),                                      // ldx d,y
+        /* 0xB7 */ ALU(DPILY, LDA),                                 // lda [d],y
+        /* 0xB8 */ FLAG(W65C816_FLAG_OVERFLOW, false),              // clv
+        /* 0xB9 */ ALU(ABSY, LDA),                                  // lda a,y
+        /* 0xBA */ TR(s, x, X),                                     // tsx
+        /* 0xBB */ TR(y, x, X),                                     // tyx
+        /* 0xBC */ LD(ABSX, y),                                     // ldy a,x
+        /* 0xBD */ ALU(ABSX, LDA),                                  // lda a,x
+        /* 0xBE */ LD(ABSY, x),                                     // ldx a,y
+        /* 0xBF */ ALU(ABSLX, LDA),                                 // lda al,x
+        /* 0xC0 */ CP(IMM, y),                                      // cpy #
+        /* 0xC1 */ ALU(DPIX, CMP),                                  // cmp (d,x)
+        /* 0xC2 */ OP(rep),                                         // rep #
+        /* 0xC3 */ ALU(SR, CMP),                                    // cmp d,s
+        /* 0xC4 */ CP(DP, y),                                       // cpy d
+        /* 0xC5 */ ALU(DP, CMP),                                    // cmp d
+        /* 0xC6 */ RMW(DP, DEC),                                    // dec d
+        /* 0xC7 */ ALU(DPIL, CMP),                                  // cmp [d]
+        /* 0xC8 */ INC_I(y),                                        // iny
+        /* 0xC9 */ ALU(IMM, CMP),                                   // cmp #
+        /* 0xCA */ DEC_I(x),                                        // dex
+        /* 0xCB */ OP(wai),                                         // wai
+        /* 0xCC */ CP(ABS, y),                                      // cpy a
+        /* 0xCD */ ALU(ABS, CMP),                                   // cmp a
+        /* 0xCE */ RMW(ABS, DEC),                                   // dec a
+        /* 0xCF */ ALU(ABSL, CMP),                                  // cmp al
+        /* 0xD0 */ BRANCH(W65C816_FLAG_ZERO, false),                // bne
+        /* 0xD1 */ ALU(DPIY, CMP),                                  // cmp (d),y
+        /* 0xD2 */ ALU(DPI, CMP),                                   // cmp (d)
+        /* 0xD3 */ ALU(SRIY, CMP),                                  // cmp (d,s),y
+        /* 0xD4 */ OP(pei),                                         // pei (d)
+        /* 0xD5 */ ALU(DPX, CMP),                                   // cmp d,x
+        /* 0xD6 */ RMW(DPX, DEC),                                   // dec d,x
+        /* 0xD7 */ ALU(DPILY, CMP),                                 // cmp [d],y
+        /* 0xD8 */ FLAG(W65C816_FLAG_DECIMAL, false),               // cld
+        /* 0xD9 */ ALU(ABSY, CMP),                                  // cmp a,y
+        /* 0xDA */ PUSH(x, X),                                      // phx
+        /* 0xDB */ OP(stp),                                         // stp
+        /* 0xDC */ OP(jmp_ail),                                     // jmp [a]
+        /* 0xDD */ ALU(ABSX, CMP),                                  // cmp a,x
+        /* 0xDE */ RMW(ABSX, DEC),                                  // dec a,x
+        /* 0xDF */ ALU(ABSLX, CMP),                                 // cmp al,x
+        /* 0xE0 */ CP(IMM, x),                                      // cpx #
+        /* 0xE1 */ ALU(DPIX, SBC),                                  // sbc (d,x)
+        /* 0xE2 */ OP(sep),                                         // sep #
+        /* 0xE3 */ ALU(SR, SBC),                                    // sbc d,s
+        /* 0xE4 */ CP(DP, x),                                       // cpx d
+        /* 0xE5 */ ALU(DP, SBC),                                    // sbc d
+        /* 0xE6 */ RMW(DP, INC),                                    // inc d
+        /* 0xE7 */ ALU(DPIL, SBC),                                  // sbc [d]
+        /* 0xE8 */ INC_I(x),                                        // inx
+        /* 0xE9 */ ALU(IMM, SBC),                                   // sbc #
+        /* 0xEA */ OP(nop),                                         // nop
+        /* 0xEB */ OP(xba),                                         // xba
+        /* 0xEC */ CP(ABS, x),                                      // cpx a
+        /* 0xED */ ALU(ABS, SBC),                                   // sbc a
+        /* 0xEE */ RMW(ABS, INC),                                   // inc a
+        /* 0xEF */ ALU(ABSL, SBC),                                  // sbc al
+        /* 0xF0 */ BRANCH(W65C816_FLAG_ZERO, true),                 // beq
+        /* 0xF1 */ ALU(DPIY, SBC),                                  // sbc (d),y
+        /* 0xF2 */ ALU(DPI, SBC),                                   // sbc (d)
+        /* 0xF3 */ ALU(SRIY, SBC),                                  // sbc (d,s),y
+        /* 0xF4 */ OP(pea),                                         // pea a
+        /* 0xF5 */ ALU(DPX, SBC),                                   // sbc d,x
+        /* 0xF6 */ RMW(DPX, INC),                                   // inc d,x
+        /* 0xF7 */ ALU(DPILY, SBC),                                 // sbc [d],y
+        /* 0xF8 */ FLAG(W65C816_FLAG_DECIMAL, true),                // sed
+        /* 0xF9 */ ALU(ABSY, SBC),                                  // sbc a,y
+        /* 0xFA */ PULL(x, X),                                      // plx
+        /* 0xFB */ OP(xce),                                         // xce
+        /* 0xFC */ OP(jsr_aix),                                     // jsr (a,x)
+        /* 0xFD */ ALU(ABSX, SBC),                                  // sbc a,x
+        /* 0xFE */ RMW(ABSX, INC),                                  // inc a,x
+        /* 0xFF */ ALU(ABSLX, SBC)                                  // sbc al,x
+};
+
+#undef MOVE
+#undef PUSH8
+#undef PULL
+#undef PUSH
+#undef FLAG
+#undef BRANCH
+#undef TR
+#undef DEC_I
+#undef INC_I
+#undef CP
+#undef LD
+#undef BIT
+#undef RMW
+#undef ST
+#undef ALU
+#undef OP
+#undef R
+
+/*********************************************************************************************************************\
+| Decode Tables                                                                                                       |
+\*********************************************************************************************************************/
+
+/*
+Decode information: {length, cycles, flags}.  MW and XW add the extra byte or cycle of a 16 bit accumulator or
+index, NW the extra cycle of an interrupt or rti in native mode.  The cycles leave out the penalties resolved as
+the op runs: one for a direct page that is not page aligned, one for an 8 bit index crossing a page on a read and
+one or two for a taken branch.  Ops that may change the PC, the mode or the I flag end a decoded block.
+*/
+#define MW (M ? 0 : 1)
+#define XW (X ? 0 : 1)
+#define NW (E ? 0 : 1)
+
+template <bool M, bool X, bool E>
+const W65C816_OP_INFO W65C816::Mode<M, X, E>::INFO[256] = {
+        /* 0x00 */ {2, 7 + NW, W65C816_OP_ENDS_BLOCK},         // brk
+        /* 0x01 */ {2, 6 + MW, 0},                             // ora (d,x)
+        /* 0x02 */ {2, 7 + NW, W65C816_OP_ENDS_BLOCK},         // cop
+        /* 0x03 */ {2, 4 + MW, 0},                             // ora d,s
+        /* 0x04 */ {2, 5 + 2 * MW, 0},                         // tsb d
+        /* 0x05 */ {2, 3 + MW, 0},                             // ora d
+        /* 0x06 */ {2, 5 + 2 * MW, 0},                         // asl d
+        /* 0x07 */ {2, 6 + MW, 0},                             // ora [d]
+        /* 0x08 */ {1, 3, 0},                                  // php
+        /* 0x09 */ {2 + MW, 2 + MW, 0},                        // ora #
+        /* 0x0A */ {1, 2, 0},                                  // asl
+        /* 0x0B */ {1, 4, 0},                                  // phd
+        /* 0x0C */ {3, 6 + 2 * MW, 0},                         // tsb a
+        /* 0x0D */ {3, 4 + MW, 0},                             // ora a
+        /* 0x0E */ {3, 6 + 2 * MW, 0},                         // asl a
+        /* 0x0F */ {4, 5 + MW, 0},                             // ora al
+        /* 0x10 */ {2, 2, W65C816_OP_ENDS_BLOCK},              // bpl
+        /* 0x11 */ {2, 5 + MW + XW, 0},                        // ora (d),y
+        /* 0x12 */ {2, 5 + MW, 0},                             // ora (d)
+        /* 0x13 */ {2, 7 + MW, 0},                             // ora (d,s),y
+        /* 0x14 */ {2, 5 + 2 * MW, 0},                         // trb d
+        /* 0x15 */ {2, 4 + MW, 0},                             // ora d,x
+        /* 0x16 */ {2, 6 + 2 * MW, 0},                         // asl d,x
+        /* 0x17 */ {2, 6 + MW, 0},                             // ora [d],y
+        /* 0x18 */ {1, 2, 0},                                  // clc
+        /* 0x19 */ {3, 4 + MW + XW, 0},                        // ora a,y
+        /* 0x1A */ {1, 2, 0},                                  // inc
+        /* 0x1B */ {1, 2, 0},                                  // tcs
+        /* 0x1C */ {3, 6 + 2 * MW, 0},                         // trb a
+        /* 0x1D */ {3, 4 + MW + XW, 0},                        // ora a,x
+        /* 0x1E */ {3, 7 + 2 * MW, 0},                         // asl a,x
+        /* 0x1F */ {4, 5 + MW, 0},                             // ora al,x
+        /* 0x20 */ {3, 6, W65C816_OP_ENDS_BLOCK},              // jsr a
+        /* 0x21 */ {2, 6 + MW, 0},                             // and (d,x)
+        /* 0x22 */ {4, 8, W65C816_OP_ENDS_BLOCK},              // jsl al
+        /* 0x23 */ {2, 4 + MW, 0},                             // and d,s
+        /* 0x24 */ {2, 3 + MW, 0},                             // bit d
+        /* 0x25 */ {2, 3 + MW, 0},                             // and d
+        /* 0x26 */ {2, 5 + 2 * MW, 0},                         // rol d
+        /* 0x27 */ {2, 6 + MW, 0},                             // and [d]
+        /* 0x28 */ {1, 4, W65C816_OP_ENDS_BLOCK},              // plp
+        /* 0x29 */ {2 + MW, 2 + MW, 0},                        // and #
+        /* 0x2A */ {1, 2, 0},                                  // rol
+        /* 0x2B */ {1, 5, 0},                                  // pld
+        /* 0x2C */ {3, 4 + MW, 0},                             // bit a
+        /* 0x2D */ {3, 4 + MW, 0},                             // and a
+        /* 0x2E */ {3, 6 + 2 * MW, 0},                         // rol a
+        /* 0x2F */ {4, 5 + MW, 0},                             // and al
+        /* 0x30 */ {2, 2, W65C816_OP_ENDS_BLOCK},              // bmi
+        /* 0x31 */ {2, 5 + MW + XW, 0},                        // and (d),y
+        /* 0x32 */ {2, 5 + MW, 0},                             // and (d)
+        /* 0x33 */ {2, 7 + MW, 0},                             // and (d,s),y
+        /* 0x34 */ {2, 4 + MW, 0},                             // bit d,x
+        /* 0x35 */ {2, 4 + MW, 0},                             // and d,x
+        /* 0x36 */ {2, 6 + 2 * MW, 0},                         // rol d,x
+        /* 0x37 */ {2, 6 + MW, 0},                             // and [d],y
+        /* 0x38 */ {1, 2, 0},                                  // sec
+        /* 0x39 */ {3, 4 + MW + XW, 0},                        // and a,y
+        /* 0x3A */ {1, 2, 0},                                  // dec
+        /* 0x3B */ {1, 2, 0},                                  // tsc
+        /* 0x3C */ {3, 4 + MW + XW, 0},                        // bit a,x
+        /* 0x3D */ {3, 4 + MW + XW, 0},                        // and a,x
+        /* 0x3E */ {3, 7 + 2 * MW, 0},                         // rol a,x
+        /* 0x3F */ {4, 5 + MW, 0},                             // and al,x
+        /* 0x40 */ {1, 6 + NW, W65C816_OP_ENDS_BLOCK},         // rti
+        /* 0x41 */ {2, 6 + MW, 0},                             // eor (d,x)
+        /* 0x42 */ {2, 2, 0},                                  // wdm
+        /* 0x43 */ {2, 4 + MW, 0},                             // eor d,s
+        /* 0x44 */ {3, 7, W65C816_OP_ENDS_BLOCK},              // mvp
+        /* 0x45 */ {2, 3 + MW, 0},                             // eor d
+        /* 0x46 */ {2, 5 + 2 * MW, 0},                         // lsr d
+        /* 0x47 */ {2, 6 + MW, 0},                             // eor [d]
+        /* 0x48 */ {1, 3 + MW, 0},                             // pha
+        /* 0x49 */ {2 + MW, 2 + MW, 0},                        // eor #
+        /* 0x4A */ {1, 2, 0},                                  // lsr
+        /* 0x4B */ {1, 3, 0},                                  // phk
+        /* 0x4C */ {3, 3, W65C816_OP_ENDS_BLOCK},              // jmp a
+        /* 0x4D */ {3, 4 + MW, 0},                             // eor a
+        /* 0x4E */ {3, 6 + 2 * MW, 0},                         // lsr a
+        /* 0x4F */ {4, 5 + MW, 0},                             // eor al
+        /* 0x50 */ {2, 2, W65C816_OP_ENDS_BLOCK},              // bvc
+        /* 0x51 */ {2, 5 + MW + XW, 0},                        // eor (d),y
+        /* 0x52 */ {2, 5 + MW, 0},                             // eor (d)
+        /* 0x53 */ {2, 7 + MW, 0},                             // eor (d,s),y
+        /* 0x54 */ {3, 7, W65C816_OP_ENDS_BLOCK},              // mvn
+        /* 0x55 */ {2, 4 + MW, 0},                             // eor d,x
+        /* 0x56 */ {2, 6 + 2 * MW, 0},                         // lsr d,x
+        /* 0x57 */ {2, 6 + MW, 0},                             // eor [d],y
+        /* 0x58 */ {1, 2, W65C816_OP_ENDS_BLOCK},              // cli
+        /* 0x59 */ {3, 4 + MW + XW, 0},                        // eor a,y
+        /* 0x5A */ {1, 3 + XW, 0},                             // phy
+        /* 0x5B */ {1, 2, 0},                                  // tcd
+        /* 0x5C */ {4, 4, W65C816_OP_ENDS_BLOCK},              // jmp al
+        /* 0x5D */ {3, 4 + MW + XW, 0},                        // eor a,x
+        /* 0x5E */ {3, 7 + 2 * MW, 0},                         // lsr a,x
+        /* 0x5F */ {4, 5 + MW, 0},                             // eor al,x
+        /* 0x60 */ {1, 6, W65C816_OP_ENDS_BLOCK},              // rts
+        /* 0x61 */ {2, 6 + MW, 0},                             // adc (d,x)
+        /* 0x62 */ {3, 6, 0},                                  // per rl
+        /* 0x63 */ {2, 4 + MW, 0},                             // adc d,s
+        /* 0x64 */ {2, 3 + MW, 0},                             // stz d
+        /* 0x65 */ {2, 3 + MW, 0},                             // adc d
+        /* 0x66 */ {2, 5 + 2 * MW, 0},                         // ror d
+        /* 0x67 */ {2, 6 + MW, 0},                             // adc [d]
+        /* 0x68 */ {1, 4 + MW, 0},                             // pla
+        /* 0x69 */ {2 + MW, 2 + MW, 0},                        // adc #
+        /* 0x6A */ {1, 2, 0},                                  // ror
+        /* 0x6B */ {1, 6, W65C816_OP_ENDS_BLOCK},              // rtl
+        /* 0x6C */ {3, 5, W65C816_OP_ENDS_BLOCK},              // jmp (a)
+        /* 0x6D */ {3, 4 + MW, 0},                             // adc a
+        /* 0x6E */ {3, 6 + 2 * MW, 0},                         // ror a
+        /* 0x6F */ {4, 5 + MW, 0},                             // adc al
+        /* 0x70 */ {2, 2, W65C816_OP_ENDS_BLOCK},              // bvs
+        /* 0x71 */ {2, 5 + MW + XW, 0},                        // adc (d),y
+        /* 0x72 */ {2, 5 + MW, 0},                             // adc (d)
+        /* 0x73 */ {2, 7 + MW, 0},                             // adc (d,s),y
+        /* 0x74 */ {2, 4 + MW, 0},                             // stz d,x
+        /* 0x75 */ {2, 4 + MW, 0},                             // adc d,x
+        /* 0x76 */ {2, 6 + 2 * MW, 0},                         // ror d,x
+        /* 0x77 */ {2, 6 + MW, 0},                             // adc [d],y
+        /* 0x78 */ {1, 2, W65C816_OP_ENDS_BLOCK},              // sei
+        /* 0x79 */ {3, 4 + MW + XW, 0},                        // adc a,y
+        /* 0x7A */ {1, 4 + XW, 0},                             // ply
+        /* 0x7B */ {1, 2, 0},                                  // tdc
+        /* 0x7C */ {3, 6, W65C816_OP_ENDS_BLOCK},              // jmp (a,x)
+        /* 0x7D */ {3, 4 + MW + XW, 0},                        // adc a,x
+        /* 0x7E */ {3, 7 + 2 * MW, 0},                         // ror a,x
+        /* 0x7F */ {4, 5 + MW, 0},                             // adc al,x
+        /* 0x80 */ {2, 2, W65C816_OP_ENDS_BLOCK},              // bra
+        /* 0x81 */ {2, 6 + MW, 0},                             // sta (d,x)
+        /* 0x82 */ {3, 4, W65C816_OP_ENDS_BLOCK},              // brl
+        /* 0x83 */ {2, 4 + MW, 0},                             // sta d,s
+        /* 0x84 */ {2, 3 + XW, 0},                             // sty d
+        /* 0x85 */ {2, 3 + MW, 0},                             // sta d
+        /* 0x86 */ {2, 3 + XW, 0},                             // stx d
+        /* 0x87 */ {2, 6 + MW, 0},                             // sta [d]
+        /* 0x88 */ {1, 2, 0},                                  // dey
+        /* 0x89 */ {2 + MW, 2 + MW, 0},                        // bit #
+        /* 0x8A */ {1, 2, 0},                                  // txa
+        /* 0x8B */ {1, 3, 0},                                  // phb
+        /* 0x8C */ {3, 4 + XW, 0},                             // sty a
+        /* 0x8D */ {3, 4 + MW, 0},                             // sta a
+        /* 0x8E */ {3, 4 + XW, 0},                             // stx a
+        /* 0x8F */ {4, 5 + MW, 0},                             // sta al
+        /* 0x90 */ {2, 2, W65C816_OP_ENDS_BLOCK},              // bcc
+        /* 0x91 */ {2, 6 + MW, 0},                             // sta (d),y
+        /* 0x92 */ {2, 5 + MW, 0},                             // sta (d)
+        /* 0x93 */ {2, 7 + MW, 0},                             // sta (d,s),y
+        /* 0x94 */ {2, 4 + XW, 0},                             // sty d,x
+        /* 0x95 */ {2, 4 + MW, 0},                             // sta d,x
+        /* 0x96 */ {2, 4 + XW, 0},                             // stx d,y
+        /* 0x97 */ {2, 6 + MW, 0},                             // sta [d],y
+        /* 0x98 */ {1, 2, 0},                                  // tya
+        /* 0x99 */ {3, 5 + MW, 0},                             // sta a,y
+        /* 0x9A */ {1, 2, 0},                                  // txs
+        /* 0x9B */ {1, 2, 0},                                  // txy
+        /* 0x9C */ {3, 4 + MW, 0},                             // stz a
+        /* 0x9D */ {3, 5 + MW, 0},                             // sta a,x
+        /* 0x9E */ {3, 5 + MW, 0},                             // stz a,x
+        /* 0x9F */ {4, 5 + MW, 0},                             // sta al,x
+        /* 0xA0 */ {2 + XW, 2 + XW, 0},                        // ldy #
+        /* 0xA1 */ {2, 6 + MW, 0},                             // lda (d,x)
+        /* 0xA2 */ {2 + XW, 2 + XW, 0},                        // ldx #
+        /* 0xA3 */ {2, 4 + MW, 0},                             // lda d,s
+        /* 0xA4 */ {2, 3 + XW, 0},                             // ldy d
+        /* 0xA5 */ {2, 3 + MW, 0},                             // lda d
+        /* 0xA6 */ {2, 3 + XW, 0},                             // ldx d
+        /* 0xA7 */ {2, 6 + MW, 0},                             // lda [d]
+        /* 0xA8 */ {1, 2, 0},                                  // tay
+        /* 0xA9 */ {2 + MW, 2 + MW, 0},                        // lda #
+        /* 0xAA */ {1, 2, 0},                                  // tax
+        /* 0xAB */ {1, 4, 0},                                  // plb
+        /* 0xAC */ {3, 4 + XW, 0},                             // ldy a
+        /* 0xAD */ {3, 4 + MW, 0},                             // lda a
+        /* 0xAE */ {3, 4 + XW, 0},                             // ldx a
+        /* 0xAF */ {4, 5 + MW, 0},                             // lda al
+        /* 0xB0 */ {2, 2, W65C816_OP_ENDS_BLOCK},              // bcs
+        /* 0xB1 */ {2, 5 + MW + XW, 0},                        // lda (d),y
+        /* 0xB2 */ {2, 5 + MW, 0},                             // lda (d)
+        /* 0xB3 */ {2, 7 + MW, 0},                             // lda (d,s),y
+        /* 0xB4 */ {2, 4 + XW, 0},                             // ldy d,x
+        /* 0xB5 */ {2, 4 + MW, 0},                             // lda d,x
+        /* 0xB6 */ {2, 4 + XW, 0},                             // ldx d,y
+        /* 0xB7 */ {2, 6 + MW, 0},                             // lda [d],y
+        /* 0xB8 */ {1, 2, 0},                                  // clv
+        /* 0xB9 */ {3, 4 + MW + XW, 0},                        // lda a,y
+        /* 0xBA */ {1, 2, 0},                                  // tsx
+        /* 0xBB */ {1, 2, 0},                                  // tyx
+        /* 0xBC */ {3, 4 + 2 * XW, 0},                         // ldy a,x
+        /* 0xBD */ {3, 4 + MW + XW, 0},                        // lda a,x
+        /* 0xBE */ {3, 4 + 2 * XW, 0},                         // ldx a,y
+        /* 0xBF */ {4, 5 + MW, 0},                             // lda al,x
+        /* 0xC0 */ {2 + XW, 2 + XW, 0},                        // cpy #
+        /* 0xC1 */ {2, 6 + MW, 0},                             // cmp (d,x)
+        /* 0xC2 */ {2, 3, W65C816_OP_ENDS_BLOCK},              // rep #
+        /* 0xC3 */ {2, 4 + MW, 0},                             // cmp d,s
+        /* 0xC4 */ {2, 3 + XW, 0},                             // cpy d
+        /* 0xC5 */ {2, 3 + MW, 0},                             // cmp d
+        /* 0xC6 */ {2, 5 + 2 * MW, 0},                         // dec d
+        /* 0xC7 */ {2, 6 + MW, 0},                             // cmp [d]
+        /* 0xC8 */ {1, 2, 0},                                  // iny
+        /* 0xC9 */ {2 + MW, 2 + MW, 0},                        // cmp #
+        /* 0xCA */ {1, 2, 0},                                  // dex
+        /* 0xCB */ {1, 3, W65C816_OP_ENDS_BLOCK},              // wai
+        /* 0xCC */ {3, 4 + XW, 0},                             // cpy a
+        /* 0xCD */ {3, 4 + MW, 0},                             // cmp a
+        /* 0xCE */ {3, 6 + 2 * MW, 0},                         // dec a
+        /* 0xCF */ {4, 5 + MW, 0},                             // cmp al
+        /* 0xD0 */ {2, 2, W65C816_OP_ENDS_BLOCK},              // bne
+        /* 0xD1 */ {2, 5 + MW + XW, 0},                        // cmp (d),y
+        /* 0xD2 */ {2, 5 + MW, 0},                             // cmp (d)
+        /* 0xD3 */ {2, 7 + MW, 0},                             // cmp (d,s),y
+        /* 0xD4 */ {2, 6, 0},                                  // pei (d)
+        /* 0xD5 */ {2, 4 + MW, 0},                             // cmp d,x
+        /* 0xD6 */ {2, 6 + 2 * MW, 0},                         // dec d,x
+        /* 0xD7 */ {2, 6 + MW, 0},                             // cmp [d],y
+        /* 0xD8 */ {1, 2, 0},                                  // cld
+        /* 0xD9 */ {3, 4 + MW + XW, 0},                        // cmp a,y
+        /* 0xDA */ {1, 3 + XW, 0},                             // phx
+        /* 0xDB */ {1, 3, W65C816_OP_ENDS_BLOCK},              // stp
+        /* 0xDC */ {3, 6, W65C816_OP_ENDS_BLOCK},              // jmp [a]
+        /* 0xDD */ {3, 4 + MW + XW, 0},                        // cmp a,x
+        /* 0xDE */ {3, 7 + 2 * MW, 0},                         // dec a,x
+        /* 0xDF */ {4, 5 + MW, 0},                             // cmp al,x
+        /* 0xE0 */ {2 + XW, 2 + XW, 0},                        // cpx #
+        /* 0xE1 */ {2, 6 + MW, 0},                             // sbc (d,x)
+        /* 0xE2 */ {2, 3, W65C816_OP_ENDS_BLOCK},              // sep #
+        /* 0xE3 */ {2, 4 + MW, 0},                             // sbc d,s
+        /* 0xE4 */ {2, 3 + XW, 0},                             // cpx d
+        /* 0xE5 */ {2, 3 + MW, 0},                             // sbc d
+        /* 0xE6 */ {2, 5 + 2 * MW, 0},                         // inc d
+        /* 0xE7 */ {2, 6 + MW, 0},                             // sbc [d]
+        /* 0xE8 */ {1, 2, 0},                                  // inx
+        /* 0xE9 */ {2 + MW, 2 + MW, 0},                        // sbc #
+        /* 0xEA */ {1, 2, 0},                                  // nop
+        /* 0xEB */ {1, 3, 0},                                  // xba
+        /* 0xEC */ {3, 4 + XW, 0},                             // cpx a
+        /* 0xED */ {3, 4 + MW, 0},                             // sbc a
+        /* 0xEE */ {3, 6 + 2 * MW, 0},                         // inc a
+        /* 0xEF */ {4, 5 + MW, 0},                             // sbc al
+        /* 0xF0 */ {2, 2, W65C816_OP_ENDS_BLOCK},              // beq
+        /* 0xF1 */ {2, 5 + MW + XW, 0},                        // sbc (d),y
+        /* 0xF2 */ {2, 5 + MW, 0},                             // sbc (d)
+        /* 0xF3 */ {2, 7 + MW, 0},                             // sbc (d,s),y
+        /* 0xF4 */ {3, 5, 0},                                  // pea a
+        /* 0xF5 */ {2, 4 + MW, 0},                             // sbc d,x
+        /* 0xF6 */ {2, 6 + 2 * MW, 0},                         // inc d,x
+        /* 0xF7 */ {2, 6 + MW, 0},                             // sbc [d],y
+        /* 0xF8 */ {1, 2, 0},                                  // sed
+        /* 0xF9 */ {3, 4 + MW + XW, 0},                        // sbc a,y
+        /* 0xFA */ {1, 4 + XW, 0},                             // plx
+        /* 0xFB */ {1, 2, W65C816_OP_ENDS_BLOCK},              // xce
+        /* 0xFC */ {3, 8, W65C816_OP_ENDS_BLOCK},              // jsr (a,x)
+        /* 0xFD */ {3, 4 + MW + XW, 0},                        // sbc a,x
+        /* 0xFE */ {3, 7 + 2 * MW, 0},                         // inc a,x
+        /* 0xFF */ {4, 5 + MW, 0}                              // sbc al,x
+};
+
+#undef NW
+#undef XW
+#undef MW
+
+/* The tables of every mode, the index is W65C816_MODE_*. */
+const W65C816::MODE_TABLES W65C816::MODES[W65C816_MODE_COUNT] = {
+        /* M16_X16 */   {Mode<false, false, false>::OPS, Mode<false, false, false>::INFO},
+        /* M16_X8 */    {Mode<false, true, false>::OPS, Mode<false, true, false>::INFO},
+        /* M8_X16 */    {Mode<true, false, false>::OPS, Mode<true, false, false>::INFO},
+        /* M8_X8 */     {Mode<true, true, false>::OPS, Mode<true, true, false>::INFO},
+        /* EMULATION */ {Mode<true, true, true>::OPS, Mode<true, true, true>::INFO}
+};
@@ -0,0 +1,211 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#include <string.h>
+#include "Processors/Nintendo/5A22/dma.hpp"
+
+namespace SiNES { namespace Processors { namespace Nintendo {
+    /* Port offsets of the bytes of each transfer mode, repeated over four bytes. */
+    static const uint8 PATTERNS[8][4] = {
+        /* 0 */ {0, 0, 0, 0},   // One port.
+        /* 1 */ {0, 1, 0, 1},   // Two ports, VRAM data low and high.
+        /* 2 */ {0, 0, 0, 0},   // One port written twice.
+        /* 3 */ {0, 0, 1, 1},   // Two ports written twice each.
+        /* 4 */ {0, 1, 2, 3},   // Four ports.
+        /* 5 */ {0, 1, 0, 1},   // As mode 1.
+        /* 6 */ {0, 0, 0, 0},   // As mode 2.
+        /* 7 */ {0, 0, 1, 1}    // As mode 3.
+    };
+
+    /* Bytes in one HDMA transfer of each mode. */
+    static const uint8 LENGTHS[8] = {1, 2, 2, 4, 4, 4, 2, 4};
+
+    #include "hdma.cpp"
+
+    /* Constructor for the DMA controller of a processor. */
+    DMA::DMA(W65C816 &cpu) : cpu(cpu), aBus(cpu.getBus()) {
+        for (uint32 i = 0; i < DMA_CHANNEL_COUNT; ++i) {
+            CHANNEL &channel = this->channels[i];
+            channel.control = 0xFF;
+            channel.port = 0xFF;
+            channel.addr = 0xFFFF;
+            channel.bank = 0xFF;
+            channel.count = 0xFFFF;
+            channel.indirectBank = 0xFF;
+            channel.tableAddr = 0xFFFF;
+            channel.lineCounter = 0xFF;
+            channel.unused = 0xFF;
+            channel.hdmaTransfer = false;
+            channel.hdmaEnded = true;
+        }
+        this->hdmaEnable = 0x00;
+        memset(&this->bBus, 0x00, sizeof(this->bBus));
+        memset(&this->stats, 0x00, sizeof(this->stats));
+        memset(&this->hdma, 0x00, sizeof(this->hdma));
+        this->hdma.synced = true;
+        this->aBus.setWatchHandler(LONG_BUS_WATCH_TABLES, &DMA::watchedTable, this);
+    }
+
+    /* Set the handlers of the B bus. */
+    void DMA::setBBus(const DMA_B_BUS &bus) {
+        this->bBus = bus;
+    }
+
+    /* Read a DMA register. */
+    uint8 DMA::readRegister(uint16 addr) {
+        uint8 index = (addr >> 4) & 0x07;
+        if (this->hdmaEnable & (0x01 << index)) {
+            this->hdmaSync();
+        }
+        const CHANNEL &channel = this->channels[index];
+        switch (addr & 0x0F) {
+            case 0x0: return channel.control;
+            case 0x1: return channel.port;
+            case 0x2: return (uint8)channel.addr;
+            case 0x3: return (uint8)(channel.addr >> 8);
+            case 0x4: return channel.bank;
+            case 0x5: return (uint8)channel.count;
+            case 0x6: return (uint8)(channel.count >> 8);
+            case 0x7: return channel.indirectBank;
+            case 0x8: return (uint8)channel.tableAddr;
+            case 0x9: return (uint8)(channel.tableAddr >> 8);
+            case 0xA: return channel.lineCounter;
+            default:  return channel.unused;
+        }
+    }
+
+    /* Write a DMA register. */
+    void DMA::writeRegister(uint16 addr, uint8 value) {
+        if (DMA_REG_MDMAEN == addr) {
+            this->start(value);
+            return;
+        }
+        if (DMA_REG_HDMAEN == addr) {
+            if (value != this->hdmaEnable) {
+                this->hdmaGoLive();
+                this->hdmaEnable = value;
+            }
+            return;
+        }
+        uint8 index = (addr >> 4) & 0x07;
+        if (this->hdmaEnable & (0x01 << index)) {
+            this->hdmaGoLive();
+        }
+        CHANNEL &channel = this->channels[index];
+        switch (addr & 0x0F) {
+            case 0x0: channel.control = value; break;
+            case 0x1: channel.port = value; break;
+            case 0x2: channel.addr = (uint16)((channel.addr & 0xFF00) | value); break;
+            case 0x3: channel.addr = (uint16)((channel.addr & 0x00FF) | (value << 8)); break;
+            case 0x4: channel.bank = value; break;
+            case 0x5: channel.count = (uint16)((channel.count & 0xFF00) | value); break;
+            case 0x6: channel.count = (uint16)((channel.count & 0x00FF) | (value << 8)); break;
+            case 0x7: channel.indirectBank = value; break;
+            case 0x8: channel.tableAddr = (uint16)((channel.tableAddr & 0xFF00) | value); break;
+            case 0x9: channel.tableAddr = (uint16)((channel.tableAddr & 0x00FF) | (value << 8)); break;
+            case 0xA: channel.lineCounter = value; break;
+            default:  channel.unused = value; break;
+        }
+    }
+
+    /* Run the general purpose transfers of a set of channels. */
+    uint32 DMA::start(uint8 channels) {
+        if (0 == channels) {
+            return 0;
+        }
+        if (channels & this->hdmaEnable) {
+            this->hdmaGoLive();
+        }
+
+        /* The transfers start on the DMA clock, a multiple of 8 master cycles. */
+        uint32 cycles = (uint32)((8 - (this->cpu.cycleCount() & 0x07)) & 0x07) + DMA_START_CYCLES;
+        for (uint32 i = 0; i < DMA_CHANNEL_COUNT; ++i) {
+            if (channels & (0x01 << i)) {
+                cycles += DMA_CHANNEL_CYCLES + DMA_BYTE_CYCLES * this->transfer(this->channels[i]);
+            }
+        }
+        this->cpu.stall(cycles);
+        this->stats.cycles += cycles;
+        return cycles;
+    }
+
+    /* Get the instrumentation counters. */
+    const DMA_STATS &DMA::getStats() const {
+        return this->stats;
+    }
+
+    /* Run the transfer of a channel. */
+    uint32 DMA::transfer(CHANNEL &channel) {
+        uint32 count = (0 == channel.count) ? 0x10000 : channel.count;
+        uint8 mode = channel.control & DMA_CONTROL_MODE;
+        bool toA = 0 != (channel.control & DMA_CONTROL_B_TO_A);
+        uint16 step = 1;
+        if (channel.control & DMA_CONTROL_FIXED) {
+            step = 0;
+        } else if (channel.control & DMA_CONTROL_DECREMENT) {
+            step = 0xFFFF;
+        }
+        bool bulk = !toA && 1 == step && NULL != this->bBus.bulk;
+        bool bulked = false;
+
+        uint32 done = 0;
+        while (done < count) {
+            /* Whole runs of a fast path source page go to the ports in one call. */
+            if (bulk) {
+                const uint8 *from = this->aBus.readPage(LONG_BUS_PAGE(channel.bank, channel.addr));
+                if (NULL != from) {
+                    uint32 offset = channel.addr & (LONG_BUS_PAGE_SIZE - 1);
+                    uint32 chunk = LONG_BUS_PAGE_SIZE - offset;
+                    if (chunk > count - done) {
+                        chunk = count - done;
+                    }
+                    uint32 taken = this->bBus.bulk(this->bBus.context, channel.port, mode, done, from + offset, chunk);
+                    if (taken > 0) {
+                        channel.addr = (uint16)(channel.addr + taken);
+                        done += taken;
+                        bulked = true;
+                        this->stats.bulkBytes += taken;
+                        continue;
+                    }
+                    bulk = false;   // The port is not sequential, it will not take the rest either.
+                }
+            }
+
+            uint32 addr = ((uint32)channel.bank << 16) | channel.addr;
+            uint8 port = (uint8)(channel.port + PATTERNS[mode][done & 0x03]);
+            if (toA) {
+                uint8 value = (NULL != this->bBus.read) ? this->bBus.read(this->bBus.context, port) : LONG_BUS_OPEN_BUS;
+                if (reachable(addr)) {
+                    this->aBus.write8(addr, value);
+                }
+            } else {
+                uint8 value = reachable(addr) ? this->aBus.read8(addr) : LONG_BUS_OPEN_BUS;
+                if (NULL != this->bBus.write) {
+                    this->bBus.write(this->bBus.context, port, value);
+                }
+            }
+            channel.addr = (uint16)(channel.addr + step);
+            ++done;
+        }
+        channel.count = 0;
+
+        if (bulked && NULL != this->bBus.done) {
+            this->bBus.done(this->bBus.context, channel.port);
+        }
+        ++this->stats.transfers;
+        this->stats.bytes += done;
+        return done;
+    }
+
+    /* Check if the A bus side of a transfer may access an address. */
+    bool DMA::reachable(uint32 addr) {
+        /* $2100-$21FF and $4200-$43FF of the system banks ($00-$3F and $80-$BF). */
+        if (addr & 0x400000) {
+            return true;
+        }
+        uint16 offset = (uint16)addr;
+        return 0x2100 != (offset & 0xFF00) && 0x4200 != (offset & 0xFE00);
+    }
+
+} /* END: Nintendo */ } /* END: Processors */ } /* END: SiNES */
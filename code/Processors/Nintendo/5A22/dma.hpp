@@ -0,0 +1,266 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#ifndef SINES_5A22_DMA_H            /* START: HEADER GUARD */
+#define SINES_5A22_DMA_H
+
+#include "xplat/types.hpp"
+#include "Processors/Nintendo/5A22/65c816.hpp"
+
+namespace SiNES { namespace Processors { namespace Nintendo {
+    /* Handlers for the B bus, the PPU, APU and WRAM ports at $2100 | port. */
+    typedef uint8 (*DMA_B_READ_FN)(void *context, uint8 port);
+    typedef void (*DMA_B_WRITE_FN)(void *context, uint8 port, uint8 value);
+
+    /* Copy a run of bytes into the ports of a transfer mode, starting at byte index of its port pattern, and
+       return the bytes taken.  A port that is not sequential in its current state (a VRAM increment that does
+       not match the pattern) takes none and the bytes go through DMA_B_WRITE_FN one at a time. */
+    typedef uint32 (*DMA_B_BULK_FN)(void *context, uint8 port, uint8 mode, uint32 index, const uint8 *data,
+                                    uint32 count);
+
+    /* Called once after a transfer that went through DMA_B_BULK_FN, to mark the written memory dirty once. */
+    typedef void (*DMA_B_DONE_FN)(void *context, uint8 port);
+
+    /* Handlers of the B bus, bulk and done may be NULL. */
+    typedef struct _DMA_B_BUS {
+        DMA_B_READ_FN   read;
+        DMA_B_WRITE_FN  write;
+        DMA_B_BULK_FN   bulk;
+        DMA_B_DONE_FN   done;
+        void           *context;    // Passed to the handlers.
+    } DMA_B_BUS;
+
+    /* DMA registers, $43x0-$43xF for channel x, and the enable registers. */
+    #define DMA_CHANNEL_COUNT           8
+    #define DMA_REG_MDMAEN              0x420B  // Starts a general purpose transfer on each set channel bit.
+    #define DMA_REG_HDMAEN              0x420C  // Enables HDMA on each set channel bit.
+    #define DMA_REG_FIRST               0x4300
+    #define DMA_REG_LAST                0x437F
+
+    /* Master cycles of the DMA clock: per byte, per channel and to start a transfer. */
+    #define DMA_BYTE_CYCLES             8
+    #define DMA_CHANNEL_CYCLES          8
+    #define DMA_START_CYCLES            8
+
+    /* Master cycles of HDMA: per line with an active channel, and to load an indirect address. */
+    #define HDMA_LINE_CYCLES            18
+    #define HDMA_INDIRECT_CYCLES        16
+
+    /* A write of an HDMA transfer to the B bus port at $2100 | port. */
+    typedef struct _HDMA_WRITE {
+        uint8   port;
+        uint8   value;
+    } HDMA_WRITE;
+
+    /* Most lines HDMA runs on in a frame, and most writes in a line (four bytes from each channel). */
+    #define HDMA_MAX_LINES              240
+    #define HDMA_MAX_WRITES             (DMA_CHANNEL_COUNT * 4)
+
+    /* Run time instrumentation counters. */
+    typedef struct _DMA_STATS {
+        uint64  transfers;  // Channel transfers run.
+        uint64  bytes;      // Bytes moved, in bulk or one at a time.
+        uint64  bulkBytes;  // Bytes moved through DMA_B_BULK_FN.
+        uint64  cycles;     // Master cycles the processor was stalled for.
+        uint64  hdmaFrames; // Frames with HDMA enabled.
+        uint64  hdmaLive;   // Frames that fell back to evaluating HDMA as the lines run.
+        uint64  hdmaSyncs;  // Replays of the read ahead lines to bring the channel registers up to date.
+    } DMA_STATS;
+
+    /**
+     * The DMA controller of the 5A22, eight channels moving bytes between the A bus (the 24 bit address space of
+     * the processor) and the B bus (the ports at $2100-$21FF).
+     *
+     * A write to MDMAEN runs the transfers of the set channels at once, lowest channel first, and stalls the
+     * processor for their master cycles: DMA_BYTE_CYCLES per byte and DMA_CHANNEL_CYCLES per channel, after the
+     * clock is aligned to a multiple of 8 and DMA_START_CYCLES.  A transfer from an incrementing A bus address
+     * into the ports is handed to DMA_B_BULK_FN one fast path page of the source at a time, the PPU copies it
+     * straight into its memory and is told once when the transfer is done.  Every other transfer moves one byte
+     * at a time through the bus handlers.
+     *
+     * HDMA reads the tables of a whole frame ahead at its start into a list of port writes per line (see
+     * hdma.cpp), and each line hands its list to the PPU as one batch.
+     */
+    class DMA {
+    public:
+        /**
+         * Constructor for the DMA controller of a processor, every channel is cleared to 0xFF.
+         *
+         * @param cpu       [IN]        The processor stalled by the transfers, whose bus is the A bus.
+         */
+        explicit DMA(W65C816 &cpu);
+
+        /**
+         * Set the handlers of the B bus.
+         *
+         * @param bus       [IN]        The handlers, copied.
+         */
+        void setBBus(const DMA_B_BUS &bus);
+
+        /**
+         * Read a DMA register.
+         *
+         * @param addr      [IN]        The register address, $4300-$437F.
+         *
+         * @return The value of the register.
+         */
+        uint8 readRegister(uint16 addr);
+
+        /**
+         * Write a DMA register, a write to MDMAEN runs the transfers.
+         *
+         * @param addr      [IN]        The register address, MDMAEN, HDMAEN or $4300-$437F.
+         * @param value     [IN]        The value written.
+         */
+        void writeRegister(uint16 addr, uint8 value);
+
+        /**
+         * Run the general purpose transfers of a set of channels and stall the processor for them.
+         *
+         * @param channels  [IN]        Bit x set to run channel x.
+         *
+         * @return The master cycles the processor was stalled for.
+         */
+        uint32 start(uint8 channels);
+
+        /**
+         * Start the HDMA of a frame: load the tables of the enabled channels and read the lines ahead.
+         *
+         * @param lines     [IN]        The lines HDMA runs on this frame, at most HDMA_MAX_LINES.
+         */
+        void hdmaFrame(uint32 lines);
+
+        /**
+         * Run the HDMA of the next line and stall the processor for it.
+         *
+         * @param writes    [OUT]       The writes of the line to the B bus, valid until the next call.
+         *
+         * @return The number of writes.
+         */
+        uint32 hdmaLine(const HDMA_WRITE **writes);
+
+        /**
+         * Get the instrumentation counters.
+         *
+         * @return The counters since the controller was created.
+         */
+        const DMA_STATS &getStats() const;
+
+    private:
+        /* Registers of a channel. */
+        typedef struct _CHANNEL {
+            uint8   control;    // DMAPx ($43x0)
+            #define DMA_CONTROL_MODE        0x07        // Transfer mode, the pattern of ports the bytes go to.
+            #define DMA_CONTROL_FIXED       (0x01 << 3) // The A bus address does not move.
+            #define DMA_CONTROL_DECREMENT   (0x01 << 4) // The A bus address counts down.
+            #define DMA_CONTROL_INDIRECT    (0x01 << 6) // HDMA tables hold pointers to the data.
+            #define DMA_CONTROL_B_TO_A      (0x01 << 7) // Bytes move from the B bus to the A bus.
+            uint8   port;       // BBADx ($43x1), the B bus address is $2100 | port.
+            uint16  addr;       // A1Tx ($43x2-$43x3), the A bus address in its bank.
+            uint8   bank;       // A1Bx ($43x4)
+            uint16  count;      // DASx ($43x5-$43x6), the byte count (0 for 65536), the HDMA indirect address.
+            uint8   indirectBank; // DASBx ($43x7)
+            uint16  tableAddr;  // A2Ax ($43x8-$43x9), the HDMA table address.
+            uint8   lineCounter; // NLTRx ($43xA)
+            uint8   unused;     // $43xB and $43xF, plain storage.
+            bool    hdmaTransfer; // HDMA transfers on the next line.
+            bool    hdmaEnded;  // HDMA reached the end of the table or was not started this frame.
+        } CHANNEL;
+
+        /* HDMA of the current frame. */
+        typedef struct _HDMA_FRAME {
+            CHANNEL     start[DMA_CHANNEL_COUNT];   // The channels once the tables were loaded.
+            CHANNEL     end[DMA_CHANNEL_COUNT];     // The channels after the last line read ahead.
+            uint32      lines;      // Lines HDMA runs on this frame.
+            uint32      line;       // The next line.
+            bool        active;     // Lines are left to run.
+            bool        live;       // Lines are evaluated as they run, the tables could not be read ahead.
+            bool        synced;     // The registers of the enabled channels match the next line.
+            bool        readAhead;  // The tables are being read ahead.
+            bool        readFailed; // Reading ahead met memory off the fast path.
+            uint16      first[HDMA_MAX_LINES + 1];  // Index of the first write of each line.
+            uint16      cycles[HDMA_MAX_LINES];     // Stall of each line.
+            HDMA_WRITE  writes[HDMA_MAX_LINES * HDMA_MAX_WRITES];
+            HDMA_WRITE  scratch[HDMA_MAX_WRITES];   // The writes of a line evaluated as it runs.
+        } HDMA_FRAME;
+
+        CHANNEL     channels[DMA_CHANNEL_COUNT];
+        uint8       hdmaEnable; // HDMAEN
+        W65C816    &cpu;        // The processor stalled by the transfers.
+        SiNES::Memory::LongBus &aBus;   // The A bus, the bus of the processor.
+        DMA_B_BUS   bBus;
+        DMA_STATS   stats;
+        HDMA_FRAME  hdma;
+
+        /**
+         * Run the transfer of a channel.
+         *
+         * @param channel   [IN/OUT]    The channel, its address and count are left as the transfer ends.
+         *
+         * @return The number of bytes moved.
+         */
+        uint32 transfer(CHANNEL &channel);
+
+        /**
+         * Check if the A bus side of a transfer may access an address, DMA cannot reach the B bus and DMA
+         * registers through the A bus.
+         *
+         * @param addr      [IN]        The 24 bit address.
+         *
+         * @return True if the address is accessible.
+         */
+        static bool reachable(uint32 addr);
+
+        /**
+         * Read a byte of an HDMA table or its data.  While reading ahead, only fast path memory is read and
+         * writable pages are watched.
+         *
+         * @param addr      [IN]        The 24 bit address.
+         *
+         * @return The value at the address.
+         */
+        uint8 hdmaRead(uint32 addr);
+
+        /**
+         * Load the line counter of a channel, and the indirect address with it, from its table.
+         *
+         * @param channel   [IN/OUT]    The channel.
+         *
+         * @return The master cycles taken.
+         */
+        uint32 hdmaLoad(CHANNEL &channel);
+
+        /**
+         * Run one line of HDMA on a set of channels.
+         *
+         * @param set       [IN/OUT]    The channels, advanced by the line.
+         * @param writes    [OUT]       The writes to the B bus, at most HDMA_MAX_WRITES.
+         * @param count     [OUT]       The number of writes.
+         *
+         * @return The master cycles taken.
+         */
+        uint32 hdmaRun(CHANNEL *set, HDMA_WRITE *writes, uint32 &count);
+
+        /**
+         * Bring the registers of the enabled channels up to the next line by replaying the lines read ahead.
+         */
+        void hdmaSync();
+
+        /**
+         * Switch the rest of the frame to evaluating the lines as they run.
+         */
+        void hdmaGoLive();
+
+        /**
+         * Bus watch handler, the tables read ahead are about to change.
+         *
+         * @param context   [IN]        The controller.
+         * @param page      [IN]        The page being written.
+         */
+        static void watchedTable(void *context, uint16 page);
+    };
+
+} /* END: Nintendo */ } /* END: Processors */ } /* END: SiNES */
+
+#endif                              /* END: HEADER GUARD */
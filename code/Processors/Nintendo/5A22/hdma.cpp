@@ -0,0 +1,239 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+/*
+HDMA of the 5A22.
+
+hdmaFrame loads the tables of the enabled channels as the hardware does at the start of the frame, then runs
+every line of the frame ahead on a copy of the channels, recording the port writes and the stall of each line.
+hdmaLine then only hands out the list of the line, the tables are not walked while the processor runs.
+
+The lines read ahead stay exact as long as the memory they read does not change.  Every writable page read
+ahead is watched on the bus, and a write to one (a game rewriting a table in the middle of the frame) first
+replays the lines already run to bring the channel registers up to date, then switches the rest of the frame
+to evaluating each line as it runs.  The same happens for a write to the registers of an enabled channel or to
+HDMAEN, a general purpose DMA on an enabled channel, tables off the fast path (I/O, coprocessors) and B bus to
+A bus channels.  Register reads replay the lines run so far and leave the lines read ahead in place, and the last
+line leaves the registers as the read ahead ended them.
+
+A channel enabled in the middle of a frame starts with the next frame.
+*/
+
+/* Read a byte of an HDMA table or its data. */
+uint8 DMA::hdmaRead(uint32 addr)
+{
+    if (!reachable(addr)) {
+        return LONG_BUS_OPEN_BUS;
+    }
+    if (!this->hdma.readAhead) {
+        return this->aBus.read8(addr);
+    }
+    uint16 page = (uint16)((addr & LONG_BUS_ADDR_MASK) >> LONG_BUS_PAGE_SHIFT);
+    const uint8 *host = this->aBus.readPage(page);
+    if (NULL == host) {
+        this->hdma.readFailed = true;
+        return LONG_BUS_OPEN_BUS;
+    }
+    if (this->aBus.isWritable(page)) {
+        this->aBus.watch(page, LONG_BUS_WATCH_TABLES);
+    }
+    return host[addr & (LONG_BUS_PAGE_SIZE - 1)];
+}
+
+/* Load the line counter of a channel, and the indirect address with it, from its table. */
+uint32 DMA::hdmaLoad(CHANNEL &channel)
+{
+    uint32 bank = (uint32)channel.bank << 16;
+    uint32 cycles = DMA_BYTE_CYCLES;
+    channel.lineCounter = this->hdmaRead(bank | channel.tableAddr);
+    channel.tableAddr = (uint16)(channel.tableAddr + 1);
+    if ((channel.control & DMA_CONTROL_INDIRECT) && 0 != channel.lineCounter) {
+        uint8 low = this->hdmaRead(bank | channel.tableAddr);
+        uint8 high = this->hdmaRead(bank | (uint16)(channel.tableAddr + 1));
+        channel.count = (uint16)(low | (high << 8));
+        channel.tableAddr = (uint16)(channel.tableAddr + 2);
+        cycles += HDMA_INDIRECT_CYCLES;
+    }
+    channel.hdmaEnded = (0 == channel.lineCounter);
+    channel.hdmaTransfer = true;
+    return cycles;
+}
+
+/* Run one line of HDMA on a set of channels. */
+uint32 DMA::hdmaRun(CHANNEL *set, HDMA_WRITE *writes, uint32 &count)
+{
+    uint32 cycles = 0;
+    count = 0;
+    for (uint32 i = 0; i < DMA_CHANNEL_COUNT; ++i) {
+        CHANNEL &channel = set[i];
+        if (!(this->hdmaEnable & (0x01 << i)) || channel.hdmaEnded) {
+            continue;
+        }
+        if (0 == cycles) {
+            cycles = HDMA_LINE_CYCLES;
+        }
+        cycles += DMA_CHANNEL_CYCLES;
+
+        if (channel.hdmaTransfer) {
+            uint8 mode = channel.control & DMA_CONTROL_MODE;
+            bool indirect = 0 != (channel.control & DMA_CONTROL_INDIRECT);
+            for (uint32 b = 0; b < LENGTHS[mode]; ++b) {
+                uint16 &addr = indirect ? channel.count : channel.tableAddr;
+                uint32 full = ((uint32)(indirect ? channel.indirectBank : channel.bank) << 16) | addr;
+                uint8 port = (uint8)(channel.port + PATTERNS[mode][b]);
+                if (channel.control & DMA_CONTROL_B_TO_A) {
+                    uint8 value = LONG_BUS_OPEN_BUS;
+                    if (NULL != this->bBus.read) {
+                        value = this->bBus.read(this->bBus.context, port);
+                    }
+                    if (reachable(full)) {
+                        this->aBus.write8(full, value);
+                    }
+                } else {
+                    writes[count].port = port;
+                    writes[count].value = this->hdmaRead(full);
+                    ++count;
+                }
+                addr = (uint16)(addr + 1);
+            }
+            cycles += DMA_BYTE_CYCLES * LENGTHS[mode];
+        }
+
+        /* The repeat bit transfers on every line of the run, otherwise only on its first line. */
+        --channel.lineCounter;
+        channel.hdmaTransfer = 0 != (channel.lineCounter & 0x80);
+        if (0 == (channel.lineCounter & 0x7F)) {
+            cycles += this->hdmaLoad(channel);
+        }
+    }
+    return cycles;
+}
+
+/* Start the HDMA of a frame. */
+void DMA::hdmaFrame(uint32 lines)
+{
+    HDMA_FRAME &frame = this->hdma;
+    frame.lines = (lines < HDMA_MAX_LINES) ? lines : HDMA_MAX_LINES;
+    frame.line = 0;
+    frame.active = (0 != this->hdmaEnable && 0 != frame.lines);
+    frame.live = false;
+    frame.synced = true;
+    if (!frame.active) {
+        return;
+    }
+
+    /* The tables are loaded at the start of the frame as on the hardware. */
+    uint32 cycles = HDMA_LINE_CYCLES;
+    bool backwards = false;
+    for (uint32 i = 0; i < DMA_CHANNEL_COUNT; ++i) {
+        CHANNEL &channel = this->channels[i];
+        channel.hdmaEnded = true;
+        if (this->hdmaEnable & (0x01 << i)) {
+            channel.tableAddr = channel.addr;
+            cycles += DMA_CHANNEL_CYCLES + this->hdmaLoad(channel);
+            backwards = backwards || 0 != (channel.control & DMA_CONTROL_B_TO_A);
+        }
+    }
+    this->cpu.stall(cycles);
+    this->stats.cycles += cycles;
+    memcpy(frame.start, this->channels, sizeof(frame.start));
+    ++this->stats.hdmaFrames;
+
+    /* Read the lines ahead on a copy, B bus reads can only happen as the lines run. */
+    frame.readFailed = backwards;
+    if (!frame.readFailed) {
+        CHANNEL work[DMA_CHANNEL_COUNT];
+        memcpy(work, frame.start, sizeof(work));
+        frame.readAhead = true;
+        uint32 total = 0;
+        for (uint32 line = 0; line < frame.lines && !frame.readFailed; ++line) {
+            uint32 count = 0;
+            frame.first[line] = (uint16)total;
+            frame.cycles[line] = (uint16)this->hdmaRun(work, frame.writes + total, count);
+            total += count;
+        }
+        frame.first[frame.lines] = (uint16)total;
+        frame.readAhead = false;
+        memcpy(frame.end, work, sizeof(frame.end));
+    }
+    if (frame.readFailed) {
+        frame.live = true;
+        ++this->stats.hdmaLive;
+    }
+}
+
+/* Run the HDMA of the next line. */
+uint32 DMA::hdmaLine(const HDMA_WRITE **writes)
+{
+    HDMA_FRAME &frame = this->hdma;
+    *writes = frame.scratch;
+    if (!frame.active) {
+        return 0;
+    }
+
+    uint32 count = 0;
+    uint32 cycles = 0;
+    if (frame.live) {
+        cycles = this->hdmaRun(this->channels, frame.scratch, count);
+    } else {
+        *writes = frame.writes + frame.first[frame.line];
+        count = frame.first[frame.line + 1] - frame.first[frame.line];
+        cycles = frame.cycles[frame.line];
+        frame.synced = false;
+    }
+    if (++frame.line >= frame.lines) {
+        /* The registers end the frame as the lines read ahead left them, tables rewritten in V-blank need no replay. */
+        frame.active = false;
+        if (!frame.synced) {
+            for (uint32 i = 0; i < DMA_CHANNEL_COUNT; ++i) {
+                if (this->hdmaEnable & (0x01 << i)) {
+                    this->channels[i] = frame.end[i];
+                }
+            }
+            frame.synced = true;
+        }
+    }
+    this->cpu.stall(cycles);
+    this->stats.cycles += cycles;
+    return count;
+}
+
+/* Bring the registers of the enabled channels up to the next line. */
+void DMA::hdmaSync()
+{
+    HDMA_FRAME &frame = this->hdma;
+    if (frame.synced) {
+        return;
+    }
+    for (uint32 i = 0; i < DMA_CHANNEL_COUNT; ++i) {
+        if (this->hdmaEnable & (0x01 << i)) {
+            this->channels[i] = frame.start[i];
+        }
+    }
+    for (uint32 line = 0; line < frame.line; ++line) {
+        uint32 count = 0;
+        this->hdmaRun(this->channels, frame.scratch, count);
+    }
+    frame.synced = true;
+    ++this->stats.hdmaSyncs;
+}
+
+/* Switch the rest of the frame to evaluating the lines as they run. */
+void DMA::hdmaGoLive()
+{
+    this->hdmaSync();
+    if (this->hdma.active && !this->hdma.live) {
+        this->hdma.live = true;
+        ++this->stats.hdmaLive;
+    }
+}
+
+/* Bus watch handler, the tables read ahead are about to change. */
+void DMA::watchedTable(void *context, uint16 page)
+{
+    /* The handler runs before the write lands, so the replay still reads the memory the lines read. */
+    DMA *dma = (DMA *)context;
+    dma->hdmaGoLive();
+    dma->aBus.unwatch(page, LONG_BUS_WATCH_TABLES);
+}
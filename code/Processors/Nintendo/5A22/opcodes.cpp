@@ -0,0 +1,864 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#include "xplat/types.hpp"
+#include "Processors/Nintendo/5A22/65c816.hpp"
+
+/*
+FORMAT for processor operation functions.
+<mnemonic> [#1 |     #2] [N V M X D I Z C]
+Where #1 is the length in bytes, one more for a 16 bit immediate.
+Where #2 is the base duration in cycles.
+N,V,M,X,D,I,Z,C are flags that were affected by the operation.
+If the flag is marked by a "0" it is reset after instruction run.
+If the flag is marked by a "1" it is set after instruction run.
+If the flag is marked by a "-" it is unchanged.
+If the flag is marked by the corresponding symbol it is affected by the function as normal.
+
+The handlers are templates on the register widths of the mode they run in, M and X true for 8 bit registers
+and E for emulation mode, so every width test below is folded away in each instantiation.
+*/
+
+/**
+ * Mask and sign bit of a value at a width.
+ */
+#define MASK(W8) ((W8) ? 0x00FFu : 0xFFFFu)
+#define SIGN(W8) ((W8) ? 0x0080u : 0x8000u)
+
+/**
+ * Address of a byte in the program bank.
+ */
+#define PROGRAM(ADDR) (((uint32)this->r.pbr << 16) | (uint16)(ADDR))
+
+/**
+ * Address of a byte in the data bank, carrying into the next bank.
+ */
+#define DATA(ADDR) (((uint32)this->r.dbr << 16) + (ADDR))
+
+/**
+ * Check if two addresses lie in different pages.
+ */
+#define CROSSES(A, B) (0 != (((A) ^ (B)) & 0xFF00))
+
+/**
+ * Check if an addressing mode reads its operand from bank 0 through the direct page or the stack.
+ */
+#define BANK0(AM) (W65C816_AM_DP == (AM) || W65C816_AM_DPX == (AM) || W65C816_AM_DPY == (AM) || \
+                   W65C816_AM_SR == (AM))
+
+/**
+ * Check if an addressing mode is relative to the direct page, which costs a cycle when D is not page aligned.
+ */
+#define DIRECT(AM) (W65C816_AM_DP <= (AM) && W65C816_AM_DPILY >= (AM))
+
+/*********************************************************************************************************************\
+| Memory Access                                                                                                       |
+\*********************************************************************************************************************/
+
+/* Read a byte from the address space without timing it. */
+inline uint8 W65C816::peek8(uint32 addr)
+{
+    return this->bus.read8(addr);
+}
+
+/* Get the master cycles a memory access adds to an internal cycle. */
+inline uint8 W65C816::accessExtra(uint32 addr) const
+{
+#if W65C816_TIMING == W65C816_TIMING_ACCESS
+    uint8 extra = this->accessTime[(addr & LONG_BUS_ADDR_MASK) >> LONG_BUS_PAGE_SHIFT];
+    if (W65C816_SPEED_MIXED == extra) {
+        extra = (0x4000 == (addr & 0xFE00)) ? 6 : 0;
+    }
+    return extra;
+#else
+    (void)addr;
+    return 0;
+#endif
+}
+
+/* Read a byte from the address space. */
+inline uint8 W65C816::read8(uint32 addr)
+{
+    this->cycles += this->accessExtra(addr);
+    return this->bus.read8(addr);
+}
+
+/* Write a byte to the address space. */
+inline void W65C816::write8(uint32 addr, uint8 value)
+{
+    this->cycles += this->accessExtra(addr);
+    this->bus.write8(addr, value);
+}
+
+/* Read a little endian word from bank 0. */
+inline uint16 W65C816::read16(uint16 addr)
+{
+    return (uint16)(this->read8(addr) | (this->read8((uint16)(addr + 1)) << 8));
+}
+
+/* Fetch the op code at the PC into imm with its operand and advance the PC past it. */
+inline uint8 W65C816::fetchOp()
+{
+    uint8 op = this->peek8(PROGRAM(this->r.pc));
+    uint8 length = this->info[op].length;
+    this->imm = 0;
+    this->cycles += this->accessExtra(PROGRAM(this->r.pc));
+    for (uint32 i = 1; i < length; ++i) {
+        this->imm |= (uint32)this->peek8(PROGRAM(this->r.pc + i)) << (8 * (i - 1));
+        this->cycles += this->accessExtra(PROGRAM(this->r.pc + i));
+    }
+    this->r.pc += length;
+    return op;
+}
+
+/* Push a byte onto the stack. */
+template <bool E>
+inline void W65C816::push8(uint8 value)
+{
+    this->write8(this->r.s, value);
+    if (E) {
+        this->r.s = (uint16)(0x0100 | ((this->r.s - 1) & 0xFF));
+    } else {
+        --this->r.s;
+    }
+}
+
+/* Pull a byte from the stack. */
+template <bool E>
+inline uint8 W65C816::pull8()
+{
+    if (E) {
+        this->r.s = (uint16)(0x0100 | ((this->r.s + 1) & 0xFF));
+    } else {
+        ++this->r.s;
+    }
+    return this->read8(this->r.s);
+}
+
+/* Push a word onto the stack. */
+template <bool E>
+inline void W65C816::push16(uint16 value)
+{
+    this->push8<E>((uint8)(value >> 8));
+    this->push8<E>((uint8)value);
+}
+
+/* Pull a word from the stack. */
+template <bool E>
+inline uint16 W65C816::pull16()
+{
+    uint16 value = this->pull8<E>();
+    return (uint16)(value | (this->pull8<E>() << 8));
+}
+
+/*********************************************************************************************************************\
+| Addressing                                                                                                          |
+\*********************************************************************************************************************/
+
+/* Get the bank 0 address of a direct page offset. */
+template <bool E>
+inline uint16 W65C816::direct(uint16 offset)
+{
+    if (E && 0 == (this->r.d & 0xFF)) {
+        return (uint16)(this->r.d | (offset & 0xFF));
+    }
+    return (uint16)(this->r.d + offset);
+}
+
+/* Resolve the effective address of the executing op. */
+template <bool X, bool E, uint8 AM>
+inline uint32 W65C816::ea(bool read)
+{
+    uint32 base;
+    uint32 addr;
+    uint16 ptr;
+    if (DIRECT(AM) && 0 != (this->r.d & 0xFF)) {
+        W65C816_ADD_CYCLES(1);
+    }
+    switch (AM) {
+        case W65C816_AM_DP:
+            return this->direct<E>((uint16)this->imm);
+        case W65C816_AM_DPX:
+            return this->direct<E>((uint16)(this->imm + this->r.x));
+        case W65C816_AM_DPY:
+            return this->direct<E>((uint16)(this->imm + this->r.y));
+        case W65C816_AM_DPI:
+            ptr = (uint16)(this->read8(this->direct<E>((uint16)this->imm))
+                           | (this->read8(this->direct<E>((uint16)(this->imm + 1))) << 8));
+            return DATA(ptr);
+        case W65C816_AM_DPIX:
+            ptr = (uint16)(this->read8(this->direct<E>((uint16)(this->imm + this->r.x)))
+                           | (this->read8(this->direct<E>((uint16)(this->imm + this->r.x + 1))) << 8));
+            return DATA(ptr);
+        case W65C816_AM_DPIY:
+            ptr = (uint16)(this->read8(this->direct<E>((uint16)this->imm))
+                           | (this->read8(this->direct<E>((uint16)(this->imm + 1))) << 8));
+            base = DATA(ptr);
+            addr = (base + this->r.y) & LONG_BUS_ADDR_MASK;
+            if (X && read && CROSSES(base, addr)) {
+                W65C816_ADD_CYCLES(1);
+            }
+            return addr;
+        case W65C816_AM_DPIL:
+        case W65C816_AM_DPILY:
+            base = this->direct<false>((uint16)this->imm);
+            addr = this->read8(base) | (this->read8((uint16)(base + 1)) << 8)
+                   | (this->read8((uint16)(base + 2)) << 16);
+            return (W65C816_AM_DPILY == AM) ? (addr + this->r.y) & LONG_BUS_ADDR_MASK : addr;
+        case W65C816_AM_ABS:
+            return DATA(this->imm);
+        case W65C816_AM_ABSX:
+        case W65C816_AM_ABSY:
+            base = DATA(this->imm);
+            addr = (base + ((W65C816_AM_ABSX == AM) ? this->r.x : this->r.y)) & LONG_BUS_ADDR_MASK;
+            if (X && read && CROSSES(base, addr)) {
+                W65C816_ADD_CYCLES(1);
+            }
+            return addr;
+        case W65C816_AM_ABSL:
+            return this->imm;
+        case W65C816_AM_ABSLX:
+            return (this->imm + this->r.x) & LONG_BUS_ADDR_MASK;
+        case W65C816_AM_SR:
+            return (uint16)(this->r.s + this->imm);
+        case W65C816_AM_SRIY:
+            base = (uint16)(this->r.s + this->imm);
+            ptr = (uint16)(this->read8(base) | (this->read8((uint16)(base + 1)) << 8));
+            return (DATA(ptr) + this->r.y) & LONG_BUS_ADDR_MASK;
+        default:
+            return 0;
+    }
+}
+
+/* Get the address of the high byte of a word operand. */
+template <uint8 AM>
+inline uint32 W65C816::next(uint32 addr)
+{
+    return BANK0(AM) ? (uint16)(addr + 1) : (addr + 1) & LONG_BUS_ADDR_MASK;
+}
+
+/* Read an operand of a width. */
+template <bool W8, uint8 AM>
+inline uint16 W65C816::load(uint32 addr)
+{
+    uint16 value = this->read8(addr);
+    if (!W8) {
+        value |= this->read8(this->next<AM>(addr)) << 8;
+    }
+    return value;
+}
+
+/* Write an operand of a width. */
+template <bool W8, uint8 AM>
+inline void W65C816::store(uint32 addr, uint16 value)
+{
+    this->write8(addr, (uint8)value);
+    if (!W8) {
+        this->write8(this->next<AM>(addr), (uint8)(value >> 8));
+    }
+}
+
+/* Read the operand of the executing op. */
+template <bool W8, bool X, bool E, uint8 AM>
+inline uint16 W65C816::operand()
+{
+    if (W65C816_AM_IMM == AM) {
+        return (uint16)(this->imm & MASK(W8));
+    }
+    return this->load<W8, AM>(this->ea<X, E, AM>(true));
+}
+
+/*********************************************************************************************************************\
+| Flags and Modes                                                                                                     |
+\*********************************************************************************************************************/
+
+/* Set the N and Z flags from a value. */
+template <bool W8>
+inline void W65C816::setNZ(uint16 value)
+{
+    this->r.p = (uint8)((this->r.p & ~(W65C816_FLAG_NEGATIVE | W65C816_FLAG_ZERO))
+                        | ((value & SIGN(W8)) ? W65C816_FLAG_NEGATIVE : 0)
+                        | ((value & MASK(W8)) ? 0 : W65C816_FLAG_ZERO));
+}
+
+/* Write a register at a width. */
+template <bool W8>
+inline void W65C816::put(uint16 &reg, uint16 value)
+{
+    reg = W8 ? (uint16)((reg & 0xFF00) | (value & 0xFF)) : value;
+}
+
+/* Add to the accumulator with carry, in binary or decimal. */
+template <bool W8, bool SUB>
+inline void W65C816::add(uint16 value)
+{
+    const int32 top = W8 ? 4 : 12;         // Shift of the top digit.
+    int32 a = this->r.c & MASK(W8);
+    int32 v = (SUB ? ~value : value) & MASK(W8);
+    int32 carry = this->r.p & W65C816_FLAG_CARRY;
+    int32 res = 0;
+    if (!(this->r.p & W65C816_FLAG_DECIMAL)) {
+        res = a + v + carry;
+    } else {
+        /* Add digit by digit, each digit below the top one is adjusted as soon as it is summed. */
+        for (int32 shift = 0; shift < top; shift += 4) {
+            int32 low = (0x01 << shift) - 1;
+            res = (a & (0x0F << shift)) + (v & (0x0F << shift)) + (carry << shift) + (res & low);
+            if (SUB ? res <= ((0x10 << shift) - 1) : res > ((0x09 << shift) | low)) {
+                res += SUB ? -(0x06 << shift) : (0x06 << shift);
+            }
+            carry = res > ((0x10 << shift) - 1);
+        }
+        res = (a & (0x0F << top)) + (v & (0x0F << top)) + (carry << top) + (res & ((0x01 << top) - 1));
+    }
+
+    /* The overflow is taken before the top digit is adjusted. */
+    uint8 overflow = (~(a ^ v) & (a ^ res) & SIGN(W8)) ? W65C816_FLAG_OVERFLOW : 0;
+    if (this->r.p & W65C816_FLAG_DECIMAL) {
+        if (SUB && res <= (int32)MASK(W8)) {
+            res -= 0x06 << top;
+        } else if (!SUB && res > ((0x09 << top) | ((0x01 << top) - 1))) {
+            res += 0x06 << top;
+        }
+    }
+    this->r.p = (uint8)((this->r.p & ~(W65C816_FLAG_OVERFLOW | W65C816_FLAG_CARRY)) | overflow
+                        | ((res > (int32)MASK(W8)) ? W65C816_FLAG_CARRY : 0));
+    this->put<W8>(this->r.c, (uint16)res);
+    this->setNZ<W8>((uint16)res);
+}
+
+/* Compare a register with a value. */
+template <bool W8>
+inline void W65C816::compare(uint16 reg, uint16 value)
+{
+    int32 res = (int32)(reg & MASK(W8)) - (int32)(value & MASK(W8));
+    this->r.p = (uint8)((this->r.p & ~W65C816_FLAG_CARRY) | ((res >= 0) ? W65C816_FLAG_CARRY : 0));
+    this->setNZ<W8>((uint16)res);
+}
+
+/* Run the operation of a read-modify-write op. */
+template <bool W8, uint8 OP>
+inline uint16 W65C816::modify(uint16 value)
+{
+    uint16 carry = this->r.p & W65C816_FLAG_CARRY;
+    uint16 res;
+    switch (OP) {
+        case W65C816_RMW_ASL:
+            carry = (value & SIGN(W8)) ? W65C816_FLAG_CARRY : 0;
+            res = (uint16)(value << 1);
+            break;
+        case W65C816_RMW_ROL:
+            res = (uint16)((value << 1) | carry);
+            carry = (value & SIGN(W8)) ? W65C816_FLAG_CARRY : 0;
+            break;
+        case W65C816_RMW_LSR:
+            res = (uint16)((value & MASK(W8)) >> 1);
+            carry = value & 0x01;
+            break;
+        case W65C816_RMW_ROR:
+            res = (uint16)(((value & MASK(W8)) >> 1) | (carry ? SIGN(W8) : 0));
+            carry = value & 0x01;
+            break;
+        case W65C816_RMW_INC:
+            res = (uint16)(value + 1);
+            break;
+        case W65C816_RMW_DEC:
+            res = (uint16)(value - 1);
+            break;
+        case W65C816_RMW_TSB:
+        case W65C816_RMW_TRB:
+            this->r.p = (uint8)((this->r.p & ~W65C816_FLAG_ZERO)
+                                | ((value & this->r.c & MASK(W8)) ? 0 : W65C816_FLAG_ZERO));
+            return (W65C816_RMW_TSB == OP) ? (uint16)(value | this->r.c) : (uint16)(value & ~this->r.c);
+        default:
+            return value;
+    }
+    this->r.p = (uint8)((this->r.p & ~W65C816_FLAG_CARRY) | carry);
+    this->setNZ<W8>(res);
+    return res;
+}
+
+/* Load the P register and swap in the dispatch table of the new mode. */
+inline void W65C816::setP(uint8 value)
+{
+    if (this->r.e) {
+        value |= W65C816_FLAG_MEMORY | W65C816_FLAG_INDEX;
+    }
+    this->r.p = value;
+    if (value & W65C816_FLAG_INDEX) {
+        this->r.x &= 0x00FF;
+        this->r.y &= 0x00FF;
+    }
+    this->updateMode();
+}
+
+/* Swap in the dispatch table of the mode selected by P and E. */
+inline void W65C816::updateMode()
+{
+    uint8 mode = this->r.e ? W65C816_MODE_EMULATION
+                           : (uint8)((this->r.p & (W65C816_FLAG_MEMORY | W65C816_FLAG_INDEX)) >> 4);
+    if (mode != this->mode) {
+        this->mode = mode;
+        this->ops = MODES[mode].ops;
+        this->info = MODES[mode].info;
+        ++this->stats.modeSwitches;
+    }
+}
+
+/* Push the state and jump through an interrupt vector. */
+void W65C816::interrupt(uint16 vector, uint16 eVector, bool brk)
+{
+    if (this->r.e) {
+        this->push16<true>(this->r.pc);
+        this->push8<true>(brk ? this->r.p : (uint8)(this->r.p & ~W65C816_FLAG_INDEX));
+        vector = eVector;
+    } else {
+        this->push8<false>(this->r.pbr);
+        this->push16<false>(this->r.pc);
+        this->push8<false>(this->r.p);
+    }
+    this->r.p = (uint8)((this->r.p | W65C816_FLAG_IRQ) & ~W65C816_FLAG_DECIMAL);
+    this->r.pbr = 0x00;
+    this->r.pc = this->read16(vector);
+}
+
+/* Take a pending NMI, or an IRQ when the line is asserted and the I flag is clear. */
+bool W65C816::serviceInterrupts()
+{
+    if (this->nmiPending) {
+        this->nmiPending = false;
+        this->waiting = false;
+        this->interrupt(W65C816_VECTOR_NMI, W65C816_VECTOR_E_NMI, false);
+    } else if (this->irqLine) {
+        /* wai ends on an IRQ even while it is masked, execution then carries on after the wai. */
+        this->waiting = false;
+        if (this->r.p & W65C816_FLAG_IRQ) {
+            return false;
+        }
+        this->interrupt(W65C816_VECTOR_IRQ, W65C816_VECTOR_E_IRQ, false);
+    } else {
+        return false;
+    }
+    W65C816_ADD_CYCLES(this->r.e ? 7 : 8);
+    ++this->stats.interrupts;
+    return true;
+}
+
+/*********************************************************************************************************************\
+| Load, Store and Arithmetic Commands                                                                                 |
+\*********************************************************************************************************************/
+
+/* ora and eor adc lda cmp sbc  [2-4 |   2-7] [N V - - - - Z C] */
+template <bool M, bool X, bool E, uint8 AM, uint8 OP>
+void W65C816::alu()
+{
+    uint16 value = this->operand<M, X, E, AM>();
+    switch (OP) {
+        case W65C816_ALU_ORA:
+            this->put<M>(this->r.c, this->r.c | value);
+            this->setNZ<M>(this->r.c);
+            break;
+        case W65C816_ALU_AND:
+            this->put<M>(this->r.c, this->r.c & value);
+            this->setNZ<M>(this->r.c);
+            break;
+        case W65C816_ALU_EOR:
+            this->put<M>(this->r.c, this->r.c ^ value);
+            this->setNZ<M>(this->r.c);
+            break;
+        case W65C816_ALU_ADC:
+            this->add<M, false>(value);
+            break;
+        case W65C816_ALU_LDA:
+            this->put<M>(this->r.c, value);
+            this->setNZ<M>(value);
+            break;
+        case W65C816_ALU_CMP:
+            this->compare<M>(this->r.c, value);
+            break;
+        case W65C816_ALU_SBC:
+            this->add<M, true>(value);
+            break;
+    }
+}
+
+/* sta stx sty stz              [2-4 |   3-7] [- - - - - - - -] */
+template <bool M, bool X, bool E, uint8 AM, uint8 SRC>
+void W65C816::st()
+{
+    uint32 addr = this->ea<X, E, AM>(false);
+    switch (SRC) {
+        case W65C816_SRC_A:
+            this->store<M, AM>(addr, this->r.c);
+            break;
+        case W65C816_SRC_X:
+            this->store<X, AM>(addr, this->r.x);
+            break;
+        case W65C816_SRC_Y:
+            this->store<X, AM>(addr, this->r.y);
+            break;
+        case W65C816_SRC_Z:
+            this->store<M, AM>(addr, 0x0000);
+            break;
+    }
+}
+
+/* asl rol lsr ror inc dec tsb trb  [1-3 |   2-9] [N - - - - - Z C] */
+template <bool M, bool X, bool E, uint8 AM, uint8 OP>
+void W65C816::rmw()
+{
+    if (W65C816_AM_ACC == AM) {
+        this->put<M>(this->r.c, this->modify<M, OP>(this->r.c));
+        return;
+    }
+    uint32 addr = this->ea<X, E, AM>(false);
+    this->store<M, AM>(addr, this->modify<M, OP>(this->load<M, AM>(addr)));
+}
+
+/* bit                          [2-3 |   2-6] [N V - - - - Z -] */
+template <bool M, bool X, bool E, uint8 AM>
+void W65C816::bit()
+{
+    uint16 value = this->operand<M, X, E, AM>();
+    uint8 p = (uint8)(this->r.p & ~W65C816_FLAG_ZERO);
+    if (W65C816_AM_IMM != AM) {
+        p = (uint8)((p & ~(W65C816_FLAG_NEGATIVE | W65C816_FLAG_OVERFLOW))
+                    | ((value & SIGN(M)) ? W65C816_FLAG_NEGATIVE : 0)
+                    | ((value & (SIGN(M) >> 1)) ? W65C816_FLAG_OVERFLOW : 0));
+    }
+    this->r.p = (uint8)(p | ((value & this->r.c & MASK(M)) ? 0 : W65C816_FLAG_ZERO));
+}
+
+/* ldx ldy                      [2-3 |   2-6] [N - - - - - Z -] */
+template <bool M, bool X, bool E, uint8 AM, W65C816::REG16 REG>
+void W65C816::ld_i()
+{
+    uint16 value = this->operand<X, X, E, AM>();
+    this->put<X>(this->r.*REG, value);
+    this->setNZ<X>(value);
+}
+
+/* cpx cpy                      [2-3 |   2-5] [N - - - - - Z C] */
+template <bool M, bool X, bool E, uint8 AM, W65C816::REG16 REG>
+void W65C816::cp_i()
+{
+    this->compare<X>(this->r.*REG, this->operand<X, X, E, AM>());
+}
+
+/* inx iny                      [1  |     2] [N - - - - - Z -] */
+template <bool M, bool X, bool E, W65C816::REG16 REG>
+void W65C816::inc_i()
+{
+    this->put<X>(this->r.*REG, (uint16)(this->r.*REG + 1));
+    this->setNZ<X>(this->r.*REG);
+}
+
+/* dex dey                      [1  |     2] [N - - - - - Z -] */
+template <bool M, bool X, bool E, W65C816::REG16 REG>
+void W65C816::dec_i()
+{
+    this->put<X>(this->r.*REG, (uint16)(this->r.*REG - 1));
+    this->setNZ<X>(this->r.*REG);
+}
+
+/* tax tay txa tya txs tsx txy tyx tcd tdc tcs tsc  [1 | 2] [N - - - - - Z -] */
+template <bool M, bool X, bool E, W65C816::REG16 SRC, W65C816::REG16 DST, uint8 WIDTH>
+void W65C816::tr()
+{
+    const bool W8 = (W65C816_WIDTH_M == WIDTH) ? M : (W65C816_WIDTH_X == WIDTH) ? X : false;
+    uint16 value = this->r.*SRC;
+    this->put<W8>(this->r.*DST, value);
+    if (&_REGISTERS::s != DST) {
+        this->setNZ<W8>(value);
+    } else if (E) {
+        this->r.s = (uint16)(0x0100 | (this->r.s & 0xFF));
+    }
+}
+
+/* xba                          [1  |     3] [N - - - - - Z -] */
+template <bool M, bool X, bool E>
+void W65C816::xba()
+{
+    this->r.c = (uint16)((this->r.c >> 8) | (this->r.c << 8));
+    this->setNZ<true>((uint8)this->r.c);
+}
+
+/*********************************************************************************************************************\
+| Jump and Call Commands                                                                                              |
+\*********************************************************************************************************************/
+
+/* bpl bmi bvc bvs bcc bcs bne beq bra  [2 | 2/3/4] [- - - - - - - -] */
+template <bool M, bool X, bool E, uint8 FLAG, bool SET>
+void W65C816::branch()
+{
+    if ((0 != (this->r.p & FLAG)) == SET) {
+        uint16 target = (uint16)(this->r.pc + (int8)this->imm);
+        W65C816_ADD_CYCLES((E && CROSSES(target, this->r.pc)) ? 2 : 1);
+        this->r.pc = target;
+    }
+}
+
+/* brl                          [3  |     4] [- - - - - - - -] */
+template <bool M, bool X, bool E>
+void W65C816::brl()
+{
+    this->r.pc = (uint16)(this->r.pc + this->imm);
+}
+
+/* jmp a                        [3  |     3] [- - - - - - - -] */
+template <bool M, bool X, bool E>
+void W65C816::jmp_a()
+{
+    this->r.pc = (uint16)this->imm;
+}
+
+/* jmp al                       [4  |     4] [- - - - - - - -] */
+template <bool M, bool X, bool E>
+void W65C816::jmp_al()
+{
+    this->r.pc = (uint16)this->imm;
+    this->r.pbr = (uint8)(this->imm >> 16);
+}
+
+/* jmp (a)                      [3  |     5] [- - - - - - - -] */
+template <bool M, bool X, bool E>
+void W65C816::jmp_ai()
+{
+    this->r.pc = this->read16((uint16)this->imm);
+}
+
+/* jmp (a,x)                    [3  |     6] [- - - - - - - -] */
+template <bool M, bool X, bool E>
+void W65C816::jmp_aix()
+{
+    uint16 ptr = (uint16)(this->imm + this->r.x);
+    this->r.pc = (uint16)(this->read8(PROGRAM(ptr)) | (this->read8(PROGRAM(ptr + 1)) << 8));
+}
+
+/* jmp [a]                      [3  |     6] [- - - - - - - -] */
+template <bool M, bool X, bool E>
+void W65C816::jmp_ail()
+{
+    uint16 ptr = (uint16)this->imm;
+    this->r.pc = this->read16(ptr);
+    this->r.pbr = this->read8((uint16)(ptr + 2));
+}
+
+/* jsr a                        [3  |     6] [- - - - - - - -] */
+template <bool M, bool X, bool E>
+void W65C816::jsr_a()
+{
+    this->push16<E>((uint16)(this->r.pc - 1));
+    this->r.pc = (uint16)this->imm;
+}
+
+/* jsr (a,x)                    [3  |     8] [- - - - - - - -] */
+template <bool M, bool X, bool E>
+void W65C816::jsr_aix()
+{
+    uint16 ptr = (uint16)(this->imm + this->r.x);
+    this->push16<E>((uint16)(this->r.pc - 1));
+    this->r.pc = (uint16)(this->read8(PROGRAM(ptr)) | (this->read8(PROGRAM(ptr + 1)) << 8));
+}
+
+/* jsl al                       [4  |     8] [- - - - - - - -] */
+template <bool M, bool X, bool E>
+void W65C816::jsl()
+{
+    this->push8<E>(this->r.pbr);
+    this->push16<E>((uint16)(this->r.pc - 1));
+    this->r.pc = (uint16)this->imm;
+    this->r.pbr = (uint8)(this->imm >> 16);
+}
+
+/* rts                          [1  |     6] [- - - - - - - -] */
+template <bool M, bool X, bool E>
+void W65C816::rts()
+{
+    this->r.pc = (uint16)(this->pull16<E>() + 1);
+}
+
+/* rtl                          [1  |     6] [- - - - - - - -] */
+template <bool M, bool X, bool E>
+void W65C816::rtl()
+{
+    this->r.pc = (uint16)(this->pull16<E>() + 1);
+    this->r.pbr = this->pull8<E>();
+}
+
+/* rti                          [1  |   6-7] [N V M X D I Z C] */
+template <bool M, bool X, bool E>
+void W65C816::rti()
+{
+    this->setP(this->pull8<E>());
+    this->r.pc = this->pull16<E>();
+    if (!E) {
+        this->r.pbr = this->pull8<E>();
+    }
+}
+
+/* brk                          [2  |   7-8] [- - - - 0 1 - -] */
+template <bool M, bool X, bool E>
+void W65C816::brk()
+{
+    this->interrupt(W65C816_VECTOR_BRK, W65C816_VECTOR_E_IRQ, true);
+}
+
+/* cop                          [2  |   7-8] [- - - - 0 1 - -] */
+template <bool M, bool X, bool E>
+void W65C816::cop()
+{
+    this->interrupt(W65C816_VECTOR_COP, W65C816_VECTOR_E_COP, true);
+}
+
+/*********************************************************************************************************************\
+| Flag and Mode Commands                                                                                              |
+\*********************************************************************************************************************/
+
+/* clc sec cli sei clv cld sed  [1  |     2] [- V - - D I - C] */
+template <bool M, bool X, bool E, uint8 FLAG, bool SET>
+void W65C816::flag()
+{
+    this->r.p = (uint8)(SET ? (this->r.p | FLAG) : (this->r.p & ~FLAG));
+}
+
+/* rep                          [2  |     3] [N V M X D I Z C] */
+template <bool M, bool X, bool E>
+void W65C816::rep()
+{
+    this->setP((uint8)(this->r.p & ~this->imm));
+}
+
+/* sep                          [2  |     3] [N V M X D I Z C] */
+template <bool M, bool X, bool E>
+void W65C816::sep()
+{
+    this->setP((uint8)(this->r.p | this->imm));
+}
+
+/* xce                          [1  |     2] [- - M X - - - C] */
+template <bool M, bool X, bool E>
+void W65C816::xce()
+{
+    bool carry = 0 != (this->r.p & W65C816_FLAG_CARRY);
+    this->r.p = (uint8)((this->r.p & ~W65C816_FLAG_CARRY) | (E ? W65C816_FLAG_CARRY : 0));
+    this->r.e = carry;
+    if (carry) {
+        this->r.s = (uint16)(0x0100 | (this->r.s & 0xFF));
+    }
+    this->setP(this->r.p);
+}
+
+/*********************************************************************************************************************\
+| Stack Commands                                                                                                      |
+\*********************************************************************************************************************/
+
+/* pha phx phy phd              [1  |   3-4] [- - - - - - - -] */
+template <bool M, bool X, bool E, W65C816::REG16 REG, uint8 WIDTH>
+void W65C816::push_r()
+{
+    const bool W8 = (W65C816_WIDTH_M == WIDTH) ? M : (W65C816_WIDTH_X == WIDTH) ? X : false;
+    if (W8) {
+        this->push8<E>((uint8)(this->r.*REG));
+    } else {
+        this->push16<E>(this->r.*REG);
+    }
+}
+
+/* pla plx ply pld              [1  |   4-5] [N - - - - - Z -] */
+template <bool M, bool X, bool E, W65C816::REG16 REG, uint8 WIDTH>
+void W65C816::pull_r()
+{
+    const bool W8 = (W65C816_WIDTH_M == WIDTH) ? M : (W65C816_WIDTH_X == WIDTH) ? X : false;
+    uint16 value = W8 ? this->pull8<E>() : this->pull16<E>();
+    this->put<W8>(this->r.*REG, value);
+    this->setNZ<W8>(value);
+}
+
+/* phb phk php                  [1  |     3] [- - - - - - - -] */
+template <bool M, bool X, bool E, W65C816::REG8 REG>
+void W65C816::push_r8()
+{
+    this->push8<E>(this->r.*REG);
+}
+
+/* plb                          [1  |     4] [N - - - - - Z -] */
+template <bool M, bool X, bool E>
+void W65C816::plb()
+{
+    this->r.dbr = this->pull8<E>();
+    this->setNZ<true>(this->r.dbr);
+}
+
+/* plp                          [1  |     4] [N V M X D I Z C] */
+template <bool M, bool X, bool E>
+void W65C816::plp()
+{
+    this->setP(this->pull8<E>());
+}
+
+/* pea a                        [3  |     5] [- - - - - - - -] */
+template <bool M, bool X, bool E>
+void W65C816::pea()
+{
+    this->push16<E>((uint16)this->imm);
+}
+
+/* pei (d)                      [2  |     6] [- - - - - - - -] */
+template <bool M, bool X, bool E>
+void W65C816::pei()
+{
+    if (0 != (this->r.d & 0xFF)) {
+        W65C816_ADD_CYCLES(1);
+    }
+    uint16 value = (uint16)(this->read8(this->direct<E>((uint16)this->imm))
+                            | (this->read8(this->direct<E>((uint16)(this->imm + 1))) << 8));
+    this->push16<E>(value);
+}
+
+/* per rl                       [3  |     6] [- - - - - - - -] */
+template <bool M, bool X, bool E>
+void W65C816::per()
+{
+    this->push16<E>((uint16)(this->r.pc + this->imm));
+}
+
+/*********************************************************************************************************************\
+| Misceleanous Commands                                                                                               |
+\*********************************************************************************************************************/
+
+/* mvp mvn                      [3  |     7] [- - - - - - - -] */
+template <bool M, bool X, bool E, bool DOWN>
+void W65C816::move()
+{
+    uint8 dst = (uint8)this->imm;
+    uint8 src = (uint8)(this->imm >> 8);
+    this->r.dbr = dst;
+    this->write8(((uint32)dst << 16) | this->r.y, this->read8(((uint32)src << 16) | this->r.x));
+    this->put<X>(this->r.x, (uint16)(DOWN ? this->r.x - 1 : this->r.x + 1));
+    this->put<X>(this->r.y, (uint16)(DOWN ? this->r.y - 1 : this->r.y + 1));
+    if (0xFFFF != --this->r.c) {
+        this->r.pc -= 3;
+    }
+}
+
+/* nop wdm                      [1-2 |    2] [- - - - - - - -] */
+template <bool M, bool X, bool E>
+void W65C816::nop()
+{
+}
+
+/* wai                          [1  |     3] [- - - - - - - -] */
+template <bool M, bool X, bool E>
+void W65C816::wai()
+{
+    this->waiting = true;
+}
+
+/* stp                          [1  |     3] [- - - - - - - -] */
+template <bool M, bool X, bool E>
+void W65C816::stp()
+{
+    this->stopped = true;
+}
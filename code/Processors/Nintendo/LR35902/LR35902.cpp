@@ -1,521 +1,588 @@
-#include "Processors/Nintendo/LR35902/LR35902.hpp"
-
-namespace SiNES { namespace Processors { namespace Nintendo {
-    #include "opcodes.cpp"
-
-    /* Execute an operation in the processor. */
-    void LR35902::execOp() {
-        // @TODO read value from stack.
-        uint8 op = 0x00;
-        switch (op) {
-            case 0x00: return this->nop();
-            case 0x01: return this->ld_rr_nn(this->r.b, this->r.c);
-            case 0x02: return this->ld_rr_a(this->r.b, this->r.c);
-            case 0x03: return this->inc_rr(this->r.b, this->r.c);
-            case 0x04: return this->inc_r(this->r.b);
-            case 0x05: return this->dec_r(this->r.b);
-            case 0x06: return this->ld_r_n(this->r.b);
-            case 0x07: return this->rlca();
-            case 0x08: return this->ld_nn_sp();
-            case 0x09: return this->add_hl_rr(this->r.b, this->r.c);
-            case 0x0A: return this->ld_a_rr(this->r.b, this->r.c);
-            case 0x0B: return this->dec_rr(this->r.b, this->r.c);
-            case 0x0C: return this->inc_r(this->r.c);
-            case 0x0D: return this->dec_r(this->r.c);
-            case 0x0E: return this->ld_r_n(this->r.c);
-            case 0x0F: return this->rrca();
-            case 0x10: return this->stop();
-            case 0x11: return this->ld_rr_nn(this->r.d, this->r.e);
-            case 0x12: return this->ld_rr_a(this->r.d, this->r.e);
-            case 0x13: return this->inc_rr(this->r.d, this->r.e);
-            case 0x14: return this->inc_r(this->r.d);
-            case 0x15: return this->dec_r(this->r.d);
-            case 0x16: return this->ld_r_n(this->r.d);
-            case 0x17: return this->rla();
-            case 0x18: return this->jr_n();
-            case 0x19: return this->add_hl_rr(this->r.d, this->r.e);
-            case 0x1A: return this->ld_a_rr(this->r.d, this->r.e);
-            case 0x1B: return this->dec_rr(this->r.d, this->r.e);
-            case 0x1C: return this->inc_r(this->r.e);
-            case 0x1D: return this->dec_r(this->r.e);
-            case 0x1E: return this->ld_r_n(this->r.e);
-            case 0x1F: return this->rra();
-            case 0x20: return this->jr_cc_n(false, LR35902_FLAG_ZERO);
-            case 0x21: return this->ld_rr_nn(this->r.h, this->r.l);
-            case 0x22: return this->ldi_hl_a();
-            case 0x23: return this->inc_rr(this->r.h, this->r.l);
-            case 0x24: return this->inc_r(this->r.h);
-            case 0x25: return this->dec_r(this->r.h);
-            case 0x26: return this->ld_r_n(this->r.h);
-            case 0x27: return this->daa();
-            case 0x28: return this->jr_cc_n(true, LR35902_FLAG_ZERO);
-            case 0x29: return this->add_hl_rr(this->r.h, this->r.l);
-            case 0x2A: return this->ldi_a_hl();
-            case 0x2B: return this->dec_rr(this->r.h, this->r.l);
-            case 0x2C: return this->inc_r(this->r.l);
-            case 0x2D: return this->dec_r(this->r.l);
-            case 0x2E: return this->ld_r_n(this->r.l);
-            case 0x2F: return this->cpl();
-            case 0x30: return this->jr_cc_n(false, LR35902_FLAG_CARRY);
-            case 0x31: return this->ld_rr_nn(this->r.sp);
-            case 0x32: return this->ldd_hl_a();
-            case 0x33: return this->inc_rr(this->r.sp);
-            case 0x34: return this->inc_hl();
-            case 0x35: return this->dec_hl();
-            case 0x36: return this->ld_hl_n();
-            case 0x37: return this->scf();
-            case 0x38: return this->jr_cc_n(true, LR35902_FLAG_CARRY);
-            case 0x39: return this->add_hl_rr(this->r.sp);
-            case 0x3A: return this->ldd_a_hl();
-            case 0x3B: return this->dec_rr(this->r.sp);
-            case 0x3C: return this->inc_r(this->r.a);
-            case 0x3D: return this->dec_r(this->r.a);
-            case 0x3E: return this->ld_r_n(this->r.a);
-            case 0x3F: return this->ccf();
-            case 0x40: return this->ld_r_r(this->r.b, this->r.b);
-            case 0x41: return this->ld_r_r(this->r.b, this->r.c);
-            case 0x42: return this->ld_r_r(this->r.b, this->r.d);
-            case 0x43: return this->ld_r_r(this->r.b, this->r.e);
-            case 0x44: return this->ld_r_r(this->r.b, this->r.h);
-            case 0x45: return this->ld_r_r(this->r.b, this->r.l);
-            case 0x46: return this->ld_r_hl(this->r.b);
-            case 0x47: return this->ld_r_r(this->r.b, this->r.a);
-            case 0x48: return this->ld_r_r(this->r.c, this->r.b);
-            case 0x49: return this->ld_r_r(this->r.c, this->r.c);
-            case 0x4A: return this->ld_r_r(this->r.c, this->r.d);
-            case 0x4B: return this->ld_r_r(this->r.c, this->r.e);
-            case 0x4C: return this->ld_r_r(this->r.c, this->r.h);
-            case 0x4D: return this->ld_r_r(this->r.c, this->r.l);
-            case 0x4E: return this->ld_r_hl(this->r.c);
-            case 0x4F: return this->ld_r_r(this->r.c, this->r.a);
-            case 0x50: return this->ld_r_r(this->r.d, this->r.b);
-            case 0x51: return this->ld_r_r(this->r.d, this->r.c);
-            case 0x52: return this->ld_r_r(this->r.d, this->r.d);
-            case 0x53: return this->ld_r_r(this->r.d, this->r.e);
-            case 0x54: return this->ld_r_r(this->r.d, this->r.h);
-            case 0x55: return this->ld_r_r(this->r.d, this->r.l);
-            case 0x56: return this->ld_r_hl(this->r.d);
-            case 0x57: return this->ld_r_r(this->r.d, this->r.a);
-            case 0x58: return this->ld_r_r(this->r.e, this->r.b);
-            case 0x59: return this->ld_r_r(this->r.e, this->r.c);
-            case 0x5A: return this->ld_r_r(this->r.e, this->r.d);
-            case 0x5B: return this->ld_r_r(this->r.e, this->r.e);
-            case 0x5C: return this->ld_r_r(this->r.e, this->r.h);
-            case 0x5D: return this->ld_r_r(this->r.e, this->r.l);
-            case 0x5E: return this->ld_r_hl(this->r.e);
-            case 0x5F: return this->ld_r_r(this->r.e, this->r.a);
-            case 0x60: return this->ld_r_r(this->r.h, this->r.b);
-            case 0x61: return this->ld_r_r(this->r.h, this->r.c);
-            case 0x62: return this->ld_r_r(this->r.h, this->r.d);
-            case 0x63: return this->ld_r_r(this->r.h, this->r.e);
-            case 0x64: return this->ld_r_r(this->r.h, this->r.h);
-            case 0x65: return this->ld_r_r(this->r.h, this->r.l);
-            case 0x66: return this->ld_r_hl(this->r.h);
-            case 0x67: return this->ld_r_r(this->r.h, this->r.a);
-            case 0x68: return this->ld_r_r(this->r.l, this->r.b);
-            case 0x69: return this->ld_r_r(this->r.l, this->r.c);
-            case 0x6A: return this->ld_r_r(this->r.l, this->r.d);
-            case 0x6B: return this->ld_r_r(this->r.l, this->r.e);
-            case 0x6C: return this->ld_r_r(this->r.l, this->r.h);
-            case 0x6D: return this->ld_r_r(this->r.l, this->r.l);
-            case 0x6E: return this->ld_r_hl(this->r.l);
-            case 0x6F: return this->ld_r_r(this->r.l, this->r.a);
-            case 0x70: return this->ld_hl_r(this->r.b);
-            case 0x71: return this->ld_hl_r(this->r.c);
-            case 0x72: return this->ld_hl_r(this->r.d);
-            case 0x73: return this->ld_hl_r(this->r.e);
-            case 0x74: return this->ld_hl_r(this->r.h);
-            case 0x75: return this->ld_hl_r(this->r.l);
-            case 0x76: return this->halt();
-            case 0x77: return this->ld_hl_r(this->r.a);
-            case 0x78: return this->ld_r_r(this->r.a, this->r.b);
-            case 0x79: return this->ld_r_r(this->r.a, this->r.c);
-            case 0x7A: return this->ld_r_r(this->r.a, this->r.d);
-            case 0x7B: return this->ld_r_r(this->r.a, this->r.e);
-            case 0x7C: return this->ld_r_r(this->r.a, this->r.h);
-            case 0x7D: return this->ld_r_r(this->r.a, this->r.l);
-            case 0x7E: return this->ld_r_hl(this->r.a);
-            case 0x7F: return this->ld_r_r(this->r.a, this->r.a);
-            case 0x80: return this->add_a_r(this->r.b);
-            case 0x81: return this->add_a_r(this->r.c);
-            case 0x82: return this->add_a_r(this->r.d);
-            case 0x83: return this->add_a_r(this->r.e);
-            case 0x84: return this->add_a_r(this->r.h);
-            case 0x85: return this->add_a_r(this->r.l);
-            case 0x86: return this->add_a_hl();
-            case 0x87: return this->add_a_r(this->r.a);
-            case 0x88: return this->adc_a_r(this->r.b);
-            case 0x89: return this->adc_a_r(this->r.c);
-            case 0x8A: return this->adc_a_r(this->r.d);
-            case 0x8B: return this->adc_a_r(this->r.e);
-            case 0x8C: return this->adc_a_r(this->r.h);
-            case 0x8D: return this->adc_a_r(this->r.l);
-            case 0x8E: return this->adc_a_hl();
-            case 0x8F: return this->adc_a_r(this->r.a);
-            case 0x90: return this->sub_a_r(this->r.b);
-            case 0x91: return this->sub_a_r(this->r.c);
-            case 0x92: return this->sub_a_r(this->r.d);
-            case 0x93: return this->sub_a_r(this->r.e);
-            case 0x94: return this->sub_a_r(this->r.h);
-            case 0x95: return this->sub_a_r(this->r.l);
-            case 0x96: return this->sub_a_hl();
-            case 0x97: return this->sub_a_r(this->r.a);
-            case 0x98: return this->sub_a_r(this->r.b);
-            case 0x99: return this->sbc_a_r(this->r.c);
-            case 0x9A: return this->sbc_a_r(this->r.d);
-            case 0x9B: return this->sbc_a_r(this->r.e);
-            case 0x9C: return this->sbc_a_r(this->r.h);
-            case 0x9D: return this->sbc_a_r(this->r.l);
-            case 0x9E: return this->sbc_a_hl();
-            case 0x9F: return this->sbc_a_r(this->r.a);
-            case 0xA0: return this->and_a_r(this->r.b);
-            case 0xA1: return this->and_a_r(this->r.c);
-            case 0xA2: return this->and_a_r(this->r.d);
-            case 0xA3: return this->and_a_r(this->r.e);
-            case 0xA4: return this->and_a_r(this->r.h);
-            case 0xA5: return this->and_a_r(this->r.l);
-            case 0xA6: return this->and_a_hl();
-            case 0xA7: return this->and_a_r(this->r.a);
-            case 0xA8: return this->and_a_r(this->r.b);
-            case 0xA9: return this->xor_a_r(this->r.c);
-            case 0xAA: return this->xor_a_r(this->r.d);
-            case 0xAB: return this->xor_a_r(this->r.e);
-            case 0xAC: return this->xor_a_r(this->r.h);
-            case 0xAD: return this->xor_a_r(this->r.l);
-            case 0xAE: return this->xor_a_hl();
-            case 0xAF: return this->xor_a_r(this->r.a);
-            case 0xB0: return this->or_a_r(this->r.b);
-            case 0xB1: return this->or_a_r(this->r.c);
-            case 0xB2: return this->or_a_r(this->r.d);
-            case 0xB3: return this->or_a_r(this->r.e);
-            case 0xB4: return this->or_a_r(this->r.h);
-            case 0xB5: return this->or_a_r(this->r.l);
-            case 0xB6: return this->or_a_hl();
-            case 0xB7: return this->or_a_r(this->r.a);
-            case 0xB8: return this->or_a_r(this->r.b);
-            case 0xB9: return this->cp_a_r(this->r.c);
-            case 0xBA: return this->cp_a_r(this->r.d);
-            case 0xBB: return this->cp_a_r(this->r.e);
-            case 0xBC: return this->cp_a_r(this->r.h);
-            case 0xBD: return this->cp_a_r(this->r.l);
-            case 0xBE: return this->cp_a_hl();
-            case 0xBF: return this->cp_a_r(this->r.a);
-            case 0xC0: return this->ret_cc(false, LR35902_FLAG_ZERO);
-            case 0xC1: return this->pop_rr(this->r.b, this->r.c);
-            case 0xC2: return this->jp_cc_nn(false, LR35902_FLAG_ZERO);
-            case 0xC3: return this->jp_nn();
-            case 0xC4: return this->call_cc_nn(false, LR35902_FLAG_ZERO);
-            case 0xC5: return this->push_rr(this->r.b, this->r.c);
-            case 0xC6: return this->add_a_n();
-            case 0xC7: return this->rst_n(0x00);
-            case 0xC8: return this->ret_cc(true, LR35902_FLAG_ZERO);
-            case 0xC9: return this->ret();
-            case 0xCA: return this->jp_cc_nn(true, LR35902_FLAG_ZERO);
-            case 0xCB: goto CB_OPS;
-            case 0xCC: return this->call_cc_nn(true, LR35902_FLAG_ZERO);
-            case 0xCD: return this->call_nn();
-            case 0xCE: return this->adc_a_n();
-            case 0xCF: return this->rst_n(0x08);
-            case 0xD0: return this->ret_cc(false, LR35902_FLAG_CARRY);
-            case 0xD1: return this->pop_rr(this->r.d, this->r.e);
-            case 0xD2: return this->jp_cc_nn(false, LR35902_FLAG_CARRY);
-            case 0xD4: return this->call_cc_nn(false, LR35902_FLAG_CARRY);
-            case 0xD5: return this->push_rr(this->r.d, this->r.e);
-            case 0xD6: return this->sub_a_n();
-            case 0xD7: return this->rst_n(0x10);
-            case 0xD8: return this->ret_cc(true, LR35902_FLAG_CARRY);
-            case 0xD9: return this->reti();
-            case 0xDA: return this->jp_cc_nn(true, LR35902_FLAG_CARRY);
-            case 0xDC: return this->call_cc_nn(true, LR35902_FLAG_CARRY);
-            case 0xDE: return this->sbc_a_n();
-            case 0xDF: return this->rst_n(0x18);
-            case 0xE0: return this->ldh_n_a();
-            case 0xE1: return this->pop_rr(this->r.h, this->r.l);
-            case 0xE2: return this->ld_c_a();
-            case 0xE5: return this->push_rr(this->r.h, this->r.l);
-            case 0xE6: return this->and_a_n();
-            case 0xE7: return this->rst_n(0x20);
-            case 0xE8: return this->jp_hl();
-            case 0xE9: return this->add_sp_n();
-            case 0xEA: return this->ld_nn_a();
-            case 0xEE: return this->xor_a_n();
-            case 0xEF: return this->rst_n(0x28);
-            case 0xF0: return this->ldh_a_n();
-            case 0xF1: return this->pop_rr(this->r.a, this->r.f);
-            case 0xF2: return this->ld_a_c();
-            case 0xF3: return this->di();
-            case 0xF5: return this->push_rr(this->r.a, this->r.f);
-            case 0xF6: return this->or_a_n();
-            case 0xF7: return this->rst_n(0x30);
-            case 0xF8: return this->ldhl_sp_n();
-            case 0xF9: return this->ld_sp_hl();
-            case 0xFA: return this->ld_a_nn();
-            case 0xFB: return this->ei();
-            case 0xFE: return this->cp_a_n();
-            case 0xFF: return this->rst_n(0x38);
-            default: return this->INVALID_OP();
-        }
-
-CB_OPS:
-        op = 0x00; // @TODO read next op & update timer
-        switch (op) {
-            case 0x00: return this->rlc_r(this->r.b);
-            case 0x01: return this->rlc_r(this->r.c);
-            case 0x02: return this->rlc_r(this->r.d);
-            case 0x03: return this->rlc_r(this->r.e);
-            case 0x04: return this->rlc_r(this->r.h);
-            case 0x05: return this->rlc_r(this->r.l);
-            case 0x06: return this->rlc_hl();
-            case 0x07: return this->rlc_r(this->r.a);
-            case 0x08: return this->rrc_r(this->r.b);
-            case 0x09: return this->rrc_r(this->r.c);
-            case 0x0A: return this->rrc_r(this->r.d);
-            case 0x0B: return this->rrc_r(this->r.e);
-            case 0x0C: return this->rrc_r(this->r.h);
-            case 0x0D: return this->rrc_r(this->r.l);
-            case 0x0E: return this->rrc_hl();
-            case 0x0F: return this->rrc_r(this->r.a);
-            case 0x10: return this->rl_r(this->r.b);
-            case 0x11: return this->rl_r(this->r.c);
-            case 0x12: return this->rl_r(this->r.d);
-            case 0x13: return this->rl_r(this->r.e);
-            case 0x14: return this->rl_r(this->r.h);
-            case 0x15: return this->rl_r(this->r.l);
-            case 0x16: return this->rl_hl();
-            case 0x17: return this->rl_r(this->r.a);
-            case 0x18: return this->rr_r(this->r.b);
-            case 0x19: return this->rr_r(this->r.c);
-            case 0x1A: return this->rr_r(this->r.d);
-            case 0x1B: return this->rr_r(this->r.e);
-            case 0x1C: return this->rr_r(this->r.h);
-            case 0x1D: return this->rr_r(this->r.l);
-            case 0x1E: return this->rr_hl();
-            case 0x1F: return this->rr_r(this->r.a);
-            case 0x20: return this->sla_r(this->r.b);
-            case 0x21: return this->sla_r(this->r.c);
-            case 0x22: return this->sla_r(this->r.d);
-            case 0x23: return this->sla_r(this->r.e);
-            case 0x24: return this->sla_r(this->r.h);
-            case 0x25: return this->sla_r(this->r.l);
-            case 0x26: return this->sla_hl();
-            case 0x27: return this->sla_r(this->r.a);
-            case 0x28: return this->sra_r(this->r.b);
-            case 0x29: return this->sra_r(this->r.c);
-            case 0x2A: return this->sra_r(this->r.d);
-            case 0x2B: return this->sra_r(this->r.e);
-            case 0x2C: return this->sra_r(this->r.h);
-            case 0x2D: return this->sra_r(this->r.l);
-            case 0x2E: return this->sra_hl();
-            case 0x2F: return this->sra_r(this->r.a);
-            case 0x30: return this->swap_r(this->r.b);
-            case 0x31: return this->swap_r(this->r.c);
-            case 0x32: return this->swap_r(this->r.d);
-            case 0x33: return this->swap_r(this->r.e);
-            case 0x34: return this->swap_r(this->r.h);
-            case 0x35: return this->swap_r(this->r.l);
-            case 0x36: return this->swap_hl();
-            case 0x37: return this->swap_r(this->r.a);
-            case 0x38: return this->srl_r(this->r.b);
-            case 0x39: return this->srl_r(this->r.c);
-            case 0x3A: return this->srl_r(this->r.d);
-            case 0x3B: return this->srl_r(this->r.e);
-            case 0x3C: return this->srl_r(this->r.h);
-            case 0x3D: return this->srl_r(this->r.l);
-            case 0x3E: return this->srl_hl();
-            case 0x3F: return this->srl_r(this->r.a);
-            case 0x40: return this->bit_b_r(0x00, this->r.b);
-            case 0x41: return this->bit_b_r(0x00, this->r.c);
-            case 0x42: return this->bit_b_r(0x00, this->r.d);
-            case 0x43: return this->bit_b_r(0x00, this->r.e);
-            case 0x44: return this->bit_b_r(0x00, this->r.h);
-            case 0x45: return this->bit_b_r(0x00, this->r.l);
-            case 0x46: return this->bit_b_hl(0x00);
-            case 0x47: return this->bit_b_r(0x00, this->r.a);
-            case 0x48: return this->bit_b_r(0x01, this->r.b);
-            case 0x49: return this->bit_b_r(0x01, this->r.c);
-            case 0x4A: return this->bit_b_r(0x01, this->r.d);
-            case 0x4B: return this->bit_b_r(0x01, this->r.e);
-            case 0x4C: return this->bit_b_r(0x01, this->r.h);
-            case 0x4D: return this->bit_b_r(0x01, this->r.l);
-            case 0x4E: return this->bit_b_hl(0x01);
-            case 0x4F: return this->bit_b_r(0x1, this->r.a);
-            case 0x50: return this->bit_b_r(0x2, this->r.b);
-            case 0x51: return this->bit_b_r(0x2, this->r.c);
-            case 0x52: return this->bit_b_r(0x2, this->r.d);
-            case 0x53: return this->bit_b_r(0x2, this->r.e);
-            case 0x54: return this->bit_b_r(0x2, this->r.h);
-            case 0x55: return this->bit_b_r(0x2, this->r.l);
-            case 0x56: return this->bit_b_hl(0x02);
-            case 0x57: return this->bit_b_r(0x02, this->r.a);
-            case 0x58: return this->bit_b_r(0x03, this->r.b);
-            case 0x59: return this->bit_b_r(0x03, this->r.c);
-            case 0x5A: return this->bit_b_r(0x03, this->r.d);
-            case 0x5B: return this->bit_b_r(0x03, this->r.e);
-            case 0x5C: return this->bit_b_r(0x03, this->r.h);
-            case 0x5D: return this->bit_b_r(0x03, this->r.l);
-            case 0x5E: return this->bit_b_hl(0x03);
-            case 0x5F: return this->bit_b_r(0x03, this->r.a);
-            case 0x60: return this->bit_b_r(0x04, this->r.b);
-            case 0x61: return this->bit_b_r(0x04, this->r.c);
-            case 0x62: return this->bit_b_r(0x04, this->r.d);
-            case 0x63: return this->bit_b_r(0x04, this->r.e);
-            case 0x64: return this->bit_b_r(0x04, this->r.h);
-            case 0x65: return this->bit_b_r(0x04, this->r.l);
-            case 0x66: return this->bit_b_hl(0x04);
-            case 0x67: return this->bit_b_r(0x04, this->r.a);
-            case 0x68: return this->bit_b_r(0x05, this->r.b);
-            case 0x69: return this->bit_b_r(0x05, this->r.c);
-            case 0x6A: return this->bit_b_r(0x05, this->r.d);
-            case 0x6B: return this->bit_b_r(0x05, this->r.e);
-            case 0x6C: return this->bit_b_r(0x05, this->r.h);
-            case 0x6D: return this->bit_b_r(0x05, this->r.l);
-            case 0x6E: return this->bit_b_hl(0x05);
-            case 0x6F: return this->bit_b_r(0x05, this->r.a);
-            case 0x70: return this->bit_b_r(0x06, this->r.b);
-            case 0x71: return this->bit_b_r(0x06, this->r.c);
-            case 0x72: return this->bit_b_r(0x06, this->r.d);
-            case 0x73: return this->bit_b_r(0x06, this->r.e);
-            case 0x74: return this->bit_b_r(0x06, this->r.h);
-            case 0x75: return this->bit_b_r(0x06, this->r.l);
-            case 0x76: return this->bit_b_hl(0x06);
-            case 0x77: return this->bit_b_r(0x06, this->r.a);
-            case 0x78: return this->bit_b_r(0x07, this->r.b);
-            case 0x79: return this->bit_b_r(0x07, this->r.c);
-            case 0x7A: return this->bit_b_r(0x07, this->r.d);
-            case 0x7B: return this->bit_b_r(0x07, this->r.e);
-            case 0x7C: return this->bit_b_r(0x07, this->r.h);
-            case 0x7D: return this->bit_b_r(0x07, this->r.l);
-            case 0x7E: return this->bit_b_hl(0x7);
-            case 0x7F: return this->bit_b_r(0x07, this->r.a);
-            case 0x80: return this->res_b_r(0x00, this->r.b);
-            case 0x81: return this->res_b_r(0x00, this->r.c);
-            case 0x82: return this->res_b_r(0x00, this->r.d);
-            case 0x83: return this->res_b_r(0x00, this->r.e);
-            case 0x84: return this->res_b_r(0x00, this->r.h);
-            case 0x85: return this->res_b_r(0x00, this->r.l);
-            case 0x86: return this->res_b_hl(0x00);
-            case 0x87: return this->res_b_r(0x00, this->r.a);
-            case 0x88: return this->res_b_r(0x01, this->r.b);
-            case 0x89: return this->res_b_r(0x01, this->r.c);
-            case 0x8A: return this->res_b_r(0x01, this->r.d);
-            case 0x8B: return this->res_b_r(0x01, this->r.e);
-            case 0x8C: return this->res_b_r(0x01, this->r.h);
-            case 0x8D: return this->res_b_r(0x01, this->r.l);
-            case 0x8E: return this->res_b_hl(0x01);
-            case 0x8F: return this->res_b_r(0x1, this->r.a);
-            case 0x90: return this->res_b_r(0x2, this->r.b);
-            case 0x91: return this->res_b_r(0x2, this->r.c);
-            case 0x92: return this->res_b_r(0x2, this->r.d);
-            case 0x93: return this->res_b_r(0x2, this->r.e);
-            case 0x94: return this->res_b_r(0x2, this->r.h);
-            case 0x95: return this->res_b_r(0x2, this->r.l);
-            case 0x96: return this->res_b_hl(0x02);
-            case 0x97: return this->res_b_r(0x02, this->r.a);
-            case 0x98: return this->res_b_r(0x03, this->r.b);
-            case 0x99: return this->res_b_r(0x03, this->r.c);
-            case 0x9A: return this->res_b_r(0x03, this->r.d);
-            case 0x9B: return this->res_b_r(0x03, this->r.e);
-            case 0x9C: return this->res_b_r(0x03, this->r.h);
-            case 0x9D: return this->res_b_r(0x03, this->r.l);
-            case 0x9E: return this->res_b_hl(0x03);
-            case 0x9F: return this->res_b_r(0x03, this->r.a);
-            case 0xA0: return this->res_b_r(0x04, this->r.b);
-            case 0xA1: return this->res_b_r(0x04, this->r.c);
-            case 0xA2: return this->res_b_r(0x04, this->r.d);
-            case 0xA3: return this->res_b_r(0x04, this->r.e);
-            case 0xA4: return this->res_b_r(0x04, this->r.h);
-            case 0xA5: return this->res_b_r(0x04, this->r.l);
-            case 0xA6: return this->res_b_hl(0x04);
-            case 0xA7: return this->res_b_r(0x04, this->r.a);
-            case 0xA8: return this->res_b_r(0x05, this->r.b);
-            case 0xA9: return this->res_b_r(0x05, this->r.c);
-            case 0xAA: return this->res_b_r(0x05, this->r.d);
-            case 0xAB: return this->res_b_r(0x05, this->r.e);
-            case 0xAC: return this->res_b_r(0x05, this->r.h);
-            case 0xAD: return this->res_b_r(0x05, this->r.l);
-            case 0xAE: return this->res_b_hl(0x05);
-            case 0xAF: return this->res_b_r(0x05, this->r.a);
-            case 0xB0: return this->res_b_r(0x06, this->r.b);
-            case 0xB1: return this->res_b_r(0x06, this->r.c);
-            case 0xB2: return this->res_b_r(0x06, this->r.d);
-            case 0xB3: return this->res_b_r(0x06, this->r.e);
-            case 0xB4: return this->res_b_r(0x06, this->r.h);
-            case 0xB5: return this->res_b_r(0x06, this->r.l);
-            case 0xB6: return this->res_b_hl(0x06);
-            case 0xB7: return this->res_b_r(0x06, this->r.a);
-            case 0xB8: return this->res_b_r(0x07, this->r.b);
-            case 0xB9: return this->res_b_r(0x07, this->r.c);
-            case 0xBA: return this->res_b_r(0x07, this->r.d);
-            case 0xBB: return this->res_b_r(0x07, this->r.e);
-            case 0xBC: return this->res_b_r(0x07, this->r.h);
-            case 0xBD: return this->res_b_r(0x07, this->r.l);
-            case 0xBE: return this->res_b_hl(0x7);
-            case 0xBF: return this->res_b_r(0x07, this->r.a);
-            case 0xC0: return this->set_b_r(0x00, this->r.b);
-            case 0xC1: return this->set_b_r(0x00, this->r.c);
-            case 0xC2: return this->set_b_r(0x00, this->r.d);
-            case 0xC3: return this->set_b_r(0x00, this->r.e);
-            case 0xC4: return this->set_b_r(0x00, this->r.h);
-            case 0xC5: return this->set_b_r(0x00, this->r.l);
-            case 0xC6: return this->set_b_hl(0x00);
-            case 0xC7: return this->set_b_r(0x00, this->r.a);
-            case 0xC8: return this->set_b_r(0x01, this->r.b);
-            case 0xC9: return this->set_b_r(0x01, this->r.c);
-            case 0xCA: return this->set_b_r(0x01, this->r.d);
-            case 0xCB: return this->set_b_r(0x01, this->r.e);
-            case 0xCC: return this->set_b_r(0x01, this->r.h);
-            case 0xCD: return this->set_b_r(0x01, this->r.l);
-            case 0xCE: return this->set_b_hl(0x01);
-            case 0xCF: return this->set_b_r(0x1, this->r.a);
-            case 0xD0: return this->set_b_r(0x2, this->r.b);
-            case 0xD1: return this->set_b_r(0x2, this->r.c);
-            case 0xD2: return this->set_b_r(0x2, this->r.d);
-            case 0xD3: return this->set_b_r(0x2, this->r.e);
-            case 0xD4: return this->set_b_r(0x2, this->r.h);
-            case 0xD5: return this->set_b_r(0x2, this->r.l);
-            case 0xD6: return this->set_b_hl(0x02);
-            case 0xD7: return this->set_b_r(0x02, this->r.a);
-            case 0xD8: return this->set_b_r(0x03, this->r.b);
-            case 0xD9: return this->set_b_r(0x03, this->r.c);
-            case 0xDA: return this->set_b_r(0x03, this->r.d);
-            case 0xDB: return this->set_b_r(0x03, this->r.e);
-            case 0xDC: return this->set_b_r(0x03, this->r.h);
-            case 0xDD: return this->set_b_r(0x03, this->r.l);
-            case 0xDE: return this->set_b_hl(0x03);
-            case 0xDF: return this->set_b_r(0x03, this->r.a);
-            case 0xE0: return this->set_b_r(0x04, this->r.b);
-            case 0xE1: return this->set_b_r(0x04, this->r.c);
-            case 0xE2: return this->set_b_r(0x04, this->r.d);
-            case 0xE3: return this->set_b_r(0x04, this->r.e);
-            case 0xE4: return this->set_b_r(0x04, this->r.h);
-            case 0xE5: return this->set_b_r(0x04, this->r.l);
-            case 0xE6: return this->set_b_hl(0x04);
-            case 0xE7: return this->set_b_r(0x04, this->r.a);
-            case 0xE8: return this->set_b_r(0x05, this->r.b);
-            case 0xE9: return this->set_b_r(0x05, this->r.c);
-            case 0xEA: return this->set_b_r(0x05, this->r.d);
-            case 0xEB: return this->set_b_r(0x05, this->r.e);
-            case 0xEC: return this->set_b_r(0x05, this->r.h);
-            case 0xED: return this->set_b_r(0x05, this->r.l);
-            case 0xEE: return this->set_b_hl(0x05);
-            case 0xEF: return this->set_b_r(0x05, this->r.a);
-            case 0xF0: return this->set_b_r(0x06, this->r.b);
-            case 0xF1: return this->set_b_r(0x06, this->r.c);
-            case 0xF2: return this->set_b_r(0x06, this->r.d);
-            case 0xF3: return this->set_b_r(0x06, this->r.e);
-            case 0xF4: return this->set_b_r(0x06, this->r.h);
-            case 0xF5: return this->set_b_r(0x06, this->r.l);
-            case 0xF6: return this->set_b_hl(0x06);
-            case 0xF7: return this->set_b_r(0x06, this->r.a);
-            case 0xF8: return this->set_b_r(0x07, this->r.b);
-            case 0xF9: return this->set_b_r(0x07, this->r.c);
-            case 0xFA: return this->set_b_r(0x07, this->r.d);
-            case 0xFB: return this->set_b_r(0x07, this->r.e);
-            case 0xFC: return this->set_b_r(0x07, this->r.h);
-            case 0xFD: return this->set_b_r(0x07, this->r.l);
-            case 0xFE: return this->set_b_hl(0x7);
-            case 0xFF: return this->set_b_r(0x07, this->r.a);
-            default: return this->INVALID_OP();
-        }
-    }
-} /* END: Nintendo */ } /* END: Processors */ } /* END: SiNES */
+#include <string.h>
+#include "Processors/Nintendo/LR35902/LR35902.hpp"
+#include "Processors/Nintendo/LR35902/alu.hpp"
+#if LR35902_JIT
+    #ifdef WIN32
+        #include <windows.h>
+    #else
+        #include <sys/mman.h>
+    #endif
+#endif
+
+namespace SiNES { namespace Processors { namespace Nintendo {
+    #include "opcodes.cpp"
+    #include "dispatch.cpp"
+    #include "block.cpp"
+#if LR35902_JIT
+    #include "jit.cpp"
+#endif
+
+    /* Constructor for an LR35902 processor. */
+    LR35902::LR35902(SiNES::Memory::Arena *arena) {
+        memset(&this->rr, 0x00, sizeof(this->rr));
+        this->lf.op = LR35902_LAZY_NONE;
+        this->imm = 0x0000;
+        this->ime = false;
+        this->imePending = false;
+        this->rom = NULL;
+        this->romSize = 0;
+#if LR35902_TIMING != LR35902_TIMING_NONE
+        this->cycles = 0;
+#endif
+#if LR35902_TIMING == LR35902_TIMING_ACCESS
+        this->accessHook = NULL;
+        this->accessContext = NULL;
+#endif
+#if LR35902_TIMING != LR35902_TIMING_NONE
+        for (uint32 i = 0; i < LR35902_INT_COUNT; ++i) {
+            this->due[i] = LR35902_NEVER;
+        }
+        this->nextDue = LR35902_NEVER;
+        this->idleSkip = false;
+#endif
+#if LR35902_FUSION
+        this->runEnd = LR35902_NEVER;
+#endif
+        this->halted = false;
+        this->wake = 0x00;
+        memset(&this->stats, 0x00, sizeof(this->stats));
+        this->blockCache = (NULL != arena) ? (LR35902_BLOCK_CACHE *)arena->alloc(sizeof(LR35902_BLOCK_CACHE)) : NULL;
+        this->ownsBlockCache = (NULL == this->blockCache);
+        if (this->ownsBlockCache) {
+            this->blockCache = new LR35902_BLOCK_CACHE;
+        }
+        for (uint32 i = 0; i < LR35902_BLOCK_CACHE_SIZE; ++i) {
+            this->blockCache->blocks[i].key = LR35902_BLOCK_INVALID;
+        }
+        this->codeWrites = 0;
+        this->bus.setWatchHandler(&LR35902::watchedWrite, this);
+#if LR35902_JIT
+        this->jit = new LR35902_JIT_STATE;
+        this->jit->enabled = false;
+        this->jit->code = NULL;
+        this->jit->used = 0;
+        this->jit->flushes = 0;
+#endif
+    }
+
+    /* Destructor for an LR35902 processor. */
+    LR35902::~LR35902() {
+        if (this->ownsBlockCache) {
+            delete this->blockCache;
+        }
+#if LR35902_JIT
+        jitFreeCode(this->jit->code);
+        delete this->jit;
+#endif
+    }
+
+    /* Attach flat host memory to the bus. */
+    void LR35902::attachMemory(uint8 *memory) {
+        this->bus.map(0x00, 0x80, memory, false);
+        this->bus.map(0x80, 0x80, memory + 0x8000, true);
+    }
+
+    /* Attach a ROM image to 0x0000-0x7FFF. */
+    void LR35902::attachRom(const uint8 *rom, uint32 size) {
+        this->rom = rom;
+        this->romSize = size;
+
+        /* ROM pages are mapped read only, the bus never writes through them.  Missing banks read open bus. */
+        this->bus.map(0x00, 0x40, (size >= 0x4000) ? (uint8 *)rom : NULL, false);
+        this->bus.map(0x40, 0x40, (size >= 0x8000) ? (uint8 *)rom + 0x4000 : NULL, false);
+    }
+
+    /* Attach the instance's own RAM to 0x8000-0xFFFF. */
+    void LR35902::attachRam(uint8 *ram) {
+        this->bus.map(0x80, 0x80, ram, true);
+    }
+
+    /* Get the memory bus of the processor. */
+    SiNES::Memory::Bus &LR35902::getBus() {
+        return this->bus;
+    }
+
+#if LR35902_TIMING != LR35902_TIMING_NONE
+    /* Get the master cycle counter. */
+    uint64 LR35902::cycleCount() const {
+        return this->cycles;
+    }
+#endif
+
+    /* Get the instrumentation counters. */
+    const LR35902_STATS &LR35902::getStats() const {
+        return this->stats;
+    }
+
+    /* Drop host state a restored snapshot may have made stale. */
+    void LR35902::restored() {
+#if LR35902_JIT
+        this->jitFlush();
+#endif
+    }
+
+    /* Account for the memory held by the processor. */
+    void LR35902::memoryUsage(PROCESSOR_MEMORY &usage) const {
+        usage.instance = (uint32)(sizeof(*this) + sizeof(*this->blockCache));
+#if LR35902_JIT
+        usage.instance += (NULL != this->jit->code) ? LR35902_JIT_CODE_SIZE : 0;
+        usage.instance += (uint32)sizeof(*this->jit);
+#endif
+        usage.shared = (uint32)(sizeof(OP_TABLE) + sizeof(CB_OP_TABLE) + sizeof(OP_INFO) + sizeof(CB_OP_INFO));
+#if LR35902_ALU == LR35902_ALU_TABLE
+        usage.shared += (uint32)(sizeof(LR35902_ALU_ADD) + sizeof(LR35902_ALU_SUB) + sizeof(LR35902_ALU_INC)
+                                 + sizeof(LR35902_ALU_DEC) + sizeof(LR35902_ALU_SWAP) + sizeof(LR35902_ALU_DAA));
+#endif
+    }
+
+#if LR35902_TIMING != LR35902_TIMING_NONE
+    /* Schedule an interrupt source to raise its IF bit at a master cycle. */
+    void LR35902::schedule(uint8 source, uint64 cycle) {
+        this->due[source] = cycle;
+        if (cycle < this->nextDue) {
+            this->nextDue = cycle;
+        } else {
+            this->raiseDue();
+        }
+    }
+
+    /* Switch idle loop skipping. */
+    void LR35902::setIdleSkip(bool enable) {
+        this->idleSkip = enable;
+    }
+
+    /* Raise the IF bit of every source that is due and find the next scheduled cycle. */
+    void LR35902::raiseDue() {
+        this->nextDue = LR35902_NEVER;
+        for (uint32 i = 0; i < LR35902_INT_COUNT; ++i) {
+            if (this->due[i] <= this->cycles) {
+                this->bus.write8(0xFF0F, (uint8)(this->bus.read8(0xFF0F) | (0x01 << i)));
+                this->due[i] = LR35902_NEVER;
+            } else if (this->due[i] < this->nextDue) {
+                this->nextDue = this->due[i];
+            }
+        }
+    }
+
+    /* Raise due sources and, while halted, fast-forward to the next scheduled cycle. */
+    uint32 LR35902::idle(uint32 budget) {
+        if (this->cycles >= this->nextDue) {
+            this->raiseDue();
+        }
+        if (!this->halted) {
+            return 0;
+        }
+
+        /* Nothing can change IF before the next scheduled cycle, so the wait is skipped in one step. */
+        uint32 skip = 0;
+        if (!(this->peek8(0xFFFF) & this->peek8(0xFF0F) & this->wake)) {
+            skip = budget;
+            if (LR35902_NEVER != this->nextDue && this->nextDue - this->cycles < budget) {
+                skip = (uint32)(this->nextDue - this->cycles);
+            }
+            this->cycles += skip;
+            this->stats.haltCycles += skip;
+            if (this->cycles >= this->nextDue) {
+                this->raiseDue();
+            }
+        }
+        if (this->peek8(0xFFFF) & this->peek8(0xFF0F) & this->wake) {
+            this->halted = false;
+        }
+        return skip;
+    }
+
+    /* Run the block at the PC and fast-forward if it is an idle loop that left the registers unchanged. */
+    uint32 LR35902::execIdleBlock(uint32 budget) {
+        uint16 pc = this->rr.pc;
+        uint32 key = this->blockKey(pc);
+        const LR35902_BLOCK &block = this->blockCache->blocks[LR35902_BLOCK_CACHE_INDEX(key)];
+        if (!this->blockCached(block, key) || !(block.flags & LR35902_BLOCK_IDLE)) {
+            return this->execBlock();
+        }
+
+        /* An iteration that reads the same state and writes nothing repeats until IF or a polled value changes,
+           which the loop only reads from memory changed at scheduled cycles. */
+        _PAIRS rr = this->rr;
+        _LAZY_FLAGS lf = this->lf;
+        uint32 cycles = this->execBlock();
+        if (this->rr.pc != pc || 0 != memcmp(&rr, &this->rr, sizeof(rr)) || 0 != memcmp(&lf, &this->lf, sizeof(lf))) {
+            return cycles;
+        }
+        if (cycles >= budget) {
+            return cycles;
+        }
+        /* The registers are unchanged, so the pointers read through are those of the next iteration. */
+        if (((block.flags & LR35902_BLOCK_READS_BC) && clockedRegister(this->rr.bc))
+            || ((block.flags & LR35902_BLOCK_READS_DE) && clockedRegister(this->rr.de))
+            || ((block.flags & LR35902_BLOCK_READS_HL) && clockedRegister(this->rr.hl))
+            || ((block.flags & LR35902_BLOCK_READS_C) && clockedRegister((uint16)(0xFF00 | this->r.c)))) {
+            return cycles;
+        }
+
+        uint32 skip = budget - cycles;
+        if (LR35902_NEVER != this->nextDue && this->nextDue - this->cycles < skip) {
+            skip = this->nextDue > this->cycles ? (uint32)(this->nextDue - this->cycles) : 0;
+        }
+        this->cycles += skip;
+        ++this->stats.idleLoops;
+        this->stats.idleCycles += skip;
+        return cycles + skip;
+    }
+#endif
+
+#if LR35902_TIMING == LR35902_TIMING_ACCESS
+    /* Set the hook called on every data access. */
+    void LR35902::setAccessHook(LR35902_ACCESS_HOOK hook, void *context) {
+        this->accessHook = hook;
+        this->accessContext = context;
+    }
+#endif
+
+    /* Execute an operation in the processor, taking a pending interrupt first. */
+    void LR35902::execOp() {
+        if (this->locked) {
+            return;
+        }
+#if LR35902_TIMING != LR35902_TIMING_NONE
+        /* A single step of a halted processor idles for one machine cycle, run fast-forwards. */
+        if (this->halted || this->cycles >= this->nextDue) {
+            this->idle(4);
+            if (this->halted) {
+                return;
+            }
+        }
+#endif
+        if (this->ime && this->serviceInterrupts()) {
+            return;
+        }
+        bool enable = this->imePending;
+#if LR35902_DISPATCH == LR35902_DISPATCH_TABLE
+        this->execOpTable();
+#else
+        this->execOpSwitch();
+#endif
+        if (enable && this->imePending) {
+            this->ime = true;
+            this->imePending = false;
+        }
+    }
+
+    /* Run decoded blocks until one of a set of events is raised or a cycle budget is spent. */
+    uint32 LR35902::runUntil(uint32 events, uint32 cycles) {
+        uint32 spent = 0;
+        this->raised = 0;
+#if LR35902_FUSION
+        this->runEnd = this->cycles + cycles;
+#endif
+        while (spent < cycles) {
+            /* An undefined op locks the processor up, neither interrupts nor ops run again. */
+            if (this->locked) {
+                LR35902_ADD_CYCLES(cycles - spent);
+                spent = cycles;
+                break;
+            }
+#if LR35902_TIMING != LR35902_TIMING_NONE
+            if (this->halted || this->cycles >= this->nextDue) {
+                spent += this->idle(cycles - spent);
+                if (this->halted) {
+                    continue;
+                }
+            }
+#endif
+            if (this->ime && this->serviceInterrupts()) {
+                spent += 20;
+                this->raiseEvents(PROCESSOR_EVENT_INTERRUPT);
+            }
+            if (this->raised & events) {
+                break;
+            }
+            if (this->imePending) {
+                /* Blocks end at ei, the op after it runs on its own so an interrupt it enables is taken next. */
+#if LR35902_TIMING != LR35902_TIMING_NONE
+                uint64 start = this->cycles;
+                this->execOp();
+                spent += (uint32)(this->cycles - start);
+#else
+                spent += OP_INFO[this->peek8(this->rr.pc)].cycles;
+                this->execOp();
+#endif
+                continue;
+            }
+#if LR35902_TIMING != LR35902_TIMING_NONE
+            if (this->idleSkip) {
+                spent += this->execIdleBlock(cycles - spent);
+                continue;
+            }
+#endif
+            spent += this->execBlock();
+        }
+        return spent;
+    }
+
+    /* Execute an operation in the processor through the dispatch tables. */
+    void LR35902::execOpTable() {
+        uint8 op = this->fetchOp();
+        LR35902_ADD_CYCLES(OP_INFO[op].cycles);
+        (this->*OP_TABLE[op])();
+    }
+
+    /* Execute an operation in the processor through the op code switch. */
+    void LR35902::execOpSwitch() {
+        uint8 op = this->fetchOp();
+        LR35902_ADD_CYCLES(OP_INFO[op].cycles);
+        switch (op) {
+            case 0x00: return this->nop();
+            case 0x01: return this->ld_rr_nn(this->rr.bc);
+            case 0x02: return this->ld_rr_a(this->rr.bc);
+            case 0x03: return this->inc_rr(this->rr.bc);
+            case 0x04: return this->inc_r(this->r.b);
+            case 0x05: return this->dec_r(this->r.b);
+            case 0x06: return this->ld_r_n(this->r.b);
+            case 0x07: return this->rlca();
+            case 0x08: return this->ld_nn_sp();
+            case 0x09: return this->add_hl_rr(this->rr.bc);
+            case 0x0A: return this->ld_a_rr(this->rr.bc);
+            case 0x0B: return this->dec_rr(this->rr.bc);
+            case 0x0C: return this->inc_r(this->r.c);
+            case 0x0D: return this->dec_r(this->r.c);
+            case 0x0E: return this->ld_r_n(this->r.c);
+            case 0x0F: return this->rrca();
+            case 0x10: return this->stop();
+            case 0x11: return this->ld_rr_nn(this->rr.de);
+            case 0x12: return this->ld_rr_a(this->rr.de);
+            case 0x13: return this->inc_rr(this->rr.de);
+            case 0x14: return this->inc_r(this->r.d);
+            case 0x15: return this->dec_r(this->r.d);
+            case 0x16: return this->ld_r_n(this->r.d);
+            case 0x17: return this->rla();
+            case 0x18: return this->jr_n();
+            case 0x19: return this->add_hl_rr(this->rr.de);
+            case 0x1A: return this->ld_a_rr(this->rr.de);
+            case 0x1B: return this->dec_rr(this->rr.de);
+            case 0x1C: return this->inc_r(this->r.e);
+            case 0x1D: return this->dec_r(this->r.e);
+            case 0x1E: return this->ld_r_n(this->r.e);
+            case 0x1F: return this->rra();
+            case 0x20: return this->jr_cc_n(false, LR35902_FLAG_ZERO);
+            case 0x21: return this->ld_rr_nn(this->rr.hl);
+            case 0x22: return this->ldi_hl_a();
+            case 0x23: return this->inc_rr(this->rr.hl);
+            case 0x24: return this->inc_r(this->r.h);
+            case 0x25: return this->dec_r(this->r.h);
+            case 0x26: return this->ld_r_n(this->r.h);
+            case 0x27: return this->daa();
+            case 0x28: return this->jr_cc_n(true, LR35902_FLAG_ZERO);
+            case 0x29: return this->add_hl_rr(this->rr.hl);
+            case 0x2A: return this->ldi_a_hl();
+            case 0x2B: return this->dec_rr(this->rr.hl);
+            case 0x2C: return this->inc_r(this->r.l);
+            case 0x2D: return this->dec_r(this->r.l);
+            case 0x2E: return this->ld_r_n(this->r.l);
+            case 0x2F: return this->cpl();
+            case 0x30: return this->jr_cc_n(false, LR35902_FLAG_CARRY);
+            case 0x31: return this->ld_rr_nn(this->rr.sp);
+            case 0x32: return this->ldd_hl_a();
+            case 0x33: return this->inc_rr(this->rr.sp);
+            case 0x34: return this->inc_hl();
+            case 0x35: return this->dec_hl();
+            case 0x36: return this->ld_hl_n();
+            case 0x37: return this->scf();
+            case 0x38: return this->jr_cc_n(true, LR35902_FLAG_CARRY);
+            case 0x39: return this->add_hl_rr(this->rr.sp);
+            case 0x3A: return this->ldd_a_hl();
+            case 0x3B: return this->dec_rr(this->rr.sp);
+            case 0x3C: return this->inc_r(this->r.a);
+            case 0x3D: return this->dec_r(this->r.a);
+            case 0x3E: return this->ld_r_n(this->r.a);
+            case 0x3F: return this->ccf();
+            case 0x40: return this->ld_r_r(this->r.b, this->r.b);
+            case 0x41: return this->ld_r_r(this->r.b, this->r.c);
+            case 0x42: return this->ld_r_r(this->r.b, this->r.d);
+            case 0x43: return this->ld_r_r(this->r.b, this->r.e);
+            case 0x44: return this->ld_r_r(this->r.b, this->r.h);
+            case 0x45: return this->ld_r_r(this->r.b, this->r.l);
+            case 0x46: return this->ld_r_hl(this->r.b);
+            case 0x47: return this->ld_r_r(this->r.b, this->r.a);
+            case 0x48: return this->ld_r_r(this->r.c, this->r.b);
+            case 0x49: return this->ld_r_r(this->r.c, this->r.c);
+            case 0x4A: return this->ld_r_r(this->r.c, this->r.d);
+            case 0x4B: return this->ld_r_r(this->r.c, this->r.e);
+            case 0x4C: return this->ld_r_r(this->r.c, this->r.h);
+            case 0x4D: return this->ld_r_r(this->r.c, this->r.l);
+            case 0x4E: return this->ld_r_hl(this->r.c);
+            case 0x4F: return this->ld_r_r(this->r.c, this->r.a);
+            case 0x50: return this->ld_r_r(this->r.d, this->r.b);
+            case 0x51: return this->ld_r_r(this->r.d, this->r.c);
+            case 0x52: return this->ld_r_r(this->r.d, this->r.d);
+            case 0x53: return this->ld_r_r(this->r.d, this->r.e);
+            case 0x54: return this->ld_r_r(this->r.d, this->r.h);
+            case 0x55: return this->ld_r_r(this->r.d, this->r.l);
+            case 0x56: return this->ld_r_hl(this->r.d);
+            case 0x57: return this->ld_r_r(this->r.d, this->r.a);
+            case 0x58: return this->ld_r_r(this->r.e, this->r.b);
+            case 0x59: return this->ld_r_r(this->r.e, this->r.c);
+            case 0x5A: return this->ld_r_r(this->r.e, this->r.d);
+            case 0x5B: return this->ld_r_r(this->r.e, this->r.e);
+            case 0x5C: return this->ld_r_r(this->r.e, this->r.h);
+            case 0x5D: return this->ld_r_r(this->r.e, this->r.l);
+            case 0x5E: return this->ld_r_hl(this->r.e);
+            case 0x5F: return this->ld_r_r(this->r.e, this->r.a);
+            case 0x60: return this->ld_r_r(this->r.h, this->r.b);
+            case 0x61: return this->ld_r_r(this->r.h, this->r.c);
+            case 0x62: return this->ld_r_r(this->r.h, this->r.d);
+            case 0x63: return this->ld_r_r(this->r.h, this->r.e);
+            case 0x64: return this->ld_r_r(this->r.h, this->r.h);
+            case 0x65: return this->ld_r_r(this->r.h, this->r.l);
+            case 0x66: return this->ld_r_hl(this->r.h);
+            case 0x67: return this->ld_r_r(this->r.h, this->r.a);
+            case 0x68: return this->ld_r_r(this->r.l, this->r.b);
+            case 0x69: return this->ld_r_r(this->r.l, this->r.c);
+            case 0x6A: return this->ld_r_r(this->r.l, this->r.d);
+            case 0x6B: return this->ld_r_r(this->r.l, this->r.e);
+            case 0x6C: return this->ld_r_r(this->r.l, this->r.h);
+            case 0x6D: return this->ld_r_r(this->r.l, this->r.l);
+            case 0x6E: return this->ld_r_hl(this->r.l);
+            case 0x6F: return this->ld_r_r(this->r.l, this->r.a);
+            case 0x70: return this->ld_hl_r(this->r.b);
+            case 0x71: return this->ld_hl_r(this->r.c);
+            case 0x72: return this->ld_hl_r(this->r.d);
+            case 0x73: return this->ld_hl_r(this->r.e);
+            case 0x74: return this->ld_hl_r(this->r.h);
+            case 0x75: return this->ld_hl_r(this->r.l);
+            case 0x76: return this->halt();
+            case 0x77: return this->ld_hl_r(this->r.a);
+            case 0x78: return this->ld_r_r(this->r.a, this->r.b);
+            case 0x79: return this->ld_r_r(this->r.a, this->r.c);
+            case 0x7A: return this->ld_r_r(this->r.a, this->r.d);
+            case 0x7B: return this->ld_r_r(this->r.a, this->r.e);
+            case 0x7C: return this->ld_r_r(this->r.a, this->r.h);
+            case 0x7D: return this->ld_r_r(this->r.a, this->r.l);
+            case 0x7E: return this->ld_r_hl(this->r.a);
+            case 0x7F: return this->ld_r_r(this->r.a, this->r.a);
+            case 0x80: return this->add_a_r(this->r.b);
+            case 0x81: return this->add_a_r(this->r.c);
+            case 0x82: return this->add_a_r(this->r.d);
+            case 0x83: return this->add_a_r(this->r.e);
+            case 0x84: return this->add_a_r(this->r.h);
+            case 0x85: return this->add_a_r(this->r.l);
+            case 0x86: return this->add_a_hl();
+            case 0x87: return this->add_a_r(this->r.a);
+            case 0x88: return this->adc_a_r(this->r.b);
+            case 0x89: return this->adc_a_r(this->r.c);
+            case 0x8A: return this->adc_a_r(this->r.d);
+            case 0x8B: return this->adc_a_r(this->r.e);
+            case 0x8C: return this->adc_a_r(this->r.h);
+            case 0x8D: return this->adc_a_r(this->r.l);
+            case 0x8E: return this->adc_a_hl();
+            case 0x8F: return this->adc_a_r(this->r.a);
+            case 0x90: return this->sub_a_r(this->r.b);
+            case 0x91: return this->sub_a_r(this->r.c);
+            case 0x92: return this->sub_a_r(this->r.d);
+            case 0x93: return this->sub_a_r(this->r.e);
+            case 0x94: return this->sub_a_r(this->r.h);
+            case 0x95: return this->sub_a_r(this->r.l);
+            case 0x96: return this->sub_a_hl();
+            case 0x97: return this->sub_a_r(this->r.a);
+            case 0x98: return this->sbc_a_r(this->r.b);
+            case 0x99: return this->sbc_a_r(this->r.c);
+            case 0x9A: return this->sbc_a_r(this->r.d);
+            case 0x9B: return this->sbc_a_r(this->r.e);
+            case 0x9C: return this->sbc_a_r(this->r.h);
+            case 0x9D: return this->sbc_a_r(this->r.l);
+            case 0x9E: return this->sbc_a_hl();
+            case 0x9F: return this->sbc_a_r(this->r.a);
+            case 0xA0: return this->and_a_r(this->r.b);
+            case 0xA1: return this->and_a_r(this->r.c);
+            case 0xA2: return this->and_a_r(this->r.d);
+            case 0xA3: return this->and_a_r(this->r.e);
+            case 0xA4: return this->and_a_r(this->r.h);
+            case 0xA5: return this->and_a_r(this->r.l);
+            case 0xA6: return this->and_a_hl();
+            case 0xA7: return this->and_a_r(this->r.a);
+            case 0xA8: return this->xor_a_r(this->r.b);
+            case 0xA9: return this->xor_a_r(this->r.c);
+            case 0xAA: return this->xor_a_r(this->r.d);
+            case 0xAB: return this->xor_a_r(this->r.e);
+            case 0xAC: return this->xor_a_r(this->r.h);
+            case 0xAD: return this->xor_a_r(this->r.l);
+            case 0xAE: return this->xor_a_hl();
+            case 0xAF: return this->xor_a_r(this->r.a);
+            case 0xB0: return this->or_a_r(this->r.b);
+            case 0xB1: return this->or_a_r(this->r.c);
+            case 0xB2: return this->or_a_r(this->r.d);
+            case 0xB3: return this->or_a_r(this->r.e);
+            case 0xB4: return this->or_a_r(this->r.h);
+            case 0xB5: return this->or_a_r(this->r.l);
+            case 0xB6: return this->or_a_hl();
+            case 0xB7: return this->or_a_r(this->r.a);
+            case 0xB8: return this->cp_a_r(this->r.b);
+            case 0xB9: return this->cp_a_r(this->r.c);
+            case 0xBA: return this->cp_a_r(this->r.d);
+            case 0xBB: return this->cp_a_r(this->r.e);
+            case 0xBC: return this->cp_a_r(this->r.h);
+            case 0xBD: return this->cp_a_r(this->r.l);
+            case 0xBE: return this->cp_a_hl();
+            case 0xBF: return this->cp_a_r(this->r.a);
+            case 0xC0: return this->ret_cc(false, LR35902_FLAG_ZERO);
+            case 0xC1: return this->pop_rr(this->rr.bc);
+            case 0xC2: return this->jp_cc_nn(false, LR35902_FLAG_ZERO);
+            case 0xC3: return this->jp_nn();
+            case 0xC4: return this->call_cc_nn(false, LR35902_FLAG_ZERO);
+            case 0xC5: return this->push_rr(this->rr.bc);
+            case 0xC6: return this->add_a_n();
+            case 0xC7: return this->rst_n(0x00);
+            case 0xC8: return this->ret_cc(true, LR35902_FLAG_ZERO);
+            case 0xC9: return this->ret();
+            case 0xCA: return this->jp_cc_nn(true, LR35902_FLAG_ZERO);
+            case 0xCB: goto CB_OPS;
+            case 0xCC: return this->call_cc_nn(true, LR35902_FLAG_ZERO);
+            case 0xCD: return this->call_nn();
+            case 0xCE: return this->adc_a_n();
+            case 0xCF: return this->rst_n(0x08);
+            case 0xD0: return this->ret_cc(false, LR35902_FLAG_CARRY);
+            case 0xD1: return this->pop_rr(this->rr.de);
+            case 0xD2: return this->jp_cc_nn(false, LR35902_FLAG_CARRY);
+            case 0xD4: return this->call_cc_nn(false, LR35902_FLAG_CARRY);
+            case 0xD5: return this->push_rr(this->rr.de);
+            case 0xD6: return this->sub_a_n();
+            case 0xD7: return this->rst_n(0x10);
+            case 0xD8: return this->ret_cc(true, LR35902_FLAG_CARRY);
+            case 0xD9: return this->reti();
+            case 0xDA: return this->jp_cc_nn(true, LR35902_FLAG_CARRY);
+            case 0xDC: return this->call_cc_nn(true, LR35902_FLAG_CARRY);
+            case 0xDE: return this->sbc_a_n();
+            case 0xDF: return this->rst_n(0x18);
+            case 0xE0: return this->ldh_n_a();
+            case 0xE1: return this->pop_rr(this->rr.hl);
+            case 0xE2: return this->ld_c_a();
+            case 0xE5: return this->push_rr(this->rr.hl);
+            case 0xE6: return this->and_a_n();
+            case 0xE7: return this->rst_n(0x20);
+            case 0xE8: return this->add_sp_n();
+            case 0xE9: return this->jp_hl();
+            case 0xEA: return this->ld_nn_a();
+            case 0xEE: return this->xor_a_n();
+            case 0xEF: return this->rst_n(0x28);
+            case 0xF0: return this->ldh_a_n();
+            case 0xF1: return this->pop_rr(this->rr.af);
+            case 0xF2: return this->ld_a_c();
+            case 0xF3: return this->di();
+            case 0xF5: return this->push_rr(this->rr.af);
+            case 0xF6: return this->or_a_n();
+            case 0xF7: return this->rst_n(0x30);
+            case 0xF8: return this->ldhl_sp_n();
+            case 0xF9: return this->ld_sp_hl();
+            case 0xFA: return this->ld_a_nn();
+            case 0xFB: return this->ei();
+            case 0xFE: return this->cp_a_n();
+            case 0xFF: return this->rst_n(0x38);
+            default: return this->INVALID_OP();
+        }
+
+CB_OPS:
+        op = (uint8)this->imm;
+        LR35902_ADD_CYCLES(CB_OP_INFO[op].cycles);
+        (this->*CB_OP_TABLE[op])();
+    }
+} /* END: Nintendo */ } /* END: Processors */ } /* END: SiNES */
@@ -1,834 +1,1294 @@
-#include "Processors/Processor.hpp"
-
-namespace SiNES { namespace Processors { namespace Nintendo {
-    /**
-     * The LR35902 Processor class.
-     */
-    class LR35902 : public SiNES::Processors::Processor {
-    public:
-        /**
-         * Constructor for an LR35902 processor.
-         */
-        LR35902();
-
-        /**
-         * Destructor for an LR35902 processor.
-         */
-        virtual ~LR35902();
-
-        /**
-         * Execute the next processor level operation.
-         */
-        virtual void execOp();
-
-    protected:
-        /************************************************\
-        |* Op Code Functions                            *|
-        \************************************************/
-        /*
-        FORMAT for processor operation functions: <mnemonic> [#1 |    #2] [Z H N C]
-        Where:
-            mnemonic            : Is the processor operation mnemonic associated with the instruction
-            #1                  : The length in bytes read from the stack.
-            #2                  : The duration in clock cycles.
-            Z - Zero Flag       : Set when a math operation is zero or two values match with CP.
-            H - Subtract Flag   : Set if the last operation used subtraction.
-            N - Half Carry Flag : If the lower nibble carried in the math operation.
-            C - Carry Flag      : Set if a carry occurred from the last math operation or register A is smaller in with CP.
-        Z,H,N,C are flags that were affected by the operation.
-            * If the flag is marked by a "0" it is reset after instruction run.
-            * If the flag is marked by a "1" it is set after instruction run.
-            * If the flag is marked by a "-" it is unchanged.
-            * If the flag is marked by the corresponding symbol it is affected by the function as normal.
-        */
-
-        /************************\
-        |* Misc. Operations     *|
-        \************************/
-
-        /**
-         * The no operation op.
-         * nop          [1  |     4] [- - - -]
-         */
-        void nop();
-
-        /**
-         * The stop operation.
-         * stop         [2  |     4] [- - - -]
-         */
-        void stop();
-
-        /**
-         * The halt operation.
-         * halt         [1  |     4] [- - - -]
-         */
-        void halt();
-
-        /**
-         * Disable interrupts.
-         * di           [1  |     4] [- - - -]
-         */
-        void di();
-
-        /**
-         * Enable interrupts.
-         * ei           [1  |     4] [- - - -]
-         */
-        void ei();
-
-        /************************\
-        |* Jump/Call Operations *|
-        \************************/
-
-        /**
-         * Jump return operation.
-         * jr_n         [1  |    12] [- - - -]
-         */
-        void jr_n();
-
-        /**
-         * Jump return operation on condition.
-         * jr_cc_n      [1  |  12/8] [- - - -]
-         *
-         * @param set       [IN]        True if the flag should be checked for set.
-         * @param flags     [IN]        The flags to check for being set.
-         */
-        void jr_cc_n(bool set, uint8 flags);
-
-        /**
-         * Jump operation.
-         * jp_nn        [1  |    16] [- - - -]
-         */
-        void jp_nn();
-
-        /**
-         * Jump operation based on value (HL).
-         * jp_hl        [1  |    16] [- - - -]
-         */
-        void jp_hl();
-
-        /**
-         * Jump operation on condition.
-         * jp_cc_nn     [1  | 16/12] [- - - -]
-         *
-         * @param set       [IN]        True if the flag should be checked for set.
-         * @param flags     [IN]        The flags to check for being set.
-         */
-        void jp_cc_nn(bool set, uint8 flags);
-
-        /**
-         * The call operation.
-         * call_cc_nn   [1  |    24] [- - - -]
-         */
-        void call_nn();
-
-        /**
-         * Call operation on condition.
-         * call_cc_nn   [1  | 16/12] [- - - -]
-         *
-         * @param set       [IN]        True if the flag should be checked for set.
-         * @param flags     [IN]        The flags to check for being set.
-         */
-        void call_cc_nn(bool set, uint8 flags);
-
-        /**
-         * return operation on condition.
-         * ret          [1  |    16] [- - - -]
-         */
-        void ret();
-
-        /**
-         * Return operation and enable interupt.
-         * reti         [1  |    16] [- - - -]
-         */
-        void reti();
-
-        /**
-         * return operation on condition.
-         * ret_cc       [1  |  20/8] [- - - -]
-         *
-         * @param set       [IN]        True if the flag should be checked for set.
-         * @param flags     [IN]        The flags to check for being set.
-         */
-        void ret_cc(bool set, uint8 flags);
-
-        /**
-         * Push present address onto the stack and jump to address 0x0000 + n.
-         * rst_n        [1  |    16] [- - - -]
-         *
-         * @param address   [IN]        The offset to jump to.
-         */
-        void rst_n(uint8 offset);
-
-        /************************\
-        |* 8 Bit Load Ops       *|
-        \************************/
-
-        /**
-         * Store the accumulator register into the address in the provided register.
-         * ld_rr_a      [1  |     8] [- - - -]
-         *
-         * @param hReg      [IN]        High byte of the register.
-         * @param lReg      [IN]        Low byte of the register.
-         */
-        void ld_rr_a(uint8 &hReg, uint8 &lReg);
-
-        /**
-         * Store the value at the address in the provided register into the accumulator.
-         * ld_a_rr      [1  |     8] [- - - -]
-         *
-         * @param hReg      [IN]        High byte of the register.
-         * @param lReg      [IN]        Low byte of the register.
-         */
-        void ld_a_rr(uint8 &hReg, uint8 &lReg);
-
-        /**
-         * Store the 8 bit value into the provided 8 bit register.
-         * ld_rr_n      [2  |     8] [- - - -]
-         *
-         * @param reg       [IN]        Register to act on.
-         */
-        void ld_r_n(uint8 &reg);
-
-        /**
-         * Load register 1 into register 2.
-         * ld_r_r       [1  |     4] [- - - -]
-         *
-         * @param reg1      [IN]        The register to store to.
-         * @param reg2      [IN]        The register to store from.
-         */
-        void ld_r_r(uint8 &reg1, uint8 &reg2);
-
-        /**
-         * Load (HL) into register 2.
-         * ld_r_hl      [1  |     8] [- - - -]
-         *
-         * @param reg       [IN]        The register to store to.
-         */
-        void ld_r_hl(uint8 &reg);
-
-        /**
-         * Load register 2 into (HL).
-         * ld_hl_r      [1  |     8] [- - - -]
-         *
-         * @param reg       [IN]        The register to store to.
-         */
-        void ld_hl_r(uint8 &reg);
-
-        /**
-         * Store the contents of the top stack item into (HL).
-         * ld_hl_n      [2  |    12] [- - - -]
-         */
-        void ld_hl_n();
-
-        /**
-         * Store register A into memory address $FF00 + n.
-         * ldh_n_a      [2  |    12] [- - - -]
-         */
-        void ldh_n_a();
-
-        /**
-         * Store memory address $FF00 + n's value into register A.
-         * ldh_a_n      [2  |    12] [- - - -]
-         */
-        void ldh_a_n();
-
-        /**
-         * Store register A into memory address $FF00 + register c.
-         * ld_c_a       [2  |    12] [- - - -]
-         */
-        void ld_c_a();
-
-        /**
-         * Store memory address $FF00 + register C's value into register A.
-         * ld_a_c       [2  |    12] [- - - -]
-         */
-        void ld_a_c();
-
-        /**
-         * Store register A into memory address nn.
-         * ld_nn_a      [3  |    16] [- - - -]
-         */
-        void ld_nn_a();
-
-        /**
-         * Store memory address nn's valu  into register A.
-         * ld_a_nn      [3  |    16] [- - - -]
-         */
-        void ld_a_nn();
-
-        /************************\
-        |* 8 Bit Arithmetic Ops *|
-        \************************/
-
-        /**
-         * Add register to register A.
-         * add_a_r      [1  |     4] [Z 0 H C]
-         *
-         * @param reg       [IN]        Register to add to A.
-         */
-        void add_a_r(uint8 &reg);
-
-        /**
-         * Add (HL) to register A.
-         * add_a_hl     [1  |     8] [Z 0 H C]
-         */
-        void add_a_hl();
-
-        /**
-         * Add value on stack to register A.
-         * add_a_n      [1  |     8] [Z 0 H C]
-         */
-        void add_a_n();
-
-        /**
-         * Add register + carry bit to register A.
-         * adc_a_r      [1  |     4] [Z 0 H C]
-         *
-         * @param reg       [IN]        Register to add to A.
-         */
-        void adc_a_r(uint8 &reg);
-
-        /**
-         * Add (HL) + carry bit to register A.
-         * adc_a_hl     [1  |     8] [Z 0 H C]
-         */
-        void adc_a_hl();
-
-        /**
-         * Add value on stack + carry bit to register A.
-         * adc_a_n      [1  |     8] [Z 0 H C]
-         */
-        void adc_a_n();
-
-        /**
-         * Subtract value in register from register A.
-         * sub_a_r      [1  |     4] [Z 1 H C]
-         *
-         * @param reg       [IN]        Register to subtract A.
-         */
-        void sub_a_r(uint8 &reg);
-
-        /**
-         * Subtract (HL) from register A.
-         * sub_a_hl     [1  |     8] [Z 1 H C]
-         */
-        void sub_a_hl();
-
-        /**
-         * subtract value on stack from register A.
-         * add_a_n      [1  |     8] [Z 1 H C]
-         */
-        void sub_a_n();
-
-        /**
-         * Subtract register + carry bit from register A.
-         * sbc_a_r      [1  |     4] [Z 1 H C]
-         *
-         * @param reg       [IN]        Register to add to A.
-         */
-        void sbc_a_r(uint8 &reg);
-
-        /**
-         * Subtract + carry bit from register A.
-         * sbc_a_hl     [1  |     8] [Z 1 H C]
-         */
-        void sbc_a_hl();
-
-        /**
-         * Subtract value on stack + carry bit from register A.
-         * sbc_a_n      [1  |     8] [Z 1 H C]
-         */
-        void sbc_a_n();
-
-        /**
-         * Perform A = A & R.
-         * and_a_r      [1  |     4] [Z 0 1 0]
-         *
-         * @param reg       [IN]        Register to and with A.
-         */
-        void and_a_r(uint8 &reg);
-
-        /**
-         * Perform A = A | (HL).
-         * and_a_hl     [1  |     8] [Z 0 1 0]
-         */
-        void and_a_hl();
-
-        /**
-         * Perform A = A | n.
-         * and_a_n      [1  |     8] [Z 0 1 0]
-         */
-        void and_a_n();
-
-        /**
-         * Perform A = A ^ R.
-         * xor_a_r      [1  |     4] [Z 0 0 0]
-         *
-         * @param reg       [IN]        Register to xor with A.
-         */
-        void xor_a_r(uint8 &reg);
-
-        /**
-         * Perform A = A ^ (HL).
-         * xor_a_hl     [1  |     8] [Z 0 0 0]
-         */
-        void xor_a_hl();
-
-        /**
-         * Perform A = A ^ n.
-         * xor_a_n      [1  |     8] [Z 0 0 0]
-         */
-        void xor_a_n();
-
-        /**
-         * Perform A = A | R.
-         * or_a_r       [1  |     4] [Z 0 0 0]
-         *
-         * @param reg       [IN]        Register to or with A.
-         */
-        void or_a_r(uint8 &reg);
-
-        /**
-         * Perform A = A | (HL).
-         * or_a_hl      [1  |     8] [Z 0 0 0]
-         */
-        void or_a_hl();
-
-        /**
-         * Perform A = A | n.
-         * or_a_n       [1  |     8] [Z 0 0 0]
-         */
-        void or_a_n();
-
-        /**
-         * Compare register with register A.
-         * cp_a_r       [1  |     4] [Z 1 H C]
-         *
-         * @param reg       [IN]        Register to subtract A.
-         */
-        void cp_a_r(uint8 &reg);
-
-        /**
-         * Compare (HL) with register A.
-         * cp_a_hl      [1  |     8] [Z 1 H C]
-         */
-        void cp_a_hl();
-
-        /**
-         * Compare value on stack with register A.
-         * cp_a_n       [1  |     8] [Z 1 H C]
-         */
-        void cp_a_n();
-
-        /**
-         * Increment the 8 bit register.
-         * inc_r        [1  |     4] [Z 0 H -]
-         *
-         * @param reg       [IN]        Register to act on.
-         */
-        void inc_r(uint8 &reg);
-
-        /**
-         * Increment (hl).
-         * inc_hl       [1  |    12] [Z 0 H -]
-         */
-        void inc_hl();
-
-        /**
-         * Decrement the 8 bit register.
-         * dec_r        [1  |     4] [Z 1 H -]
-         *
-         * @param reg       [IN]        Register to act on.
-         */
-        void dec_r(uint8 &reg);
-
-        /**
-         * Decrement (hl).
-         * decc_hl      [1  |    12] [Z 1 H -]
-         */
-        void dec_hl();
-
-        /**
-         * Rotate A left.  Old bit 7 to carry flag register.
-         * rrca         [1  |     4] [0 0 0 C]
-         */
-        void rlca();
-
-        /**
-         * Rotate A left through carry flag.
-         * rlca         [1  |     4] [0 0 0 C]
-         */
-        void rla();
-
-        /**
-         * Rotate A right.  Old bit 0 to carry flag register.
-         * rrca         [1  |     4] [0 0 0 C]
-         */
-        void rrca();
-
-        /**
-         * Rotate A right through carry flag.
-         * rrca         [1  |     4] [0 0 0 C]
-         */
-        void rra();
-
-        /**
-         * Decimal adjust register A into BCD format.
-         * daa          [1  |     4] [Z - 0 C]
-         */
-        void daa();
-
-        /**
-         * Take the complement of register A.
-         * cpl          [1  |     4] [- 1 1 -]
-         */
-        void cpl();
-
-        /**
-         * Set the carry flag.
-         * scf          [1  |     4] [- 0 0 1]
-         */
-        void scf();
-
-        /**
-         * Take the complement of carry flag.
-         * ccf          [1  |     4] [- 0 0 C]
-         */
-        void ccf();
-
-        /************************\
-        |* 16 Bit Load Ops      *|
-        \************************/
-
-        /**
-         * Read 16 bits from the stack and store them in a 16 bit register.
-         * ld_rr_nn     [3  |    12] [- - - -]
-         *
-         * @param hReg      [IN]        High byte of the register.
-         * @param lReg      [IN]        Low byte of the register.
-         */
-        void ld_rr_nn(uint8 &hReg, uint8 &lReg);
-
-        /**
-         * Read 16 bits from the stack and store them in a 16 bit register.
-         * ld_rr_nn     [3  |    12] [- - - -]
-         *
-         * @param reg       [IN]        The register.
-         */
-        void ld_rr_nn(uint16 &reg);
-
-        /**
-         * Read 16 bits from the stack and store them in a 16 bit register.
-         * ld_nn_sp     [3  |    20] [- - - -]
-         */
-        void ld_nn_sp();
-
-        /**
-         * Store the contents of A into (HL) and increment HL.
-         * ldi_hl_a     [1  |     8] [- - - -]
-         */
-        void ldi_hl_a();
-
-        /**
-         * Store the contents of (HL) into A and increment HL.
-         * ldi_a_hl     [1  |     8] [- - - -]
-         */
-        void ldi_a_hl();
-
-        /**
-         * Store the contents of A into (HL) and deccrement HL.
-         * ldd_hl_a     [1  |     8] [- - - -]
-         */
-        void ldd_hl_a();
-
-        /**
-         * Store the contents of (HL) into A and deccrement HL.
-         * ldd_a_hl     [1  |     8] [- - - -]
-         */
-        void ldd_a_hl();
-
-        /**
-         * Store the contents of SP+N into HL.
-         * ldhl_sp_n    [2  |    12] [- - - -]
-         */
-        void ldhl_sp_n();
-
-        /**
-         * Store the contents of HL into SP.
-         * ld_sp_hl     [1  |     8] [- - - -]
-         */
-        void ld_sp_hl();
-
-        /**
-         * Pop 16 bits from stack into a register.
-         * pop_rr       [1  |    12] [- - - -]
-         *
-         * @param hReg      [IN]        High byte of the register.
-         * @param lReg      [IN]        Low byte of the register.
-         */
-        void pop_rr(uint8 &hReg, uint8 &lReg);
-
-        /**
-         * Push 16 bit register onto the stack.
-         * push_rr      [1  |    12] [- - - -]
-         *
-         * @param hReg      [IN]        High byte of the register.
-         * @param lReg      [IN]        Low byte of the register.
-         */
-        void push_rr(uint8 &hReg, uint8 &lReg);
-
-        /************************\
-        |* 16 Bit Arithmetic Ops*|
-        \************************/
-
-        /**
-         * Increment the 16 bit register.
-         * inc_rr       [1  |     8] [- - - -]
-         *
-         * @param hReg      [IN]        High byte of the register.
-         * @param lReg      [IN]        Low byte of the register.
-         */
-        void inc_rr(uint8 &hReg, uint8 &lReg);
-
-        /**
-         * Increment the 16 bit register.
-         * inc_rr       [1  |     8] [- - - -]
-         *
-         * @param reg       [IN]        The register.
-         */
-        void inc_rr(uint16 &reg);
-
-        /**
-         * Decrement the 16 bit register.
-         * dec_rr       [1  |     8] [Z 0 H -]
-         *
-         * @param hReg      [IN]        High byte of the register.
-         * @param lReg      [IN]        Low byte of the register.
-         */
-        void dec_rr(uint8 &hReg, uint8 &lReg);
-
-        /**
-         * Increment the 16 bit register.
-         * dec_rr       [1  |     8] [- - - -]
-         *
-         * @param reg       [IN]        The register.
-         */
-        void dec_rr(uint16 &reg);
-
-        /**
-         * Add value in 16 bit register to HL.
-         * add_hl_rr    [1  |     8] [- 0 H C]
-         *
-         * @param hReg      [IN]        High byte of the register.
-         * @param lReg      [IN]        Low byte of the register.
-         */
-        void add_hl_rr(uint8 &hReg, uint8 &lReg);
-
-        /**
-         * Add value in 16 bit register to HL.
-         * add_hl_rr    [1  |     8] [- 0 H C]
-         *
-         * @param reg       [IN]        The register.
-         */
-        void add_hl_rr(uint16 &reg);
-
-        /**
-         * Add one byte signed value to SP.
-         * add_sp_n     [2  |    16] [0 0 H C]
-         */
-        void add_sp_n();
-
-        /************************\
-        |* CB Prefix Operations *|
-        \************************/
-
-        /**
-         * Rotate register left. Old bit 7 to carry flag.
-         * rlc_r        [2  |     8] [Z 0 0 C]
-         *
-         * @param reg       [IN]        Register to operate on.
-         */
-        void rlc_r(uint8 &reg);
-
-        /**
-         * Rotate (HL) left. Old bit 7 to carry flag.
-         * rlc_hl       [2  |    16] [Z 0 0 C]
-         */
-        void rlc_hl();
-
-        /**
-         * Rotate register left through carry
-         * rl_r         [2  |     8] [Z 0 0 C]
-         *
-         * @param reg       [IN]        Register to operate on.
-         */
-        void rl_r(uint8 &reg);
-
-        /**
-         * Rotate (HL) left through carry.
-         * rl_hl        [2  |    16] [Z 0 0 C]
-         */
-        void rl_hl();
-
-        /**
-         * Rotate register right. Old bit 7 to carry flag.
-         * rrc_r        [2  |     8] [Z 0 0 C]
-         *
-         * @param reg       [IN]        Register to operate on.
-         */
-        void rrc_r(uint8 &reg);
-
-        /**
-         * Rotate (HL) right. Old bit 7 to carry flag.
-         * rrc_hl       [2  |    16] [Z 0 0 C]
-         */
-        void rrc_hl();
-
-        /**
-         * Rotate register right through carry
-         * rr_r         [2  |     8] [Z 0 0 C]
-         *
-         * @param reg       [IN]        Register to operate on.
-         */
-        void rr_r(uint8 &reg);
-
-        /**
-         * Rotate (HL) right through carry.
-         * rr_hl        [2  |    16] [Z 0 0 C]
-         */
-        void rr_hl();
-
-        /**
-         * Shift register left into carry. LSB set to 0.
-         * sla_r        [2  |     8] [Z 0 0 C]
-         *
-         * @param reg       [IN]        Register to operate on.
-         */
-        void sla_r(uint8 &reg);
-
-        /**
-         * Shift (HL) left into carry. LSB set to 0.
-         * sla_hl       [2  |    16] [Z 0 0 C]
-         */
-        void sla_hl();
-
-        /**
-         * Shift register right into carry. MSB unchanged.
-         * sra_r        [2  |     8] [Z 0 0 0]
-         *
-         * @param reg       [IN]        Register to operate on.
-         */
-        void sra_r(uint8 &reg);
-
-        /**
-         * Shift (HL) right into carry. MSB set to 0.
-         * sra_hl       [2  |    16] [Z 0 0 0]
-         */
-        void sra_hl();
-
-        /**
-         * Shift register right into carry. MSB set to 0.
-         * srl_r        [2  |     8] [Z 0 0 C]
-         *
-         * @param reg       [IN]        Register to operate on.
-         */
-        void srl_r(uint8 &reg);
-
-        /**
-         * Shift (HL) right into carry. MSB set to 0.
-         * srl_hl       [2  |    16] [Z 0 0 C]
-         */
-        void srl_hl();
-
-        /**
-         * Swap upper and lower nibbles of the register.
-         * swap_r       [2  |     8] [Z 0 0 0]
-         *
-         * @param reg       [IN]        Register to operate on.
-         */
-        void swap_r(uint8 &reg);
-
-        /**
-         * Swap upper and lower nibbles of the register.
-         * swap_hl      [2  |    16] [Z 0 0 0]
-         */
-        void swap_hl();
-
-        /**
-         * Test bit in a given register.
-         * bit          [2  |     8] [Z 0 1 -]
-         *
-         * @param bit       [IN]        Bit position to operate on.
-         * @param reg       [IN]        Register to operate on.
-         */
-        void bit_b_r(const uint8 bit, const uint8 &reg);
-
-        /**
-         * Test bit in (HL).
-         * bit_hl       [2  |    16] [Z 0 1 -]
-         *
-         * @param bit       [IN]        Bit position to operate on.
-         */
-        void bit_b_hl(const uint8 bit);
-
-        /**
-         * Reset bit in a given register.
-         * res          [2  |     8] [- - - -]
-         *
-         * @param bit       [IN]        Bit position to operate on.
-         * @param reg       [IN]        Register to operate on.
-         */
-        void res_b_r(const uint8 bit, uint8 &reg);
-
-        /**
-         * Test bit in (HL).
-         * res_hl       [2  |    16] [- - - -]
-         *
-         * @param bit       [IN]        Bit position to operate on.
-         */
-        void res_b_hl(const uint8 bit);
-
-        /**
-         * Set bit in a given register.
-         * set          [2  |     8] [- - - -]
-         *
-         * @param bit       [IN]        Bit position to operate on.
-         * @param reg       [IN]        Register to operate on.
-         */
-        void set_b_r(const uint8 bit, uint8 &reg);
-
-        /**
-         * Set bit in (HL).
-         * set_hl       [2  |    16] [Z 0 1 -]
-         *
-         * @param bit       [IN]        Bit position to operate on.
-         */
-        void set_b_hl(const uint8 bit);
-
-    private:
-        /************************\
-        |* Data Types           *|
-        \************************/
-
-        /* Registers in the cpu */
-        struct _REGISTERS {
-            uint8   a;  // Accumulator register
-            uint8   f;  // Flags register: Bits [ZNHC0000]
-            #define LR35902_FLAG_ZERO           (0x01 << 7)
-            #define LR35902_FLAG_SUBTRACT       (0x01 << 6)
-            #define LR35902_FLAG_HALF_CARRY     (0x01 << 5)
-            #define LR35902_FLAG_CARRY          (0x01 << 4)
-            uint8   b;  // b
-            uint8   c;  // c
-            uint8   d;  // d
-            uint8   e;  // e
-            uint8   h;  // h
-            uint8   l;  // l
-
-            uint16  sp; // Stack pointer
-            uint16  pc; // Program Counter
-        } r;
-    };
-
-} /* END: Nintendo */ } /* END: Processors */ } /* END: SiNES */
+#ifndef SINES_LR35902_H             /* START: HEADER GUARD */
+#define SINES_LR35902_H
+
+#include "Memory/Arena.hpp"
+#include "Memory/Bus.hpp"
+#include "Processors/Processor.hpp"
+#include "Processors/Nintendo/LR35902/config.hpp"
+#include "Processors/Nintendo/LR35902/block.hpp"
+#include "Processors/Nintendo/LR35902/jit.hpp"
+
+namespace SiNES { namespace Processors { namespace Nintendo {
+    /* Interrupt sources, the bit of each source in IF (0xFF0F) and IE (0xFFFF). */
+    #define LR35902_INT_VBLANK          0
+    #define LR35902_INT_LCD_STAT        1
+    #define LR35902_INT_TIMER           2
+    #define LR35902_INT_SERIAL          3
+    #define LR35902_INT_JOYPAD          4
+    #define LR35902_INT_COUNT           5
+
+    /* Scheduled cycle of a source that is not scheduled. */
+    #define LR35902_NEVER               0xFFFFFFFFFFFFFFFFULL
+
+    /* Run time instrumentation counters. */
+    typedef struct _LR35902_STATS {
+        uint64  haltCycles; // Cycles fast-forwarded while halted or stopped.
+        uint64  idleLoops;  // Idle loops detected.
+        uint64  idleCycles; // Cycles fast-forwarded in idle loops.
+        uint64  fusions[LR35902_FUSE_COUNT];    // Fused loops run in bulk, by LR35902_FUSE_* kind.
+        uint64  fusedIterations;                // Loop iterations run in bulk.
+        uint64  interrupts; // Interrupts taken.
+    } LR35902_STATS;
+
+#if LR35902_TIMING == LR35902_TIMING_ACCESS
+    /* Hook called on every data access, with the master cycle count at the end of the accessing op. */
+    typedef void (*LR35902_ACCESS_HOOK)(void *context, uint16 addr, bool write, uint64 cycle);
+#endif
+
+    /**
+     * The LR35902 Processor class.
+     */
+    class LR35902 : public SiNES::Processors::Processor {
+    public:
+        /**
+         * Constructor for an LR35902 processor.
+         *
+         * @param arena     [IN]        Arena to carve the block cache out of, NULL to allocate it.  Construct
+         *                              the processor itself in the arena first so its hot fields lead it.
+         */
+        explicit LR35902(SiNES::Memory::Arena *arena = NULL);
+
+        /**
+         * Destructor for an LR35902 processor.
+         */
+        virtual ~LR35902();
+
+        /**
+         * Execute the next processor level operation, taking a pending interrupt first.
+         */
+        virtual void execOp();
+
+        /**
+         * Run decoded blocks until one of a set of events is raised or a cycle budget is spent.  Interrupts are
+         * taken and events checked between blocks, a taken interrupt raises PROCESSOR_EVENT_INTERRUPT and its
+         * handler runs from the next run.
+         *
+         * @param events    [IN]        Mask of PROCESSOR_EVENT_* that end the run.
+         * @param cycles    [IN]        The cycle budget.
+         *
+         * @return The number of clock cycles consumed, the last block may overrun the budget.
+         */
+        virtual uint32 runUntil(uint32 events, uint32 cycles);
+
+        /**
+         * Execute the next operation through the hand written op code switch.
+         */
+        void execOpSwitch();
+
+        /**
+         * Execute the next operation through the compile time generated dispatch tables.
+         */
+        void execOpTable();
+
+        /**
+         * Execute the decoded block starting at the PC from the block cache, decoding it first if needed.
+         *
+         * @return The number of clock cycles taken by the executed ops.
+         */
+        uint32 execBlock();
+
+        /**
+         * Attach flat host memory to the bus, 0x0000-0x7FFF read only and 0x8000-0xFFFF writable.
+         *
+         * @param memory    [IN]        64KB of host memory backing the address space.
+         */
+        void attachMemory(uint8 *memory);
+
+        /**
+         * Attach a ROM image to 0x0000-0x7FFF, bank 0 and bank 1.  The image is only read, so every instance
+         * running a title maps the one shared image, and a mapper switches banks by mapping other parts of it on
+         * the bus.
+         *
+         * @param rom       [IN]        The ROM image.
+         * @param size      [IN]        Size of the ROM image in bytes.
+         */
+        void attachRom(const uint8 *rom, uint32 size);
+
+        /**
+         * Attach the instance's own RAM to 0x8000-0xFFFF.
+         *
+         * @param ram       [IN]        32KB of host memory for VRAM, external RAM, WRAM, OAM and I/O.
+         */
+        void attachRam(uint8 *ram);
+
+        /**
+         * Get the memory bus of the processor, for mapping ROM banks, RAM and I/O handlers.
+         *
+         * @return The bus.
+         */
+        SiNES::Memory::Bus &getBus();
+
+#if LR35902_TIMING != LR35902_TIMING_NONE
+        /**
+         * Get the master cycle counter.
+         *
+         * @return The number of clock cycles run since the processor was created.
+         */
+        uint64 cycleCount() const;
+#endif
+
+        /**
+         * Get the instrumentation counters.
+         *
+         * @return The counters since the processor was created.
+         */
+        const LR35902_STATS &getStats() const;
+
+        /**
+         * Account for the memory held by the processor: the object, the block cache and any translated code
+         * are per instance, the dispatch, decode and ALU tables are shared.
+         *
+         * @param usage     [OUT]       The instance and shared bytes.
+         */
+        virtual void memoryUsage(PROCESSOR_MEMORY &usage) const;
+
+#if LR35902_TIMING != LR35902_TIMING_NONE
+        /**
+         * Schedule an interrupt source to raise its IF bit when the master cycle counter reaches a cycle.  The
+         * peripheral behind the source catches up lazily when it is next accessed, a halted processor skips
+         * straight to the earliest scheduled cycle.
+         *
+         * @param source    [IN]        The LR35902_INT_* source.
+         * @param cycle     [IN]        The master cycle to raise the source at, LR35902_NEVER to cancel it.
+         */
+        void schedule(uint8 source, uint64 cycle);
+
+        /**
+         * Switch idle loop skipping, off by default.  A polling loop that reads memory, writes nothing and
+         * ends an iteration with the registers unchanged is fast-forwarded to the next scheduled cycle.  Loops
+         * reading DIV, the timer, the LCD status or LY always run, as these count between scheduled cycles.
+         * This assumes other polled memory only changes at scheduled cycles, so it is enabled per ROM.
+         *
+         * @param enable    [IN]        True to skip idle loops in runUntil.
+         */
+        void setIdleSkip(bool enable);
+#endif
+
+#if LR35902_TIMING == LR35902_TIMING_ACCESS
+        /**
+         * Set the hook called on every data access.
+         *
+         * @param hook      [IN]        The hook, NULL to remove it.
+         * @param context   [IN]        Passed to the hook.
+         */
+        void setAccessHook(LR35902_ACCESS_HOOK hook, void *context);
+#endif
+
+#if LR35902_JIT
+        /**
+         * Switch between translated and interpreted execution of blocks.
+         *
+         * @param enable    [IN]        True to run translated blocks from execBlock.
+         */
+        void setJit(bool enable);
+#endif
+
+        /**
+         * Drop host state a restored snapshot of the processor's memory may have made stale, the translated
+         * code of its blocks.
+         */
+        void restored();
+
+    protected:
+        /************************************************\
+        |* Op Code Functions                            *|
+        \************************************************/
+        /*
+        FORMAT for processor operation functions: <mnemonic> [#1 |    #2] [Z H N C]
+        Where:
+            mnemonic            : Is the processor operation mnemonic associated with the instruction
+            #1                  : The length in bytes read from the stack.
+            #2                  : The duration in clock cycles.
+            Z - Zero Flag       : Set when a math operation is zero or two values match with CP.
+            H - Subtract Flag   : Set if the last operation used subtraction.
+            N - Half Carry Flag : If the lower nibble carried in the math operation.
+            C - Carry Flag      : Set if a carry occurred from the last math operation or register A is smaller in with CP.
+        Z,H,N,C are flags that were affected by the operation.
+            * If the flag is marked by a "0" it is reset after instruction run.
+            * If the flag is marked by a "1" it is set after instruction run.
+            * If the flag is marked by a "-" it is unchanged.
+            * If the flag is marked by the corresponding symbol it is affected by the function as normal.
+        */
+
+        /************************\
+        |* Misc. Operations     *|
+        \************************/
+
+        /**
+         * The no operation op.
+         * nop          [1  |     4] [- - - -]
+         */
+        void nop();
+
+        /**
+         * The stop operation.
+         * stop         [2  |     4] [- - - -]
+         */
+        void stop();
+
+        /**
+         * The halt operation.
+         * halt         [1  |     4] [- - - -]
+         */
+        void halt();
+
+        /**
+         * Disable interrupts.
+         * di           [1  |     4] [- - - -]
+         */
+        void di();
+
+        /**
+         * Enable interrupts once the next op has run.
+         * ei           [1  |     4] [- - - -]
+         */
+        void ei();
+
+        /************************\
+        |* Jump/Call Operations *|
+        \************************/
+
+        /**
+         * Jump return operation.
+         * jr_n         [1  |    12] [- - - -]
+         */
+        void jr_n();
+
+        /**
+         * Jump return operation on condition.
+         * jr_cc_n      [1  |  12/8] [- - - -]
+         *
+         * @param set       [IN]        True if the flag should be checked for set.
+         * @param flags     [IN]        The flags to check for being set.
+         */
+        void jr_cc_n(bool set, uint8 flags);
+
+        /**
+         * Jump operation.
+         * jp_nn        [1  |    16] [- - - -]
+         */
+        void jp_nn();
+
+        /**
+         * Jump operation based on value (HL).
+         * jp_hl        [1  |    16] [- - - -]
+         */
+        void jp_hl();
+
+        /**
+         * Jump operation on condition.
+         * jp_cc_nn     [1  | 16/12] [- - - -]
+         *
+         * @param set       [IN]        True if the flag should be checked for set.
+         * @param flags     [IN]        The flags to check for being set.
+         */
+        void jp_cc_nn(bool set, uint8 flags);
+
+        /**
+         * The call operation.
+         * call_cc_nn   [1  |    24] [- - - -]
+         */
+        void call_nn();
+
+        /**
+         * Call operation on condition.
+         * call_cc_nn   [1  | 16/12] [- - - -]
+         *
+         * @param set       [IN]        True if the flag should be checked for set.
+         * @param flags     [IN]        The flags to check for being set.
+         */
+        void call_cc_nn(bool set, uint8 flags);
+
+        /**
+         * return operation on condition.
+         * ret          [1  |    16] [- - - -]
+         */
+        void ret();
+
+        /**
+         * Return operation and enable interupt.
+         * reti         [1  |    16] [- - - -]
+         */
+        void reti();
+
+        /**
+         * return operation on condition.
+         * ret_cc       [1  |  20/8] [- - - -]
+         *
+         * @param set       [IN]        True if the flag should be checked for set.
+         * @param flags     [IN]        The flags to check for being set.
+         */
+        void ret_cc(bool set, uint8 flags);
+
+        /**
+         * Push present address onto the stack and jump to address 0x0000 + n.
+         * rst_n        [1  |    16] [- - - -]
+         *
+         * @param address   [IN]        The offset to jump to.
+         */
+        void rst_n(uint8 offset);
+
+        /************************\
+        |* 8 Bit Load Ops       *|
+        \************************/
+
+        /**
+         * Store the accumulator register into the address in the provided register.
+         * ld_rr_a      [1  |     8] [- - - -]
+         *
+         * @param reg       [IN]        The register.
+         */
+        void ld_rr_a(uint16 &reg);
+
+        /**
+         * Store the value at the address in the provided register into the accumulator.
+         * ld_a_rr      [1  |     8] [- - - -]
+         *
+         * @param reg       [IN]        The register.
+         */
+        void ld_a_rr(uint16 &reg);
+
+        /**
+         * Store the 8 bit value into the provided 8 bit register.
+         * ld_rr_n      [2  |     8] [- - - -]
+         *
+         * @param reg       [IN]        Register to act on.
+         */
+        void ld_r_n(uint8 &reg);
+
+        /**
+         * Load register 1 into register 2.
+         * ld_r_r       [1  |     4] [- - - -]
+         *
+         * @param reg1      [IN]        The register to store to.
+         * @param reg2      [IN]        The register to store from.
+         */
+        void ld_r_r(uint8 &reg1, uint8 &reg2);
+
+        /**
+         * Load (HL) into register 2.
+         * ld_r_hl      [1  |     8] [- - - -]
+         *
+         * @param reg       [IN]        The register to store to.
+         */
+        void ld_r_hl(uint8 &reg);
+
+        /**
+         * Load register 2 into (HL).
+         * ld_hl_r      [1  |     8] [- - - -]
+         *
+         * @param reg       [IN]        The register to store to.
+         */
+        void ld_hl_r(uint8 &reg);
+
+        /**
+         * Store the contents of the top stack item into (HL).
+         * ld_hl_n      [2  |    12] [- - - -]
+         */
+        void ld_hl_n();
+
+        /**
+         * Store register A into memory address $FF00 + n.
+         * ldh_n_a      [2  |    12] [- - - -]
+         */
+        void ldh_n_a();
+
+        /**
+         * Store memory address $FF00 + n's value into register A.
+         * ldh_a_n      [2  |    12] [- - - -]
+         */
+        void ldh_a_n();
+
+        /**
+         * Store register A into memory address $FF00 + register c.
+         * ld_c_a       [2  |    12] [- - - -]
+         */
+        void ld_c_a();
+
+        /**
+         * Store memory address $FF00 + register C's value into register A.
+         * ld_a_c       [2  |    12] [- - - -]
+         */
+        void ld_a_c();
+
+        /**
+         * Store register A into memory address nn.
+         * ld_nn_a      [3  |    16] [- - - -]
+         */
+        void ld_nn_a();
+
+        /**
+         * Store memory address nn's valu  into register A.
+         * ld_a_nn      [3  |    16] [- - - -]
+         */
+        void ld_a_nn();
+
+        /************************\
+        |* 8 Bit Arithmetic Ops *|
+        \************************/
+
+        /**
+         * Add register to register A.
+         * add_a_r      [1  |     4] [Z 0 H C]
+         *
+         * @param reg       [IN]        Register to add to A.
+         */
+        void add_a_r(uint8 &reg);
+
+        /**
+         * Add (HL) to register A.
+         * add_a_hl     [1  |     8] [Z 0 H C]
+         */
+        void add_a_hl();
+
+        /**
+         * Add value on stack to register A.
+         * add_a_n      [1  |     8] [Z 0 H C]
+         */
+        void add_a_n();
+
+        /**
+         * Add register + carry bit to register A.
+         * adc_a_r      [1  |     4] [Z 0 H C]
+         *
+         * @param reg       [IN]        Register to add to A.
+         */
+        void adc_a_r(uint8 &reg);
+
+        /**
+         * Add (HL) + carry bit to register A.
+         * adc_a_hl     [1  |     8] [Z 0 H C]
+         */
+        void adc_a_hl();
+
+        /**
+         * Add value on stack + carry bit to register A.
+         * adc_a_n      [1  |     8] [Z 0 H C]
+         */
+        void adc_a_n();
+
+        /**
+         * Subtract value in register from register A.
+         * sub_a_r      [1  |     4] [Z 1 H C]
+         *
+         * @param reg       [IN]        Register to subtract A.
+         */
+        void sub_a_r(uint8 &reg);
+
+        /**
+         * Subtract (HL) from register A.
+         * sub_a_hl     [1  |     8] [Z 1 H C]
+         */
+        void sub_a_hl();
+
+        /**
+         * subtract value on stack from register A.
+         * add_a_n      [1  |     8] [Z 1 H C]
+         */
+        void sub_a_n();
+
+        /**
+         * Subtract register + carry bit from register A.
+         * sbc_a_r      [1  |     4] [Z 1 H C]
+         *
+         * @param reg       [IN]        Register to add to A.
+         */
+        void sbc_a_r(uint8 &reg);
+
+        /**
+         * Subtract + carry bit from register A.
+         * sbc_a_hl     [1  |     8] [Z 1 H C]
+         */
+        void sbc_a_hl();
+
+        /**
+         * Subtract value on stack + carry bit from register A.
+         * sbc_a_n      [1  |     8] [Z 1 H C]
+         */
+        void sbc_a_n();
+
+        /**
+         * Perform A = A & R.
+         * and_a_r      [1  |     4] [Z 0 1 0]
+         *
+         * @param reg       [IN]        Register to and with A.
+         */
+        void and_a_r(uint8 &reg);
+
+        /**
+         * Perform A = A | (HL).
+         * and_a_hl     [1  |     8] [Z 0 1 0]
+         */
+        void and_a_hl();
+
+        /**
+         * Perform A = A | n.
+         * and_a_n      [1  |     8] [Z 0 1 0]
+         */
+        void and_a_n();
+
+        /**
+         * Perform A = A ^ R.
+         * xor_a_r      [1  |     4] [Z 0 0 0]
+         *
+         * @param reg       [IN]        Register to xor with A.
+         */
+        void xor_a_r(uint8 &reg);
+
+        /**
+         * Perform A = A ^ (HL).
+         * xor_a_hl     [1  |     8] [Z 0 0 0]
+         */
+        void xor_a_hl();
+
+        /**
+         * Perform A = A ^ n.
+         * xor_a_n      [1  |     8] [Z 0 0 0]
+         */
+        void xor_a_n();
+
+        /**
+         * Perform A = A | R.
+         * or_a_r       [1  |     4] [Z 0 0 0]
+         *
+         * @param reg       [IN]        Register to or with A.
+         */
+        void or_a_r(uint8 &reg);
+
+        /**
+         * Perform A = A | (HL).
+         * or_a_hl      [1  |     8] [Z 0 0 0]
+         */
+        void or_a_hl();
+
+        /**
+         * Perform A = A | n.
+         * or_a_n       [1  |     8] [Z 0 0 0]
+         */
+        void or_a_n();
+
+        /**
+         * Compare register with register A.
+         * cp_a_r       [1  |     4] [Z 1 H C]
+         *
+         * @param reg       [IN]        Register to subtract A.
+         */
+        void cp_a_r(uint8 &reg);
+
+        /**
+         * Compare (HL) with register A.
+         * cp_a_hl      [1  |     8] [Z 1 H C]
+         */
+        void cp_a_hl();
+
+        /**
+         * Compare value on stack with register A.
+         * cp_a_n       [1  |     8] [Z 1 H C]
+         */
+        void cp_a_n();
+
+        /**
+         * Increment the 8 bit register.
+         * inc_r        [1  |     4] [Z 0 H -]
+         *
+         * @param reg       [IN]        Register to act on.
+         */
+        void inc_r(uint8 &reg);
+
+        /**
+         * Increment (hl).
+         * inc_hl       [1  |    12] [Z 0 H -]
+         */
+        void inc_hl();
+
+        /**
+         * Decrement the 8 bit register.
+         * dec_r        [1  |     4] [Z 1 H -]
+         *
+         * @param reg       [IN]        Register to act on.
+         */
+        void dec_r(uint8 &reg);
+
+        /**
+         * Decrement (hl).
+         * decc_hl      [1  |    12] [Z 1 H -]
+         */
+        void dec_hl();
+
+        /**
+         * Rotate A left.  Old bit 7 to carry flag register.
+         * rrca         [1  |     4] [0 0 0 C]
+         */
+        void rlca();
+
+        /**
+         * Rotate A left through carry flag.
+         * rlca         [1  |     4] [0 0 0 C]
+         */
+        void rla();
+
+        /**
+         * Rotate A right.  Old bit 0 to carry flag register.
+         * rrca         [1  |     4] [0 0 0 C]
+         */
+        void rrca();
+
+        /**
+         * Rotate A right through carry flag.
+         * rrca         [1  |     4] [0 0 0 C]
+         */
+        void rra();
+
+        /**
+         * Decimal adjust register A into BCD format.
+         * daa          [1  |     4] [Z - 0 C]
+         */
+        void daa();
+
+        /**
+         * Take the complement of register A.
+         * cpl          [1  |     4] [- 1 1 -]
+         */
+        void cpl();
+
+        /**
+         * Set the carry flag.
+         * scf          [1  |     4] [- 0 0 1]
+         */
+        void scf();
+
+        /**
+         * Take the complement of carry flag.
+         * ccf          [1  |     4] [- 0 0 C]
+         */
+        void ccf();
+
+        /************************\
+        |* 16 Bit Load Ops      *|
+        \************************/
+
+        /**
+         * Read 16 bits from the stack and store them in a 16 bit register.
+         * ld_rr_nn     [3  |    12] [- - - -]
+         *
+         * @param reg       [IN]        The register.
+         */
+        void ld_rr_nn(uint16 &reg);
+
+        /**
+         * Read 16 bits from the stack and store them in a 16 bit register.
+         * ld_nn_sp     [3  |    20] [- - - -]
+         */
+        void ld_nn_sp();
+
+        /**
+         * Store the contents of A into (HL) and increment HL.
+         * ldi_hl_a     [1  |     8] [- - - -]
+         */
+        void ldi_hl_a();
+
+        /**
+         * Store the contents of (HL) into A and increment HL.
+         * ldi_a_hl     [1  |     8] [- - - -]
+         */
+        void ldi_a_hl();
+
+        /**
+         * Store the contents of A into (HL) and deccrement HL.
+         * ldd_hl_a     [1  |     8] [- - - -]
+         */
+        void ldd_hl_a();
+
+        /**
+         * Store the contents of (HL) into A and deccrement HL.
+         * ldd_a_hl     [1  |     8] [- - - -]
+         */
+        void ldd_a_hl();
+
+        /**
+         * Store the contents of SP+N into HL.
+         * ldhl_sp_n    [2  |    12] [0 0 H C]
+         */
+        void ldhl_sp_n();
+
+        /**
+         * Store the contents of HL into SP.
+         * ld_sp_hl     [1  |     8] [- - - -]
+         */
+        void ld_sp_hl();
+
+        /**
+         * Pop 16 bits from stack into a register.
+         * pop_rr       [1  |    12] [- - - -]
+         *
+         * @param reg       [IN]        The register.
+         */
+        void pop_rr(uint16 &reg);
+
+        /**
+         * Push 16 bit register onto the stack.
+         * push_rr      [1  |    12] [- - - -]
+         *
+         * @param reg       [IN]        The register.
+         */
+        void push_rr(uint16 &reg);
+
+        /************************\
+        |* 16 Bit Arithmetic Ops*|
+        \************************/
+
+        /**
+         * Increment the 16 bit register.
+         * inc_rr       [1  |     8] [- - - -]
+         *
+         * @param reg       [IN]        The register.
+         */
+        void inc_rr(uint16 &reg);
+
+        /**
+         * Decrement the 16 bit register.
+         * dec_rr       [1  |     8] [- - - -]
+         *
+         * @param reg       [IN]        The register.
+         */
+        void dec_rr(uint16 &reg);
+
+        /**
+         * Add value in 16 bit register to HL.
+         * add_hl_rr    [1  |     8] [- 0 H C]
+         *
+         * @param reg       [IN]        The register.
+         */
+        void add_hl_rr(uint16 &reg);
+
+        /**
+         * Add one byte signed value to SP.
+         * add_sp_n     [2  |    16] [0 0 H C]
+         */
+        void add_sp_n();
+
+        /************************\
+        |* CB Prefix Operations *|
+        \************************/
+
+        /*
+         * Register forms only, the (HL) forms are decoded by cb_op which reads the operand from the bus and writes
+         * the result back.
+         */
+
+        /**
+         * Rotate register left. Old bit 7 to carry flag.
+         * rlc_r        [2  |     8] [Z 0 0 C]
+         *
+         * @param reg       [IN]        Register to operate on.
+         */
+        void rlc_r(uint8 &reg);
+
+        /**
+         * Rotate register left through carry
+         * rl_r         [2  |     8] [Z 0 0 C]
+         *
+         * @param reg       [IN]        Register to operate on.
+         */
+        void rl_r(uint8 &reg);
+
+        /**
+         * Rotate register right. Old bit 7 to carry flag.
+         * rrc_r        [2  |     8] [Z 0 0 C]
+         *
+         * @param reg       [IN]        Register to operate on.
+         */
+        void rrc_r(uint8 &reg);
+
+        /**
+         * Rotate register right through carry
+         * rr_r         [2  |     8] [Z 0 0 C]
+         *
+         * @param reg       [IN]        Register to operate on.
+         */
+        void rr_r(uint8 &reg);
+
+        /**
+         * Shift register left into carry. LSB set to 0.
+         * sla_r        [2  |     8] [Z 0 0 C]
+         *
+         * @param reg       [IN]        Register to operate on.
+         */
+        void sla_r(uint8 &reg);
+
+        /**
+         * Shift register right into carry. MSB unchanged.
+         * sra_r        [2  |     8] [Z 0 0 C]
+         *
+         * @param reg       [IN]        Register to operate on.
+         */
+        void sra_r(uint8 &reg);
+
+        /**
+         * Shift register right into carry. MSB set to 0.
+         * srl_r        [2  |     8] [Z 0 0 C]
+         *
+         * @param reg       [IN]        Register to operate on.
+         */
+        void srl_r(uint8 &reg);
+
+        /**
+         * Swap upper and lower nibbles of the register.
+         * swap_r       [2  |     8] [Z 0 0 0]
+         *
+         * @param reg       [IN]        Register to operate on.
+         */
+        void swap_r(uint8 &reg);
+
+        /**
+         * Test bit in a given register.
+         * bit          [2  |     8] [Z 0 1 -]
+         *
+         * @param bit       [IN]        Bit position to operate on.
+         * @param reg       [IN]        Register to operate on.
+         */
+        void bit_b_r(const uint8 bit, const uint8 &reg);
+
+        /**
+         * Reset bit in a given register.
+         * res          [2  |     8] [- - - -]
+         *
+         * @param bit       [IN]        Bit position to operate on.
+         * @param reg       [IN]        Register to operate on.
+         */
+        void res_b_r(const uint8 bit, uint8 &reg);
+
+        /**
+         * Set bit in a given register.
+         * set          [2  |     8] [- - - -]
+         *
+         * @param bit       [IN]        Bit position to operate on.
+         * @param reg       [IN]        Register to operate on.
+         */
+        void set_b_r(const uint8 bit, uint8 &reg);
+
+    private:
+        /************************\
+        |* Data Types           *|
+        \************************/
+
+        /* Registers in the cpu, the 8 bit registers ordered so each pair is in host byte order. */
+        struct _REGISTERS {
+        #if SINES_BIG_ENDIAN
+            uint8   a, f;       // Accumulator and flags register: Bits [ZNHC0000]
+            uint8   b, c;
+            uint8   d, e;
+            uint8   h, l;
+        #else
+            uint8   f, a;       // Flags register: Bits [ZNHC0000] and accumulator.
+            uint8   c, b;
+            uint8   e, d;
+            uint8   l, h;
+        #endif
+            #define LR35902_FLAG_ZERO           (0x01 << 7)
+            #define LR35902_FLAG_SUBTRACT       (0x01 << 6)
+            #define LR35902_FLAG_HALF_CARRY     (0x01 << 5)
+            #define LR35902_FLAG_CARRY          (0x01 << 4)
+        };
+
+        /* The register pairs over the 8 bit registers, with the 16 bit only registers. */
+        struct _PAIRS {
+            uint16  af;
+            uint16  bc;
+            uint16  de;
+            uint16  hl;
+            uint16  sp; // Stack pointer
+            uint16  pc; // Program Counter
+        };
+
+        /* The pairs overlay the 8 bit registers, so a pair is read and written with one 16 bit access. */
+        union {
+            _REGISTERS  r;
+            _PAIRS      rr;
+        };
+
+        /* Deferred flag state, see LR35902_FLAGS_LAZY in config.hpp. */
+        struct _LAZY_FLAGS {
+            uint8   op; // Kind of the last flag producing op, r.f is current when NONE.
+            #define LR35902_LAZY_NONE           0x00    // r.f holds the flags.
+            #define LR35902_LAZY_ADD            0x01    // [Z 0 H C] of x + y + c
+            #define LR35902_LAZY_SUB            0x02    // [Z 1 H C] of x - y - c
+            #define LR35902_LAZY_INC            0x03    // [Z 0 H c] of x + 1
+            #define LR35902_LAZY_DEC            0x04    // [Z 1 H c] of x - 1
+            #define LR35902_LAZY_AND            0x05    // [Z 0 1 0] of res
+            #define LR35902_LAZY_LOGIC          0x06    // [Z 0 0 0] of res
+            #define LR35902_LAZY_ROT            0x07    // [Z 0 0 C] of res, carry out in bit 8
+            #define LR35902_LAZY_ROTA           0x08    // [0 0 0 C] of res, carry out in bit 8
+            #define LR35902_LAZY_BIT            0x09    // [Z 0 1 c] of res
+            uint8   x;  // First operand
+            uint8   y;  // Second operand
+            uint8   c;  // Carry in, or the carry flag to preserve.
+            uint16  res;// Result including the carry out in bit 8.
+        } lf;
+
+        uint16  imm;        // Immediate operand of the executing op (the op code for CB ops).
+        bool    ime;        // Interrupt master enable.
+        bool    imePending; // Set by ei, ime follows once the next op has run.
+        bool    halted;     // Waiting for an interrupt after halt or stop.
+
+        /* The hot state above and the counters below share the first cache lines, the page table follows. */
+#if LR35902_TIMING != LR35902_TIMING_NONE
+        uint64  cycles;     // Master cycle counter, advanced once per op.
+    #define LR35902_ADD_CYCLES(N)   (this->cycles += (N))
+        uint64  nextDue;    // Earliest scheduled cycle.
+    #if LR35902_FUSION
+        uint64  runEnd;     // Cycle the budget of runUntil ends at, fused loops stop short of it.
+    #endif
+#else
+    #define LR35902_ADD_CYCLES(N)
+#endif
+        SiNES::Memory::Bus bus; // Address space, decoded RAM pages are watched for writes.
+
+        const uint8 *rom;   // Shared ROM image, NULL if flat memory is attached.
+        uint32  romSize;    // Size of the ROM image in bytes.
+#if LR35902_TIMING == LR35902_TIMING_ACCESS
+        LR35902_ACCESS_HOOK accessHook;     // Called on every data access.
+        void               *accessContext;  // Passed to the access hook.
+#endif
+
+#if LR35902_TIMING != LR35902_TIMING_NONE
+        uint64  due[LR35902_INT_COUNT]; // Scheduled cycle of each interrupt source.
+        bool    idleSkip;   // Fast-forward idle loops in runUntil.
+#endif
+        uint8   wake;       // IF bits that end the wait, all sources for halt and the joypad for stop.
+        LR35902_STATS stats;
+
+        /* Decoded block cache, allocated with the processor or from its arena. */
+        LR35902_BLOCK_CACHE *blockCache;
+        bool    ownsBlockCache; // The block cache was allocated with the processor.
+        uint32  codeWrites; // Number of writes that dropped decoded blocks.
+
+#if LR35902_JIT
+        /* Translator state lives outside the processor, a restored snapshot never rolls the code cache back. */
+        LR35902_JIT_STATE *jit;
+#endif
+
+#if LR35902_TIMING != LR35902_TIMING_NONE
+        /************************\
+        |* Scheduling           *|
+        \************************/
+
+        /**
+         * Raise the IF bit of every source that is due and find the next scheduled cycle.
+         */
+        void raiseDue();
+
+        /**
+         * Raise due sources and, while halted, fast-forward the master cycle counter to the next scheduled cycle.
+         *
+         * @param budget    [IN]        Most cycles to fast-forward.
+         *
+         * @return The number of cycles fast-forwarded.
+         */
+        uint32 idle(uint32 budget);
+
+        /**
+         * Run the block at the PC and fast-forward to the next scheduled cycle if it is an idle loop that
+         * left the registers unchanged.
+         *
+         * @param budget    [IN]        Most cycles to fast-forward.
+         *
+         * @return The number of clock cycles run and fast-forwarded.
+         */
+        uint32 execIdleBlock(uint32 budget);
+#endif
+
+        /************************\
+        |* Interrupts           *|
+        \************************/
+
+        /**
+         * Take the highest priority interrupt requested in IF and enabled in IE while IME is set: clear its IF
+         * bit and IME, end any halt, push the PC and jump to the vector of the source at 0x40 + 8 * source.
+         *
+         * @return True if an interrupt was taken.
+         */
+        bool serviceInterrupts();
+
+        /************************\
+        |* Memory Access        *|
+        \************************/
+
+        /**
+         * Read a byte from the address space without timing it, for op fetches and decoding.
+         *
+         * @param addr      [IN]        The address to read.
+         *
+         * @return The value at the address.
+         */
+        uint8 peek8(uint16 addr);
+
+        /**
+         * Read a byte from the address space.
+         *
+         * @param addr      [IN]        The address to read.
+         *
+         * @return The value at the address.
+         */
+        uint8 read8(uint16 addr);
+
+        /**
+         * Write a byte to the address space.
+         *
+         * @param addr      [IN]        The address to write.
+         * @param value     [IN]        The value to write.
+         */
+        void write8(uint16 addr, uint8 value);
+
+        /**
+         * Read a little endian word from the address space.
+         *
+         * @param addr      [IN]        The address to read.
+         *
+         * @return The value at the address.
+         */
+        uint16 read16(uint16 addr);
+
+        /**
+         * Write a little endian word to the address space.
+         *
+         * @param addr      [IN]        The address to write.
+         * @param value     [IN]        The value to write.
+         */
+        void write16(uint16 addr, uint16 value);
+
+        /**
+         * Push a word onto the stack.
+         *
+         * @param value     [IN]        The value to push.
+         */
+        void push16(uint16 value);
+
+        /**
+         * Pop a word from the stack.
+         *
+         * @return The value popped.
+         */
+        uint16 pop16();
+
+        /**
+         * Fetch the op code at the PC into imm with its operand and advance the PC past it.
+         *
+         * @return The op code.
+         */
+        uint8 fetchOp();
+
+        /************************\
+        |* Block Cache          *|
+        \************************/
+
+        /**
+         * Build the block cache key for an address.
+         *
+         * @param pc        [IN]        Address of the first op.
+         *
+         * @return The bank and address of the op.
+         */
+        uint32 blockKey(uint16 pc);
+
+        /**
+         * Check if a cached block holds the ops at a key, decoded from the memory the bus maps there now.
+         *
+         * @param block     [IN]        The cached block.
+         * @param key       [IN]        The key of the ops.
+         *
+         * @return True if the block can run.
+         */
+        bool blockCached(const LR35902_BLOCK &block, uint32 key);
+
+        /**
+         * Decode the ops starting at the PC into a block.
+         *
+         * @param block     [OUT]       The block to decode into.
+         * @param key       [IN]        The key of the block.
+         */
+        void decodeBlock(LR35902_BLOCK &block, uint32 key);
+
+        /**
+         * Drop every block that holds ops from a page of RAM or from a page mirroring the same host memory.
+         *
+         * @param page      [IN]        The page (address >> 8) that was written.
+         */
+        void invalidatePage(uint8 page);
+
+        /**
+         * Bus watch handler, drops the blocks decoded from a page before it is written.
+         *
+         * @param context   [IN]        The processor.
+         * @param page      [IN]        The page being written.
+         */
+        static void watchedWrite(void *context, uint8 page);
+
+#if LR35902_FUSION
+        /**
+         * Match a decoded block against the fused loops and put the bulk handler of a match in front of its ops.
+         *
+         * @param block     [IN/OUT]    The decoded block.
+         */
+        void fuseBlock(LR35902_BLOCK &block);
+
+        /**
+         * Get a register by its index in the op code order (B, C, D, E, H, L, -, A).
+         *
+         * @param index     [IN]        Index of the register.
+         *
+         * @return The register.
+         */
+        uint8 &reg8(uint8 index);
+
+        /**
+         * Run all but the last iteration of a fused loop in bulk, the ops of the block then run the last one.
+         * Stops short of the next scheduled cycle, the runUntil budget and any page off the bus fast path.
+         */
+        void fusedLoop();
+#endif
+
+#if LR35902_JIT
+        /************************\
+        |* Block Translation    *|
+        \************************/
+
+        /**
+         * Translate a decoded block into x86-64 code, with the end of the code cache writable only while it does.
+         * Turns the translator off if the host refuses to change the protection of the code cache.
+         *
+         * @param block     [IN/OUT]    The block, native is set to its translation.
+         */
+        void jitCompile(LR35902_BLOCK &block);
+
+        /**
+         * Translate a decoded block at the end of the code cache.
+         *
+         * @param block     [IN]        The block.
+         *
+         * @return The translation, NULL if the code cache filled up.
+         */
+        uint8 *jitTranslate(const LR35902_BLOCK &block);
+
+        /**
+         * Run a single op through its interpreter handler on behalf of a translated block.
+         *
+         * @param cpu       [IN]        The processor.
+         * @param uop       [IN]        The op to run.
+         *
+         * @return Non zero if the op dropped decoded blocks and the translated block must exit.
+         */
+        static uint32 jitFallback(LR35902 *cpu, const LR35902_UOP *uop);
+
+        /**
+         * Drop every translation and empty the code cache.
+         */
+        void jitFlush();
+#endif
+
+        /************************\
+        |* Flag Evaluation      *|
+        \************************/
+
+        /**
+         * Calculate the F register for a flag producing op.
+         *
+         * @param op        [IN]        LR35902_LAZY_* kind of the op.
+         * @param x         [IN]        First operand.
+         * @param y         [IN]        Second operand.
+         * @param c         [IN]        Carry in, or the carry flag to preserve.
+         * @param res       [IN]        Result including the carry out in bit 8.
+         *
+         * @return The value of the F register.
+         */
+        static uint8 evalFlags(uint8 op, uint8 x, uint8 y, uint8 c, uint16 res);
+
+        /**
+         * Materialize any deferred flags into r.f.
+         *
+         * @return The value of the F register.
+         */
+        uint8 flags();
+
+        /**
+         * Read the carry flag without materializing the rest of the F register.
+         *
+         * @return 1 if the carry flag is set, otherwise 0.
+         */
+        uint8 carry();
+
+        /**
+         * Check a jump condition against the flags.
+         *
+         * @param set       [IN]        True if the flag should be checked for set.
+         * @param flags     [IN]        The flags to check.
+         *
+         * @return True if the condition holds.
+         */
+        bool condition(bool set, uint8 flags);
+
+        /************************\
+        |* Dispatch Tables      *|
+        \************************/
+
+        /* Register selectors used to bake the operands into the specialized handlers. */
+        typedef uint8  _REGISTERS::*REG8;
+        typedef uint16 _PAIRS::*REG16;
+
+        /* Handler tables indexed by op code, generated at compile time in dispatch.cpp. */
+        static const LR35902_OP_FN OP_TABLE[256];
+        static const LR35902_OP_FN CB_OP_TABLE[256];
+
+        /* Decode information indexed by op code. */
+        static const LR35902_OP_INFO OP_INFO[256];
+        static const LR35902_OP_INFO CB_OP_INFO[256];
+
+        /**
+         * Read the op code following the CB prefix and dispatch it through CB_OP_TABLE.
+         */
+        void cb_prefix();
+
+        /*
+         * Operand specialized handlers.  Each instantiation forwards to the generic handler of the
+         * same name with the register operands fixed at compile time, see the generic handler for
+         * the details of the operation.
+         */
+        template <bool SET, uint8 FLAGS>    void jr_cc_n();
+        template <bool SET, uint8 FLAGS>    void jp_cc_nn();
+        template <bool SET, uint8 FLAGS>    void call_cc_nn();
+        template <bool SET, uint8 FLAGS>    void ret_cc();
+        template <uint8 OFFSET>             void rst_n();
+        template <REG16 REG>                void ld_rr_a();
+        template <REG16 REG>                void ld_a_rr();
+        template <REG8 REG>                 void ld_r_n();
+        template <REG8 REG1, REG8 REG2>     void ld_r_r();
+        template <REG8 REG>                 void ld_r_hl();
+        template <REG8 REG>                 void ld_hl_r();
+        template <REG8 REG>                 void add_a_r();
+        template <REG8 REG>                 void adc_a_r();
+        template <REG8 REG>                 void sub_a_r();
+        template <REG8 REG>                 void sbc_a_r();
+        template <REG8 REG>                 void and_a_r();
+        template <REG8 REG>                 void xor_a_r();
+        template <REG8 REG>                 void or_a_r();
+        template <REG8 REG>                 void cp_a_r();
+        template <REG8 REG>                 void inc_r();
+        template <REG8 REG>                 void dec_r();
+        template <REG16 REG>                void ld_rr_nn();
+        template <REG16 REG>                void pop_rr();
+        template <REG16 REG>                void push_rr();
+        template <REG16 REG>                void inc_rr();
+        template <REG16 REG>                void dec_rr();
+        template <REG16 REG>                void add_hl_rr();
+
+        /*
+         * CB prefixed handlers, decoded from the fields of the op code at compile time, see dispatch.cpp.
+         */
+        template <uint8 INDEX>              uint8 &cb_r();
+        template <uint8 OP>                 void cb_alu(uint8 &value);
+        template <uint8 OP>                 void cb_op();
+    };
+
+} /* END: Nintendo */ } /* END: Processors */ } /* END: SiNES */
+
+#endif                              /* END: HEADER GUARD */
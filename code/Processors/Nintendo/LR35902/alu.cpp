@@ -0,0 +1,74 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#include "Processors/Nintendo/LR35902/alu.hpp"
+#include "Processors/Nintendo/LR35902/LR35902.hpp"
+
+namespace SiNES { namespace Processors { namespace Nintendo {
+#if LR35902_ALU == LR35902_ALU_TABLE
+    uint16 LR35902_ALU_ADD[2][256][256];
+    uint16 LR35902_ALU_SUB[2][256][256];
+    uint16 LR35902_ALU_INC[256];
+    uint16 LR35902_ALU_DEC[256];
+    uint16 LR35902_ALU_SWAP[256];
+    uint16 LR35902_ALU_DAA[8 * 256];
+
+    /* Pack a result and its flags into a table entry. */
+    #define ENTRY(RESULT, Z, N, H, C) ((uint16)(                                                   \
+        (uint8)(RESULT)                                                                             \
+        | (((Z) ? LR35902_FLAG_ZERO : 0x00) | ((N) ? LR35902_FLAG_SUBTRACT : 0x00)                  \
+        |  ((H) ? LR35902_FLAG_HALF_CARRY : 0x00) | ((C) ? LR35902_FLAG_CARRY : 0x00)) << 8))
+
+    /**
+     * Builds the ALU tables before main runs.
+     */
+    static class AluTableBuilder {
+    public:
+        AluTableBuilder() {
+            for (uint32 c = 0; c < 2; ++c) {
+                for (uint32 a = 0; a < 256; ++a) {
+                    for (uint32 n = 0; n < 256; ++n) {
+                        uint32 sum = a + n + c;
+                        uint32 diff = a - n - c;
+                        LR35902_ALU_ADD[c][a][n] = ENTRY(sum, 0 == (sum & 0xFF), 0,
+                                                         ((a & 0x0F) + (n & 0x0F) + c) > 0x0F, sum > 0xFF);
+                        LR35902_ALU_SUB[c][a][n] = ENTRY(diff, 0 == (diff & 0xFF), 1,
+                                                         (a & 0x0F) < ((n & 0x0F) + c), a < n + c);
+                    }
+                }
+            }
+
+            for (uint32 r = 0; r < 256; ++r) {
+                uint8 swapped = (uint8)((r << 4) | (r >> 4));
+                LR35902_ALU_INC[r] = ENTRY(r + 1, 0 == ((r + 1) & 0xFF), 0, 0x0F == (r & 0x0F), 0);
+                LR35902_ALU_DEC[r] = ENTRY(r - 1, 0 == ((r - 1) & 0xFF), 1, 0x00 == (r & 0x0F), 0);
+                LR35902_ALU_SWAP[r] = ENTRY(swapped, 0 == swapped, 0, 0, 0);
+            }
+
+            for (uint32 nhc = 0; nhc < 8; ++nhc) {
+                uint8 f = (uint8)(nhc << 4);
+                for (uint32 a = 0; a < 256; ++a) {
+                    uint8 adjust = 0x00;
+                    uint8 value = (uint8)a;
+                    bool carry = 0 != (f & LR35902_FLAG_CARRY);
+                    if (f & LR35902_FLAG_SUBTRACT) {
+                        if (f & LR35902_FLAG_HALF_CARRY) { adjust |= 0x06; }
+                        if (carry)                       { adjust |= 0x60; }
+                        value -= adjust;
+                    } else {
+                        if ((f & LR35902_FLAG_HALF_CARRY) || (a & 0x0F) > 0x09) { adjust |= 0x06; }
+                        if (carry || a > 0x99)                                 { adjust |= 0x60; carry = true; }
+                        value += adjust;
+                    }
+                    LR35902_ALU_DAA[LR35902_ALU_DAA_INDEX(a, f)] =
+                        ENTRY(value, 0 == value, f & LR35902_FLAG_SUBTRACT, 0, carry);
+                }
+            }
+        }
+    } aluTableBuilder;
+
+    #undef ENTRY
+#endif
+
+} /* END: Nintendo */ } /* END: Processors */ } /* END: SiNES */
@@ -0,0 +1,49 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#ifndef SINES_LR35902_ALU_H         /* START: HEADER GUARD */
+#define SINES_LR35902_ALU_H
+
+#include "xplat/types.hpp"
+#include "Processors/Nintendo/LR35902/config.hpp"
+
+namespace SiNES { namespace Processors { namespace Nintendo {
+    /*
+    Lookup tables for the table driven 8 bit ALU (LR35902_ALU_TABLE in config.hpp).
+
+    Every entry packs the result in the low byte and the complete F register in the high byte, so an
+    op costs a single load followed by two byte stores.  The tables are built once at start up, and only
+    exist in builds that use them.
+    */
+#if LR35902_ALU == LR35902_ALU_TABLE
+
+    /* Extract the result and F register from a table entry. */
+    #define LR35902_ALU_RESULT(ENTRY)   ((uint8)(ENTRY))
+    #define LR35902_ALU_FLAGS(ENTRY)    ((uint8)((ENTRY) >> 8))
+
+    /* Index for LR35902_ALU_DAA: the N, H and C flags above the value of A. */
+    #define LR35902_ALU_DAA_INDEX(A, F) ((((F) & 0x70) << 4) | (A))
+
+    /* A + n + carry, indexed by [carry][A][n].                     [Z 0 H C] */
+    extern uint16 LR35902_ALU_ADD[2][256][256];
+
+    /* A - n - carry, indexed by [carry][A][n].  Also used by cp.   [Z 1 H C] */
+    extern uint16 LR35902_ALU_SUB[2][256][256];
+
+    /* r + 1, indexed by [r].  The carry flag must be merged in.    [Z 0 H -] */
+    extern uint16 LR35902_ALU_INC[256];
+
+    /* r - 1, indexed by [r].  The carry flag must be merged in.    [Z 1 H -] */
+    extern uint16 LR35902_ALU_DEC[256];
+
+    /* Swap the nibbles of r, indexed by [r].                       [Z 0 0 0] */
+    extern uint16 LR35902_ALU_SWAP[256];
+
+    /* Decimal adjust A, indexed by LR35902_ALU_DAA_INDEX.          [Z - 0 C] */
+    extern uint16 LR35902_ALU_DAA[8 * 256];
+#endif
+
+} /* END: Nintendo */ } /* END: Processors */ } /* END: SiNES */
+
+#endif                              /* END: HEADER GUARD */
@@ -0,0 +1,470 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+/*
+Cached interpreter for the LR35902.
+
+A block is the straight run of ops starting at a PC up to and including the first op that may change the
+PC or the interrupt state (LR35902_OP_ENDS_BLOCK).  Each op is decoded once into an LR35902_UOP holding its
+handler, immediate operand and cycles, so running the block again skips the fetch and decode entirely.
+
+A block that only reads memory and ends with a branch back to its own start is flagged LR35902_BLOCK_IDLE,
+a candidate polling loop for runUntil to skip.  Skipping is only sound for state that changes at scheduled
+cycles, so a loop reading DIV, the timer or the LCD status and LY (see clockedRegister) is never flagged, and one
+reading through BC, DE, HL or C is flagged with the pointer so runUntil checks where it points before skipping.
+
+A block that is a whole copy, fill or countdown loop (see LR35902_FUSE_*) gets a fused uop in front of its ops.
+The fused uop runs all but the last iteration in bulk, with memcpy and memset straight on the fast path memory
+of the bus, and the ops of the block then run the last iteration as decoded, leaving the registers, flags and
+cycles exactly as the unfused loop would.  Bulk iterations stop short of the next scheduled cycle and the
+runUntil budget, so interrupts and events are seen between the same iterations, and at the first page off the
+fast path (I/O, ROM, watched code), which the ops of the block then access one iteration at a time.
+
+Blocks are keyed by the PC, and in the switchable ROM bank also by the host memory the bus maps there, so a
+bank switch (a mapper re-pointing 0x4000-0x7FFF on the bus) selects the blocks of the new bank and keeps those
+of the old one.  A block also keeps the host memory of its first page, and only runs while the bus still maps
+it there.  Blocks decoded from RAM watch their pages on the bus, and a write to a watched page, or to any page
+mirroring its memory, drops every block holding ops from that memory.
+*/
+
+/* Build the block cache key for an address, folding the host memory of a switchable ROM page into the bank. */
+inline uint32 LR35902::blockKey(uint16 pc)
+{
+    if (pc < 0x4000 || pc >= 0x8000) {
+        return pc;
+    }
+    size_t host = (size_t)this->bus.hostPage((uint8)(pc >> 8));
+    return ((uint32)(host >> 14) & 0xFFFF) << 16 | pc;
+}
+
+/* Check if a cached block holds the ops at a key, decoded from the memory the bus maps there now. */
+inline bool LR35902::blockCached(const LR35902_BLOCK &block, uint32 key)
+{
+    return block.key == key && block.host == this->bus.hostPage((uint8)(key >> 8));
+}
+
+/* Check if an address is a register that counts with the clock between scheduled cycles: DIV and the timer
+   (0xFF04-0xFF07), the LCD status, scroll and LY (0xFF41-0xFF45).  A loop polling one of these is not idle. */
+static bool clockedRegister(uint16 addr)
+{
+    return (addr >= 0xFF04 && addr <= 0xFF07) || (addr >= 0xFF41 && addr <= 0xFF45);
+}
+
+/* Registers of the ops in an idle loop, by their op code order index: B, C, D, E, H and L.  IDLE_C is C as the
+   offset of ld a,(c) into the I/O page. */
+#define IDLE_REG(INDEX)     ((uint8)(0x01 << (INDEX)))
+#define IDLE_BC             (IDLE_REG(0) | IDLE_REG(1))
+#define IDLE_DE             (IDLE_REG(2) | IDLE_REG(3))
+#define IDLE_HL             (IDLE_REG(4) | IDLE_REG(5))
+#define IDLE_C              IDLE_REG(7)
+
+/* Registers an op allowed by idleOp reads memory through. */
+static uint8 idlePointers(uint8 op, uint8 cbOp)
+{
+    if ((op >= 0x40 && op < 0xC0 && 0x06 == (op & 0x07)) || 0x2A == op || 0x3A == op
+        || (0xCB == op && 0x06 == (cbOp & 0x07))) {
+        return IDLE_HL;                                                 /* (hl), ldi/ldd a,(hl) */
+    }
+    switch (op) {
+        case 0x0A: return IDLE_BC;                                      /* ld a,(bc) */
+        case 0x1A: return IDLE_DE;                                      /* ld a,(de) */
+        case 0xF2: return IDLE_C;                                       /* ld a,(c) */
+        default:   return 0;
+    }
+}
+
+/* Registers other than A and F written by an op allowed by idleOp. */
+static uint8 idleWrites(uint8 op)
+{
+    if (0x2A == op || 0x3A == op) {
+        return IDLE_HL;                                                 /* ldi/ldd a,(hl) */
+    }
+    if ((op >= 0x40 && op < 0x80) || (op < 0x40 && (op & 0x07) >= 0x04 && (op & 0x07) <= 0x06)) {
+        uint8 reg = IDLE_REG((op >> 3) & 0x07) & (IDLE_BC | IDLE_DE | IDLE_HL);  /* ld r,r, inc r, dec r, ld r,n */
+        return (IDLE_REG(1) == reg) ? (uint8)(reg | IDLE_C) : reg;
+    }
+    return 0;
+}
+
+/* Check if an op may appear in an idle loop: it writes no memory, leaves the PC and interrupts alone and reads
+   no clocked register by its address. */
+static bool idleOp(uint8 op, uint16 imm)
+{
+    uint8 cbOp = (uint8)imm;
+    if (0xF0 == op) {
+        return !clockedRegister((uint16)(0xFF00 | cbOp));               /* ldh a,(n) */
+    }
+    if (0xFA == op) {
+        return !clockedRegister(imm);                                   /* ld a,(nn) */
+    }
+    if (op >= 0x40 && op < 0x80) {
+        return op < 0x70 || op > 0x77;                                  /* ld r,r and ld r,(hl) */
+    }
+    if (op >= 0x80 && op < 0xC0) {
+        return true;                                                    /* alu a,r and alu a,(hl) */
+    }
+    switch (op) {
+        case 0x00:                                                      /* nop */
+        case 0x04: case 0x0C: case 0x14: case 0x1C: case 0x24: case 0x2C: case 0x3C:   /* inc r */
+        case 0x05: case 0x0D: case 0x15: case 0x1D: case 0x25: case 0x2D: case 0x3D:   /* dec r */
+        case 0x06: case 0x0E: case 0x16: case 0x1E: case 0x26: case 0x2E: case 0x3E:   /* ld r,n */
+        case 0x07: case 0x0F: case 0x17: case 0x1F:                     /* rlca, rrca, rla, rra */
+        case 0x0A: case 0x1A: case 0x2A: case 0x3A:                     /* ld a,(rr), ldi/ldd a,(hl) */
+        case 0x2F: case 0x37: case 0x3F:                                /* cpl, scf, ccf */
+        case 0xC6: case 0xCE: case 0xD6: case 0xDE:                     /* add, adc, sub, sbc n */
+        case 0xE6: case 0xEE: case 0xF6: case 0xFE:                     /* and, xor, or, cp n */
+        case 0xF0: case 0xF2: case 0xFA:                                /* ldh a,(n), ld a,(c), ld a,(nn) */
+            return true;
+        case 0xCB:                                                      /* bit b,r and bit b,(hl) */
+            return cbOp >= 0x40 && cbOp < 0x80;
+        default:
+            return false;
+    }
+}
+
+/* Decode the ops starting at the PC into a block. */
+void LR35902::decodeBlock(LR35902_BLOCK &block, uint32 key)
+{
+    uint16 pc = (uint16)key;
+
+    block.key = key;
+    block.host = this->bus.hostPage((uint8)(pc >> 8));
+    block.native = NULL;
+    block.cycles = 0;
+    block.count = 0;
+    block.flags = 0;
+    bool idle = true;
+    uint8 pointers = 0;
+    uint8 written = 0;
+    while (block.count < LR35902_BLOCK_MAX_UOPS) {
+        LR35902_UOP &uop = block.uops[block.count++];
+        uint8 op = this->peek8(pc);
+        const LR35902_OP_INFO &info = OP_INFO[op];
+
+        uop.fn = OP_TABLE[op];
+        uop.length = info.length;
+        uop.cycles = info.cycles;
+        uop.fusion = LR35902_FUSE_NONE;
+        uop.imm = 0x0000;
+        if (info.length > 1) {
+            uop.imm = this->peek8((uint16)(pc + 1));
+            if (info.length > 2) {
+                uop.imm |= this->peek8((uint16)(pc + 2)) << 8;
+            }
+        }
+        if (0xCB == op) {
+            uop.fn = CB_OP_TABLE[uop.imm];
+            uop.cycles += CB_OP_INFO[uop.imm].cycles;
+        }
+
+        if (pc >= 0x8000) {
+            this->bus.watch((uint8)(pc >> 8));
+            this->bus.watch((uint8)((uint16)(pc + info.length - 1) >> 8));
+        }
+        block.cycles += uop.cycles;
+        pc += info.length;
+
+        if (info.flags & LR35902_OP_ENDS_BLOCK) {
+            /* Only a jr or jp back to the start of the block closes an idle loop. */
+            uint16 target = pc;
+            if (0x18 == op || (op & 0xE7) == 0x20) {
+                target = (uint16)(pc + (int8)uop.imm);
+            } else if (0xC3 == op || (op & 0xE7) == 0xC2) {
+                target = uop.imm;
+            }
+            if (idle && target == (uint16)key) {
+                block.flags |= LR35902_BLOCK_IDLE;
+                block.flags |= (pointers & IDLE_BC) ? LR35902_BLOCK_READS_BC : 0;
+                block.flags |= (pointers & IDLE_DE) ? LR35902_BLOCK_READS_DE : 0;
+                block.flags |= (pointers & IDLE_HL) ? LR35902_BLOCK_READS_HL : 0;
+                block.flags |= (pointers & IDLE_C) ? LR35902_BLOCK_READS_C : 0;
+            }
+            break;
+        }
+        /* A pointer changed within the iteration reads somewhere else than the one checked at its start. */
+        uint8 reads = idlePointers(op, (uint8)uop.imm);
+        idle = idle && idleOp(op, uop.imm) && 0 == (reads & written);
+        pointers |= reads;
+        written |= idleWrites(op);
+    }
+    block.end = pc;
+#if LR35902_FUSION
+    this->fuseBlock(block);
+#endif
+}
+
+#if LR35902_FUSION
+/* Operands of a fused loop in the imm of its uop. */
+#define FUSE_IMM(FUSION, REG, CYCLES)   ((uint16)(((CYCLES) << 8) | ((FUSION) << 4) | (REG)))
+#define FUSE_DESCENDING                 0x08    // Fill from HL down, ld (hl-),a.
+
+/* Offset of an address in its bus page and the bytes left in the page from it. */
+#define PAGE_OFFSET(ADDR)               ((uint32)((ADDR) & (BUS_PAGE_SIZE - 1)))
+#define PAGE_LEFT(ADDR)                 ((uint32)BUS_PAGE_SIZE - PAGE_OFFSET(ADDR))
+
+/* Check for dec r of a register, the op code order index of the register is in bits 3-5. */
+#define DEC_R(OP)                       (0x05 == ((OP) & 0xC7) && 0x35 != (OP))
+
+/* Check for ld a,b; or c or ld a,c; or b, the test of BC for zero. */
+#define TEST_BC(CODE)                   ((0x78 == (CODE)[0] && 0xB1 == (CODE)[1]) || (0x79 == (CODE)[0] && 0xB0 == (CODE)[1]))
+
+/* Match a decoded block against the fused loops. */
+void LR35902::fuseBlock(LR35902_BLOCK &block)
+{
+    uint16 start = (uint16)block.key;
+    uint32 length = (uint16)(block.end - start);
+    uint8 code[8];
+    if (length < 3 || length > sizeof(code) || block.count >= LR35902_BLOCK_MAX_UOPS) {
+        return;
+    }
+    for (uint32 i = 0; i < length; ++i) {
+        code[i] = this->peek8((uint16)(start + i));
+    }
+
+    /* Every fused loop is a body followed by a jr nz back to its start. */
+    if (0x20 != code[length - 2] || (uint8)(0x100 - length) != code[length - 1]) {
+        return;
+    }
+    uint32 body = length - 2;
+    uint8 fusion = LR35902_FUSE_NONE;
+    uint8 reg = 0;
+    if (6 == body && 0x2A == code[0] && 0x12 == code[1] && 0x13 == code[2] && 0x0B == code[3] && TEST_BC(code + 4)) {
+        fusion = LR35902_FUSE_COPY_BC;
+    } else if (4 == body && 0x2A == code[0] && 0x12 == code[1] && 0x13 == code[2] && DEC_R(code[3])
+               && ((code[3] >> 3) & 0x07) <= 0x01) {
+        fusion = LR35902_FUSE_COPY_R;                                   /* counted in B or C */
+        reg = (code[3] >> 3) & 0x07;
+    } else if (5 == body && 0xAF == code[0] && 0x22 == code[1] && 0x0B == code[2] && TEST_BC(code + 3)) {
+        fusion = LR35902_FUSE_FILL_BC;
+    } else if (2 == body && (0x22 == code[0] || 0x32 == code[0]) && DEC_R(code[1]) && ((code[1] >> 3) & 0x07) <= 0x03) {
+        fusion = LR35902_FUSE_FILL_R;                                   /* counted in B, C, D or E */
+        reg = (uint8)(((code[1] >> 3) & 0x07) | ((0x32 == code[0]) ? FUSE_DESCENDING : 0x00));
+    } else if (1 == body && DEC_R(code[0])) {
+        fusion = LR35902_FUSE_COUNTDOWN;
+        reg = (code[0] >> 3) & 0x07;
+    }
+    if (LR35902_FUSE_NONE == fusion) {
+        return;
+    }
+
+    /* The fused uop takes no bytes or cycles of its own, it accounts for the iterations it runs. */
+    uint32 iteration = block.cycles + OP_INFO[0x20].taken - OP_INFO[0x20].cycles;
+    memmove(&block.uops[1], &block.uops[0], block.count * sizeof(LR35902_UOP));
+    ++block.count;
+    LR35902_UOP &uop = block.uops[0];
+    uop.fn = &LR35902::fusedLoop;
+    uop.imm = FUSE_IMM(fusion, reg, iteration);
+    uop.length = 0;
+    uop.cycles = 0;
+    uop.fusion = fusion;
+}
+
+/* Get a register by its index in the op code order. */
+uint8 &LR35902::reg8(uint8 index)
+{
+    switch (index) {
+        case 0x00: return this->r.b;
+        case 0x01: return this->r.c;
+        case 0x02: return this->r.d;
+        case 0x03: return this->r.e;
+        case 0x04: return this->r.h;
+        case 0x05: return this->r.l;
+        default:   return this->r.a;
+    }
+}
+
+/* Run all but the last iteration of a fused loop in bulk. */
+void LR35902::fusedLoop()
+{
+    uint8 fusion = (uint8)((this->imm >> 4) & 0x0F);
+    uint8 reg = (uint8)(this->imm & 0x0F);
+    uint32 iteration = this->imm >> 8;
+    bool countBC = LR35902_FUSE_COPY_BC == fusion || LR35902_FUSE_FILL_BC == fusion;
+    uint8 &counter = this->reg8(reg & 0x07);
+    uint32 remaining = countBC ? this->rr.bc : counter;
+    if (0 == remaining) {
+        remaining = countBC ? 0x10000 : 0x100;
+    }
+
+    /* Only the iterations that start before the next scheduled cycle and the end of the budget. */
+    uint64 limit = (this->nextDue < this->runEnd) ? this->nextDue : this->runEnd;
+    if (this->cycles >= limit) {
+        return;
+    }
+    uint64 fit = (limit - this->cycles - 1) / iteration;
+    uint32 count = (fit < remaining - 1) ? (uint32)fit : remaining - 1;
+
+    uint32 done = 0;
+    switch (fusion) {
+        case LR35902_FUSE_COPY_BC:
+        case LR35902_FUSE_COPY_R:
+            while (done < count) {
+                uint16 src = this->rr.hl;
+                uint16 dst = this->rr.de;
+                const uint8 *from = this->bus.readPage((uint8)(src >> BUS_PAGE_SHIFT));
+                uint8 *to = this->bus.writePage((uint8)(dst >> BUS_PAGE_SHIFT));
+                if (NULL == from || NULL == to) {
+                    break;
+                }
+                uint32 chunk = count - done;
+                if (chunk > PAGE_LEFT(src)) {
+                    chunk = PAGE_LEFT(src);
+                }
+                if (chunk > PAGE_LEFT(dst)) {
+                    chunk = PAGE_LEFT(dst);
+                }
+                from += PAGE_OFFSET(src);
+                to += PAGE_OFFSET(dst);
+
+                /* A destination just ahead of the source repeats the bytes copied, as the byte loop would. */
+                if (to > from && to < from + chunk) {
+                    for (uint32 i = 0; i < chunk; ++i) {
+                        to[i] = from[i];
+                    }
+                } else {
+                    memmove(to, from, chunk);
+                }
+                this->r.a = to[chunk - 1];
+                this->rr.hl = (uint16)(src + chunk);
+                this->rr.de = (uint16)(dst + chunk);
+                done += chunk;
+            }
+            break;
+
+        case LR35902_FUSE_FILL_BC:
+        case LR35902_FUSE_FILL_R:
+            while (done < count) {
+                uint16 dst = this->rr.hl;
+                uint8 *to = this->bus.writePage((uint8)(dst >> BUS_PAGE_SHIFT));
+                if (NULL == to) {
+                    break;
+                }
+                uint32 chunk = count - done;
+                if (reg & FUSE_DESCENDING) {
+                    if (chunk > PAGE_OFFSET(dst) + 1) {
+                        chunk = PAGE_OFFSET(dst) + 1;
+                    }
+                    memset(to + PAGE_OFFSET(dst) + 1 - chunk, this->r.a, chunk);
+                    this->rr.hl = (uint16)(dst - chunk);
+                } else {
+                    if (chunk > PAGE_LEFT(dst)) {
+                        chunk = PAGE_LEFT(dst);
+                    }
+                    memset(to + PAGE_OFFSET(dst), (LR35902_FUSE_FILL_BC == fusion) ? 0x00 : this->r.a, chunk);
+                    this->rr.hl = (uint16)(dst + chunk);
+                }
+                done += chunk;
+            }
+            break;
+
+        default:
+            done = count;
+            break;
+    }
+    if (0 == done) {
+        return;
+    }
+
+    if (countBC) {
+        this->rr.bc = (uint16)(this->rr.bc - done);
+    } else {
+        counter = (uint8)(counter - done);
+    }
+    LR35902_ADD_CYCLES((uint64)done * iteration);
+    ++this->stats.fusions[fusion];
+    this->stats.fusedIterations += done;
+}
+
+#undef TEST_BC
+#undef DEC_R
+#undef PAGE_LEFT
+#undef PAGE_OFFSET
+#undef FUSE_DESCENDING
+#undef FUSE_IMM
+#endif
+
+/* Drop every block that holds ops from a page of RAM or one of its mirrors. */
+void LR35902::invalidatePage(uint8 page)
+{
+    /* A block of at most LR35902_BLOCK_MAX_UOPS ops spans no more than two pages. */
+    const uint8 *host = this->bus.hostPage(page);
+    for (uint32 i = 0; i < LR35902_BLOCK_CACHE_SIZE; ++i) {
+        LR35902_BLOCK &block = this->blockCache->blocks[i];
+        uint16 start = (uint16)block.key;
+        if (LR35902_BLOCK_INVALID == block.key || start < 0x8000) {
+            continue;
+        }
+        uint8 firstPage = (uint8)(start >> 8);
+        uint8 lastPage = (uint8)((uint16)(block.end - 1) >> 8);
+        bool first = firstPage == page || (NULL != host && this->bus.hostPage(firstPage) == host);
+        bool last = lastPage == page || (NULL != host && this->bus.hostPage(lastPage) == host);
+        if (first || last) {
+            block.key = LR35902_BLOCK_INVALID;
+            block.native = NULL;
+        }
+    }
+    this->bus.unwatch(page);
+    ++this->codeWrites;
+}
+
+/* Bus watch handler, drops the blocks decoded from a page before it is written. */
+void LR35902::watchedWrite(void *context, uint8 page)
+{
+    ((LR35902 *)context)->invalidatePage(page);
+}
+
+/* Execute the decoded block starting at the PC. */
+uint32 LR35902::execBlock()
+{
+    uint32 key = this->blockKey(this->rr.pc);
+    LR35902_BLOCK &block = this->blockCache->blocks[LR35902_BLOCK_CACHE_INDEX(key)];
+    if (!this->blockCached(block, key)) {
+        this->decodeBlock(block, key);
+    }
+
+    /* Taken branches add their extra cycles to the master counter from the handlers. */
+#if LR35902_TIMING != LR35902_TIMING_NONE
+    uint64 start = this->cycles;
+#endif
+
+#if LR35902_JIT
+    if (this->jit->enabled && NULL == block.native) {
+        this->jitCompile(block);
+    }
+    if (this->jit->enabled) {
+    #if LR35902_FLAGS == LR35902_FLAGS_LAZY
+        /* Translated code reads and writes r.f directly. */
+        this->flags();
+    #endif
+    #if LR35902_TIMING != LR35902_TIMING_NONE
+        this->cycles += ((LR35902_JIT_FN)block.native)(this);
+        return (uint32)(this->cycles - start);
+    #else
+        return ((LR35902_JIT_FN)block.native)(this);
+    #endif
+    }
+#endif
+
+    /* A write into the block's own pages drops it, the remaining ops are then left to the next block. */
+    const LR35902_UOP *uop = block.uops;
+    const LR35902_UOP *end = uop + block.count;
+#if LR35902_TIMING != LR35902_TIMING_NONE
+    for (; uop != end && block.key == key; ++uop) {
+        this->imm = uop->imm;
+        this->rr.pc += uop->length;
+        this->cycles += uop->cycles;
+        (this->*uop->fn)();
+    }
+    return (uint32)(this->cycles - start);
+#else
+    uint32 cycles = 0;
+    for (; uop != end && block.key == key; ++uop) {
+        this->imm = uop->imm;
+        this->rr.pc += uop->length;
+        cycles += uop->cycles;
+        (this->*uop->fn)();
+    }
+    return cycles;
+#endif
+}
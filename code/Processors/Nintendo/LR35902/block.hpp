@@ -0,0 +1,72 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#ifndef SINES_LR35902_BLOCK_H       /* START: HEADER GUARD */
+#define SINES_LR35902_BLOCK_H
+
+#include "xplat/types.hpp"
+
+namespace SiNES { namespace Processors { namespace Nintendo {
+    class LR35902;
+
+    /* Pointer to an op code handler of the LR35902. */
+    typedef void (LR35902::*LR35902_OP_FN)();
+
+    /* Static decode information for an op code. */
+    typedef struct _LR35902_OP_INFO {
+        uint8   length; // Length in bytes including the op code (and the CB prefix).
+        uint8   cycles; // Duration in clock cycles, the not taken duration for conditional ops.
+        uint8   taken;  // Duration in clock cycles when a conditional op branches, equal to cycles otherwise.
+        uint8   flags;  // Decode flags.
+        #define LR35902_OP_ENDS_BLOCK       (0x01 << 0) // May change the PC or interrupt state, ends a block.
+    } LR35902_OP_INFO;
+
+    /* Loops the block decoder fuses into one bulk handler, see block.cpp. */
+    #define LR35902_FUSE_NONE           0   // A single op.
+    #define LR35902_FUSE_COPY_BC        1   // ld a,(hl+); ld (de),a; inc de; dec bc; ld a,b; or c; jr nz
+    #define LR35902_FUSE_COPY_R         2   // ld a,(hl+); ld (de),a; inc de; dec r; jr nz
+    #define LR35902_FUSE_FILL_BC        3   // xor a; ld (hl+),a; dec bc; ld a,b; or c; jr nz
+    #define LR35902_FUSE_FILL_R         4   // ld (hl+),a or ld (hl-),a; dec r; jr nz
+    #define LR35902_FUSE_COUNTDOWN      5   // dec r; jr nz
+    #define LR35902_FUSE_COUNT          6
+
+    /* A pre-decoded op ready to run from the block cache. */
+    typedef struct _LR35902_UOP {
+        LR35902_OP_FN   fn;     // Handler for the op.
+        uint16          imm;    // Immediate operand (or the CB op code), the operands of a fused loop.
+        uint8           length; // Bytes to advance the PC by before the handler runs.
+        uint8           cycles; // Duration in clock cycles.
+        uint8           fusion; // LR35902_FUSE_* loop the handler runs, LR35902_FUSE_NONE for a single op.
+    } LR35902_UOP;
+
+    /* Decoded basic block: a straight run of ops ending at a branch or LR35902_BLOCK_MAX_UOPS. */
+    #define LR35902_BLOCK_MAX_UOPS      16
+    #define LR35902_BLOCK_INVALID       0xFFFFFFFF
+    typedef struct _LR35902_BLOCK {
+        uint32      key;        // (bank << 16) | pc of the first op, LR35902_BLOCK_INVALID if empty.
+        const uint8 *host;      // Host memory mapped to the page of the first op, bank folds it in 0x4000-0x7FFF.
+        uint16      end;        // Address following the last op.
+        uint16      cycles;     // Sum of the cycles of all ops.
+        uint8       count;      // Number of decoded ops.
+        uint8       flags;      // Block flags.
+        #define LR35902_BLOCK_IDLE          (0x01 << 0) // Branches back to its start and writes nothing.
+        #define LR35902_BLOCK_READS_BC      (0x01 << 1) // An idle loop reading memory at BC.
+        #define LR35902_BLOCK_READS_DE      (0x01 << 2) // An idle loop reading memory at DE.
+        #define LR35902_BLOCK_READS_HL      (0x01 << 3) // An idle loop reading memory at HL.
+        #define LR35902_BLOCK_READS_C       (0x01 << 4) // An idle loop reading the I/O page at C.
+        void       *native;     // Translation of the block, see jit.hpp.
+        LR35902_UOP uops[LR35902_BLOCK_MAX_UOPS];
+    } LR35902_BLOCK;
+
+    /* Direct mapped cache of decoded blocks, indexed by a hash of the block key.  RAM pages holding decoded ops
+       are watched on the bus. */
+    #define LR35902_BLOCK_CACHE_SIZE    512
+    #define LR35902_BLOCK_CACHE_INDEX(KEY) ((((KEY) >> 16) * 0x9E37 + (KEY)) & (LR35902_BLOCK_CACHE_SIZE - 1))
+    typedef struct _LR35902_BLOCK_CACHE {
+        LR35902_BLOCK   blocks[LR35902_BLOCK_CACHE_SIZE];
+    } LR35902_BLOCK_CACHE;
+
+} /* END: Nintendo */ } /* END: Processors */ } /* END: SiNES */
+
+#endif                              /* END: HEADER GUARD */
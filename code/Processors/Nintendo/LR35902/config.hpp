@@ -0,0 +1,65 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#ifndef SINES_LR35902_CONFIG_H      /* START: HEADER GUARD */
+#define SINES_LR35902_CONFIG_H
+
+/*
+ * Build time options for the LR35902 core.  Each option may be overridden on the
+ * compiler command line (see CMakeLists.txt), otherwise the defaults below are used.
+ */
+
+/* Dispatch engines available to LR35902::execOp. */
+#define LR35902_DISPATCH_SWITCH     0   /* Hand written switch over the op code. */
+#define LR35902_DISPATCH_TABLE      1   /* Compile time generated table of specialized handlers. */
+
+#ifndef LR35902_DISPATCH
+    #define LR35902_DISPATCH LR35902_DISPATCH_TABLE
+#endif
+
+/* Evaluation of the F register. */
+#define LR35902_FLAGS_EAGER         0   /* Every flag producing op rebuilds r.f. */
+#define LR35902_FLAGS_LAZY          1   /* Ops record their operands, r.f is rebuilt when it is read. */
+
+#ifndef LR35902_FLAGS
+    #define LR35902_FLAGS LR35902_FLAGS_EAGER
+#endif
+
+/* Backend for the 8 bit arithmetic ops (add, adc, sub, sbc, cp, inc, dec, daa, swap). */
+#define LR35902_ALU_COMPUTED        0   /* Results and flags are calculated by the handlers. */
+#define LR35902_ALU_TABLE           1   /* Results and flags are loaded from the tables in alu.hpp. */
+
+#ifndef LR35902_ALU
+    #define LR35902_ALU LR35902_ALU_COMPUTED
+#endif
+
+/* Clock cycle accounting. */
+#define LR35902_TIMING_NONE         0   /* No master cycle counter, for comparison against untimed runs. */
+#define LR35902_TIMING_OP           1   /* The master cycle counter advances once per op. */
+#define LR35902_TIMING_ACCESS       2   /* As OP, also calls the access hook on every data access. */
+
+#ifndef LR35902_TIMING
+    #define LR35902_TIMING LR35902_TIMING_OP
+#endif
+
+/* Fusion of copy, fill and countdown loops in the block decoder, see block.cpp.  Needs op level timing, the
+   access hook has to see every access and untimed runs have no budget to stop a fused loop at. */
+#ifndef LR35902_FUSION
+    #define LR35902_FUSION (LR35902_TIMING == LR35902_TIMING_OP)
+#endif
+
+#if LR35902_FUSION && LR35902_TIMING != LR35902_TIMING_OP
+    #error LR35902_FUSION requires LR35902_TIMING_OP
+#endif
+
+/* x86-64 translation of decoded blocks, see jit.cpp.  Enabled at run time through LR35902::setJit. */
+#ifndef LR35902_JIT
+    #define LR35902_JIT 0
+#endif
+
+#if LR35902_JIT && !(defined(_M_X64) || defined(__x86_64__))
+    #error LR35902_JIT requires an x86-64 host
+#endif
+
+#endif                              /* END: HEADER GUARD */
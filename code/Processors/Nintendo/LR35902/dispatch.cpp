@@ -0,0 +1,1051 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+/*
+Compile time generated dispatch for the LR35902.
+
+Every op code that operates on a register is given its own handler by instantiating a template with the
+register baked in as a pointer to member.  Since this file is included in the same translation unit as
+opcodes.cpp the generic handler is inlined into each instantiation, leaving a single indirect call through
+the table per op code and no register references to chase at run time.
+*/
+
+/*********************************************************************************************************************\
+| Operand Specialized Handlers                                                                                        |
+\*********************************************************************************************************************/
+
+template <bool SET, uint8 FLAGS>
+void LR35902::jr_cc_n()
+{
+    this->jr_cc_n(SET, FLAGS);
+}
+
+template <bool SET, uint8 FLAGS>
+void LR35902::jp_cc_nn()
+{
+    this->jp_cc_nn(SET, FLAGS);
+}
+
+template <bool SET, uint8 FLAGS>
+void LR35902::call_cc_nn()
+{
+    this->call_cc_nn(SET, FLAGS);
+}
+
+template <bool SET, uint8 FLAGS>
+void LR35902::ret_cc()
+{
+    this->ret_cc(SET, FLAGS);
+}
+
+template <uint8 OFFSET>
+void LR35902::rst_n()
+{
+    this->rst_n(OFFSET);
+}
+
+template <LR35902::REG16 REG>
+void LR35902::ld_rr_a()
+{
+    this->ld_rr_a(this->rr.*REG);
+}
+
+template <LR35902::REG16 REG>
+void LR35902::ld_a_rr()
+{
+    this->ld_a_rr(this->rr.*REG);
+}
+
+template <LR35902::REG8 REG>
+void LR35902::ld_r_n()
+{
+    this->ld_r_n(this->r.*REG);
+}
+
+template <LR35902::REG8 REG1, LR35902::REG8 REG2>
+void LR35902::ld_r_r()
+{
+    this->ld_r_r(this->r.*REG1, this->r.*REG2);
+}
+
+template <LR35902::REG8 REG>
+void LR35902::ld_r_hl()
+{
+    this->ld_r_hl(this->r.*REG);
+}
+
+template <LR35902::REG8 REG>
+void LR35902::ld_hl_r()
+{
+    this->ld_hl_r(this->r.*REG);
+}
+
+template <LR35902::REG8 REG>
+void LR35902::add_a_r()
+{
+    this->add_a_r(this->r.*REG);
+}
+
+template <LR35902::REG8 REG>
+void LR35902::adc_a_r()
+{
+    this->adc_a_r(this->r.*REG);
+}
+
+template <LR35902::REG8 REG>
+void LR35902::sub_a_r()
+{
+    this->sub_a_r(this->r.*REG);
+}
+
+template <LR35902::REG8 REG>
+void LR35902::sbc_a_r()
+{
+    this->sbc_a_r(this->r.*REG);
+}
+
+template <LR35902::REG8 REG>
+void LR35902::and_a_r()
+{
+    this->and_a_r(this->r.*REG);
+}
+
+template <LR35902::REG8 REG>
+void LR35902::xor_a_r()
+{
+    this->xor_a_r(this->r.*REG);
+}
+
+template <LR35902::REG8 REG>
+void LR35902::or_a_r()
+{
+    this->or_a_r(this->r.*REG);
+}
+
+template <LR35902::REG8 REG>
+void LR35902::cp_a_r()
+{
+    this->cp_a_r(this->r.*REG);
+}
+
+template <LR35902::REG8 REG>
+void LR35902::inc_r()
+{
+    this->inc_r(this->r.*REG);
+}
+
+template <LR35902::REG8 REG>
+void LR35902::dec_r()
+{
+    this->dec_r(this->r.*REG);
+}
+
+template <LR35902::REG16 REG>
+void LR35902::ld_rr_nn()
+{
+    this->ld_rr_nn(this->rr.*REG);
+}
+
+template <LR35902::REG16 REG>
+void LR35902::pop_rr()
+{
+    this->pop_rr(this->rr.*REG);
+}
+
+template <LR35902::REG16 REG>
+void LR35902::push_rr()
+{
+    this->push_rr(this->rr.*REG);
+}
+
+template <LR35902::REG16 REG>
+void LR35902::inc_rr()
+{
+    this->inc_rr(this->rr.*REG);
+}
+
+template <LR35902::REG16 REG>
+void LR35902::dec_rr()
+{
+    this->dec_rr(this->rr.*REG);
+}
+
+template <LR35902::REG16 REG>
+void LR35902::add_hl_rr()
+{
+    this->add_hl_rr(this->rr.*REG);
+}
+
+/*
+CB prefixed op codes are decoded from their fields at compile time: bits 0-2 select the register ((HL) at 6),
+bits 3-5 the bit index or the shift/rotate, and bits 6-7 the group.  The (HL) forms read the operand from the
+bus and, except for bit, write the result back.
+*/
+
+template <uint8 INDEX>
+uint8 &LR35902::cb_r()
+{
+    switch (INDEX) {
+        case 0x00: return this->r.b;
+        case 0x01: return this->r.c;
+        case 0x02: return this->r.d;
+        case 0x03: return this->r.e;
+        case 0x04: return this->r.h;
+        case 0x05: return this->r.l;
+        default:   return this->r.a;
+    }
+}
+
+template <uint8 OP>
+void LR35902::cb_alu(uint8 &value)
+{
+    const uint8 index = (OP >> 3) & 0x07;
+    switch (OP >> 6) {
+        case 0x00:
+            switch (index) {
+                case 0x00: return this->rlc_r(value);
+                case 0x01: return this->rrc_r(value);
+                case 0x02: return this->rl_r(value);
+                case 0x03: return this->rr_r(value);
+                case 0x04: return this->sla_r(value);
+                case 0x05: return this->sra_r(value);
+                case 0x06: return this->swap_r(value);
+                default:   return this->srl_r(value);
+            }
+        case 0x01: return this->bit_b_r(index, value);
+        case 0x02: return this->res_b_r(index, value);
+        default:   return this->set_b_r(index, value);
+    }
+}
+
+template <uint8 OP>
+void LR35902::cb_op()
+{
+    if (0x06 == (OP & 0x07)) {
+        uint8 value = this->read8(this->rr.hl);
+        this->cb_alu<OP>(value);
+        if (0x40 != (OP & 0xC0)) {
+            this->write8(this->rr.hl, value);
+        }
+    } else {
+        this->cb_alu<OP>(this->cb_r<OP & 0x07>());
+    }
+}
+
+/* Dispatch the op code following the CB prefix, fetched into imm. */
+void LR35902::cb_prefix()
+{
+    LR35902_ADD_CYCLES(CB_OP_INFO[(uint8)this->imm].cycles);
+    (this->*CB_OP_TABLE[(uint8)this->imm])();
+}
+
+/*********************************************************************************************************************\
+| Dispatch Tables                                                                                                     |
+\*********************************************************************************************************************/
+
+/* Select a register for a specialized handler. */
+#define R(NAME) &LR35902::_REGISTERS::NAME
+#define RR(NAME) &LR35902::_PAIRS::NAME
+
+const LR35902_OP_FN LR35902::OP_TABLE[256] = {
+        /* 0x00 */ &LR35902::nop,
+        /* 0x01 */ &LR35902::ld_rr_nn<RR(bc)>,
+        /* 0x02 */ &LR35902::ld_rr_a<RR(bc)>,
+        /* 0x03 */ &LR35902::inc_rr<RR(bc)>,
+        /* 0x04 */ &LR35902::inc_r<R(b)>,
+        /* 0x05 */ &LR35902::dec_r<R(b)>,
+        /* 0x06 */ &LR35902::ld_r_n<R(b)>,
+        /* 0x07 */ &LR35902::rlca,
+        /* 0x08 */ &LR35902::ld_nn_sp,
+        /* 0x09 */ &LR35902::add_hl_rr<RR(bc)>,
+        /* 0x0A */ &LR35902::ld_a_rr<RR(bc)>,
+        /* 0x0B */ &LR35902::dec_rr<RR(bc)>,
+        /* 0x0C */ &LR35902::inc_r<R(c)>,
+        /* 0x0D */ &LR35902::dec_r<R(c)>,
+        /* 0x0E */ &LR35902::ld_r_n<R(c)>,
+        /* 0x0F */ &LR35902::rrca,
+        /* 0x10 */ &LR35902::stop,
+        /* 0x11 */ &LR35902::ld_rr_nn<RR(de)>,
+        /* 0x12 */ &LR35902::ld_rr_a<RR(de)>,
+        /* 0x13 */ &LR35902::inc_rr<RR(de)>,
+        /* 0x14 */ &LR35902::inc_r<R(d)>,
+        /* 0x15 */ &LR35902::dec_r<R(d)>,
+        /* 0x16 */ &LR35902::ld_r_n<R(d)>,
+        /* 0x17 */ &LR35902::rla,
+        /* 0x18 */ &LR35902::jr_n,
+        /* 0x19 */ &LR35902::add_hl_rr<RR(de)>,
+        /* 0x1A */ &LR35902::ld_a_rr<RR(de)>,
+        /* 0x1B */ &LR35902::dec_rr<RR(de)>,
+        /* 0x1C */ &LR35902::inc_r<R(e)>,
+        /* 0x1D */ &LR35902::dec_r<R(e)>,
+        /* 0x1E */ &LR35902::ld_r_n<R(e)>,
+        /* 0x1F */ &LR35902::rra,
+        /* 0x20 */ &LR35902::jr_cc_n<false, LR35902_FLAG_ZERO>,
+        /* 0x21 */ &LR35902::ld_rr_nn<RR(hl)>,
+        /* 0x22 */ &LR35902::ldi_hl_a,
+        /* 0x23 */ &LR35902::inc_rr<RR(hl)>,
+        /* 0x24 */ &LR35902::inc_r<R(h)>,
+        /* 0x25 */ &LR35902::dec_r<R(h)>,
+        /* 0x26 */ &LR35902::ld_r_n<R(h)>,
+        /* 0x27 */ &LR35902::daa,
+        /* 0x28 */ &LR35902::jr_cc_n<true, LR35902_FLAG_ZERO>,
+        /* 0x29 */ &LR35902::add_hl_rr<RR(hl)>,
+        /* 0x2A */ &LR35902::ldi_a_hl,
+        /* 0x2B */ &LR35902::dec_rr<RR(hl)>,
+        /* 0x2C */ &LR35902::inc_r<R(l)>,
+        /* 0x2D */ &LR35902::dec_r<R(l)>,
+        /* 0x2E */ &LR35902::ld_r_n<R(l)>,
+        /* 0x2F */ &LR35902::cpl,
+        /* 0x30 */ &LR35902::jr_cc_n<false, LR35902_FLAG_CARRY>,
+        /* 0x31 */ &LR35902::ld_rr_nn<RR(sp)>,
+        /* 0x32 */ &LR35902::ldd_hl_a,
+        /* 0x33 */ &LR35902::inc_rr<RR(sp)>,
+        /* 0x34 */ &LR35902::inc_hl,
+        /* 0x35 */ &LR35902::dec_hl,
+        /* 0x36 */ &LR35902::ld_hl_n,
+        /* 0x37 */ &LR35902::scf,
+        /* 0x38 */ &LR35902::jr_cc_n<true, LR35902_FLAG_CARRY>,
+        /* 0x39 */ &LR35902::add_hl_rr<RR(sp)>,
+        /* 0x3A */ &LR35902::ldd_a_hl,
+        /* 0x3B */ &LR35902::dec_rr<RR(sp)>,
+        /* 0x3C */ &LR35902::inc_r<R(a)>,
+        /* 0x3D */ &LR35902::dec_r<R(a)>,
+        /* 0x3E */ &LR35902::ld_r_n<R(a)>,
+        /* 0x3F */ &LR35902::ccf,
+        /* 0x40 */ &LR35902::ld_r_r<R(b), R(b)>,
+        /* 0x41 */ &LR35902::ld_r_r<R(b), R(c)>,
+        /* 0x42 */ &LR35902::ld_r_r<R(b), R(d)>,
+        /* 0x43 */ &LR35902::ld_r_r<R(b), R(e)>,
+        /* 0x44 */ &LR35902::ld_r_r<R(b), R(h)>,
+        /* 0x45 */ &LR35902::ld_r_r<R(b), R(l)>,
+        /* 0x46 */ &LR35902::ld_r_hl<R(b)>,
+        /* 0x47 */ &LR35902::ld_r_r<R(b), R(a)>,
+        /* 0x48 */ &LR35902::ld_r_r<R(c), R(b)>,
+        /* 0x49 */ &LR35902::ld_r_r<R(c), R(c)>,
+        /* 0x4A */ &LR35902::ld_r_r<R(c), R(d)>,
+        /* 0x4B */ &LR35902::ld_r_r<R(c), R(e)>,
+        /* 0x4C */ &LR35902::ld_r_r<R(c), R(h)>,
+        /* 0x4D */ &LR35902::ld_r_r<R(c), R(l)>,
+        /* 0x4E */ &LR35902::ld_r_hl<R(c)>,
+        /* 0x4F */ &LR35902::ld_r_r<R(c), R(a)>,
+        /* 0x50 */ &LR35902::ld_r_r<R(d), R(b)>,
+        /* 0x51 */ &LR35902::ld_r_r<R(d), R(c)>,
+        /* 0x52 */ &LR35902::ld_r_r<R(d), R(d)>,
+        /* 0x53 */ &LR35902::ld_r_r<R(d), R(e)>,
+        /* 0x54 */ &LR35902::ld_r_r<R(d), R(h)>,
+        /* 0x55 */ &LR35902::ld_r_r<R(d), R(l)>,
+        /* 0x56 */ &LR35902::ld_r_hl<R(d)>,
+        /* 0x57 */ &LR35902::ld_r_r<R(d), R(a)>,
+        /* 0x58 */ &LR35902::ld_r_r<R(e), R(b)>,
+        /* 0x59 */ &LR35902::ld_r_r<R(e), R(c)>,
+        /* 0x5A */ &LR35902::ld_r_r<R(e), R(d)>,
+        /* 0x5B */ &LR35902::ld_r_r<R(e), R(e)>,
+        /* 0x5C */ &LR35902::ld_r_r<R(e), R(h)>,
+        /* 0x5D */ &LR35902::ld_r_r<R(e), R(l)>,
+        /* 0x5E */ &LR35902::ld_r_hl<R(e)>,
+        /* 0x5F */ &LR35902::ld_r_r<R(e), R(a)>,
+        /* 0x60 */ &LR35902::ld_r_r<R(h), R(b)>,
+        /* 0x61 */ &LR35902::ld_r_r<R(h), R(c)>,
+        /* 0x62 */ &LR35902::ld_r_r<R(h), R(d)>,
+        /* 0x63 */ &LR35902::ld_r_r<R(h), R(e)>,
+        /* 0x64 */ &LR35902::ld_r_r<R(h), R(h)>,
+        /* 0x65 */ &LR35902::ld_r_r<R(h), R(l)>,
+        /* 0x66 */ &LR35902::ld_r_hl<R(h)>,
+        /* 0x67 */ &LR35902::ld_r_r<R(h), R(a)>,
+        /* 0x68 */ &LR35902::ld_r_r<R(l), R(b)>,
+        /* 0x69 */ &LR35902::ld_r_r<R(l), R(c)>,
+        /* 0x6A */ &LR35902::ld_r_r<R(l), R(d)>,
+        /* 0x6B */ &LR35902::ld_r_r<R(l), R(e)>,
+        /* 0x6C */ &LR35902::ld_r_r<R(l), R(h)>,
+        /* 0x6D */ &LR35902::ld_r_r<R(l), R(l)>,
+        /* 0x6E */ &LR35902::ld_r_hl<R(l)>,
+        /* 0x6F */ &LR35902::ld_r_r<R(l), R(a)>,
+        /* 0x70 */ &LR35902::ld_hl_r<R(b)>,
+        /* 0x71 */ &LR35902::ld_hl_r<R(c)>,
+        /* 0x72 */ &LR35902::ld_hl_r<R(d)>,
+        /* 0x73 */ &LR35902::ld_hl_r<R(e)>,
+        /* 0x74 */ &LR35902::ld_hl_r<R(h)>,
+        /* 0x75 */ &LR35902::ld_hl_r<R(l)>,
+        /* 0x76 */ &LR35902::halt,
+        /* 0x77 */ &LR35902::ld_hl_r<R(a)>,
+        /* 0x78 */ &LR35902::ld_r_r<R(a), R(b)>,
+        /* 0x79 */ &LR35902::ld_r_r<R(a), R(c)>,
+        /* 0x7A */ &LR35902::ld_r_r<R(a), R(d)>,
+        /* 0x7B */ &LR35902::ld_r_r<R(a), R(e)>,
+        /* 0x7C */ &LR35902::ld_r_r<R(a), R(h)>,
+        /* 0x7D */ &LR35902::ld_r_r<R(a), R(l)>,
+        /* 0x7E */ &LR35902::ld_r_hl<R(a)>,
+        /* 0x7F */ &LR35902::ld_r_r<R(a), R(a)>,
+        /* 0x80 */ &LR35902::add_a_r<R(b)>,
+        /* 0x81 */ &LR35902::add_a_r<R(c)>,
+        /* 0x82 */ &LR35902::add_a_r<R(d)>,
+        /* 0x83 */ &LR35902::add_a_r<R(e)>,
+        /* 0x84 */ &LR35902::add_a_r<R(h)>,
+        /* 0x85 */ &LR35902::add_a_r<R(l)>,
+        /* 0x86 */ &LR35902::add_a_hl,
+        /* 0x87 */ &LR35902::add_a_r<R(a)>,
+        /* 0x88 */ &LR35902::adc_a_r<R(b)>,
+        /* 0x89 */ &LR35902::adc_a_r<R(c)>,
+        /* 0x8A */ &LR35902::adc_a_r<R(d)>,
+        /* 0x8B */ &LR35902::adc_a_r<R(e)>,
+        /* 0x8C */ &LR35902::adc_a_r<R(h)>,
+        /* 0x8D */ &LR35902::adc_a_r<R(l)>,
+        /* 0x8E */ &LR35902::adc_a_hl,
+        /* 0x8F */ &LR35902::adc_a_r<R(a)>,
+        /* 0x90 */ &LR35902::sub_a_r<R(b)>,
+        /* 0x91 */ &LR35902::sub_a_r<R(c)>,
+        /* 0x92 */ &LR35902::sub_a_r<R(d)>,
+        /* 0x93 */ &LR35902::sub_a_r<R(e)>,
+        /* 0x94 */ &LR35902::sub_a_r<R(h)>,
+        /* 0x95 */ &LR35902::sub_a_r<R(l)>,
+        /* 0x96 */ &LR35902::sub_a_hl,
+        /* 0x97 */ &LR35902::sub_a_r<R(a)>,
+        /* 0x98 */ &LR35902::sbc_a_r<R(b)>,
+        /* 0x99 */ &LR35902::sbc_a_r<R(c)>,
+        /* 0x9A */ &LR35902::sbc_a_r<R(d)>,
+        /* 0x9B */ &LR35902::sbc_a_r<R(e)>,
+        /* 0x9C */ &LR35902::sbc_a_r<R(h)>,
+        /* 0x9D */ &LR35902::sbc_a_r<R(l)>,
+        /* 0x9E */ &LR35902::sbc_a_hl,
+        /* 0x9F */ &LR35902::sbc_a_r<R(a)>,
+        /* 0xA0 */ &LR35902::and_a_r<R(b)>,
+        /* 0xA1 */ &LR35902::and_a_r<R(c)>,
+        /* 0xA2 */ &LR35902::and_a_r<R(d)>,
+        /* 0xA3 */ &LR35902::and_a_r<R(e)>,
+        /* 0xA4 */ &LR35902::and_a_r<R(h)>,
+        /* 0xA5 */ &LR35902::and_a_r<R(l)>,
+        /* 0xA6 */ &LR35902::and_a_hl,
+        /* 0xA7 */ &LR35902::and_a_r<R(a)>,
+        /* 0xA8 */ &LR35902::xor_a_r<R(b)>,
+        /* 0xA9 */ &LR35902::xor_a_r<R(c)>,
+        /* 0xAA */ &LR35902::xor_a_r<R(d)>,
+        /* 0xAB */ &LR35902::xor_a_r<R(e)>,
+        /* 0xAC */ &LR35902::xor_a_r<R(h)>,
+        /* 0xAD */ &LR35902::xor_a_r<R(l)>,
+        /* 0xAE */ &LR35902::xor_a_hl,
+        /* 0xAF */ &LR35902::xor_a_r<R(a)>,
+        /* 0xB0 */ &LR35902::or_a_r<R(b)>,
+        /* 0xB1 */ &LR35902::or_a_r<R(c)>,
+        /* 0xB2 */ &LR35902::or_a_r<R(d)>,
+        /* 0xB3 */ &LR35902::or_a_r<R(e)>,
+        /* 0xB4 */ &LR35902::or_a_r<R(h)>,
+        /* 0xB5 */ &LR35902::or_a_r<R(l)>,
+        /* 0xB6 */ &LR35902::or_a_hl,
+        /* 0xB7 */ &LR35902::or_a_r<R(a)>,
+        /* 0xB8 */ &LR35902::cp_a_r<R(b)>,
+        /* 0xB9 */ &LR35902::cp_a_r<R(c)>,
+        /* 0xBA */ &LR35902::cp_a_r<R(d)>,
+        /* 0xBB */ &LR35902::cp_a_r<R(e)>,
+        /* 0xBC */ &LR35902::cp_a_r<R(h)>,
+        /* 0xBD */ &LR35902::cp_a_r<R(l)>,
+        /* 0xBE */ &LR35902::cp_a_hl,
+        /* 0xBF */ &LR35902::cp_a_r<R(a)>,
+        /* 0xC0 */ &LR35902::ret_cc<false, LR35902_FLAG_ZERO>,
+        /* 0xC1 */ &LR35902::pop_rr<RR(bc)>,
+        /* 0xC2 */ &LR35902::jp_cc_nn<false, LR35902_FLAG_ZERO>,
+        /* 0xC3 */ &LR35902::jp_nn,
+        /* 0xC4 */ &LR35902::call_cc_nn<false, LR35902_FLAG_ZERO>,
+        /* 0xC5 */ &LR35902::push_rr<RR(bc)>,
+        /* 0xC6 */ &LR35902::add_a_n,
+        /* 0xC7 */ &LR35902::rst_n<0x00>,
+        /* 0xC8 */ &LR35902::ret_cc<true, LR35902_FLAG_ZERO>,
+        /* 0xC9 */ &LR35902::ret,
+        /* 0xCA */ &LR35902::jp_cc_nn<true, LR35902_FLAG_ZERO>,
+        /* 0xCB */ &LR35902::cb_prefix,
+        /* 0xCC */ &LR35902::call_cc_nn<true, LR35902_FLAG_ZERO>,
+        /* 0xCD */ &LR35902::call_nn,
+        /* 0xCE */ &LR35902::adc_a_n,
+        /* 0xCF */ &LR35902::rst_n<0x08>,
+        /* 0xD0 */ &LR35902::ret_cc<false, LR35902_FLAG_CARRY>,
+        /* 0xD1 */ &LR35902::pop_rr<RR(de)>,
+        /* 0xD2 */ &LR35902::jp_cc_nn<false, LR35902_FLAG_CARRY>,
+        /* 0xD3 */ &LR35902::INVALID_OP,
+        /* 0xD4 */ &LR35902::call_cc_nn<false, LR35902_FLAG_CARRY>,
+        /* 0xD5 */ &LR35902::push_rr<RR(de)>,
+        /* 0xD6 */ &LR35902::sub_a_n,
+        /* 0xD7 */ &LR35902::rst_n<0x10>,
+        /* 0xD8 */ &LR35902::ret_cc<true, LR35902_FLAG_CARRY>,
+        /* 0xD9 */ &LR35902::reti,
+        /* 0xDA */ &LR35902::jp_cc_nn<true, LR35902_FLAG_CARRY>,
+        /* 0xDB */ &LR35902::INVALID_OP,
+        /* 0xDC */ &LR35902::call_cc_nn<true, LR35902_FLAG_CARRY>,
+        /* 0xDD */ &LR35902::INVALID_OP,
+        /* 0xDE */ &LR35902::sbc_a_n,
+        /* 0xDF */ &LR35902::rst_n<0x18>,
+        /* 0xE0 */ &LR35902::ldh_n_a,
+        /* 0xE1 */ &LR35902::pop_rr<RR(hl)>,
+        /* 0xE2 */ &LR35902::ld_c_a,
+        /* 0xE3 */ &LR35902::INVALID_OP,
+        /* 0xE4 */ &LR35902::INVALID_OP,
+        /* 0xE5 */ &LR35902::push_rr<RR(hl)>,
+        /* 0xE6 */ &LR35902::and_a_n,
+        /* 0xE7 */ &LR35902::rst_n<0x20>,
+        /* 0xE8 */ &LR35902::add_sp_n,
+        /* 0xE9 */ &LR35902::jp_hl,
+        /* 0xEA */ &LR35902::ld_nn_a,
+        /* 0xEB */ &LR35902::INVALID_OP,
+        /* 0xEC */ &LR35902::INVALID_OP,
+        /* 0xED */ &LR35902::INVALID_OP,
+        /* 0xEE */ &LR35902::xor_a_n,
+        /* 0xEF */ &LR35902::rst_n<0x28>,
+        /* 0xF0 */ &LR35902::ldh_a_n,
+        /* 0xF1 */ &LR35902::pop_rr<RR(af)>,
+        /* 0xF2 */ &LR35902::ld_a_c,
+        /* 0xF3 */ &LR35902::di,
+        /* 0xF4 */ &LR35902::INVALID_OP,
+        /* 0xF5 */ &LR35902::push_rr<RR(af)>,
+        /* 0xF6 */ &LR35902::or_a_n,
+        /* 0xF7 */ &LR35902::rst_n<0x30>,
+        /* 0xF8 */ &LR35902::ldhl_sp_n,
+        /* 0xF9 */ &LR35902::ld_sp_hl,
+        /* 0xFA */ &LR35902::ld_a_nn,
+        /* 0xFB */ &LR35902::ei,
+        /* 0xFC */ &LR35902::INVALID_OP,
+        /* 0xFD */ &LR35902::INVALID_OP,
+        /* 0xFE */ &LR35902::cp_a_n,
+        /* 0xFF */ &LR35902::rst_n<0x38>
+};
+
+/* Instantiate the CB handlers of 8 and 64 consecutive op codes. */
+#define CB8(OP)     &LR35902::cb_op<(OP) + 0x00>, &LR35902::cb_op<(OP) + 0x01>, \
+                    &LR35902::cb_op<(OP) + 0x02>, &LR35902::cb_op<(OP) + 0x03>, \
+                    &LR35902::cb_op<(OP) + 0x04>, &LR35902::cb_op<(OP) + 0x05>, \
+                    &LR35902::cb_op<(OP) + 0x06>, &LR35902::cb_op<(OP) + 0x07>
+#define CB64(OP)    CB8((OP) + 0x00), CB8((OP) + 0x08), CB8((OP) + 0x10), CB8((OP) + 0x18), \
+                    CB8((OP) + 0x20), CB8((OP) + 0x28), CB8((OP) + 0x30), CB8((OP) + 0x38)
+
+const LR35902_OP_FN LR35902::CB_OP_TABLE[256] = {
+        /* 0x00 */ CB64(0x00),      // rlc, rrc, rl, rr, sla, sra, swap, srl
+        /* 0x40 */ CB64(0x40),      // bit
+        /* 0x80 */ CB64(0x80),      // res
+        /* 0xC0 */ CB64(0xC0)       // set
+};
+
+#undef CB64
+#undef CB8
+
+#undef R
+#undef RR
+
+/*
+Decode information: {length, cycles, taken, flags}.  The cycles of a CB prefixed op are held by CB_OP_INFO, the
+cycles of a conditional op are the not taken duration and taken is the duration when it branches.
+*/
+const LR35902_OP_INFO LR35902::OP_INFO[256] = {
+        /* 0x00 */ {1,  4,  4, 0},
+        /* 0x01 */ {3, 12, 12, 0},
+        /* 0x02 */ {1,  8,  8, 0},
+        /* 0x03 */ {1,  8,  8, 0},
+        /* 0x04 */ {1,  4,  4, 0},
+        /* 0x05 */ {1,  4,  4, 0},
+        /* 0x06 */ {2,  8,  8, 0},
+        /* 0x07 */ {1,  4,  4, 0},
+        /* 0x08 */ {3, 20, 20, 0},
+        /* 0x09 */ {1,  8,  8, 0},
+        /* 0x0A */ {1,  8,  8, 0},
+        /* 0x0B */ {1,  8,  8, 0},
+        /* 0x0C */ {1,  4,  4, 0},
+        /* 0x0D */ {1,  4,  4, 0},
+        /* 0x0E */ {2,  8,  8, 0},
+        /* 0x0F */ {1,  4,  4, 0},
+        /* 0x10 */ {2,  4,  4, LR35902_OP_ENDS_BLOCK},
+        /* 0x11 */ {3, 12, 12, 0},
+        /* 0x12 */ {1,  8,  8, 0},
+        /* 0x13 */ {1,  8,  8, 0},
+        /* 0x14 */ {1,  4,  4, 0},
+        /* 0x15 */ {1,  4,  4, 0},
+        /* 0x16 */ {2,  8,  8, 0},
+        /* 0x17 */ {1,  4,  4, 0},
+        /* 0x18 */ {2, 12, 12, LR35902_OP_ENDS_BLOCK},
+        /* 0x19 */ {1,  8,  8, 0},
+        /* 0x1A */ {1,  8,  8, 0},
+        /* 0x1B */ {1,  8,  8, 0},
+        /* 0x1C */ {1,  4,  4, 0},
+        /* 0x1D */ {1,  4,  4, 0},
+        /* 0x1E */ {2,  8,  8, 0},
+        /* 0x1F */ {1,  4,  4, 0},
+        /* 0x20 */ {2,  8, 12, LR35902_OP_ENDS_BLOCK},
+        /* 0x21 */ {3, 12, 12, 0},
+        /* 0x22 */ {1,  8,  8, 0},
+        /* 0x23 */ {1,  8,  8, 0},
+        /* 0x24 */ {1,  4,  4, 0},
+        /* 0x25 */ {1,  4,  4, 0},
+        /* 0x26 */ {2,  8,  8, 0},
+        /* 0x27 */ {1,  4,  4, 0},
+        /* 0x28 */ {2,  8, 12, LR35902_OP_ENDS_BLOCK},
+        /* 0x29 */ {1,  8,  8, 0},
+        /* 0x2A */ {1,  8,  8, 0},
+        /* 0x2B */ {1,  8,  8, 0},
+        /* 0x2C */ {1,  4,  4, 0},
+        /* 0x2D */ {1,  4,  4, 0},
+        /* 0x2E */ {2,  8,  8, 0},
+        /* 0x2F */ {1,  4,  4, 0},
+        /* 0x30 */ {2,  8, 12, LR35902_OP_ENDS_BLOCK},
+        /* 0x31 */ {3, 12, 12, 0},
+        /* 0x32 */ {1,  8,  8, 0},
+        /* 0x33 */ {1,  8,  8, 0},
+        /* 0x34 */ {1, 12, 12, 0},
+        /* 0x35 */ {1, 12, 12, 0},
+        /* 0x36 */ {2, 12, 12, 0},
+        /* 0x37 */ {1,  4,  4, 0},
+        /* 0x38 */ {2,  8, 12, LR35902_OP_ENDS_BLOCK},
+        /* 0x39 */ {1,  8,  8, 0},
+        /* 0x3A */ {1,  8,  8, 0},
+        /* 0x3B */ {1,  8,  8, 0},
+        /* 0x3C */ {1,  4,  4, 0},
+        /* 0x3D */ {1,  4,  4, 0},
+        /* 0x3E */ {2,  8,  8, 0},
+        /* 0x3F */ {1,  4,  4, 0},
+        /* 0x40 */ {1,  4,  4, 0},
+        /* 0x41 */ {1,  4,  4, 0},
+        /* 0x42 */ {1,  4,  4, 0},
+        /* 0x43 */ {1,  4,  4, 0},
+        /* 0x44 */ {1,  4,  4, 0},
+        /* 0x45 */ {1,  4,  4, 0},
+        /* 0x46 */ {1,  8,  8, 0},
+        /* 0x47 */ {1,  4,  4, 0},
+        /* 0x48 */ {1,  4,  4, 0},
+        /* 0x49 */ {1,  4,  4, 0},
+        /* 0x4A */ {1,  4,  4, 0},
+        /* 0x4B */ {1,  4,  4, 0},
+        /* 0x4C */ {1,  4,  4, 0},
+        /* 0x4D */ {1,  4,  4, 0},
+        /* 0x4E */ {1,  8,  8, 0},
+        /* 0x4F */ {1,  4,  4, 0},
+        /* 0x50 */ {1,  4,  4, 0},
+        /* 0x51 */ {1,  4,  4, 0},
+        /* 0x52 */ {1,  4,  4, 0},
+        /* 0x53 */ {1,  4,  4, 0},
+        /* 0x54 */ {1,  4,  4, 0},
+        /* 0x55 */ {1,  4,  4, 0},
+        /* 0x56 */ {1,  8,  8, 0},
+        /* 0x57 */ {1,  4,  4, 0},
+        /* 0x58 */ {1,  4,  4, 0},
+        /* 0x59 */ {1,  4,  4, 0},
+        /* 0x5A */ {1,  4,  4, 0},
+        /* 0x5B */ {1,  4,  4, 0},
+        /* 0x5C */ {1,  4,  4, 0},
+        /* 0x5D */ {1,  4,  4, 0},
+        /* 0x5E */ {1,  8,  8, 0},
+        /* 0x5F */ {1,  4,  4, 0},
+        /* 0x60 */ {1,  4,  4, 0},
+        /* 0x61 */ {1,  4,  4, 0},
+        /* 0x62 */ {1,  4,  4, 0},
+        /* 0x63 */ {1,  4,  4, 0},
+        /* 0x64 */ {1,  4,  4, 0},
+        /* 0x65 */ {1,  4,  4, 0},
+        /* 0x66 */ {1,  8,  8, 0},
+        /* 0x67 */ {1,  4,  4, 0},
+        /* 0x68 */ {1,  4,  4, 0},
+        /* 0x69 */ {1,  4,  4, 0},
+        /* 0x6A */ {1,  4,  4, 0},
+        /* 0x6B */ {1,  4,  4, 0},
+        /* 0x6C */ {1,  4,  4, 0},
+        /* 0x6D */ {1,  4,  4, 0},
+        /* 0x6E */ {1,  8,  8, 0},
+        /* 0x6F */ {1,  4,  4, 0},
+        /* 0x70 */ {1,  8,  8, 0},
+        /* 0x71 */ {1,  8,  8, 0},
+        /* 0x72 */ {1,  8,  8, 0},
+        /* 0x73 */ {1,  8,  8, 0},
+        /* 0x74 */ {1,  8,  8, 0},
+        /* 0x75 */ {1,  8,  8, 0},
+        /* 0x76 */ {1,  4,  4, LR35902_OP_ENDS_BLOCK},
+        /* 0x77 */ {1,  8,  8, 0},
+        /* 0x78 */ {1,  4,  4, 0},
+        /* 0x79 */ {1,  4,  4, 0},
+        /* 0x7A */ {1,  4,  4, 0},
+        /* 0x7B */ {1,  4,  4, 0},
+        /* 0x7C */ {1,  4,  4, 0},
+        /* 0x7D */ {1,  4,  4, 0},
+        /* 0x7E */ {1,  8,  8, 0},
+        /* 0x7F */ {1,  4,  4, 0},
+        /* 0x80 */ {1,  4,  4, 0},
+        /* 0x81 */ {1,  4,  4, 0},
+        /* 0x82 */ {1,  4,  4, 0},
+        /* 0x83 */ {1,  4,  4, 0},
+        /* 0x84 */ {1,  4,  4, 0},
+        /* 0x85 */ {1,  4,  4, 0},
+        /* 0x86 */ {1,  8,  8, 0},
+        /* 0x87 */ {1,  4,  4, 0},
+        /* 0x88 */ {1,  4,  4, 0},
+        /* 0x89 */ {1,  4,  4, 0},
+        /* 0x8A */ {1,  4,  4, 0},
+        /* 0x8B */ {1,  4,  4, 0},
+        /* 0x8C */ {1,  4,  4, 0},
+        /* 0x8D */ {1,  4,  4, 0},
+        /* 0x8E */ {1,  8,  8, 0},
+        /* 0x8F */ {1,  4,  4, 0},
+        /* 0x90 */ {1,  4,  4, 0},
+        /* 0x91 */ {1,  4,  4, 0},
+        /* 0x92 */ {1,  4,  4, 0},
+        /* 0x93 */ {1,  4,  4, 0},
+        /* 0x94 */ {1,  4,  4, 0},
+        /* 0x95 */ {1,  4,  4, 0},
+        /* 0x96 */ {1,  8,  8, 0},
+        /* 0x97 */ {1,  4,  4, 0},
+        /* 0x98 */ {1,  4,  4, 0},
+        /* 0x99 */ {1,  4,  4, 0},
+        /* 0x9A */ {1,  4,  4, 0},
+        /* 0x9B */ {1,  4,  4, 0},
+        /* 0x9C */ {1,  4,  4, 0},
+        /* 0x9D */ {1,  4,  4, 0},
+        /* 0x9E */ {1,  8,  8, 0},
+        /* 0x9F */ {1,  4,  4, 0},
+        /* 0xA0 */ {1,  4,  4, 0},
+        /* 0xA1 */ {1,  4,  4, 0},
+        /* 0xA2 */ {1,  4,  4, 0},
+        /* 0xA3 */ {1,  4,  4, 0},
+        /* 0xA4 */ {1,  4,  4, 0},
+        /* 0xA5 */ {1,  4,  4, 0},
+        /* 0xA6 */ {1,  8,  8, 0},
+        /* 0xA7 */ {1,  4,  4, 0},
+        /* 0xA8 */ {1,  4,  4, 0},
+        /* 0xA9 */ {1,  4,  4, 0},
+        /* 0xAA */ {1,  4,  4, 0},
+        /* 0xAB */ {1,  4,  4, 0},
+        /* 0xAC */ {1,  4,  4, 0},
+        /* 0xAD */ {1,  4,  4, 0},
+        /* 0xAE */ {1,  8,  8, 0},
+        /* 0xAF */ {1,  4,  4, 0},
+        /* 0xB0 */ {1,  4,  4, 0},
+        /* 0xB1 */ {1,  4,  4, 0},
+        /* 0xB2 */ {1,  4,  4, 0},
+        /* 0xB3 */ {1,  4,  4, 0},
+        /* 0xB4 */ {1,  4,  4, 0},
+        /* 0xB5 */ {1,  4,  4, 0},
+        /* 0xB6 */ {1,  8,  8, 0},
+        /* 0xB7 */ {1,  4,  4, 0},
+        /* 0xB8 */ {1,  4,  4, 0},
+        /* 0xB9 */ {1,  4,  4, 0},
+        /* 0xBA */ {1,  4,  4, 0},
+        /* 0xBB */ {1,  4,  4, 0},
+        /* 0xBC */ {1,  4,  4, 0},
+        /* 0xBD */ {1,  4,  4, 0},
+        /* 0xBE */ {1,  8,  8, 0},
+        /* 0xBF */ {1,  4,  4, 0},
+        /* 0xC0 */ {1,  8, 20, LR35902_OP_ENDS_BLOCK},
+        /* 0xC1 */ {1, 12, 12, 0},
+        /* 0xC2 */ {3, 12, 16, LR35902_OP_ENDS_BLOCK},
+        /* 0xC3 */ {3, 16, 16, LR35902_OP_ENDS_BLOCK},
+        /* 0xC4 */ {3, 12, 24, LR35902_OP_ENDS_BLOCK},
+        /* 0xC5 */ {1, 16, 16, 0},
+        /* 0xC6 */ {2,  8,  8, 0},
+        /* 0xC7 */ {1, 16, 16, LR35902_OP_ENDS_BLOCK},
+        /* 0xC8 */ {1,  8, 20, LR35902_OP_ENDS_BLOCK},
+        /* 0xC9 */ {1, 16, 16, LR35902_OP_ENDS_BLOCK},
+        /* 0xCA */ {3, 12, 16, LR35902_OP_ENDS_BLOCK},
+        /* 0xCB */ {2,  0,  0, 0},
+        /* 0xCC */ {3, 12, 24, LR35902_OP_ENDS_BLOCK},
+        /* 0xCD */ {3, 24, 24, LR35902_OP_ENDS_BLOCK},
+        /* 0xCE */ {2,  8,  8, 0},
+        /* 0xCF */ {1, 16, 16, LR35902_OP_ENDS_BLOCK},
+        /* 0xD0 */ {1,  8, 20, LR35902_OP_ENDS_BLOCK},
+        /* 0xD1 */ {1, 12, 12, 0},
+        /* 0xD2 */ {3, 12, 16, LR35902_OP_ENDS_BLOCK},
+        /* 0xD3 */ {1,  4,  4, LR35902_OP_ENDS_BLOCK},
+        /* 0xD4 */ {3, 12, 24, LR35902_OP_ENDS_BLOCK},
+        /* 0xD5 */ {1, 16, 16, 0},
+        /* 0xD6 */ {2,  8,  8, 0},
+        /* 0xD7 */ {1, 16, 16, LR35902_OP_ENDS_BLOCK},
+        /* 0xD8 */ {1,  8, 20, LR35902_OP_ENDS_BLOCK},
+        /* 0xD9 */ {1, 16, 16, LR35902_OP_ENDS_BLOCK},
+        /* 0xDA */ {3, 12, 16, LR35902_OP_ENDS_BLOCK},
+        /* 0xDB */ {1,  4,  4, LR35902_OP_ENDS_BLOCK},
+        /* 0xDC */ {3, 12, 24, LR35902_OP_ENDS_BLOCK},
+        /* 0xDD */ {1,  4,  4, LR35902_OP_ENDS_BLOCK},
+        /* 0xDE */ {2,  8,  8, 0},
+        /* 0xDF */ {1, 16, 16, LR35902_OP_ENDS_BLOCK},
+        /* 0xE0 */ {2, 12, 12, 0},
+        /* 0xE1 */ {1, 12, 12, 0},
+        /* 0xE2 */ {1,  8,  8, 0},
+        /* 0xE3 */ {1,  4,  4, LR35902_OP_ENDS_BLOCK},
+        /* 0xE4 */ {1,  4,  4, LR35902_OP_ENDS_BLOCK},
+        /* 0xE5 */ {1, 16, 16, 0},
+        /* 0xE6 */ {2,  8,  8, 0},
+        /* 0xE7 */ {1, 16, 16, LR35902_OP_ENDS_BLOCK},
+        /* 0xE8 */ {2, 16, 16, 0},
+        /* 0xE9 */ {1,  4,  4, LR35902_OP_ENDS_BLOCK},
+        /* 0xEA */ {3, 16, 16, 0},
+        /* 0xEB */ {1,  4,  4, LR35902_OP_ENDS_BLOCK},
+        /* 0xEC */ {1,  4,  4, LR35902_OP_ENDS_BLOCK},
+        /* 0xED */ {1,  4,  4, LR35902_OP_ENDS_BLOCK},
+        /* 0xEE */ {2,  8,  8, 0},
+        /* 0xEF */ {1, 16, 16, LR35902_OP_ENDS_BLOCK},
+        /* 0xF0 */ {2, 12, 12, 0},
+        /* 0xF1 */ {1, 12, 12, 0},
+        /* 0xF2 */ {1,  8,  8, 0},
+        /* 0xF3 */ {1,  4,  4, LR35902_OP_ENDS_BLOCK},
+        /* 0xF4 */ {1,  4,  4, LR35902_OP_ENDS_BLOCK},
+        /* 0xF5 */ {1, 16, 16, 0},
+        /* 0xF6 */ {2,  8,  8, 0},
+        /* 0xF7 */ {1, 16, 16, LR35902_OP_ENDS_BLOCK},
+        /* 0xF8 */ {2, 12, 12, 0},
+        /* 0xF9 */ {1,  8,  8, 0},
+        /* 0xFA */ {3, 16, 16, 0},
+        /* 0xFB */ {1,  4,  4, LR35902_OP_ENDS_BLOCK},
+        /* 0xFC */ {1,  4,  4, LR35902_OP_ENDS_BLOCK},
+        /* 0xFD */ {1,  4,  4, LR35902_OP_ENDS_BLOCK},
+        /* 0xFE */ {2,  8,  8, 0},
+        /* 0xFF */ {1, 16, 16, LR35902_OP_ENDS_BLOCK}
+};
+
+const LR35902_OP_INFO LR35902::CB_OP_INFO[256] = {
+        /* 0x00 */ {2,  8,  8, 0},
+        /* 0x01 */ {2,  8,  8, 0},
+        /* 0x02 */ {2,  8,  8, 0},
+        /* 0x03 */ {2,  8,  8, 0},
+        /* 0x04 */ {2,  8,  8, 0},
+        /* 0x05 */ {2,  8,  8, 0},
+        /* 0x06 */ {2, 16, 16, 0},
+        /* 0x07 */ {2,  8,  8, 0},
+        /* 0x08 */ {2,  8,  8, 0},
+        /* 0x09 */ {2,  8,  8, 0},
+        /* 0x0A */ {2,  8,  8, 0},
+        /* 0x0B */ {2,  8,  8, 0},
+        /* 0x0C */ {2,  8,  8, 0},
+        /* 0x0D */ {2,  8,  8, 0},
+        /* 0x0E */ {2, 16, 16, 0},
+        /* 0x0F */ {2,  8,  8, 0},
+        /* 0x10 */ {2,  8,  8, 0},
+        /* 0x11 */ {2,  8,  8, 0},
+        /* 0x12 */ {2,  8,  8, 0},
+        /* 0x13 */ {2,  8,  8, 0},
+        /* 0x14 */ {2,  8,  8, 0},
+        /* 0x15 */ {2,  8,  8, 0},
+        /* 0x16 */ {2, 16, 16, 0},
+        /* 0x17 */ {2,  8,  8, 0},
+        /* 0x18 */ {2,  8,  8, 0},
+        /* 0x19 */ {2,  8,  8, 0},
+        /* 0x1A */ {2,  8,  8, 0},
+        /* 0x1B */ {2,  8,  8, 0},
+        /* 0x1C */ {2,  8,  8, 0},
+        /* 0x1D */ {2,  8,  8, 0},
+        /* 0x1E */ {2, 16, 16, 0},
+        /* 0x1F */ {2,  8,  8, 0},
+        /* 0x20 */ {2,  8,  8, 0},
+        /* 0x21 */ {2,  8,  8, 0},
+        /* 0x22 */ {2,  8,  8, 0},
+        /* 0x23 */ {2,  8,  8, 0},
+        /* 0x24 */ {2,  8,  8, 0},
+        /* 0x25 */ {2,  8,  8, 0},
+        /* 0x26 */ {2, 16, 16, 0},
+        /* 0x27 */ {2,  8,  8, 0},
+        /* 0x28 */ {2,  8,  8, 0},
+        /* 0x29 */ {2,  8,  8, 0},
+        /* 0x2A */ {2,  8,  8, 0},
+        /* 0x2B */ {2,  8,  8, 0},
+        /* 0x2C */ {2,  8,  8, 0},
+        /* 0x2D */ {2,  8,  8, 0},
+        /* 0x2E */ {2, 16, 16, 0},
+        /* 0x2F */ {2,  8,  8, 0},
+        /* 0x30 */ {2,  8,  8, 0},
+        /* 0x31 */ {2,  8,  8, 0},
+        /* 0x32 */ {2,  8,  8, 0},
+        /* 0x33 */ {2,  8,  8, 0},
+        /* 0x34 */ {2,  8,  8, 0},
+        /* 0x35 */ {2,  8,  8, 0},
+        /* 0x36 */ {2, 16, 16, 0},
+        /* 0x37 */ {2,  8,  8, 0},
+        /* 0x38 */ {2,  8,  8, 0},
+        /* 0x39 */ {2,  8,  8, 0},
+        /* 0x3A */ {2,  8,  8, 0},
+        /* 0x3B */ {2,  8,  8, 0},
+        /* 0x3C */ {2,  8,  8, 0},
+        /* 0x3D */ {2,  8,  8, 0},
+        /* 0x3E */ {2, 16, 16, 0},
+        /* 0x3F */ {2,  8,  8, 0},
+        /* 0x40 */ {2,  8,  8, 0},
+        /* 0x41 */ {2,  8,  8, 0},
+        /* 0x42 */ {2,  8,  8, 0},
+        /* 0x43 */ {2,  8,  8, 0},
+        /* 0x44 */ {2,  8,  8, 0},
+        /* 0x45 */ {2,  8,  8, 0},
+        /* 0x46 */ {2, 12, 12, 0},
+        /* 0x47 */ {2,  8,  8, 0},
+        /* 0x48 */ {2,  8,  8, 0},
+        /* 0x49 */ {2,  8,  8, 0},
+        /* 0x4A */ {2,  8,  8, 0},
+        /* 0x4B */ {2,  8,  8, 0},
+        /* 0x4C */ {2,  8,  8, 0},
+        /* 0x4D */ {2,  8,  8, 0},
+        /* 0x4E */ {2, 12, 12, 0},
+        /* 0x4F */ {2,  8,  8, 0},
+        /* 0x50 */ {2,  8,  8, 0},
+        /* 0x51 */ {2,  8,  8, 0},
+        /* 0x52 */ {2,  8,  8, 0},
+        /* 0x53 */ {2,  8,  8, 0},
+        /* 0x54 */ {2,  8,  8, 0},
+        /* 0x55 */ {2,  8,  8, 0},
+        /* 0x56 */ {2, 12, 12, 0},
+        /* 0x57 */ {2,  8,  8, 0},
+        /* 0x58 */ {2,  8,  8, 0},
+        /* 0x59 */ {2,  8,  8, 0},
+        /* 0x5A */ {2,  8,  8, 0},
+        /* 0x5B */ {2,  8,  8, 0},
+        /* 0x5C */ {2,  8,  8, 0},
+        /* 0x5D */ {2,  8,  8, 0},
+        /* 0x5E */ {2, 12, 12, 0},
+        /* 0x5F */ {2,  8,  8, 0},
+        /* 0x60 */ {2,  8,  8, 0},
+        /* 0x61 */ {2,  8,  8, 0},
+        /* 0x62 */ {2,  8,  8, 0},
+        /* 0x63 */ {2,  8,  8, 0},
+        /* 0x64 */ {2,  8,  8, 0},
+        /* 0x65 */ {2,  8,  8, 0},
+        /* 0x66 */ {2, 12, 12, 0},
+        /* 0x67 */ {2,  8,  8, 0},
+        /* 0x68 */ {2,  8,  8, 0},
+        /* 0x69 */ {2,  8,  8, 0},
+        /* 0x6A */ {2,  8,  8, 0},
+        /* 0x6B */ {2,  8,  8, 0},
+        /* 0x6C */ {2,  8,  8, 0},
+        /* 0x6D */ {2,  8,  8, 0},
+        /* 0x6E */ {2, 12, 12, 0},
+        /* 0x6F */ {2,  8,  8, 0},
+        /* 0x70 */ {2,  8,  8, 0},
+        /* 0x71 */ {2,  8,  8, 0},
+        /* 0x72 */ {2,  8,  8, 0},
+        /* 0x73 */ {2,  8,  8, 0},
+        /* 0x74 */ {2,  8,  8, 0},
+        /* 0x75 */ {2,  8,  8, 0},
+        /* 0x76 */ {2, 12, 12, 0},
+        /* 0x77 */ {2,  8,  8, 0},
+        /* 0x78 */ {2,  8,  8, 0},
+        /* 0x79 */ {2,  8,  8, 0},
+        /* 0x7A */ {2,  8,  8, 0},
+        /* 0x7B */ {2,  8,  8, 0},
+        /* 0x7C */ {2,  8,  8, 0},
+        /* 0x7D */ {2,  8,  8, 0},
+        /* 0x7E */ {2, 12, 12, 0},
+        /* 0x7F */ {2,  8,  8, 0},
+        /* 0x80 */ {2,  8,  8, 0},
+        /* 0x81 */ {2,  8,  8, 0},
+        /* 0x82 */ {2,  8,  8, 0},
+        /* 0x83 */ {2,  8,  8, 0},
+        /* 0x84 */ {2,  8,  8, 0},
+        /* 0x85 */ {2,  8,  8, 0},
+        /* 0x86 */ {2, 16, 16, 0},
+        /* 0x87 */ {2,  8,  8, 0},
+        /* 0x88 */ {2,  8,  8, 0},
+        /* 0x89 */ {2,  8,  8, 0},
+        /* 0x8A */ {2,  8,  8, 0},
+        /* 0x8B */ {2,  8,  8, 0},
+        /* 0x8C */ {2,  8,  8, 0},
+        /* 0x8D */ {2,  8,  8, 0},
+        /* 0x8E */ {2, 16, 16, 0},
+        /* 0x8F */ {2,  8,  8, 0},
+        /* 0x90 */ {2,  8,  8, 0},
+        /* 0x91 */ {2,  8,  8, 0},
+        /* 0x92 */ {2,  8,  8, 0},
+        /* 0x93 */ {2,  8,  8, 0},
+        /* 0x94 */ {2,  8,  8, 0},
+        /* 0x95 */ {2,  8,  8, 0},
+        /* 0x96 */ {2, 16, 16, 0},
+        /* 0x97 */ {2,  8,  8, 0},
+        /* 0x98 */ {2,  8,  8, 0},
+        /* 0x99 */ {2,  8,  8, 0},
+        /* 0x9A */ {2,  8,  8, 0},
+        /* 0x9B */ {2,  8,  8, 0},
+        /* 0x9C */ {2,  8,  8, 0},
+        /* 0x9D */ {2,  8,  8, 0},
+        /* 0x9E */ {2, 16, 16, 0},
+        /* 0x9F */ {2,  8,  8, 0},
+        /* 0xA0 */ {2,  8,  8, 0},
+        /* 0xA1 */ {2,  8,  8, 0},
+        /* 0xA2 */ {2,  8,  8, 0},
+        /* 0xA3 */ {2,  8,  8, 0},
+        /* 0xA4 */ {2,  8,  8, 0},
+        /* 0xA5 */ {2,  8,  8, 0},
+        /* 0xA6 */ {2, 16, 16, 0},
+        /* 0xA7 */ {2,  8,  8, 0},
+        /* 0xA8 */ {2,  8,  8, 0},
+        /* 0xA9 */ {2,  8,  8, 0},
+        /* 0xAA */ {2,  8,  8, 0},
+        /* 0xAB */ {2,  8,  8, 0},
+        /* 0xAC */ {2,  8,  8, 0},
+        /* 0xAD */ {2,  8,  8, 0},
+        /* 0xAE */ {2, 16, 16, 0},
+        /* 0xAF */ {2,  8,  8, 0},
+        /* 0xB0 */ {2,  8,  8, 0},
+        /* 0xB1 */ {2,  8,  8, 0},
+        /* 0xB2 */ {2,  8,  8, 0},
+        /* 0xB3 */ {2,  8,  8, 0},
+        /* 0xB4 */ {2,  8,  8, 0},
+        /* 0xB5 */ {2,  8,  8, 0},
+        /* 0xB6 */ {2, 16, 16, 0},
+        /* 0xB7 */ {2,  8,  8, 0},
+        /* 0xB8 */ {2,  8,  8, 0},
+        /* 0xB9 */ {2,  8,  8, 0},
+        /* 0xBA */ {2,  8,  8, 0},
+        /* 0xBB */ {2,  8,  8, 0},
+        /* 0xBC */ {2,  8,  8, 0},
+        /* 0xBD */ {2,  8,  8, 0},
+        /* 0xBE */ {2, 16, 16, 0},
+        /* 0xBF */ {2,  8,  8, 0},
+        /* 0xC0 */ {2,  8,  8, 0},
+        /* 0xC1 */ {2,  8,  8, 0},
+        /* 0xC2 */ {2,  8,  8, 0},
+        /* 0xC3 */ {2,  8,  8, 0},
+        /* 0xC4 */ {2,  8,  8, 0},
+        /* 0xC5 */ {2,  8,  8, 0},
+        /* 0xC6 */ {2, 16, 16, 0},
+        /* 0xC7 */ {2,  8,  8, 0},
+        /* 0xC8 */ {2,  8,  8, 0},
+        /* 0xC9 */ {2,  8,  8, 0},
+        /* 0xCA */ {2,  8,  8, 0},
+        /* 0xCB */ {2,  8,  8, 0},
+        /* 0xCC */ {2,  8,  8, 0},
+        /* 0xCD */ {2,  8,  8, 0},
+        /* 0xCE */ {2, 16, 16, 0},
+        /* 0xCF */ {2,  8,  8, 0},
+        /* 0xD0 */ {2,  8,  8, 0},
+        /* 0xD1 */ {2,  8,  8, 0},
+        /* 0xD2 */ {2,  8,  8, 0},
+        /* 0xD3 */ {2,  8,  8, 0},
+        /* 0xD4 */ {2,  8,  8, 0},
+        /* 0xD5 */ {2,  8,  8, 0},
+        /* 0xD6 */ {2, 16, 16, 0},
+        /* 0xD7 */ {2,  8,  8, 0},
+        /* 0xD8 */ {2,  8,  8, 0},
+        /* 0xD9 */ {2,  8,  8, 0},
+        /* 0xDA */ {2,  8,  8, 0},
+        /* 0xDB */ {2,  8,  8, 0},
+        /* 0xDC */ {2,  8,  8, 0},
+        /* 0xDD */ {2,  8,  8, 0},
+        /* 0xDE */ {2, 16, 16, 0},
+        /* 0xDF */ {2,  8,  8, 0},
+        /* 0xE0 */ {2,  8,  8, 0},
+        /* 0xE1 */ {2,  8,  8, 0},
+        /* 0xE2 */ {2,  8,  8, 0},
+        /* 0xE3 */ {2,  8,  8, 0},
+        /* 0xE4 */ {2,  8,  8, 0},
+        /* 0xE5 */ {2,  8,  8, 0},
+        /* 0xE6 */ {2, 16, 16, 0},
+        /* 0xE7 */ {2,  8,  8, 0},
+        /* 0xE8 */ {2,  8,  8, 0},
+        /* 0xE9 */ {2,  8,  8, 0},
+        /* 0xEA */ {2,  8,  8, 0},
+        /* 0xEB */ {2,  8,  8, 0},
+        /* 0xEC */ {2,  8,  8, 0},
+        /* 0xED */ {2,  8,  8, 0},
+        /* 0xEE */ {2, 16, 16, 0},
+        /* 0xEF */ {2,  8,  8, 0},
+        /* 0xF0 */ {2,  8,  8, 0},
+        /* 0xF1 */ {2,  8,  8, 0},
+        /* 0xF2 */ {2,  8,  8, 0},
+        /* 0xF3 */ {2,  8,  8, 0},
+        /* 0xF4 */ {2,  8,  8, 0},
+        /* 0xF5 */ {2,  8,  8, 0},
+        /* 0xF6 */ {2, 16, 16, 0},
+        /* 0xF7 */ {2,  8,  8, 0},
+        /* 0xF8 */ {2,  8,  8, 0},
+        /* 0xF9 */ {2,  8,  8, 0},
+        /* 0xFA */ {2,  8,  8, 0},
+        /* 0xFB */ {2,  8,  8, 0},
+        /* 0xFC */ {2,  8,  8, 0},
+        /* 0xFD */ {2,  8,  8, 0},
+        /* 0xFE */ {2, 16, 16, 0},
+        /* 0xFF */ {2,  8,  8, 0}
+};
@@ -0,0 +1,702 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+/*
+x86-64 translation of decoded LR35902 blocks.
+
+A translated block keeps the 8 bit registers A, B, C, D, E, H and L in host registers for its whole run and
+returns the cycles of the block in one go.  Emitted natively are:
+    - register moves, immediate loads and 16 bit increments/decrements,
+    - the 8 bit ALU ops on registers and immediates, inc r, dec r, cpl, scf and ccf, with the host flags of the
+      same x86 op turned into F (x86 AF is the half carry of 8 bit adds and subtracts),
+    - loads and stores through (BC), (DE), (HL), (HL+), (HL-), (nn), (FF00+n) and (FF00+C), and the ALU ops on
+      (HL), which inline the bus fast path: the page table entry is loaded and a page off the fast path (I/O,
+      ROM writes, watched code) jumps to the interpreter call of the op instead,
+    - jr, jp nn, jp hl and the conditional jr and jp, which end a block and set the PC in its tail.
+Every other op spills the registers and calls its interpreter handler through jitFallback, so the handlers in
+opcodes.cpp stay the single definition of each op.
+
+F is kept in memory and is always current while translated code runs: execBlock materializes lazy flags before
+entering a block and jitFallback after each handler, so native ops read and write r.f directly.
+
+Host register use:
+    rbx         : The LR35902 being run.
+    r12 - r15   : A, B, C, D.
+    rbp         : E.
+    rsi, rdi    : H, L.
+    rax - rdx   : Scratch, the host page of a memory access in rdx.
+*/
+
+/* The code cache is mapped writable and never writable and executable at once, see jitCompile. */
+#ifdef WIN32
+    #define JIT_ALLOC(SIZE)     VirtualAlloc(NULL, (SIZE), MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE)
+    #define JIT_FREE(PTR, SIZE) VirtualFree((PTR), 0, MEM_RELEASE)
+#else
+    #define JIT_ALLOC(SIZE)     mmap(NULL, (SIZE), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)
+    #define JIT_FREE(PTR, SIZE) munmap((PTR), (SIZE))
+#endif
+
+/* Host page size, the granularity of protection changes. */
+#define JIT_PAGE_SIZE       4096
+
+/* The access hook has to see every data access, memory ops then always run through their handlers. */
+#define JIT_NATIVE_MEMORY   (LR35902_TIMING != LR35902_TIMING_ACCESS)
+
+/* Host registers. */
+#define HOST_RAX    0
+#define HOST_RCX    1
+#define HOST_RDX    2
+#define HOST_RBX    3
+#define HOST_RSP    4
+#define HOST_RBP    5
+#define HOST_RSI    6
+#define HOST_RDI    7
+#define HOST_R12    12
+#define HOST_R13    13
+#define HOST_R14    14
+#define HOST_R15    15
+#define HOST_NONE   0xFF
+
+/* Guest registers in op code order (B, C, D, E, H, L, (HL), A), and their host registers. */
+static const uint8 JIT_HOST_REG[8] = {
+    HOST_R13, HOST_R14, HOST_R15, HOST_RBP, HOST_RSI, HOST_RDI, HOST_NONE, HOST_R12
+};
+#define JIT_A       JIT_HOST_REG[7]
+#define JIT_C       JIT_HOST_REG[1]
+#define JIT_H       JIT_HOST_REG[4]
+#define JIT_L       JIT_HOST_REG[5]
+
+/* Host registers saved by a translated block. */
+static const uint8 JIT_SAVED_REGS[8] = {
+    HOST_RBX, HOST_RBP, HOST_RSI, HOST_RDI, HOST_R12, HOST_R13, HOST_R14, HOST_R15
+};
+
+/* How a translated block sets the PC in its tail. */
+#define JIT_EXIT_NEXT       0   // The address following the block, unless the last op stored it.
+#define JIT_EXIT_TARGET     1   // The target of jr or jp nn.
+#define JIT_EXIT_HL         2   // HL, jp hl.
+#define JIT_EXIT_COND       3   // The target of a conditional jr or jp when its flag test passes.
+
+/*********************************************************************************************************************\
+| Code Emission                                                                                                       |
+\*********************************************************************************************************************/
+
+/* Allocate / release an executable code cache. */
+static uint8 *jitAllocCode()
+{
+    void *code = JIT_ALLOC(LR35902_JIT_CODE_SIZE);
+#ifndef WIN32
+    if (MAP_FAILED == code) {
+        return NULL;
+    }
+#endif
+    return (uint8 *)code;
+}
+static void jitFreeCode(uint8 *code)
+{
+    if (NULL != code) {
+        JIT_FREE(code, LR35902_JIT_CODE_SIZE);
+    }
+}
+
+/* Make the code cache from a page offset to its end writable to translate into, or executable to run. */
+static bool jitProtect(uint8 *code, uint32 from, bool writable)
+{
+#ifdef WIN32
+    DWORD old;
+    return 0 != VirtualProtect(code + from, LR35902_JIT_CODE_SIZE - from,
+                               writable ? PAGE_READWRITE : PAGE_EXECUTE_READ, &old);
+#else
+    return 0 == mprotect(code + from, LR35902_JIT_CODE_SIZE - from,
+                         writable ? PROT_READ | PROT_WRITE : PROT_READ | PROT_EXEC);
+#endif
+}
+
+/* Emit a byte, word or dword. */
+#define EMIT8(P, VALUE)     (*(P)++ = (uint8)(VALUE))
+#define EMIT16(P, VALUE)    (EMIT8(P, VALUE), EMIT8(P, (VALUE) >> 8))
+#define EMIT32(P, VALUE)    (EMIT16(P, VALUE), EMIT16(P, (VALUE) >> 16))
+
+/* Emit a REX prefix, always present so the low bytes of rbp, rsi and rdi are addressable. */
+#define EMIT_REX(P, W, REG, RM) EMIT8(P, 0x40 | ((W) << 3) | (((REG) >> 3) << 2) | ((RM) >> 3))
+
+/* Emit a mod r/m byte. */
+#define EMIT_MODRM(P, MOD, REG, RM) EMIT8(P, ((MOD) << 6) | (((REG) & 0x07) << 3) | ((RM) & 0x07))
+
+/* Emit a [rbx + disp32] operand. */
+#define EMIT_MEM(P, REG, DISP) (EMIT_MODRM(P, 0x02, REG, HOST_RBX), EMIT32(P, (uint32)(DISP)))
+
+/* Point a rel32 operand at a target. */
+static void jitPatch(uint8 *site, const uint8 *target)
+{
+    uint32 rel = (uint32)(target - (site + 4));
+    site[0] = (uint8)rel; site[1] = (uint8)(rel >> 8); site[2] = (uint8)(rel >> 16); site[3] = (uint8)(rel >> 24);
+}
+
+/* Emit a 64 bit push / pop. */
+static void jitPush(uint8 *&p, uint8 reg)
+{
+    if (reg >= 8) { EMIT8(p, 0x41); }
+    EMIT8(p, 0x50 + (reg & 0x07));
+}
+static void jitPop(uint8 *&p, uint8 reg)
+{
+    if (reg >= 8) { EMIT8(p, 0x41); }
+    EMIT8(p, 0x58 + (reg & 0x07));
+}
+
+/* mov reg8, [rbx + disp] */
+static void jitLoad8(uint8 *&p, uint8 reg, uint32 disp)
+{
+    EMIT_REX(p, 0, reg, 0);
+    EMIT8(p, 0x8A);
+    EMIT_MEM(p, reg, disp);
+}
+
+/* mov [rbx + disp], reg8 */
+static void jitStore8(uint8 *&p, uint8 reg, uint32 disp)
+{
+    EMIT_REX(p, 0, reg, 0);
+    EMIT8(p, 0x88);
+    EMIT_MEM(p, reg, disp);
+}
+
+/* mov word [rbx + disp], imm16 */
+static void jitStoreImm16(uint8 *&p, uint32 disp, uint16 value)
+{
+    EMIT8(p, 0x66);
+    EMIT8(p, 0xC7);
+    EMIT_MEM(p, 0, disp);
+    EMIT16(p, value);
+}
+
+/* mov dst8, src8 */
+static void jitMove8(uint8 *&p, uint8 dst, uint8 src)
+{
+    EMIT_REX(p, 0, src, dst);
+    EMIT8(p, 0x88);
+    EMIT_MODRM(p, 0x03, src, dst);
+}
+
+/* mov dst8, imm8 */
+static void jitMoveImm8(uint8 *&p, uint8 dst, uint8 value)
+{
+    EMIT_REX(p, 0, 0, dst);
+    EMIT8(p, 0xB0 + (dst & 0x07));
+    EMIT8(p, value);
+}
+
+/* ALU ops in the order of the x86 0x00-0x38 op codes and the /digit of the 0x80 group. */
+#define JIT_ADD 0
+#define JIT_OR  1
+#define JIT_ADC 2
+#define JIT_SBB 3
+#define JIT_AND 4
+#define JIT_SUB 5
+#define JIT_XOR 6
+#define JIT_CMP 7
+
+/* The x86 op of each LR35902 ALU op (add, adc, sub, sbc, and, xor, or, cp). */
+static const uint8 JIT_ALU_OP[8] = { JIT_ADD, JIT_ADC, JIT_SUB, JIT_SBB, JIT_AND, JIT_XOR, JIT_OR, JIT_CMP };
+
+/* op dst8, imm8 */
+static void jitArith8(uint8 *&p, uint8 op, uint8 dst, uint8 value)
+{
+    EMIT_REX(p, 0, 0, dst);
+    EMIT8(p, 0x80);
+    EMIT_MODRM(p, 0x03, op, dst);
+    EMIT8(p, value);
+}
+
+/* op dst8, src8 */
+static void jitArithReg8(uint8 *&p, uint8 op, uint8 dst, uint8 src)
+{
+    EMIT_REX(p, 0, src, dst);
+    EMIT8(p, op << 3);
+    EMIT_MODRM(p, 0x03, src, dst);
+}
+
+/* op byte [rbx + disp], imm8 */
+static void jitArithMem8(uint8 *&p, uint8 op, uint32 disp, uint8 value)
+{
+    EMIT8(p, 0x80);
+    EMIT_MEM(p, op, disp);
+    EMIT8(p, value);
+}
+
+/* inc/dec word [rbx + disp] */
+static void jitIncDec16(uint8 *&p, bool inc, uint32 disp)
+{
+    EMIT8(p, 0x66);
+    EMIT8(p, 0xFF);
+    EMIT_MEM(p, inc ? 0 : 1, disp);
+}
+
+/* Set the host carry flag to the carry flag in F, for adc and sbb. */
+static void jitCarryIn(uint8 *&p, uint32 offsetF)
+{
+    jitLoad8(p, HOST_RAX, offsetF);
+    EMIT8(p, 0xC0); EMIT8(p, 0xE8); EMIT8(p, 0x05);                         /* shr al, 5 */
+}
+
+/* Store [Z N H C] from the host flags of an 8 bit add or subtract, N set for a subtract. */
+static void jitFlagsArith(uint8 *&p, uint32 offsetF, bool subtract)
+{
+    EMIT8(p, 0x9F);                                                         /* lahf */
+    EMIT8(p, 0x0F); EMIT8(p, 0xB6); EMIT8(p, 0xC4);                         /* movzx eax, ah */
+    EMIT8(p, 0x89); EMIT8(p, 0xC1);                                         /* mov ecx, eax */
+    EMIT8(p, 0x83); EMIT8(p, 0xE0); EMIT8(p, 0x50);                         /* and eax, ZF | AF */
+    EMIT8(p, 0x01); EMIT8(p, 0xC0);                                         /* add eax, eax */
+    EMIT8(p, 0x83); EMIT8(p, 0xE1); EMIT8(p, 0x01);                         /* and ecx, CF */
+    EMIT8(p, 0xC1); EMIT8(p, 0xE1); EMIT8(p, 0x04);                         /* shl ecx, 4 */
+    EMIT8(p, 0x09); EMIT8(p, 0xC8);                                         /* or eax, ecx */
+    if (subtract) {
+        EMIT8(p, 0x83); EMIT8(p, 0xC8); EMIT8(p, LR35902_FLAG_SUBTRACT);    /* or eax, N */
+    }
+    jitStore8(p, HOST_RAX, offsetF);
+}
+
+/* Store [Z N H c] from the host flags of an 8 bit inc or dec, keeping the carry flag in F. */
+static void jitFlagsIncDec(uint8 *&p, uint32 offsetF, bool subtract)
+{
+    EMIT8(p, 0x9F);                                                         /* lahf */
+    EMIT8(p, 0x0F); EMIT8(p, 0xB6); EMIT8(p, 0xC4);                         /* movzx eax, ah */
+    EMIT8(p, 0x83); EMIT8(p, 0xE0); EMIT8(p, 0x50);                         /* and eax, ZF | AF */
+    EMIT8(p, 0x01); EMIT8(p, 0xC0);                                         /* add eax, eax */
+    if (subtract) {
+        EMIT8(p, 0x83); EMIT8(p, 0xC8); EMIT8(p, LR35902_FLAG_SUBTRACT);    /* or eax, N */
+    }
+    jitLoad8(p, HOST_RCX, offsetF);
+    EMIT8(p, 0x80); EMIT8(p, 0xE1); EMIT8(p, LR35902_FLAG_CARRY);           /* and cl, C */
+    EMIT8(p, 0x08); EMIT8(p, 0xC8);                                         /* or al, cl */
+    jitStore8(p, HOST_RAX, offsetF);
+}
+
+/* Store [Z 0 H 0] from the zero flag of an 8 bit logic op, H is set for and. */
+static void jitFlagsLogic(uint8 *&p, uint32 offsetF, uint8 half)
+{
+    EMIT8(p, 0x0F); EMIT8(p, 0x94); EMIT8(p, 0xC0);                         /* setz al */
+    EMIT8(p, 0xC0); EMIT8(p, 0xE0); EMIT8(p, 0x07);                         /* shl al, 7 */
+    if (0 != half) {
+        EMIT8(p, 0x0C); EMIT8(p, half);                                     /* or al, H */
+    }
+    jitStore8(p, HOST_RAX, offsetF);
+}
+
+/* ALU op number ALU of the LR35902 (add, adc, sub, sbc, and, xor, or, cp) on A and a host register or, with
+   HOST_NONE, an immediate. */
+static void jitAlu(uint8 *&p, uint8 alu, uint8 src, uint8 value, uint32 offsetF)
+{
+    uint8 op = JIT_ALU_OP[alu];
+    if (JIT_ADC == op || JIT_SBB == op) {
+        jitCarryIn(p, offsetF);
+    }
+    if (HOST_NONE == src) {
+        jitArith8(p, op, JIT_A, value);
+    } else {
+        jitArithReg8(p, op, JIT_A, src);
+    }
+    if (JIT_AND == op || JIT_XOR == op || JIT_OR == op) {
+        jitFlagsLogic(p, offsetF, (JIT_AND == op) ? LR35902_FLAG_HALF_CARRY : 0x00);
+    } else {
+        jitFlagsArith(p, offsetF, JIT_ADD != op && JIT_ADC != op);
+    }
+}
+
+/* Load the fast path pointer of a page into rdx from a bus table, the page in a host register or, with
+   HOST_NONE, a constant.  Returns the rel32 of the jump taken when the page is off the fast path. */
+static uint8 *jitHostPage(uint8 *&p, uint32 table, uint8 reg, uint8 page)
+{
+    if (HOST_NONE == reg) {
+        EMIT8(p, 0x48); EMIT8(p, 0x8B);                                     /* mov rdx, [rbx + table + page * 8] */
+        EMIT_MEM(p, HOST_RDX, table + page * sizeof(uint8 *));
+    } else {
+        EMIT_REX(p, 0, HOST_RCX, reg);                                      /* movzx ecx, reg8 */
+        EMIT8(p, 0x0F); EMIT8(p, 0xB6);
+        EMIT_MODRM(p, 0x03, HOST_RCX, reg);
+        EMIT8(p, 0x48); EMIT8(p, 0x8B); EMIT8(p, 0x94); EMIT8(p, 0xCB);     /* mov rdx, [rbx + rcx * 8 + table] */
+        EMIT32(p, table);
+    }
+    EMIT8(p, 0x48); EMIT8(p, 0x85); EMIT8(p, 0xD2);                         /* test rdx, rdx */
+    EMIT8(p, 0x0F); EMIT8(p, 0x84);                                         /* jz off the fast path */
+    uint8 *site = p;
+    EMIT32(p, 0);
+    return site;
+}
+
+/* Load or store a host register at an offset into the page in rdx, the offset in a host register or, with
+   HOST_NONE, a constant. */
+static void jitHostAccess(uint8 *&p, bool load, uint8 data, uint8 reg, uint8 offset)
+{
+    if (HOST_NONE == reg) {
+        EMIT_REX(p, 0, data, 0);                                            /* mov [rdx + offset], data8 */
+        EMIT8(p, load ? 0x8A : 0x88);
+        EMIT_MODRM(p, 0x02, data, HOST_RDX);
+        EMIT32(p, offset);
+    } else {
+        EMIT_REX(p, 0, HOST_RCX, reg);                                      /* movzx ecx, reg8 */
+        EMIT8(p, 0x0F); EMIT8(p, 0xB6);
+        EMIT_MODRM(p, 0x03, HOST_RCX, reg);
+        EMIT_REX(p, 0, data, 0);                                            /* mov [rdx + rcx], data8 */
+        EMIT8(p, load ? 0x8A : 0x88);
+        EMIT_MODRM(p, 0x00, data, HOST_RSP);
+        EMIT8(p, 0x0A);
+    }
+}
+
+/* Restore the saved registers and return the cycles already in eax. */
+static void jitReturn(uint8 *&p)
+{
+    EMIT8(p, 0x48); EMIT8(p, 0x83); EMIT8(p, 0xC4); EMIT8(p, 0x28);         /* add rsp, 40 */
+    for (int i = 7; i >= 0; --i) {
+        jitPop(p, JIT_SAVED_REGS[i]);
+    }
+    EMIT8(p, 0xC3);                                                         /* ret */
+}
+
+/* Restore the saved registers and return cycles in eax. */
+static void jitEpilogue(uint8 *&p, uint32 cycles)
+{
+    EMIT8(p, 0xB8);                                                         /* mov eax, cycles */
+    EMIT32(p, cycles);
+    jitReturn(p);
+}
+
+/* Write the host registers back to the guest registers / load them from the guest registers. */
+static void jitStoreRegs(uint8 *&p, const uint32 *offset)
+{
+    for (uint32 i = 0; i < 8; ++i) {
+        if (6 != i) { jitStore8(p, JIT_HOST_REG[i], offset[i]); }
+    }
+}
+static void jitLoadRegs(uint8 *&p, const uint32 *offset)
+{
+    for (uint32 i = 0; i < 8; ++i) {
+        if (6 != i) { jitLoad8(p, JIT_HOST_REG[i], offset[i]); }
+    }
+}
+
+/*********************************************************************************************************************\
+| Translation                                                                                                         |
+\*********************************************************************************************************************/
+
+/* Switch between translated and interpreted execution of blocks. */
+void LR35902::setJit(bool enable)
+{
+    if (enable && NULL == this->jit->code) {
+        this->jit->code = jitAllocCode();
+        this->jit->used = 0;
+    }
+    this->jit->enabled = enable && NULL != this->jit->code;
+}
+
+/* Drop every translation and empty the code cache. */
+void LR35902::jitFlush()
+{
+    for (uint32 i = 0; i < LR35902_BLOCK_CACHE_SIZE; ++i) {
+        this->blockCache->blocks[i].native = NULL;
+    }
+    this->jit->used = 0;
+    ++this->jit->flushes;
+}
+
+/* Run a single op through its interpreter handler on behalf of a translated block. */
+uint32 LR35902::jitFallback(LR35902 *cpu, const LR35902_UOP *uop)
+{
+    uint32 codeWrites = cpu->codeWrites;
+    cpu->imm = uop->imm;
+    (cpu->*uop->fn)();
+#if LR35902_FLAGS == LR35902_FLAGS_LAZY
+    /* Native ops read and write r.f directly. */
+    cpu->flags();
+#endif
+    return cpu->codeWrites != codeWrites;
+}
+
+/*
+ * Translate a decoded block into x86-64 code.  Translations are only ever appended, so just the pages from the
+ * end of the cache are made writable for the translation and executable again after it, the pages before stay
+ * executable.  If the host refuses either change the translator is turned off and blocks run interpreted.
+ */
+void LR35902::jitCompile(LR35902_BLOCK &block)
+{
+    uint32 from = this->jit->used & ~(uint32)(JIT_PAGE_SIZE - 1);
+    uint8 *native = NULL;
+    if (jitProtect(this->jit->code, from, true)) {
+        native = this->jitTranslate(block);
+        if (NULL == native) {
+            /* The cache filled up part way through, an empty cache holds any block. */
+            this->jitFlush();
+            from = 0;
+            if (jitProtect(this->jit->code, from, true)) {
+                native = this->jitTranslate(block);
+            }
+        }
+    }
+    if (!jitProtect(this->jit->code, from, false)) {
+        native = NULL;
+    }
+    block.native = native;
+    this->jit->enabled = NULL != native;
+}
+
+/* Translate a decoded block at the end of the code cache. */
+uint8 *LR35902::jitTranslate(const LR35902_BLOCK &block)
+{
+    uint8 *base = (uint8 *)this;
+    uint32 offset[8];
+    for (uint32 i = 0; i < 8; ++i) {
+        offset[i] = 0;
+    }
+    offset[0] = (uint32)(&this->r.b - base);
+    offset[1] = (uint32)(&this->r.c - base);
+    offset[2] = (uint32)(&this->r.d - base);
+    offset[3] = (uint32)(&this->r.e - base);
+    offset[4] = (uint32)(&this->r.h - base);
+    offset[5] = (uint32)(&this->r.l - base);
+    offset[7] = (uint32)(&this->r.a - base);
+    uint32 offsetF = (uint32)(&this->r.f - base);
+    uint32 offsetSP = (uint32)((uint8 *)&this->rr.sp - base);
+    uint32 offsetPC = (uint32)((uint8 *)&this->rr.pc - base);
+    uint32 readTable = (uint32)((const uint8 *)this->bus.readTable() - base);
+    uint32 writeTable = (uint32)((const uint8 *)this->bus.writeTable() - base);
+
+    uint8 *start = this->jit->code + this->jit->used;
+    uint8 *limit = this->jit->code + LR35902_JIT_CODE_SIZE - LR35902_JIT_TAIL_SIZE - LR35902_JIT_MAX_OP_SIZE;
+    uint8 *p = start;
+    if (p > limit) {
+        return NULL;
+    }
+
+    /* Prologue: save registers, keep 16 byte alignment and the Win64 shadow space, load the guest registers. */
+    for (uint32 i = 0; i < 8; ++i) {
+        jitPush(p, JIT_SAVED_REGS[i]);
+    }
+    EMIT8(p, 0x48); EMIT8(p, 0x83); EMIT8(p, 0xEC); EMIT8(p, 0x28);         /* sub rsp, 40 */
+#ifdef _WIN64
+    EMIT8(p, 0x48); EMIT8(p, 0x89); EMIT8(p, 0xCB);                         /* mov rbx, rcx */
+#else
+    EMIT8(p, 0x48); EMIT8(p, 0x89); EMIT8(p, 0xFB);                         /* mov rbx, rdi */
+#endif
+    jitLoadRegs(p, offset);
+
+    uint16 pc = (uint16)block.key;
+    uint32 cycles = 0;
+    bool pcStored = false;
+    uint8 tail = JIT_EXIT_NEXT;
+    uint16 target = 0x0000;
+    uint8 test = 0x00;
+    bool testSet = false;
+    uint32 taken = 0;
+    for (uint32 n = 0; n < block.count; ++n) {
+        if (p > limit) {
+            return NULL;
+        }
+        const LR35902_UOP &uop = block.uops[n];
+        uint8 op = this->peek8(pc);
+        uint8 dst = (op >> 3) & 0x07;
+        uint8 src = op & 0x07;
+        pc += uop.length;
+        cycles += uop.cycles;
+        pcStored = false;
+
+        /* Memory ops on the fast path leave slow set to the jump to their interpreter call. */
+        bool native = true;
+        uint8 *slow = NULL;
+        if (LR35902_FUSE_NONE != uop.fusion) {
+            /* Fused loops only run through their handler. */
+            native = false;
+        } else if (0x00 == op) {
+            /* nop */
+        } else if (op >= 0x40 && op < 0x80 && 6 != dst && 6 != src) {
+            /* ld r, r */
+            if (dst != src) { jitMove8(p, JIT_HOST_REG[dst], JIT_HOST_REG[src]); }
+        } else if (op >= 0x80 && op < 0xC0 && 6 != src) {
+            /* alu a, r */
+            jitAlu(p, dst, JIT_HOST_REG[src], 0x00, offsetF);
+        } else if (op >= 0xC0 && 0x06 == src) {
+            /* alu a, n */
+            jitAlu(p, dst, HOST_NONE, (uint8)uop.imm, offsetF);
+        } else if (op < 0x40 && (0x04 == src || 0x05 == src) && 6 != dst) {
+            /* inc r / dec r */
+            EMIT_REX(p, 0, 0, JIT_HOST_REG[dst]);
+            EMIT8(p, 0xFE);
+            EMIT_MODRM(p, 0x03, src - 0x04, JIT_HOST_REG[dst]);
+            jitFlagsIncDec(p, offsetF, 0x05 == src);
+        } else if (op < 0x40 && 0x06 == src && 6 != dst) {
+            /* ld r, n */
+            jitMoveImm8(p, JIT_HOST_REG[dst], (uint8)uop.imm);
+        } else if (op < 0x30 && 0x01 == (op & 0x0F)) {
+            /* ld rr, nn */
+            jitMoveImm8(p, JIT_HOST_REG[dst], (uint8)(uop.imm >> 8));
+            jitMoveImm8(p, JIT_HOST_REG[dst + 1], (uint8)uop.imm);
+        } else if (op < 0x30 && (0x03 == (op & 0x0F) || 0x0B == (op & 0x0F))) {
+            /* inc rr / dec rr, carried from the low into the high register without touching F. */
+            bool inc = 0x03 == (op & 0x0F);
+            uint8 high = JIT_HOST_REG[(op >> 3) & 0x06];
+            uint8 low = JIT_HOST_REG[((op >> 3) & 0x06) + 1];
+            jitArith8(p, inc ? JIT_ADD : JIT_SUB, low, 1);
+            jitArith8(p, inc ? JIT_ADC : JIT_SBB, high, 0);
+        } else if (0x31 == op) {
+            /* ld sp, nn */
+            jitStoreImm16(p, offsetSP, uop.imm);
+        } else if (0x33 == op || 0x3B == op) {
+            /* inc sp / dec sp */
+            jitIncDec16(p, 0x33 == op, offsetSP);
+        } else if (0x2F == op) {
+            /* cpl */
+            jitArith8(p, JIT_XOR, JIT_A, 0xFF);
+            jitArithMem8(p, JIT_OR, offsetF, LR35902_FLAG_SUBTRACT | LR35902_FLAG_HALF_CARRY);
+        } else if (0x37 == op) {
+            /* scf */
+            jitArithMem8(p, JIT_AND, offsetF, LR35902_FLAG_ZERO);
+            jitArithMem8(p, JIT_OR, offsetF, LR35902_FLAG_CARRY);
+        } else if (0x3F == op) {
+            /* ccf */
+            jitArithMem8(p, JIT_AND, offsetF, LR35902_FLAG_ZERO | LR35902_FLAG_CARRY);
+            jitArithMem8(p, JIT_XOR, offsetF, LR35902_FLAG_CARRY);
+        } else if (0x18 == op || 0xC3 == op) {
+            /* jr n / jp nn */
+            tail = JIT_EXIT_TARGET;
+            target = (0x18 == op) ? (uint16)(pc + (int8)uop.imm) : uop.imm;
+        } else if (0xE9 == op) {
+            /* jp hl */
+            tail = JIT_EXIT_HL;
+        } else if (0x20 == (op & 0xE7) || 0xC2 == (op & 0xE7)) {
+            /* jr cc, n / jp cc, nn */
+            tail = JIT_EXIT_COND;
+            target = (0x20 == (op & 0xE7)) ? (uint16)(pc + (int8)uop.imm) : uop.imm;
+            test = (dst & 0x02) ? LR35902_FLAG_CARRY : LR35902_FLAG_ZERO;
+            testSet = 0 != (dst & 0x01);
+#if LR35902_TIMING != LR35902_TIMING_NONE
+            taken = OP_INFO[op].taken - OP_INFO[op].cycles;
+#endif
+        } else if (JIT_NATIVE_MEMORY && op >= 0x40 && op < 0x80 && 0x76 != op) {
+            /* ld r, (hl) / ld (hl), r */
+            bool load = 6 == src;
+            slow = jitHostPage(p, load ? readTable : writeTable, JIT_H, 0);
+            jitHostAccess(p, load, JIT_HOST_REG[load ? dst : src], JIT_L, 0);
+        } else if (JIT_NATIVE_MEMORY && op >= 0x80 && op < 0xC0) {
+            /* alu a, (hl) */
+            slow = jitHostPage(p, readTable, JIT_H, 0);
+            jitHostAccess(p, true, HOST_RDX, JIT_L, 0);
+            jitAlu(p, dst, HOST_RDX, 0x00, offsetF);
+        } else if (JIT_NATIVE_MEMORY && 0x36 == op) {
+            /* ld (hl), n */
+            slow = jitHostPage(p, writeTable, JIT_H, 0);
+            jitMoveImm8(p, HOST_RAX, (uint8)uop.imm);
+            jitHostAccess(p, false, HOST_RAX, JIT_L, 0);
+        } else if (JIT_NATIVE_MEMORY && op < 0x40 && 0x02 == src) {
+            /* ld (bc), a / ld (de), a / ld (hl+), a / ld (hl-), a and the loads of A from them */
+            bool load = 0 != (op & 0x08);
+            uint8 pair = (op < 0x20) ? (uint8)((op >> 3) & 0x02) : 4;
+            slow = jitHostPage(p, load ? readTable : writeTable, JIT_HOST_REG[pair], 0);
+            jitHostAccess(p, load, JIT_A, JIT_HOST_REG[pair + 1], 0);
+            if (op >= 0x20) {
+                bool inc = op < 0x30;
+                jitArith8(p, inc ? JIT_ADD : JIT_SUB, JIT_L, 1);
+                jitArith8(p, inc ? JIT_ADC : JIT_SBB, JIT_H, 0);
+            }
+        } else if (JIT_NATIVE_MEMORY && (0xEA == op || 0xFA == op)) {
+            /* ld (nn), a / ld a, (nn) */
+            bool load = 0xFA == op;
+            slow = jitHostPage(p, load ? readTable : writeTable, HOST_NONE, (uint8)(uop.imm >> 8));
+            jitHostAccess(p, load, JIT_A, HOST_NONE, (uint8)uop.imm);
+        } else if (JIT_NATIVE_MEMORY && (0xE0 == op || 0xF0 == op || 0xE2 == op || 0xF2 == op)) {
+            /* ldh (n), a / ldh a, (n) / ld (c), a / ld a, (c) */
+            bool load = op >= 0xF0;
+            slow = jitHostPage(p, load ? readTable : writeTable, HOST_NONE, 0xFF);
+            jitHostAccess(p, load, JIT_A, (0x02 == src) ? JIT_C : HOST_NONE, (uint8)uop.imm);
+        } else {
+            native = false;
+        }
+
+        /* The fast path of a memory op jumps over the interpreter call taken off the fast path. */
+        uint8 *done = NULL;
+        if (NULL != slow) {
+            EMIT8(p, 0xE9);                                                 /* jmp done */
+            done = p;
+            EMIT32(p, 0);
+            jitPatch(slow, p);
+            native = false;
+        }
+
+        if (!native) {
+            /* Interpreter handler: spill, run, reload, and leave the block if it dropped decoded code. */
+            jitStoreRegs(p, offset);
+            jitStoreImm16(p, offsetPC, pc);
+#ifdef _WIN64
+            EMIT8(p, 0x48); EMIT8(p, 0x89); EMIT8(p, 0xD9);                 /* mov rcx, rbx */
+            EMIT8(p, 0x48); EMIT8(p, 0xBA);                                 /* mov rdx, uop */
+#else
+            EMIT8(p, 0x48); EMIT8(p, 0x89); EMIT8(p, 0xDF);                 /* mov rdi, rbx */
+            EMIT8(p, 0x48); EMIT8(p, 0xBE);                                 /* mov rsi, uop */
+#endif
+            size_t address = (size_t)&uop;
+            EMIT32(p, (uint32)address); EMIT32(p, (uint32)(address >> 32));
+            address = (size_t)&LR35902::jitFallback;
+            EMIT8(p, 0x48); EMIT8(p, 0xB8);                                 /* mov rax, jitFallback */
+            EMIT32(p, (uint32)address); EMIT32(p, (uint32)(address >> 32));
+            EMIT8(p, 0xFF); EMIT8(p, 0xD0);                                 /* call rax */
+            jitLoadRegs(p, offset);
+            pcStored = NULL == done;
+
+            if (n + 1 < block.count) {
+                EMIT8(p, 0x85); EMIT8(p, 0xC0);                             /* test eax, eax */
+                EMIT8(p, 0x0F); EMIT8(p, 0x84);                             /* jz over the exit */
+                uint8 *skip = p;
+                EMIT32(p, 0);
+                jitEpilogue(p, cycles);
+                jitPatch(skip, p);
+            }
+        }
+        if (NULL != done) {
+            jitPatch(done, p);
+        }
+    }
+
+    /* Write back the registers, set the PC (unless the last op stored it) and return the block cycles. */
+    jitStoreRegs(p, offset);
+    if (JIT_EXIT_TARGET == tail) {
+        jitStoreImm16(p, offsetPC, target);
+    } else if (JIT_EXIT_HL == tail) {
+        jitStore8(p, JIT_L, offsetPC);
+        jitStore8(p, JIT_H, offsetPC + 1);
+    } else if (!pcStored) {
+        jitStoreImm16(p, offsetPC, pc);
+    }
+    if (JIT_EXIT_COND == tail) {
+        EMIT8(p, 0xB8);                                                     /* mov eax, cycles */
+        EMIT32(p, cycles);
+        EMIT8(p, 0xF6);                                                     /* test byte [F], flag */
+        EMIT_MEM(p, 0, offsetF);
+        EMIT8(p, test);
+        EMIT8(p, testSet ? 0x74 : 0x75);                                    /* jz / jnz over the branch */
+        EMIT8(p, 9 + 5);
+        jitStoreImm16(p, offsetPC, target);
+        EMIT8(p, 0xB8);                                                     /* mov eax, cycles + taken */
+        EMIT32(p, cycles + taken);
+        jitReturn(p);
+    } else {
+        jitEpilogue(p, cycles);
+    }
+
+    this->jit->used += (uint32)(p - start);
+    return start;
+}
+
+#undef EMIT8
+#undef EMIT16
+#undef EMIT32
+#undef EMIT_REX
+#undef EMIT_MODRM
+#undef EMIT_MEM
+#undef JIT_ALLOC
+#undef JIT_FREE
+#undef JIT_PAGE_SIZE
+#undef JIT_NATIVE_MEMORY
+#undef JIT_A
+#undef JIT_C
+#undef JIT_H
+#undef JIT_L
@@ -0,0 +1,38 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#ifndef SINES_LR35902_JIT_H         /* START: HEADER GUARD */
+#define SINES_LR35902_JIT_H
+
+#include "xplat/types.hpp"
+
+namespace SiNES { namespace Processors { namespace Nintendo {
+    class LR35902;
+
+    /* Translated block, returns the number of clock cycles taken by the ops it ran. */
+    typedef uint32 (*LR35902_JIT_FN)(LR35902 *cpu);
+
+    /* Size of the executable code cache of each processor, flushed as a whole when full. */
+    #define LR35902_JIT_CODE_SIZE       (1024 * 1024)
+
+    /* Largest translation of a single op, sbc a,(HL): the fast path (page 21, access 8, carry 10,
+       op 3, flags 29, jump 5) and the interpreter call it falls back to (spill 49, PC 9, call 25, reload 49,
+       exit test 8, epilogue 22).  Largest tail of a block, a conditional branch: write back 49, PC 9, flag test
+       14, taken PC and cycles 14, return 17.  The prologue (68) fits the space of an op.  Space for the next op
+       and the tail is checked before each op is translated, and a translation that runs out is started over in
+       a flushed cache. */
+    #define LR35902_JIT_MAX_OP_SIZE     238
+    #define LR35902_JIT_TAIL_SIZE       103
+
+    /* State of the x86-64 translator. */
+    typedef struct _LR35902_JIT_STATE {
+        bool    enabled;    // Run translated blocks from execBlock.
+        uint8  *code;       // Executable code cache.
+        uint32  used;       // Bytes of the code cache in use.
+        uint32  flushes;    // Number of times the code cache filled up.
+    } LR35902_JIT_STATE;
+
+} /* END: Nintendo */ } /* END: Processors */ } /* END: SiNES */
+
+#endif                              /* END: HEADER GUARD */
@@ -1,814 +1,967 @@
-/*
- * Copyright 2013 Jason M. Baker
- */
-
-#include "xplat/types.hpp"
-#include "Processors/Nintendo/LR35902/LR35902.hpp"
-
-/*
-FORMAT for processor operation functions.
-<mnemonic> [#1 |     #2] [Z H N C]
-Where #1 is the length in bytes read from the stack.
-Where #2 is the duration in cycles.
-Z,H,N,C are flags that were affected by the operation.
-If the flag is marked by a "0" it is reset after instruction run.
-If the flag is marked by a "1" it is set after instruction run.
-If the flag is marked by a "-" it is unchanged.
-If the flag is marked by the corresponding symbol it is affected by the function as normal.
-Z - Zero Flag       : Set when a math operation is zero or two values match with CP.
-H - Subtract Flag   : Set if the last operation used subtraction.
-N - Half Carry Flag : If the lower nibble carried in the math operation.
-C - Carry Flag      : Set if a carry occurred from the last math operation or register A is smaller in with CP.
-*/
-
-/* Calculate flags */
-//#define CALC_Z_N_H(Z, N, H)         (((Z ? 0x04 : 0x00) | (N ? 0x02 : 0x00) | (H ? 0x01 : 0x00)) << (7-3+1))
-#define CALC_Z_N_H_C(Z, N, H, C)    ((Z ? LR35902_FLAG_ZERO : 0x00) | (N ? LR35902_FLAG_SUBTRACT : 0x00) | (H ? LR35902_FLAG_HALF_CARRY : 0x00) | (C ? LR35902_FLAG_CARRY : 0x00))
-
-/* Optimizations for rotations. */
-#define ROTATE_LEFT(VALUE) (((VALUE) << 1) | (VALUE) >> (sizeof(VALUE) - 1))
-#define ROTATE_RIGHT(VALUE) ((((VALUE) >> 1) | (VALUE) << (sizeof(VALUE) - 1)))
-
-#define PRE_OP_FUNC static void
-
-/**
- * Convert 2 8 bit registers into a 16 bit register.
- */
-#define GET_REG16(REG1, REG2) (((REG1) << 8) | (REG2))
-
-/*********************************************************************************************************************\
-| Misceleanous Commands                                                                                               |
-\*********************************************************************************************************************/
-
-/* nop          [1  |     4] [- - - -] */
-void LR35902::nop()
-{
-    /* @TODO Affect clock cycle. */
-}
-
-/* stop         [2  |     4] [- - - -] */
-void LR35902::stop()
-{
-    /* @TODO Affect clock cycle. */
-}
-
-/* halt         [1  |     4] [- - - -] */
-void LR35902::halt()
-{
-    /* @TODO */
-}
-
-/* di           [1  |     4] [- - - -] */
-void LR35902::di()
-{
-    /* @TODO */
-}
-
-/* ei           [1  |     4] [- - - -] */
-void LR35902::ei()
-{
-    /* @TODO */
-}
-
-/*********************************************************************************************************************\
-| Jump, Return, Call, Reset Commands                                                                                  |
-\*********************************************************************************************************************/
-
-/* jr_n         [1  |     4] [- - - -] */
-void LR35902::jr_n()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO Read from memory */
-    /* @TODO Update PC */
-}
-
-/* jr_cc_n      [1  |  12/8] [- - - -] */
-void LR35902::jr_cc_n(bool negate, uint8 flags)
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO Read from memory */
-    /* @TODO Update stack/PC */
-}
-
-/* jp_nn        [1  |    16] [- - - -] */
-void LR35902::jp_nn()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO Read from memory */
-    /* @TODO Perform Jump */
-}
-
-/* jp_hl        [1  |    16] [- - - -] */
-void LR35902::jp_hl()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO Read from memory */
-    /* @TODO Perform Jump */
-}
-
-/* jp_cc_nn     [1  | 16/12] [- - - -] */
-void LR35902::jp_cc_nn(bool set, uint8 flags)
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO Check condition. */
-    /* @TODO Read from memory */
-    /* @TODO Perform Jump */
-}
-
-/* call_cc_nn   [1  |    24] [- - - -] */
-void LR35902::call_nn()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO push address of next instruction onto stack */
-    /* @TODO Read from memory */
-    /* @TODO Perform Jump */
-}
-
-/* call_cc_nn   [1  | 16/12] [- - - -] */
-void LR35902::call_cc_nn(bool set, uint8 flags)
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO Check condition */
-    /* @TODO push address of next instruction onto stack */
-    /* @TODO Read from memory */
-    /* @TODO Perform Jump */
-}
-
-/* ret          [1  |    16] [- - - -] */
-void LR35902::ret()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO Read from memory */
-    /* @TODO Perform Jump */
-}
-
-/* reti         [1  |    16] [- - - -] */
-void LR35902::reti()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO Read from memory */
-    /* @TODO Perform Jump */
-    /* @TODO enable interupts */
-}
-
-/* ret_cc       [1  |  20/8] [- - - -] */
-void LR35902::ret_cc(bool set, uint8 flags)
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO Check condition */
-    /* @TODO Read from memory */
-    /* @TODO Perform Jump */
-}
-
-/* rst_n        [1  |    16] [- - - -] */
-void LR35902::rst_n(uint8 offset)
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO push current address onto the stack. */
-    /* @TODO Perform Jump. */
-}
-
-/*********************************************************************************************************************\
-| 8 Bit Load Commands                                                                                                 |
-\*********************************************************************************************************************/
-
-/* ld_rr_a      [1  |     8] [- - - -] */
-void LR35902::ld_rr_a(uint8 &hReg, uint8 &lReg)
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO Read from memory */
-}
-
-/* ld_a_rr      [1  |     8] [- - - -] */
-void LR35902::ld_a_rr(uint8 &hReg, uint8 &lReg)
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO Store to memory */
-}
-
-/* ld_rr_n      [2  |     8] [- - - -] */
-void LR35902::ld_r_n(uint8 &reg)
-{
-    /* @TODO Affect clock cycle. */
-    reg = 0x00;/* @TODO read from memory */
-}
-
-/* ld_hl_n      [2  |    12] [- - - -] */
-void LR35902::ld_hl_n()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO read n from stack */
-    /* @TODO Write Memory n @ (HL) */
-}
-
-/* ld_r_r       [1  |     4] [- - - -] */
-void LR35902::ld_r_r(uint8 &reg1, uint8 &reg2)
-{
-    /* @TODO Affect clock cycle. */
-    reg1 = reg2;
-}
-
-/* ld_r_hl      [1  |     8] [- - - -] */
-void LR35902::ld_r_hl(uint8 &reg)
-{
-    /* @TODO Affect clock cycle. */
-    reg = 0x00;/* @TODO read memory from hl*/
-}
-
-/* ld_hl_r      [1  |     8] [- - - -] */
-void LR35902::ld_hl_r(uint8 &reg)
-{
-    /* @TODO Affect clock cycle. */
-    reg = 0x00;/* @TODO write memory to hl*/
-}
-
-/* ldh_n_a      [2  |    12] [- - - -] */
-void LR35902::ldh_n_a()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO write a to memory. */
-}
-
-/* ldh_a_n      [2  |    12] [- - - -] */
-void LR35902::ldh_a_n()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO Read from memory. */
-}
-
-/* ld_c_a       [2  |    12] [- - - -] */
-void LR35902::ld_c_a()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO write a to memory. */
-}
-
-/* ld_a_c       [2  |    12] [- - - -] */
-void LR35902::ld_a_c()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO Read from memory. */
-}
-
-/* ld_nn_a      [3  |    16] [- - - -] */
-void LR35902::ld_nn_a()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO write a to memory. */
-}
-
-/* ld_a_nn      [3  |    16] [- - - -] */
-void LR35902::ld_a_nn()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO Read from memory. */
-}
-
-/*********************************************************************************************************************\
-| 8 Bit Arithmetic Commands                                                                                           |
-\*********************************************************************************************************************/
-
-/* add_a_r      [1  |     4] [Z 0 H C] */
-void LR35902::add_a_r(uint8 &reg)
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO implement */
-}
-
-/* add_a_hl     [1  |     8] [Z 0 H C] */
-void LR35902::add_a_hl()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO implement */
-}
-
-/* add_a_n      [1  |     8] [Z 0 H C] */
-void LR35902::add_a_n()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO implement */
-}
-
-/* adc_a_r      [1  |     4] [Z 0 H C] */
-void LR35902::adc_a_r(uint8 &reg)
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO implement */
-}
-
-/* adc_a_hl     [1  |     8] [Z 0 H C] */
-void LR35902::adc_a_hl()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO implement */
-}
-
-/* adc_a_n      [1  |     8] [Z 0 H C] */
-void LR35902::adc_a_n()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO implement */
-}
-
-/* sub_a_r      [1  |     4] [Z 1 H C] */
-void LR35902::sub_a_r(uint8 &reg)
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO implement */
-}
-
-/* sub_a_hl     [1  |     8] [Z 1 H C] */
-void LR35902::sub_a_hl()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO implement */
-}
-
-/* add_a_n      [1  |     8] [Z 1 H C] */
-void LR35902::sub_a_n()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO implement */
-}
-
-/* sbc_a_r      [1  |     4] [Z 1 H C] */
-void LR35902::sbc_a_r(uint8 &reg)
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO implement */
-}
-
-/* sbc_a_hl     [1  |     8] [Z 1 H C] */
-void LR35902::sbc_a_hl()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO implement */
-}
-
-/* sbc_a_hl     [1  |     8] [Z 1 H C] */
-void LR35902::sbc_a_n()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO implement */
-}
-
-/* and_a_r      [1  |     4] [Z 0 1 0] */
-void LR35902::and_a_r(uint8 &reg)
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO implement */
-}
-
-/* and_a_hl     [1  |     8] [Z 0 1 0] */
-void LR35902::and_a_hl()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO implement */
-}
-
-/* and_a_n      [1  |     8] [Z 0 1 0] */
-void LR35902::and_a_n()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO implement */
-}
-
-/* xor_a_r      [1  |     4] [Z 0 0 0] */
-void LR35902::xor_a_r(uint8 &reg)
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO implement */
-}
-
-/* xor_a_hl     [1  |     8] [Z 0 0 0] */
-void LR35902::xor_a_hl()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO implement */
-}
-
-/* xor_a_n      [1  |     8] [Z 0 0 0] */
-void LR35902::xor_a_n()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO implement */
-}
-
-/* or_a_r       [1  |     4] [Z 0 0 0] */
-void LR35902::or_a_r(uint8 &reg)
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO implement */
-}
-
-/* or_a_hl      [1  |     8] [Z 0 0 0] */
-void LR35902::or_a_hl()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO implement */
-}
-
-/* or_a_n       [1  |     8] [Z 0 0 0] */
-void LR35902::or_a_n()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO implement */
-}
-
-/* cp_a_r       [1  |     4] [Z 1 H C] */
-void LR35902::cp_a_r(uint8 &reg)
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO implement */
-}
-
-/* cp_a_hl      [1  |     8] [Z 1 H C] */
-void LR35902::cp_a_hl()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO implement */
-}
-
-/* cp_a_n       [1  |     8] [Z 1 H C] */
-void LR35902::cp_a_n()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO implement */
-}
-
-/* inc_r        [1  |     4] [Z 0 H -] */
-void LR35902::inc_r(uint8 &reg)
-{
-    /* @TODO Affect clock cycle. */
-    ++reg;
-    //r.f = CALC_Z_N_H_C(0 == reg, 0, reg & 0x0F);
-}
-
-/* inc_hl       [1  |    12] [Z 0 H -] */
-void LR35902::inc_hl()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO Read the memory value (HL) */
-    /* @TODO Increment the value */
-    /* @TODO Store the value back into memory (HL) */
-    /* @TODO Set registers */
-}
-
-/* dec_r        [1  |     4] [Z 1 H -] */
-void LR35902::dec_r(uint8 &reg)
-{
-    /* @TODO Affect clock cycle. */
-    --reg;
-    //this->r.f = CALC_Z_N_H_C(0 == reg, 1, reg & 0x0F);
-}
-
-/* decc_hl      [1  |    12] [Z 1 H -] */
-void LR35902::dec_hl()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO Read the memory value (HL) */
-    /* @TODO Increment the value */
-    /* @TODO Store the value back into memory (HL) */
-    /* @TODO Set registers */
-}
-
-/* rlca         [1  |     4] [0 0 0 C] */
-void LR35902::rlca()
-{
-    /* @TODO Affect clock cycle. */
-    this->r.a = ROTATE_LEFT(this->r.a);
-    //this->r.f = CALC_Z_N_H_C(0, 0, 0, this->r.a & 0x01);
-}
-
-/* rlca         [1  |     4] [0 0 0 C] */
-void LR35902::rla()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO */
-}
-
-/* rrca         [1  |     4] [0 0 0 C] */
-void LR35902::rrca()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO */
-}
-
-/* rra          [1  |     4] [0 0 0 C] */
-void LR35902::rra()
-{
-    /* @TODO Affect clock cycle. */
-    //this->r.f = CALC_Z_N_H_C(0, 0, 0, this->r.a & 0x01);
-    this->r.a = ROTATE_RIGHT(this->r.a);
-}
-
-/* daa          [1  |     4] [Z - 0 C] */
-void LR35902::daa()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO BCD Encode A. */
-}
-
-/* cpl          [1  |     4] [- 1 1 -] */
-void LR35902::cpl()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO BCD Encode A. */
-}
-
-/* scf          [1  |     4] [- 0 0 1] */
-void LR35902::scf()
-{
-    /* @TODO Affect clock cycle. */
-    //this->r.f = CALC_Z_N_H_C((), 0, 0, true);
-}
-
-/* ccf          [1  |     4] [- 0 0 C] */
-void LR35902::ccf()
-{
-    /* @TODO Affect clock cycle. */
-    //this->r.f = CALC_N_H_C(0, 0, !(this.r.f & LR35902_CARRY_FLAG));
-}
-
-/*********************************************************************************************************************\
-| 16 Bit Load Commands                                                                                                |
-\*********************************************************************************************************************/
-
-/* ld_rr_nn     [3  |    12] [- - - -] */
-void LR35902::ld_rr_nn(uint8 &hReg, uint8 &lReg)
-{
-    /* @TODO Affect clock cycle. */
-    hReg = 0x00;/* @TODO read from memory */
-    lReg = 0x00;/* @TODO read from memory */
-}
-void LR35902::ld_rr_nn(uint16 &reg)
-{
-    /* @TODO Affect clock cycle. */
-    reg  = 0x00 << 0;/* @TODO read from memory */
-    reg |= 0x00 << 8;/* @TODO read from memory */
-}
-
-/* ld_nn_sp     [3  |    20] [- - - -] */
-void LR35902::ld_nn_sp()
-{
-    /* @TODO Affect clock cycle. */
-    uint16 addr = 0x00; /* @TODO read from memory */
-    addr |= 0x00;       /* @TODO read from memory */
-    /* @TODO write to memory sp */
-}
-
-/* ldi_hl_a     [1  |     8] [- - - -] */
-void LR35902::ldi_hl_a()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO write to memory hl */
-    /* @TODO increment hl */
-}
-
-/* ldi_a_hl     [1  |     8] [- - - -] */
-void LR35902::ldi_a_hl()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO read from memory hl */
-    /* @TODO increment hl */
-}
-
-/* ldd_hl_a     [1  |     8] [- - - -] */
-void LR35902::ldd_hl_a()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO write to memory hl */
-    /* @TODO deccrement hl */
-}
-
-/* ldd_a_hl     [1  |     8] [- - - -] */
-void LR35902::ldd_a_hl()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO read from memory hl */
-    /* @TODO deccrement hl */
-}
-
-/* ldhl_sp_n    [2  |    12] [- - - -] */
-void LR35902::ldhl_sp_n()
-{
-    /* @TODO store SP+N into hl. */
-}
-
-/* ld_sp_hl     [1  |     8] [- - - -] */
-void LR35902::ld_sp_hl()
-{
-    /* @TODO store HL into SP. */
-}
-
-/* pop_rr       [1  |    12] [- - - -] */
-void LR35902::pop_rr(uint8 &hReg, uint8 &lReg)
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO write to memory from rr */
-}
-
-/* push_rr      [1  |    12] [- - - -] */
-void LR35902::push_rr(uint8 &hReg, uint8 &lReg)
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO read from memory into rr */
-}
-
-/*********************************************************************************************************************\
-| 16 Bit Arithmetic Commands                                                                                          |
-\*********************************************************************************************************************/
-
-/* add_hl_rr    [1  |     8] [- 0 H C] */
-void LR35902::add_hl_rr(uint8 &hReg, uint8 &lReg)
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO Figure out how to calculate this in general*/
-}
-void LR35902::add_hl_rr(uint16 &reg)
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO Figure out how to calculate this in general*/
-}
-
-/* add_sp_n     [2  |    16] [0 0 H C] */
-void LR35902::add_sp_n()
-{
-    /* @TODO Affect clock cycle. */
-    /* @TODO Figure out how to calculate this in general */
-}
-
-/* inc_rr       [1  |     8] [- - - -] */
-void LR35902::inc_rr(uint8 &hReg, uint8 &lReg)
-{
-    /* @TODO Affect clock cycle. */
-    ++lReg;
-    if (lReg == 0) {
-        ++hReg;
-    }
-}
-void LR35902::inc_rr(uint16 &reg)
-{
-    /* @TODO Affect clock cycles */
-    ++reg;
-}
-
-/* dec_rr       [1  |     8] [Z 0 H -] */
-void LR35902::dec_rr(uint8 &hReg, uint8 &lReg)
-{
-    /* @TODO Affect clock cycle. */
-    --lReg;
-    if (0xFF == lReg) {
-        --hReg;
-    }
-}
-void LR35902::dec_rr(uint16 &reg)
-{
-    /* @TODO Affect clock cycle. */
-    --reg;
-}
-
-/*********************************************************************************************************************\
-| CBX Commands                                                                                                        |
-\*********************************************************************************************************************/
-
-/* rlc_r        [2  |     8] [Z 0 0 C] */
-void LR35902::rlc_r(uint8 &reg)
-{
-    /* @TODO */
-}
-
-/* rlc_hl       [2  |    16] [Z 0 0 C] */
-void LR35902::rlc_hl()
-{
-    /* @TODO */
-}
-
-/* rl_r         [2  |     8] [Z 0 0 C] */
-void LR35902::rl_r(uint8 &reg)
-{
-    /* @TODO */
-}
-
-/* rl_hl        [2  |    16] [Z 0 0 C] */
-void LR35902::rl_hl()
-{
-    /* @TODO */
-}
-
-/* rrc_r        [2  |     8] [Z 0 0 C] */
-void LR35902::rrc_r(uint8 &reg)
-{
-    /* @TODO */
-}
-
-/* rrc_hl       [2  |    16] [Z 0 0 C] */
-void LR35902::rrc_hl()
-{
-    /* @TODO */
-}
-
-/* rr_r         [2  |     8] [Z 0 0 C] */
-void LR35902::rr_r(uint8 &reg)
-{
-    /* @TODO */
-}
-
-/* rr_hl        [2  |    16] [Z 0 0 C] */
-void LR35902::rr_hl()
-{
-    /* @TODO */
-}
-
-/* sla_r        [2  |     8] [Z 0 0 C] */
-void LR35902::sla_r(uint8 &reg)
-{
-    /* @TODO */
-}
-
-/* sla_hl       [2  |    16] [Z 0 0 C] */
-void LR35902::sla_hl()
-{
-    /* @TODO */
-}
-
-/* sra_r        [2  |     8] [Z 0 0 0] */
-void LR35902::sra_r(uint8 &reg)
-{
-    /* @TODO */
-}
-
-/* sra_hl       [2  |    16] [Z 0 0 0] */
-void LR35902::sra_hl()
-{
-    /* @TODO */
-}
-
-/* srl_r        [2  |     8] [Z 0 0 C] */
-void LR35902::srl_r(uint8 &reg)
-{
-    /* @TODO */
-}
-
-/* srl_hl       [2  |    16] [Z 0 0 C] */
-void LR35902::srl_hl()
-{
-    /* @TODO */
-}
-
-/* swap_r       [2  |     8] [Z 0 0 0] */
-void LR35902::swap_r(uint8 &reg)
-{
-    /* @TODO */
-}
-
-/* swap_hl      [2  |    16] [Z 0 0 0] */
-void LR35902::swap_hl()
-{
-    /* @TODO */
-}
-
-/* bit          [2  |     8] [Z 0 1 -] */
-void LR35902::bit_b_r(uint8 bit, const uint8 &reg)
-{
-    this->r.f = CALC_Z_N_H_C(reg & (1 << bit), 0, 1, this->r.f & LR35902_FLAG_CARRY);
-}
-
-/* bit_hl       [2  |    16] [Z 0 1 -] */
-void LR35902::bit_b_hl(const uint8 bit)
-{
-    uint8 value = 0x00; /* @TODO read hl from memory. */
-    this->bit_b_r(bit, value);
-    /* @TODO Write value back to memory. */
-}
-
-/* res          [2  |     8] [- - - -] */
-void LR35902::res_b_r(const uint8 bit, uint8 &reg)
-{
-    reg &= 0xFFFF ^ (1 << bit);
-}
-
-/* res_hl       [2  |    16] [- - - -] */
-void LR35902::res_b_hl(const uint8 bit)
-{
-    uint8 value = 0x00; /* @TODO read hl from memory. */
-    this->res_b_r(bit, value);
-    /* @TODO Write value back to memory. */
-}
-
-/* set          [2  |     8] [- - - -] */
-void LR35902::set_b_r(const uint8 bit, uint8 &reg)
-{
-    reg |= (1 << bit);
-}
-
-/* set_hl       [2  |    16] [Z 0 1 -] */
-void LR35902::set_b_hl(const uint8 bit)
-{
-    uint8 value = 0x00; /* @TODO read hl from memory. */
-    this->set_b_r(bit, value);
-    /* @TODO Write value back to memory. */
-}
-
-#undef PRE_OP_FUNC
-
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#include "xplat/types.hpp"
+#include "Processors/Nintendo/LR35902/LR35902.hpp"
+
+/*
+FORMAT for processor operation functions.
+<mnemonic> [#1 |     #2] [Z H N C]
+Where #1 is the length in bytes read from the stack.
+Where #2 is the duration in cycles.
+Z,H,N,C are flags that were affected by the operation.
+If the flag is marked by a "0" it is reset after instruction run.
+If the flag is marked by a "1" it is set after instruction run.
+If the flag is marked by a "-" it is unchanged.
+If the flag is marked by the corresponding symbol it is affected by the function as normal.
+Z - Zero Flag       : Set when a math operation is zero or two values match with CP.
+H - Subtract Flag   : Set if the last operation used subtraction.
+N - Half Carry Flag : If the lower nibble carried in the math operation.
+C - Carry Flag      : Set if a carry occurred from the last math operation or register A is smaller in with CP.
+*/
+
+/* Calculate flags */
+//#define CALC_Z_N_H(Z, N, H)         (((Z ? 0x04 : 0x00) | (N ? 0x02 : 0x00) | (H ? 0x01 : 0x00)) << (7-3+1))
+#define CALC_Z_N_H_C(Z, N, H, C)    ((Z ? LR35902_FLAG_ZERO : 0x00) | (N ? LR35902_FLAG_SUBTRACT : 0x00) | (H ? LR35902_FLAG_HALF_CARRY : 0x00) | (C ? LR35902_FLAG_CARRY : 0x00))
+
+/* Optimizations for rotations. */
+#define ROTATE_LEFT(VALUE) (((VALUE) << 1) | (VALUE) >> (sizeof(VALUE) * 8 - 1))
+#define ROTATE_RIGHT(VALUE) ((((VALUE) >> 1) | (VALUE) << (sizeof(VALUE) * 8 - 1)))
+
+/**
+ * Record the flags of a flag producing op, see LR35902::_LAZY_FLAGS for the meaning of the operands.
+ * Eager builds fold evalFlags for the constant op kind at each call site, lazy builds store the operands
+ * and leave the work to the first reader of the F register.
+ */
+#if LR35902_FLAGS == LR35902_FLAGS_LAZY
+    #define SET_FLAGS(OP, X, Y, C, RES) \
+        (this->lf.op = (OP), this->lf.x = (X), this->lf.y = (Y), this->lf.c = (C), this->lf.res = (RES))
+#else
+    #define SET_FLAGS(OP, X, Y, C, RES) (this->r.f = LR35902::evalFlags((OP), (X), (Y), (C), (RES)))
+#endif
+
+/**
+ * Store a complete F register, dropping any deferred flags.
+ */
+#if LR35902_FLAGS == LR35902_FLAGS_LAZY
+    #define STORE_FLAGS(F) (this->r.f = (F), this->lf.op = LR35902_LAZY_NONE)
+#else
+    #define STORE_FLAGS(F) (this->r.f = (F))
+#endif
+
+/**
+ * Store the result and F register of an ALU table entry.
+ */
+#define STORE_ALU(DST, ENTRY) (DST = LR35902_ALU_RESULT(ENTRY), STORE_FLAGS(LR35902_ALU_FLAGS(ENTRY)))
+
+#define PRE_OP_FUNC static void
+
+/**
+ * The HL register pair.
+ */
+#define HL this->rr.hl
+
+/**
+ * Account for the extra cycles of a conditional op that branches, OP is any op code of its kind.
+ */
+#define TAKEN(OP) LR35902_ADD_CYCLES(OP_INFO[OP].taken - OP_INFO[OP].cycles)
+
+/**
+ * Report a data access to the access hook.
+ */
+#if LR35902_TIMING == LR35902_TIMING_ACCESS
+    #define ACCESS(ADDR, WRITE) \
+        if (NULL != this->accessHook) { this->accessHook(this->accessContext, (ADDR), (WRITE), this->cycles); }
+#else
+    #define ACCESS(ADDR, WRITE)
+#endif
+
+/*********************************************************************************************************************\
+| Flag Evaluation                                                                                                     |
+\*********************************************************************************************************************/
+
+/* Calculate the F register for a flag producing op. */
+inline uint8 LR35902::evalFlags(uint8 op, uint8 x, uint8 y, uint8 c, uint16 res)
+{
+    switch (op) {
+        case LR35902_LAZY_ADD:
+            return CALC_Z_N_H_C(0 == (res & 0xFF), 0, ((x & 0x0F) + (y & 0x0F) + c) > 0x0F, res > 0xFF);
+        case LR35902_LAZY_SUB:
+            return CALC_Z_N_H_C(0 == (res & 0xFF), 1, (x & 0x0F) < ((y & 0x0F) + c), res > 0xFF);
+        case LR35902_LAZY_INC:
+            return CALC_Z_N_H_C(0 == (res & 0xFF), 0, 0x0F == (x & 0x0F), c);
+        case LR35902_LAZY_DEC:
+            return CALC_Z_N_H_C(0 == (res & 0xFF), 1, 0x00 == (x & 0x0F), c);
+        case LR35902_LAZY_AND:
+            return CALC_Z_N_H_C(0 == (res & 0xFF), 0, 1, 0);
+        case LR35902_LAZY_LOGIC:
+            return CALC_Z_N_H_C(0 == (res & 0xFF), 0, 0, 0);
+        case LR35902_LAZY_ROT:
+            return CALC_Z_N_H_C(0 == (res & 0xFF), 0, 0, res > 0xFF);
+        case LR35902_LAZY_ROTA:
+            return CALC_Z_N_H_C(0, 0, 0, res > 0xFF);
+        case LR35902_LAZY_BIT:
+            return CALC_Z_N_H_C(0 == (res & 0xFF), 0, 1, c);
+        default:
+            return 0x00;
+    }
+}
+
+/* Materialize any deferred flags into r.f. */
+inline uint8 LR35902::flags()
+{
+#if LR35902_FLAGS == LR35902_FLAGS_LAZY
+    if (LR35902_LAZY_NONE != this->lf.op) {
+        this->r.f = LR35902::evalFlags(this->lf.op, this->lf.x, this->lf.y, this->lf.c, this->lf.res);
+        this->lf.op = LR35902_LAZY_NONE;
+    }
+#endif
+    return this->r.f;
+}
+
+/* Read the carry flag without materializing the rest of the F register. */
+inline uint8 LR35902::carry()
+{
+#if LR35902_FLAGS == LR35902_FLAGS_LAZY
+    switch (this->lf.op) {
+        case LR35902_LAZY_NONE:
+            break;
+        case LR35902_LAZY_ADD:
+        case LR35902_LAZY_SUB:
+        case LR35902_LAZY_ROT:
+        case LR35902_LAZY_ROTA:
+            return this->lf.res > 0xFF ? 1 : 0;
+        case LR35902_LAZY_INC:
+        case LR35902_LAZY_DEC:
+        case LR35902_LAZY_BIT:
+            return this->lf.c;
+        default:
+            return 0;
+    }
+#endif
+    return (this->r.f & LR35902_FLAG_CARRY) ? 1 : 0;
+}
+
+/* Check a jump condition against the flags. */
+inline bool LR35902::condition(bool set, uint8 flags)
+{
+    return set == (0 != (this->flags() & flags));
+}
+
+/*********************************************************************************************************************\
+| Memory Access                                                                                                       |
+\*********************************************************************************************************************/
+
+/* Read a byte from the address space without timing it, for op fetches and decoding. */
+inline uint8 LR35902::peek8(uint16 addr)
+{
+    return this->bus.read8(addr);
+}
+
+/* Read a byte from the address space. */
+inline uint8 LR35902::read8(uint16 addr)
+{
+    ACCESS(addr, false);
+    return this->bus.read8(addr);
+}
+
+/* Write a byte to the address space. */
+inline void LR35902::write8(uint16 addr, uint8 value)
+{
+    ACCESS(addr, true);
+    this->bus.write8(addr, value);
+}
+
+/* Read a little endian word from the address space. */
+inline uint16 LR35902::read16(uint16 addr)
+{
+    return (uint16)(this->read8(addr) | (this->read8((uint16)(addr + 1)) << 8));
+}
+
+/* Write a little endian word to the address space. */
+inline void LR35902::write16(uint16 addr, uint16 value)
+{
+    this->write8(addr, (uint8)value);
+    this->write8((uint16)(addr + 1), (uint8)(value >> 8));
+}
+
+/* Push a word onto the stack. */
+inline void LR35902::push16(uint16 value)
+{
+    this->rr.sp -= 2;
+    this->write16(this->rr.sp, value);
+}
+
+/* Pop a word from the stack. */
+inline uint16 LR35902::pop16()
+{
+    uint16 value = this->read16(this->rr.sp);
+    this->rr.sp += 2;
+    return value;
+}
+
+/* Fetch the op code at the PC into imm with its operand and advance the PC past it. */
+inline uint8 LR35902::fetchOp()
+{
+    uint8 op = this->peek8(this->rr.pc);
+    uint8 length = OP_INFO[op].length;
+    if (length > 1) {
+        this->imm = this->peek8((uint16)(this->rr.pc + 1));
+        if (length > 2) {
+            this->imm |= this->peek8((uint16)(this->rr.pc + 2)) << 8;
+        }
+    }
+    this->rr.pc += length;
+    return op;
+}
+
+/*********************************************************************************************************************\
+| Misceleanous Commands                                                                                               |
+\*********************************************************************************************************************/
+
+/* nop          [1  |     4] [- - - -] */
+void LR35902::nop()
+{
+}
+
+/* stop         [2  |     4] [- - - -] */
+void LR35902::stop()
+{
+    this->halted = true;
+    this->wake = 0x01 << LR35902_INT_JOYPAD;
+}
+
+/* halt         [1  |     4] [- - - -] */
+void LR35902::halt()
+{
+    this->halted = true;
+    this->wake = 0x1F;
+}
+
+/* di           [1  |     4] [- - - -] */
+void LR35902::di()
+{
+    this->ime = false;
+    this->imePending = false;
+}
+
+/* ei           [1  |     4] [- - - -] */
+void LR35902::ei()
+{
+    /* Takes effect once the next op has run, see execOp and runUntil. */
+    this->imePending = true;
+}
+
+/* Take the highest priority interrupt requested in IF and enabled in IE while IME is set. */
+bool LR35902::serviceInterrupts()
+{
+    uint8 pending = (uint8)(this->peek8(0xFFFF) & this->peek8(0xFF0F) & 0x1F);
+    if (!this->ime || 0x00 == pending) {
+        return false;
+    }
+    uint8 source = 0;
+    while (!(pending & (0x01 << source))) {
+        ++source;
+    }
+    this->bus.write8(0xFF0F, (uint8)(this->bus.read8(0xFF0F) & ~(0x01 << source)));
+    this->ime = false;
+    this->halted = false;
+    this->push16(this->rr.pc);
+    this->rr.pc = (uint16)(0x40 + 8 * source);
+    LR35902_ADD_CYCLES(20);
+    ++this->stats.interrupts;
+    return true;
+}
+
+/*********************************************************************************************************************\
+| Jump, Return, Call, Reset Commands                                                                                  |
+\*********************************************************************************************************************/
+
+/* jr_n         [1  |     4] [- - - -] */
+void LR35902::jr_n()
+{
+    this->rr.pc += (int8)this->imm;
+}
+
+/* jr_cc_n      [1  |  12/8] [- - - -] */
+void LR35902::jr_cc_n(bool negate, uint8 flags)
+{
+    if (this->condition(negate, flags)) {
+        TAKEN(0x20);
+        this->rr.pc += (int8)this->imm;
+    }
+}
+
+/* jp_nn        [1  |    16] [- - - -] */
+void LR35902::jp_nn()
+{
+    this->rr.pc = this->imm;
+}
+
+/* jp_hl        [1  |    16] [- - - -] */
+void LR35902::jp_hl()
+{
+    this->rr.pc = HL;
+}
+
+/* jp_cc_nn     [1  | 16/12] [- - - -] */
+void LR35902::jp_cc_nn(bool set, uint8 flags)
+{
+    if (this->condition(set, flags)) {
+        TAKEN(0xC2);
+        this->rr.pc = this->imm;
+    }
+}
+
+/* call_nn      [1  |    24] [- - - -] */
+void LR35902::call_nn()
+{
+    this->push16(this->rr.pc);
+    this->rr.pc = this->imm;
+}
+
+/* call_cc_nn   [1  | 24/12] [- - - -] */
+void LR35902::call_cc_nn(bool set, uint8 flags)
+{
+    if (this->condition(set, flags)) {
+        TAKEN(0xC4);
+        this->push16(this->rr.pc);
+        this->rr.pc = this->imm;
+    }
+}
+
+/* ret          [1  |    16] [- - - -] */
+void LR35902::ret()
+{
+    this->rr.pc = this->pop16();
+}
+
+/* reti         [1  |    16] [- - - -] */
+void LR35902::reti()
+{
+    this->rr.pc = this->pop16();
+    this->ime = true;
+}
+
+/* ret_cc       [1  |  20/8] [- - - -] */
+void LR35902::ret_cc(bool set, uint8 flags)
+{
+    if (this->condition(set, flags)) {
+        TAKEN(0xC0);
+        this->rr.pc = this->pop16();
+    }
+}
+
+/* rst_n        [1  |    16] [- - - -] */
+void LR35902::rst_n(uint8 offset)
+{
+    this->push16(this->rr.pc);
+    this->rr.pc = offset;
+}
+
+/*********************************************************************************************************************\
+| 8 Bit Load Commands                                                                                                 |
+\*********************************************************************************************************************/
+
+/* ld_rr_a      [1  |     8] [- - - -] */
+void LR35902::ld_rr_a(uint16 &reg)
+{
+    this->write8(reg, this->r.a);
+}
+
+/* ld_a_rr      [1  |     8] [- - - -] */
+void LR35902::ld_a_rr(uint16 &reg)
+{
+    this->r.a = this->read8(reg);
+}
+
+/* ld_rr_n      [2  |     8] [- - - -] */
+void LR35902::ld_r_n(uint8 &reg)
+{
+    reg = (uint8)this->imm;
+}
+
+/* ld_hl_n      [2  |    12] [- - - -] */
+void LR35902::ld_hl_n()
+{
+    this->write8(HL, (uint8)this->imm);
+}
+
+/* ld_r_r       [1  |     4] [- - - -] */
+void LR35902::ld_r_r(uint8 &reg1, uint8 &reg2)
+{
+    reg1 = reg2;
+}
+
+/* ld_r_hl      [1  |     8] [- - - -] */
+void LR35902::ld_r_hl(uint8 &reg)
+{
+    reg = this->read8(HL);
+}
+
+/* ld_hl_r      [1  |     8] [- - - -] */
+void LR35902::ld_hl_r(uint8 &reg)
+{
+    this->write8(HL, reg);
+}
+
+/* ldh_n_a      [2  |    12] [- - - -] */
+void LR35902::ldh_n_a()
+{
+    this->write8((uint16)(0xFF00 + (uint8)this->imm), this->r.a);
+}
+
+/* ldh_a_n      [2  |    12] [- - - -] */
+void LR35902::ldh_a_n()
+{
+    this->r.a = this->read8((uint16)(0xFF00 + (uint8)this->imm));
+}
+
+/* ld_c_a       [2  |    12] [- - - -] */
+void LR35902::ld_c_a()
+{
+    this->write8((uint16)(0xFF00 + this->r.c), this->r.a);
+}
+
+/* ld_a_c       [2  |    12] [- - - -] */
+void LR35902::ld_a_c()
+{
+    this->r.a = this->read8((uint16)(0xFF00 + this->r.c));
+}
+
+/* ld_nn_a      [3  |    16] [- - - -] */
+void LR35902::ld_nn_a()
+{
+    this->write8(this->imm, this->r.a);
+}
+
+/* ld_a_nn      [3  |    16] [- - - -] */
+void LR35902::ld_a_nn()
+{
+    this->r.a = this->read8(this->imm);
+}
+
+/*********************************************************************************************************************\
+| 8 Bit Arithmetic Commands                                                                                           |
+\*********************************************************************************************************************/
+
+/* add_a_r      [1  |     4] [Z 0 H C] */
+void LR35902::add_a_r(uint8 &reg)
+{
+#if LR35902_ALU == LR35902_ALU_TABLE
+    uint16 entry = LR35902_ALU_ADD[0][this->r.a][reg];
+    STORE_ALU(this->r.a, entry);
+#else
+    uint16 res = this->r.a + reg;
+    SET_FLAGS(LR35902_LAZY_ADD, this->r.a, reg, 0, res);
+    this->r.a = (uint8)res;
+#endif
+}
+
+/* add_a_hl     [1  |     8] [Z 0 H C] */
+void LR35902::add_a_hl()
+{
+    uint8 value = this->read8(HL);
+    this->add_a_r(value);
+}
+
+/* add_a_n      [1  |     8] [Z 0 H C] */
+void LR35902::add_a_n()
+{
+    uint8 value = (uint8)this->imm;
+    this->add_a_r(value);
+}
+
+/* adc_a_r      [1  |     4] [Z 0 H C] */
+void LR35902::adc_a_r(uint8 &reg)
+{
+#if LR35902_ALU == LR35902_ALU_TABLE
+    uint16 entry = LR35902_ALU_ADD[this->carry()][this->r.a][reg];
+    STORE_ALU(this->r.a, entry);
+#else
+    uint8 c = this->carry();
+    uint16 res = this->r.a + reg + c;
+    SET_FLAGS(LR35902_LAZY_ADD, this->r.a, reg, c, res);
+    this->r.a = (uint8)res;
+#endif
+}
+
+/* adc_a_hl     [1  |     8] [Z 0 H C] */
+void LR35902::adc_a_hl()
+{
+    uint8 value = this->read8(HL);
+    this->adc_a_r(value);
+}
+
+/* adc_a_n      [1  |     8] [Z 0 H C] */
+void LR35902::adc_a_n()
+{
+    uint8 value = (uint8)this->imm;
+    this->adc_a_r(value);
+}
+
+/* sub_a_r      [1  |     4] [Z 1 H C] */
+void LR35902::sub_a_r(uint8 &reg)
+{
+#if LR35902_ALU == LR35902_ALU_TABLE
+    uint16 entry = LR35902_ALU_SUB[0][this->r.a][reg];
+    STORE_ALU(this->r.a, entry);
+#else
+    uint16 res = (uint16)(this->r.a - reg);
+    SET_FLAGS(LR35902_LAZY_SUB, this->r.a, reg, 0, res);
+    this->r.a = (uint8)res;
+#endif
+}
+
+/* sub_a_hl     [1  |     8] [Z 1 H C] */
+void LR35902::sub_a_hl()
+{
+    uint8 value = this->read8(HL);
+    this->sub_a_r(value);
+}
+
+/* add_a_n      [1  |     8] [Z 1 H C] */
+void LR35902::sub_a_n()
+{
+    uint8 value = (uint8)this->imm;
+    this->sub_a_r(value);
+}
+
+/* sbc_a_r      [1  |     4] [Z 1 H C] */
+void LR35902::sbc_a_r(uint8 &reg)
+{
+#if LR35902_ALU == LR35902_ALU_TABLE
+    uint16 entry = LR35902_ALU_SUB[this->carry()][this->r.a][reg];
+    STORE_ALU(this->r.a, entry);
+#else
+    uint8 c = this->carry();
+    uint16 res = (uint16)(this->r.a - reg - c);
+    SET_FLAGS(LR35902_LAZY_SUB, this->r.a, reg, c, res);
+    this->r.a = (uint8)res;
+#endif
+}
+
+/* sbc_a_hl     [1  |     8] [Z 1 H C] */
+void LR35902::sbc_a_hl()
+{
+    uint8 value = this->read8(HL);
+    this->sbc_a_r(value);
+}
+
+/* sbc_a_hl     [1  |     8] [Z 1 H C] */
+void LR35902::sbc_a_n()
+{
+    uint8 value = (uint8)this->imm;
+    this->sbc_a_r(value);
+}
+
+/* and_a_r      [1  |     4] [Z 0 1 0] */
+void LR35902::and_a_r(uint8 &reg)
+{
+    this->r.a &= reg;
+    SET_FLAGS(LR35902_LAZY_AND, 0, 0, 0, this->r.a);
+}
+
+/* and_a_hl     [1  |     8] [Z 0 1 0] */
+void LR35902::and_a_hl()
+{
+    uint8 value = this->read8(HL);
+    this->and_a_r(value);
+}
+
+/* and_a_n      [1  |     8] [Z 0 1 0] */
+void LR35902::and_a_n()
+{
+    uint8 value = (uint8)this->imm;
+    this->and_a_r(value);
+}
+
+/* xor_a_r      [1  |     4] [Z 0 0 0] */
+void LR35902::xor_a_r(uint8 &reg)
+{
+    this->r.a ^= reg;
+    SET_FLAGS(LR35902_LAZY_LOGIC, 0, 0, 0, this->r.a);
+}
+
+/* xor_a_hl     [1  |     8] [Z 0 0 0] */
+void LR35902::xor_a_hl()
+{
+    uint8 value = this->read8(HL);
+    this->xor_a_r(value);
+}
+
+/* xor_a_n      [1  |     8] [Z 0 0 0] */
+void LR35902::xor_a_n()
+{
+    uint8 value = (uint8)this->imm;
+    this->xor_a_r(value);
+}
+
+/* or_a_r       [1  |     4] [Z 0 0 0] */
+void LR35902::or_a_r(uint8 &reg)
+{
+    this->r.a |= reg;
+    SET_FLAGS(LR35902_LAZY_LOGIC, 0, 0, 0, this->r.a);
+}
+
+/* or_a_hl      [1  |     8] [Z 0 0 0] */
+void LR35902::or_a_hl()
+{
+    uint8 value = this->read8(HL);
+    this->or_a_r(value);
+}
+
+/* or_a_n       [1  |     8] [Z 0 0 0] */
+void LR35902::or_a_n()
+{
+    uint8 value = (uint8)this->imm;
+    this->or_a_r(value);
+}
+
+/* cp_a_r       [1  |     4] [Z 1 H C] */
+void LR35902::cp_a_r(uint8 &reg)
+{
+#if LR35902_ALU == LR35902_ALU_TABLE
+    STORE_FLAGS(LR35902_ALU_FLAGS(LR35902_ALU_SUB[0][this->r.a][reg]));
+#else
+    uint16 res = (uint16)(this->r.a - reg);
+    SET_FLAGS(LR35902_LAZY_SUB, this->r.a, reg, 0, res);
+#endif
+}
+
+/* cp_a_hl      [1  |     8] [Z 1 H C] */
+void LR35902::cp_a_hl()
+{
+    uint8 value = this->read8(HL);
+    this->cp_a_r(value);
+}
+
+/* cp_a_n       [1  |     8] [Z 1 H C] */
+void LR35902::cp_a_n()
+{
+    uint8 value = (uint8)this->imm;
+    this->cp_a_r(value);
+}
+
+/* inc_r        [1  |     4] [Z 0 H -] */
+void LR35902::inc_r(uint8 &reg)
+{
+#if LR35902_ALU == LR35902_ALU_TABLE
+    uint8 c = this->carry() ? LR35902_FLAG_CARRY : 0x00;
+    uint16 entry = LR35902_ALU_INC[reg] | (c << 8);
+    STORE_ALU(reg, entry);
+#else
+    uint8 c = this->carry();
+    uint8 x = reg++;
+    SET_FLAGS(LR35902_LAZY_INC, x, 0, c, reg);
+#endif
+}
+
+/* inc_hl       [1  |    12] [Z 0 H -] */
+void LR35902::inc_hl()
+{
+    uint8 value = this->read8(HL);
+    this->inc_r(value);
+    this->write8(HL, value);
+}
+
+/* dec_r        [1  |     4] [Z 1 H -] */
+void LR35902::dec_r(uint8 &reg)
+{
+#if LR35902_ALU == LR35902_ALU_TABLE
+    uint8 c = this->carry() ? LR35902_FLAG_CARRY : 0x00;
+    uint16 entry = LR35902_ALU_DEC[reg] | (c << 8);
+    STORE_ALU(reg, entry);
+#else
+    uint8 c = this->carry();
+    uint8 x = reg--;
+    SET_FLAGS(LR35902_LAZY_DEC, x, 0, c, reg);
+#endif
+}
+
+/* decc_hl      [1  |    12] [Z 1 H -] */
+void LR35902::dec_hl()
+{
+    uint8 value = this->read8(HL);
+    this->dec_r(value);
+    this->write8(HL, value);
+}
+
+/* rlca         [1  |     4] [0 0 0 C] */
+void LR35902::rlca()
+{
+    this->r.a = ROTATE_LEFT(this->r.a);
+    SET_FLAGS(LR35902_LAZY_ROTA, 0, 0, 0, ((this->r.a & 0x01) << 8) | this->r.a);
+}
+
+/* rlca         [1  |     4] [0 0 0 C] */
+void LR35902::rla()
+{
+    uint16 res = (this->r.a << 1) | this->carry();
+    SET_FLAGS(LR35902_LAZY_ROTA, 0, 0, 0, res);
+    this->r.a = (uint8)res;
+}
+
+/* rrca         [1  |     4] [0 0 0 C] */
+void LR35902::rrca()
+{
+    SET_FLAGS(LR35902_LAZY_ROTA, 0, 0, 0, (this->r.a & 0x01) << 8);
+    this->r.a = ROTATE_RIGHT(this->r.a);
+}
+
+/* rra          [1  |     4] [0 0 0 C] */
+void LR35902::rra()
+{
+    uint8 a = (uint8)((this->r.a >> 1) | (this->carry() << 7));
+    SET_FLAGS(LR35902_LAZY_ROTA, 0, 0, 0, ((this->r.a & 0x01) << 8) | a);
+    this->r.a = a;
+}
+
+/* daa          [1  |     4] [Z - 0 C] */
+void LR35902::daa()
+{
+#if LR35902_ALU == LR35902_ALU_TABLE
+    uint16 entry = LR35902_ALU_DAA[LR35902_ALU_DAA_INDEX(this->r.a, this->flags())];
+    STORE_ALU(this->r.a, entry);
+#else
+    uint8 f = this->flags();
+    uint8 adjust = 0x00;
+    bool carry = 0 != (f & LR35902_FLAG_CARRY);
+    if (f & LR35902_FLAG_SUBTRACT) {
+        if (f & LR35902_FLAG_HALF_CARRY) { adjust |= 0x06; }
+        if (carry)                       { adjust |= 0x60; }
+        this->r.a -= adjust;
+    } else {
+        if ((f & LR35902_FLAG_HALF_CARRY) || (this->r.a & 0x0F) > 0x09) { adjust |= 0x06; }
+        if (carry || this->r.a > 0x99)                                 { adjust |= 0x60; carry = true; }
+        this->r.a += adjust;
+    }
+    this->r.f = CALC_Z_N_H_C(0 == this->r.a, f & LR35902_FLAG_SUBTRACT, 0, carry);
+#endif
+}
+
+/* cpl          [1  |     4] [- 1 1 -] */
+void LR35902::cpl()
+{
+    this->r.a = ~this->r.a;
+    this->r.f = this->flags() | LR35902_FLAG_SUBTRACT | LR35902_FLAG_HALF_CARRY;
+}
+
+/* scf          [1  |     4] [- 0 0 1] */
+void LR35902::scf()
+{
+    this->r.f = (this->flags() & LR35902_FLAG_ZERO) | LR35902_FLAG_CARRY;
+}
+
+/* ccf          [1  |     4] [- 0 0 C] */
+void LR35902::ccf()
+{
+    uint8 f = this->flags();
+    this->r.f = (f & LR35902_FLAG_ZERO) | ((f ^ LR35902_FLAG_CARRY) & LR35902_FLAG_CARRY);
+}
+
+/*********************************************************************************************************************\
+| 16 Bit Load Commands                                                                                                |
+\*********************************************************************************************************************/
+
+/* ld_rr_nn     [3  |    12] [- - - -] */
+void LR35902::ld_rr_nn(uint16 &reg)
+{
+    reg = this->imm;
+}
+
+/* ld_nn_sp     [3  |    20] [- - - -] */
+void LR35902::ld_nn_sp()
+{
+    this->write16(this->imm, this->rr.sp);
+}
+
+/* ldi_hl_a     [1  |     8] [- - - -] */
+void LR35902::ldi_hl_a()
+{
+    this->write8(this->rr.hl++, this->r.a);
+}
+
+/* ldi_a_hl     [1  |     8] [- - - -] */
+void LR35902::ldi_a_hl()
+{
+    this->r.a = this->read8(this->rr.hl++);
+}
+
+/* ldd_hl_a     [1  |     8] [- - - -] */
+void LR35902::ldd_hl_a()
+{
+    this->write8(this->rr.hl--, this->r.a);
+}
+
+/* ldd_a_hl     [1  |     8] [- - - -] */
+void LR35902::ldd_a_hl()
+{
+    this->r.a = this->read8(this->rr.hl--);
+}
+
+/* ldhl_sp_n    [2  |    12] [0 0 H C] */
+void LR35902::ldhl_sp_n()
+{
+    uint8 n = (uint8)this->imm;
+    STORE_FLAGS(CALC_Z_N_H_C(0, 0, ((this->rr.sp & 0x0F) + (n & 0x0F)) > 0x0F, ((this->rr.sp & 0xFF) + n) > 0xFF));
+    this->rr.hl = (uint16)(this->rr.sp + (int8)n);
+}
+
+/* ld_sp_hl     [1  |     8] [- - - -] */
+void LR35902::ld_sp_hl()
+{
+    this->rr.sp = HL;
+}
+
+/* pop_rr       [1  |    12] [- - - -] */
+void LR35902::pop_rr(uint16 &reg)
+{
+    this->flags();
+    reg = this->pop16();
+    if (&reg == &this->rr.af) {
+        this->r.f &= 0xF0;
+    }
+}
+
+/* push_rr      [1  |    12] [- - - -] */
+void LR35902::push_rr(uint16 &reg)
+{
+    this->flags();
+    this->push16(reg);
+}
+
+/*********************************************************************************************************************\
+| 16 Bit Arithmetic Commands                                                                                          |
+\*********************************************************************************************************************/
+
+/* add_hl_rr    [1  |     8] [- 0 H C] */
+void LR35902::add_hl_rr(uint16 &reg)
+{
+    uint16 hl = this->rr.hl;
+    uint32 res = hl + reg;
+    this->r.f = (this->flags() & LR35902_FLAG_ZERO)
+              | CALC_Z_N_H_C(0, 0, ((hl & 0x0FFF) + (reg & 0x0FFF)) > 0x0FFF, res > 0xFFFF);
+    this->rr.hl = (uint16)res;
+}
+
+/* add_sp_n     [2  |    16] [0 0 H C] */
+void LR35902::add_sp_n()
+{
+    uint8 n = (uint8)this->imm;
+    STORE_FLAGS(CALC_Z_N_H_C(0, 0, ((this->rr.sp & 0x0F) + (n & 0x0F)) > 0x0F, ((this->rr.sp & 0xFF) + n) > 0xFF));
+    this->rr.sp += (int8)n;
+}
+
+/* inc_rr       [1  |     8] [- - - -] */
+void LR35902::inc_rr(uint16 &reg)
+{
+    ++reg;
+}
+
+/* dec_rr       [1  |     8] [Z 0 H -] */
+void LR35902::dec_rr(uint16 &reg)
+{
+    --reg;
+}
+
+/*********************************************************************************************************************\
+| CBX Commands                                                                                                        |
+\*********************************************************************************************************************/
+
+/* rlc_r        [2  |     8] [Z 0 0 C] */
+void LR35902::rlc_r(uint8 &reg)
+{
+    uint8 out = reg >> 7;
+    reg = (uint8)((reg << 1) | out);
+    SET_FLAGS(LR35902_LAZY_ROT, 0, 0, 0, (out << 8) | reg);
+}
+
+/* rl_r         [2  |     8] [Z 0 0 C] */
+void LR35902::rl_r(uint8 &reg)
+{
+    uint16 res = (reg << 1) | this->carry();
+    SET_FLAGS(LR35902_LAZY_ROT, 0, 0, 0, res);
+    reg = (uint8)res;
+}
+
+/* rrc_r        [2  |     8] [Z 0 0 C] */
+void LR35902::rrc_r(uint8 &reg)
+{
+    uint8 out = reg & 0x01;
+    reg = (uint8)((reg >> 1) | (out << 7));
+    SET_FLAGS(LR35902_LAZY_ROT, 0, 0, 0, (out << 8) | reg);
+}
+
+/* rr_r         [2  |     8] [Z 0 0 C] */
+void LR35902::rr_r(uint8 &reg)
+{
+    uint8 out = reg & 0x01;
+    reg = (uint8)((reg >> 1) | (this->carry() << 7));
+    SET_FLAGS(LR35902_LAZY_ROT, 0, 0, 0, (out << 8) | reg);
+}
+
+/* sla_r        [2  |     8] [Z 0 0 C] */
+void LR35902::sla_r(uint8 &reg)
+{
+    uint16 res = reg << 1;
+    SET_FLAGS(LR35902_LAZY_ROT, 0, 0, 0, res);
+    reg = (uint8)res;
+}
+
+/* sra_r        [2  |     8] [Z 0 0 C] */
+void LR35902::sra_r(uint8 &reg)
+{
+    uint8 out = reg & 0x01;
+    reg = (uint8)((reg >> 1) | (reg & 0x80));
+    SET_FLAGS(LR35902_LAZY_ROT, 0, 0, 0, (out << 8) | reg);
+}
+
+/* srl_r        [2  |     8] [Z 0 0 C] */
+void LR35902::srl_r(uint8 &reg)
+{
+    uint8 out = reg & 0x01;
+    reg >>= 1;
+    SET_FLAGS(LR35902_LAZY_ROT, 0, 0, 0, (out << 8) | reg);
+}
+
+/* swap_r       [2  |     8] [Z 0 0 0] */
+void LR35902::swap_r(uint8 &reg)
+{
+#if LR35902_ALU == LR35902_ALU_TABLE
+    uint16 entry = LR35902_ALU_SWAP[reg];
+    STORE_ALU(reg, entry);
+#else
+    reg = (uint8)((reg << 4) | (reg >> 4));
+    SET_FLAGS(LR35902_LAZY_ROT, 0, 0, 0, reg);
+#endif
+}
+
+/* bit          [2  |     8] [Z 0 1 -] */
+void LR35902::bit_b_r(uint8 bit, const uint8 &reg)
+{
+    uint8 c = this->carry();
+    SET_FLAGS(LR35902_LAZY_BIT, 0, 0, c, reg & (1 << bit));
+}
+
+/* res          [2  |     8] [- - - -] */
+void LR35902::res_b_r(const uint8 bit, uint8 &reg)
+{
+    reg &= ~(1 << bit);
+}
+
+/* set          [2  |     8] [- - - -] */
+void LR35902::set_b_r(const uint8 bit, uint8 &reg)
+{
+    reg |= (1 << bit);
+}
+
+#undef HL
+#undef TAKEN
+#undef ACCESS
+#undef SET_FLAGS
+#undef STORE_FLAGS
+#undef STORE_ALU
+#undef PRE_OP_FUNC
+
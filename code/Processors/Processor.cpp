@@ -0,0 +1,46 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#include "Processors/Processor.hpp"
+
+namespace SiNES { namespace Processors {
+    /* Constructor for a processor. */
+    Processor::Processor() {
+        this->events = 0;
+        this->raised = 0;
+        this->locked = false;
+    }
+
+    /* Destructor for a processor. */
+    Processor::~Processor() {
+    }
+
+    /* Run the processor until a cycle budget is spent or any event is raised. */
+    uint32 Processor::run(uint32 cycles) {
+        return this->runUntil(PROCESSOR_EVENT_ALL, cycles);
+    }
+
+    /* Raise events, ending the current run if it waits for them. */
+    void Processor::raiseEvents(uint32 events) {
+        this->events |= events;
+        this->raised |= events;
+    }
+
+    /* Clear raised events. */
+    void Processor::clearEvents(uint32 events) {
+        this->events &= ~events;
+    }
+
+    /* Get the raised events. */
+    uint32 Processor::pendingEvents() const {
+        return this->events;
+    }
+
+    /* Handler for an undefined op code, the processor locks up. */
+    void Processor::INVALID_OP() {
+        this->locked = true;
+        this->raiseEvents(PROCESSOR_EVENT_LOCKED);
+    }
+
+} /* END: Processors */ } /* END: SiNES */
@@ -1,33 +1,107 @@
-#include "xplat/types.hpp"
-
-namespace SiNES { namespace Processors {
-    /**
-     * The Abstract Processor class.
-     */
-    class Processor {
-    public:
-        /**
-         * Constructor for an LR35902 processor.
-         */
-        Processor();
-
-        /**
-         * Destructor for an LR35902 processor.
-         */
-        virtual ~Processor();
-
-        /**
-         * Execute the next processor level operation.
-         */
-        virtual void execOp() = 0;
-
-    protected:
-        /************************************************\
-        |* Op Code Functions                            *|
-        \************************************************/
-        virtual void INVALID_OP();
-
-    private:
-    };
-
-} /* END: Processors */ } /* END: SiNES */
+#ifndef SINES_PROCESSOR_H           /* START: HEADER GUARD */
+#define SINES_PROCESSOR_H
+
+#include "xplat/types.hpp"
+
+namespace SiNES { namespace Processors {
+    /* Events that end a run of the processor before its cycle budget is spent. */
+    #define PROCESSOR_EVENT_INTERRUPT   (0x01 << 0) // An interrupt was taken, its handler runs next.
+    #define PROCESSOR_EVENT_BREAK       (0x01 << 1) // The host asked the processor to return.
+    #define PROCESSOR_EVENT_LOCKED      (0x01 << 2) // An undefined op locked up the processor.
+    #define PROCESSOR_EVENT_ALL         0xFFFFFFFF
+
+    /* Memory held by a processor. */
+    typedef struct _PROCESSOR_MEMORY {
+        uint32  instance;   // Bytes owned by this processor alone: registers, caches and counters.
+        uint32  shared;     // Bytes of read only tables shared by every processor of its type.
+    } PROCESSOR_MEMORY;
+
+    /**
+     * The Abstract Processor class.
+     */
+    class Processor {
+    public:
+        /**
+         * Constructor for an LR35902 processor.
+         */
+        Processor();
+
+        /**
+         * Destructor for an LR35902 processor.
+         */
+        virtual ~Processor();
+
+        /**
+         * Execute the next processor level operation.
+         */
+        virtual void execOp() = 0;
+
+        /**
+         * Run the processor until a cycle budget is spent or any event is raised, see runUntil.
+         *
+         * @param cycles    [IN]        The cycle budget.
+         *
+         * @return The number of clock cycles consumed, the last block may overrun the budget.
+         */
+        uint32 run(uint32 cycles);
+
+        /**
+         * Run the processor until one of a set of events is raised or a cycle budget is spent.  Only the events
+         * raised while the run goes on end it.  Raised events also stay pending until the host clears them, but a
+         * pending event raised before the run does not end it, so calling run again after an event continues from
+         * where the processor stopped.
+         *
+         * @param events    [IN]        Mask of PROCESSOR_EVENT_* that end the run.
+         * @param cycles    [IN]        The cycle budget.
+         *
+         * @return The number of clock cycles consumed, the last block may overrun the budget.
+         */
+        virtual uint32 runUntil(uint32 events, uint32 cycles) = 0;
+
+        /**
+         * Raise events, ending the current run if it waits for them.
+         *
+         * @param events    [IN]        Mask of PROCESSOR_EVENT_* to raise.
+         */
+        void raiseEvents(uint32 events);
+
+        /**
+         * Clear raised events.
+         *
+         * @param events    [IN]        Mask of PROCESSOR_EVENT_* to clear.
+         */
+        void clearEvents(uint32 events);
+
+        /**
+         * Get the raised events.
+         *
+         * @return Mask of the raised PROCESSOR_EVENT_*.
+         */
+        uint32 pendingEvents() const;
+
+        /**
+         * Account for the memory held by the processor.  Host memory attached to its bus is not included.
+         *
+         * @param usage     [OUT]       The instance and shared bytes.
+         */
+        virtual void memoryUsage(PROCESSOR_MEMORY &usage) const = 0;
+
+    protected:
+        uint32 events; // Raised PROCESSOR_EVENT_*, left set until cleared by the host.
+        uint32 raised; // PROCESSOR_EVENT_* raised since the current run started, the ones that can end it.
+        bool   locked; // Locked up by an undefined op, no further op runs.
+
+        /************************************************\
+        |* Op Code Functions                            *|
+        \************************************************/
+        /**
+         * Handler for an undefined op code, the processor locks up and raises PROCESSOR_EVENT_LOCKED.
+         */
+        virtual void INVALID_OP();
+
+    private:
+    };
+
+} /* END: Processors */ } /* END: SiNES */
+
+#endif                              /* END: HEADER GUARD */
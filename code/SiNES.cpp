@@ -1,59 +1,64 @@
-/*
- * Copyright 2013 Jason M. Baker
- */
-
-#include "xplat/platform.hpp"
-#include "xplat/types.hpp"
-#include "Processors/Nintendo/LR35902/LR35902.hpp"
-#include <stdio.h>
-
-typedef struct _MEDIA {
-    FILE *pfImage;
-    int hasHeader;
-} MEDIA, FAR * LPMEDIA;
-
-#define BTS(BOOL) (BOOL ? "True" : "False")
-void log(char * msg, ...)
-{
-    va_list args;
-    va_start(args, msg);
-    vprintf(msg, args);
-    printf("\r\n");
-    va_end(args);
-}
-
-/**
- * Load media.
- *
- * @param szPath : usz    [IN]    The path to the image.
- *
- * @return @TODO figure out return type
- */
-MEDIA loadMedia(usz szPath)
-{
-    MEDIA newMedia = {0};
-    newMedia.pfImage = fopen((char*)szPath, "rb");
-
-    return newMedia;
-}
-
-/**
- * Entry point for the application.
- *
- * @param argv : char**     [IN]    The string argument array.
- * @param argc : int        [IN]    The number of arguments in the array.
- */
-int main(char **argv, int argc)
-{
-    char arrMediaPath[] = "chronotrigger.smc";
-    usz szMediaPath = (usz)arrMediaPath;
-    /* @TODO Argument Parsing */
-    MEDIA media = loadMedia(szMediaPath);
-
-    log("Details From Media");
-    log("media.hasHeader: %s", BTS(media.hasHeader));
-
-    //exec_op();
-
-    return 0;
-}
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#include "xplat/platform.hpp"
+#include "xplat/types.hpp"
+#include "Media/Cartridge.hpp"
+#include "Media/Media.hpp"
+#include "Processors/Nintendo/LR35902/LR35902.hpp"
+#include <stdio.h>
+
+#define BTS(BOOL) (BOOL ? "True" : "False")
+void log(const char * msg, ...)
+{
+    va_list args;
+    va_start(args, msg);
+    vprintf(msg, args);
+    printf("\r\n");
+    va_end(args);
+}
+
+/**
+ * Entry point for the application.
+ *
+ * @param argc : int        [IN]    The number of arguments in the array.
+ * @param argv : char**     [IN]    The string argument array, argv[1] is the path to the image and the optional
+ *                                  argv[2] the path to an IPS or BPS patch.
+ */
+int main(int argc, char **argv)
+{
+    char arrMediaPath[] = "chronotrigger.smc";
+    usz szMediaPath = (argc > 1) ? (usz)argv[1] : (usz)arrMediaPath;
+    MEDIA media = (argc > 2) ? loadPatchedMedia(szMediaPath, (usz)argv[2], 0)
+                             : loadMediaEx(szMediaPath, MEDIA_LOAD_LAZY);
+    CARTRIDGE cart;
+    int hasCart = analyzeCartridge(&media, &cart);
+
+    log("Details From Media");
+    log("media.hasHeader: %s", BTS(media.hasHeader));
+    log("media.size: %u", media.size);
+    log("media.format: %d", media.format);
+    log("media.loadMs: %.3f", media.loadMs);
+    if (hasCart) {
+        log("cart.title: %s", cart.title);
+        log("cart.map: %s (score %d)", cartridgeMapName(cart.map), cart.score);
+        log("cart.romSize: %u", cart.romSize);
+        log("cart.ramSize: %u", cart.ramSize);
+        log("cart.checksum: %04X/%04X", cart.checksum, cart.complement);
+        log("cart.resetVector: %04X", cart.resetVector);
+    }
+    log("media.ready: %u", media.ready);
+    log("media.resident: %u", mediaResident(&media));
+
+    SiNES::Processors::Nintendo::LR35902 cpu;
+    SiNES::Processors::PROCESSOR_MEMORY usage;
+    cpu.memoryUsage(usage);
+    log("cpu.instanceBytes: %u", usage.instance);
+    log("cpu.sharedBytes: %u", usage.shared);
+
+    //exec_op();
+
+    unloadMedia(&media);
+    return 0;
+}
@@ -1,4 +1,4 @@
-/*
- * Copyright 2013 Jason M. Baker
- */
-
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
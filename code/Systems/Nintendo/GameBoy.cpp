@@ -0,0 +1,113 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#include <new>
+#include <string.h>
+#include "Systems/Nintendo/GameBoy.hpp"
+
+using SiNES::Processors::Nintendo::LR35902;
+
+namespace SiNES { namespace Systems { namespace Nintendo {
+    /* Upper bound of the arena, the processor and its block cache, the RAM, framebuffer and audio ring. */
+    #define GAMEBOY_ARENA_SIZE  (sizeof(LR35902) + sizeof(SiNES::Processors::Nintendo::LR35902_BLOCK_CACHE) \
+                                 + sizeof(GAMEBOY_RAM) + GAMEBOY_SCREEN_WIDTH * GAMEBOY_SCREEN_HEIGHT * 4 \
+                                 + sizeof(GAMEBOY_AUDIO) + 8 * ARENA_ALIGN)
+
+    /* Constructor for a session without a title. */
+    GameBoy::GameBoy() {
+        this->pTitle = NULL;
+        this->cpu = NULL;
+        this->ram = NULL;
+        this->framebuffer = NULL;
+        this->audio = NULL;
+    }
+
+    /* Destructor for a session. */
+    GameBoy::~GameBoy() {
+        this->unload();
+    }
+
+    /* Start a session of a title. */
+    bool GameBoy::load(usz szPath, usz szPatch, bool hugePages) {
+        this->unload();
+        this->pTitle = acquireTitle(szPath, szPatch);
+        if (NULL == this->pTitle || !this->arena.create((uint32)GAMEBOY_ARENA_SIZE, hugePages)) {
+            this->unload();
+            return false;
+        }
+
+        /* The processor goes first so its registers, counters and page table lead the arena. */
+        this->cpu = new (this->arena.alloc(sizeof(LR35902))) LR35902(&this->arena);
+        this->ram = (GAMEBOY_RAM *)this->arena.alloc(sizeof(GAMEBOY_RAM));
+        this->framebuffer = (uint32 *)this->arena.alloc(GAMEBOY_SCREEN_WIDTH * GAMEBOY_SCREEN_HEIGHT * 4);
+        this->audio = (GAMEBOY_AUDIO *)this->arena.alloc(sizeof(GAMEBOY_AUDIO));
+
+        /* ROM from the title, RAM from the arena, echo RAM mirrors work RAM. */
+        SiNES::Memory::Bus &bus = this->cpu->getBus();
+        this->cpu->attachRom(this->pTitle->media.image, this->pTitle->media.size);
+        bus.map(0x80, 0x60, this->ram->vram, true);
+        bus.map(0xE0, 0x1E, this->ram->wram, true);
+        bus.map(0xFE, 0x02, this->ram->oam, true);
+        return true;
+    }
+
+    /* End the session. */
+    void GameBoy::unload() {
+        if (NULL != this->cpu) {
+            this->cpu->~LR35902();
+        }
+        this->arena.destroy();
+        if (NULL != this->pTitle) {
+            releaseTitle(this->pTitle);
+        }
+        this->pTitle = NULL;
+        this->cpu = NULL;
+        this->ram = NULL;
+        this->framebuffer = NULL;
+        this->audio = NULL;
+    }
+
+    /* Get the processor of the session. */
+    LR35902 *GameBoy::getCpu() {
+        return this->cpu;
+    }
+
+    /* Get the framebuffer. */
+    uint32 *GameBoy::getFramebuffer() {
+        return this->framebuffer;
+    }
+
+    /* Get the size of a snapshot. */
+    uint32 GameBoy::snapshotSize() const {
+        return this->arena.used();
+    }
+
+    /* Copy the whole mutable state of the session. */
+    void GameBoy::snapshot(void *snapshot) const {
+        this->arena.snapshot(snapshot);
+    }
+
+    /* Return the session to a snapshot taken from it. */
+    void GameBoy::restore(const void *snapshot) {
+        this->arena.restore(snapshot);
+        this->cpu->restored();
+    }
+
+    /* Account for the memory held by the session. */
+    void GameBoy::memoryUsage(GAMEBOY_MEMORY &usage) const {
+        SiNES::Processors::PROCESSOR_MEMORY cpuUsage;
+        memset(&usage, 0x00, sizeof(usage));
+        if (NULL == this->cpu) {
+            return;
+        }
+        this->cpu->memoryUsage(cpuUsage);
+
+        /* Processor memory outside the arena is translated code. */
+        usage.instance = this->arena.used() + cpuUsage.instance
+                         - (uint32)(sizeof(LR35902) + sizeof(SiNES::Processors::Nintendo::LR35902_BLOCK_CACHE));
+        usage.arena = this->arena.capacity();
+        usage.shared = cpuUsage.shared + titleBytes(this->pTitle);
+    }
+
+} /* END: Nintendo */ } /* END: Systems */ } /* END: SiNES */
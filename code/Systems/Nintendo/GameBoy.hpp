@@ -0,0 +1,138 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#ifndef SINES_GAMEBOY_H             /* START: HEADER GUARD */
+#define SINES_GAMEBOY_H
+
+#include "xplat/types.hpp"
+#include "Media/Title.hpp"
+#include "Memory/Arena.hpp"
+#include "Processors/Nintendo/LR35902/LR35902.hpp"
+
+namespace SiNES { namespace Systems { namespace Nintendo {
+    /* Screen and audio dimensions. */
+    #define GAMEBOY_SCREEN_WIDTH        160
+    #define GAMEBOY_SCREEN_HEIGHT       144
+    #define GAMEBOY_AUDIO_FRAMES        4096    // Stereo frames in the audio ring, a power of 2.
+
+    /* Memory of a session behind 0x8000-0xFFFF, in address order. */
+    typedef struct _GAMEBOY_RAM {
+        uint8   vram[0x2000];   // 0x8000 Video RAM.
+        uint8   sram[0x2000];   // 0xA000 Cartridge RAM.
+        uint8   wram[0x2000];   // 0xC000 Work RAM, mirrored at 0xE000-0xFDFF.
+        uint8   oam[0xA0];      // 0xFE00 Sprite attributes.
+        uint8   unused[0x60];   // 0xFEA0 Not usable.
+        uint8   io[0x80];       // 0xFF00 I/O registers, the APU wave RAM at 0xFF30.
+        uint8   hram[0x80];     // 0xFF80 High RAM, IE at 0xFFFF.
+    } GAMEBOY_RAM;
+
+    /* Audio ring written by the APU and drained by the host. */
+    typedef struct _GAMEBOY_AUDIO {
+        uint32  write;          // Frames written.
+        uint32  read;           // Frames read.
+        int16   samples[GAMEBOY_AUDIO_FRAMES * 2];
+    } GAMEBOY_AUDIO;
+
+    /* Memory held by a session. */
+    typedef struct _GAMEBOY_MEMORY {
+        uint32  instance;       // Bytes of the session arena in use and any translated code.
+        uint32  arena;          // Bytes committed to the session arena.
+        uint32  shared;         // Bytes of the title and processor tables shared with every session.
+    } GAMEBOY_MEMORY;
+
+    /**
+     * A Game Boy session.
+     *
+     * All mutable state (the processor with its registers, cycle counter and page table first, then its decoded
+     * block cache, the RAM, the framebuffer and the audio ring) is carved out of one arena.  The ROM image
+     * is the title's, shared with every other session running it.  A snapshot is one copy of the arena.
+     */
+    class GameBoy {
+    public:
+        /**
+         * Constructor for a session without a title.
+         */
+        GameBoy();
+
+        /**
+         * Destructor for a session, releasing its title.
+         */
+        ~GameBoy();
+
+        /**
+         * Start a session of a title.
+         *
+         * @param szPath    [IN]        The path to the image.
+         * @param szPatch   [IN]        The path to an IPS or BPS patch, NULL for none.
+         * @param hugePages [IN]        True to back the session arena with huge pages.
+         *
+         * @return True if the title was loaded and the arena committed.
+         */
+        bool load(usz szPath, usz szPatch, bool hugePages);
+
+        /**
+         * End the session, releasing its arena and title.
+         */
+        void unload();
+
+        /**
+         * Get the processor of the session.
+         *
+         * @return The processor, NULL without a title.
+         */
+        SiNES::Processors::Nintendo::LR35902 *getCpu();
+
+        /**
+         * Get the framebuffer, GAMEBOY_SCREEN_WIDTH * GAMEBOY_SCREEN_HEIGHT 32 bit pixels.
+         *
+         * @return The framebuffer, NULL without a title.
+         */
+        uint32 *getFramebuffer();
+
+        /**
+         * Get the size of a snapshot.
+         *
+         * @return The bytes a snapshot needs.
+         */
+        uint32 snapshotSize() const;
+
+        /**
+         * Copy the whole mutable state of the session.
+         *
+         * @param snapshot  [OUT]       snapshotSize() bytes to copy the state to.
+         */
+        void snapshot(void *snapshot) const;
+
+        /**
+         * Return the session to a snapshot taken from it.
+         *
+         * @param snapshot  [IN]        A snapshot of this session.
+         */
+        void restore(const void *snapshot);
+
+        /**
+         * Account for the memory held by the session.
+         *
+         * @param usage     [OUT]       The instance, arena and shared bytes.
+         */
+        void memoryUsage(GAMEBOY_MEMORY &usage) const;
+
+    private:
+        SiNES::Memory::Arena    arena;  // All mutable state of the session.
+        LPTITLE                 pTitle; // The shared title.
+
+        /* Allocations in the arena, in arena order. */
+        SiNES::Processors::Nintendo::LR35902   *cpu;
+        GAMEBOY_RAM                            *ram;
+        uint32                                 *framebuffer;
+        GAMEBOY_AUDIO                          *audio;
+
+        /* Sessions own their arena, they are not copied. */
+        GameBoy(const GameBoy &);
+        GameBoy &operator=(const GameBoy &);
+    };
+
+} /* END: Nintendo */ } /* END: Systems */ } /* END: SiNES */
+
+#endif                              /* END: HEADER GUARD */
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#include <string.h>
+#include "Tests/Test.hpp"
+#include "Memory/Arena.hpp"
+
+using SiNES::Memory::Arena;
+
+/* Size of the arenas of the checks, not a multiple of ARENA_ALIGN. */
+#define ARENA_CHECK_SIZE        10000
+
+/* Allocations start on ARENA_ALIGN and are zero filled, an allocation past the end returns NULL and leaves the
+   arena as it was, an arena asked for huge pages falls back to whatever backing the host grants, and a restored
+   snapshot puts back the bytes allocated. */
+uint32 testArena()
+{
+    uint32 failures = 0;
+    Arena arena;
+    TEST_CHECK(NULL == arena.alloc(1));
+
+    TEST_CHECK(arena.create(ARENA_CHECK_SIZE, false));
+    TEST_CHECK(ARENA_PAGES_NORMAL == arena.pages() && ARENA_CHECK_SIZE == arena.capacity());
+    uint8 *first = (uint8 *)arena.alloc(3);
+    uint8 *second = (uint8 *)arena.alloc(ARENA_ALIGN + 1);
+    uint8 *third = (uint8 *)arena.alloc(1);
+    TEST_CHECK(NULL != first && NULL != second && NULL != third);
+    TEST_CHECK(0 == ((size_t)first & (ARENA_ALIGN - 1)) && 0 == ((size_t)second & (ARENA_ALIGN - 1)));
+    TEST_CHECK(0 == ((size_t)third & (ARENA_ALIGN - 1)));
+    TEST_CHECK(first + ARENA_ALIGN == second && second + 2 * ARENA_ALIGN == third);
+    TEST_CHECK(3 * ARENA_ALIGN + 1 == arena.used());
+    TEST_CHECK(0x00 == first[0] && 0x00 == second[ARENA_ALIGN] && 0x00 == third[0]);
+
+    /* The rest of the arena fits exactly once, past that every allocation fails. */
+    uint32 rest = ARENA_CHECK_SIZE - 4 * ARENA_ALIGN;
+    TEST_CHECK(NULL == arena.alloc(rest + 1));
+    TEST_CHECK(3 * ARENA_ALIGN + 1 == arena.used());
+    uint8 *last = (uint8 *)arena.alloc(rest);
+    TEST_CHECK(NULL != last && ARENA_CHECK_SIZE == arena.used());
+    if (NULL == last) {
+        return failures;
+    }
+    TEST_CHECK(NULL == arena.alloc(1));
+    last[rest - 1] = 0x5A;
+
+    /* A snapshot is the used bytes, restoring puts back what was written since. */
+    static uint8 snapshot[ARENA_CHECK_SIZE];
+    first[0] = 0x11;
+    arena.snapshot(snapshot);
+    first[0] = 0x22;
+    last[rest - 1] = 0x33;
+    arena.restore(snapshot);
+    TEST_CHECK(0x11 == first[0] && 0x5A == last[rest - 1]);
+
+    /* Huge pages round the arena up to a huge page and are used if granted, advised or not at all otherwise. */
+    TEST_CHECK(arena.create(ARENA_CHECK_SIZE, true));
+    TEST_CHECK(ARENA_HUGE_PAGE_SIZE == arena.capacity() && 0 == arena.used());
+    TEST_CHECK(ARENA_PAGES_NORMAL == arena.pages() || ARENA_PAGES_TRANSPARENT == arena.pages()
+               || ARENA_PAGES_HUGE == arena.pages());
+    uint8 *huge = (uint8 *)arena.alloc(ARENA_HUGE_PAGE_SIZE);
+    TEST_CHECK(NULL != huge && 0x00 == huge[ARENA_HUGE_PAGE_SIZE - 1]);
+
+    arena.destroy();
+    TEST_CHECK(NULL == arena.alloc(1) && 0 == arena.capacity() && 0 == arena.used());
+    return failures;
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#include <string.h>
+#include "Tests/Test.hpp"
+#include "Memory/Bus.hpp"
+
+using SiNES::Memory::Bus;
+
+/* Accesses seen by the handlers of the bus checks. */
+typedef struct _BUS_LOG {
+    uint32  reads;
+    uint32  writes;
+    uint16  addr;       // Address of the last access.
+    uint8   value;      // Value of the last write.
+    uint32  watches;
+    uint8   page;       // Page of the last watch.
+    Bus    *bus;        // Unwatched by the watch handler.
+} BUS_LOG;
+
+static uint8 logRead(void *context, uint16 addr)
+{
+    BUS_LOG *log = (BUS_LOG *)context;
+    ++log->reads;
+    log->addr = addr;
+    return (uint8)(addr ^ 0x5A);
+}
+
+static void logWrite(void *context, uint16 addr, uint8 value)
+{
+    BUS_LOG *log = (BUS_LOG *)context;
+    ++log->writes;
+    log->addr = addr;
+    log->value = value;
+}
+
+static void logWatch(void *context, uint8 page)
+{
+    BUS_LOG *log = (BUS_LOG *)context;
+    ++log->watches;
+    log->page = page;
+    log->bus->unwatch(page);
+}
+
+/* ROM drops writes, RAM takes them on the fast path, handler pages and pages without memory take the slow path,
+   and a watched page calls the watch handler once for a write through any of its mirrors, or before other memory
+   is mapped over it. */
+uint32 testBus()
+{
+    uint32 failures = 0;
+    static uint8 rom[0x8000];
+    static uint8 ram[0x2000];
+    static uint8 bank[0x4000];
+    BUS_LOG log;
+    memset(&log, 0x00, sizeof(log));
+    for (uint32 i = 0; i < sizeof(rom); ++i) {
+        rom[i] = (uint8)i;
+    }
+    memset(ram, 0x00, sizeof(ram));
+    memset(bank, 0xB0, sizeof(bank));
+
+    Bus bus;
+    log.bus = &bus;
+    TEST_CHECK(BUS_OPEN_BUS == bus.read8(0x1234));
+    bus.write8(0x1234, 0x00);
+    TEST_CHECK(NULL == bus.readPage(0x12) && NULL == bus.writePage(0x12));
+
+    bus.map(0x00, 0x80, rom, false);
+    bus.map(0xC0, 0x20, ram, true);
+    bus.map(0xE0, 0x1E, ram, true);
+    bus.mapHandlers(0xFF, 1, &logRead, &logWrite, &log);
+    TEST_CHECK(0x34 == bus.read8(0x1234) && rom + 0x1200 == bus.readPage(0x12));
+    bus.write8(0x1234, 0x00);
+    TEST_CHECK(0x34 == rom[0x1234] && NULL == bus.writePage(0x12));
+    bus.write8(0xC010, 0x42);
+    TEST_CHECK(0x42 == ram[0x0010] && 0x42 == bus.read8(0xE010) && ram == bus.writePage(0xC0));
+
+    /* Bank switching re-points the pages. */
+    bus.map(0x40, 0x40, bank, false);
+    TEST_CHECK(0xB0 == bus.read8(0x4000) && 0xFF == bus.read8(0x3FFF));
+
+    TEST_CHECK((uint8)(0xFF44 ^ 0x5A) == bus.read8(0xFF44) && 1 == log.reads && 0xFF44 == log.addr);
+    bus.write8(0xFF46, 0x99);
+    TEST_CHECK(1 == log.writes && 0xFF46 == log.addr && 0x99 == log.value);
+    TEST_CHECK(NULL == bus.readPage(0xFF) && NULL == bus.writePage(0xFF));
+
+    /* Watching a page watches its mirror, the first write through either calls the handler once. */
+    bus.setWatchHandler(&logWatch, &log);
+    bus.watch(0xC1);
+    TEST_CHECK(NULL == bus.writePage(0xC1) && NULL == bus.writePage(0xE1) && NULL != bus.writePage(0xC0));
+    TEST_CHECK(NULL != bus.readPage(0xC1));
+    bus.write8(0xE101, 0x77);
+    bus.write8(0xC102, 0x78);
+    TEST_CHECK(1 == log.watches && 0xE1 == log.page);
+    TEST_CHECK(0x77 == ram[0x0101] && 0x78 == ram[0x0102]);
+    TEST_CHECK(ram + 0x0100 == bus.writePage(0xC1) && ram + 0x0100 == bus.writePage(0xE1));
+
+    /* Mapping over a watched page calls the handler before the memory changes, and leaves the page unwatched. */
+    bus.watch(0xC2);
+    bus.map(0xC2, 1, bank, true);
+    TEST_CHECK(2 == log.watches && 0xC2 == log.page);
+    TEST_CHECK(bank == bus.writePage(0xC2) && ram + 0x0200 == bus.writePage(0xE2));
+    bus.write8(0xC200, 0x79);
+    TEST_CHECK(2 == log.watches && 0x79 == bank[0x0000]);
+    return failures;
+}
+
+#define BUS_BENCH_ACCESSES      0x04000000
+
+/* Sum of the bytes read by the benchmark, kept so the reads are not optimized away. */
+static volatile uint32 benchSum = 0;
+
+/* Measure the accesses per second of the bus over a range of addresses, reading or writing every byte in turn. */
+static void benchAccesses(const char *path, Bus &bus, uint16 base, uint16 size, bool write)
+{
+    uint32 sum = 0;
+    double start = BENCH_CLOCK_MS();
+    for (uint32 i = 0; i < BUS_BENCH_ACCESSES; ++i) {
+        uint16 addr = (uint16)(base + (i & (size - 1)));
+        if (write) {
+            bus.write8(addr, (uint8)i);
+        } else {
+            sum += bus.read8(addr);
+        }
+    }
+    double ms = BENCH_CLOCK_MS() - start;
+    benchSum += sum;
+    printf("bus %-10s %-6s %8.1f M/s\n", path, write ? "write" : "read", (double)BUS_BENCH_ACCESSES / ms / 1000.0);
+}
+
+/* Reads and writes per second through the page table fast path and through the handlers of an I/O page. */
+void benchBus()
+{
+    static uint8 ram[0x2000];
+    BUS_LOG log;
+    memset(&log, 0x00, sizeof(log));
+    Bus bus;
+    bus.map(0xC0, 0x20, ram, true);
+    bus.mapHandlers(0xFF, 1, &logRead, &logWrite, &log);
+    benchAccesses("fast path", bus, 0xC000, 0x2000, false);
+    benchAccesses("fast path", bus, 0xC000, 0x2000, true);
+    benchAccesses("handlers", bus, 0xFF00, 0x0080, false);
+    benchAccesses("handlers", bus, 0xFF00, 0x0080, true);
+}
+
+#undef BUS_BENCH_ACCESSES
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "Tests/Test.hpp"
+#include "Media/Cartridge.hpp"
+
+/* Size of the images of the checks: 512KB for LoROM and HiROM, 6MB for ExHiROM, 1.25MB for the checksum. */
+#define CARTRIDGE_CHECK_SIZE    0x00080000
+#define CARTRIDGE_EXHIROM_SIZE  0x00600000
+#define CARTRIDGE_MIRROR_SIZE   0x00140000
+
+static const char CARTRIDGE_TITLE[CARTRIDGE_TITLE_SIZE + 1] = "SINES CARTRIDGE CHECK";
+
+/* Write an internal header for a map at an offset, with its reset vector at $8000 pointing at a sei at an entry
+   offset, and a checksum that its complement matches. */
+static void putHeader(uint8 *image, uint32 offset, uint8 mapMode, uint32 entry)
+{
+    uint8 *header = image + offset;
+    memcpy(header + CARTRIDGE_HEADER_TITLE, CARTRIDGE_TITLE, CARTRIDGE_TITLE_SIZE);
+    header[CARTRIDGE_HEADER_MAP_MODE] = mapMode;
+    header[CARTRIDGE_HEADER_ROM_TYPE] = 0x02;               /* ROM, RAM and battery */
+    header[CARTRIDGE_HEADER_ROM_SIZE] = 0x0A;               /* 1MB */
+    header[CARTRIDGE_HEADER_RAM_SIZE] = 0x03;               /* 8KB */
+    header[CARTRIDGE_HEADER_REGION] = 0x01;
+    header[CARTRIDGE_HEADER_COMPLEMENT] = 0xCB;
+    header[CARTRIDGE_HEADER_COMPLEMENT + 1] = 0xED;
+    header[CARTRIDGE_HEADER_CHECKSUM] = 0x34;
+    header[CARTRIDGE_HEADER_CHECKSUM + 1] = 0x12;
+    header[CARTRIDGE_HEADER_RESET] = 0x00;
+    header[CARTRIDGE_HEADER_RESET + 1] = 0x80;
+    image[entry] = 0x78;                                    /* sei */
+}
+
+/* Wrap an image in media that is fully loaded. */
+static MEDIA imageMedia(const uint8 *image, uint32 size)
+{
+    MEDIA media;
+    memset(&media, 0x00, sizeof(media));
+    media.image = image;
+    media.size = size;
+    media.ready = size;
+    media.format = MEDIA_FORMAT_RAW;
+    return media;
+}
+
+/* Check a cartridge was identified with the header of putHeader. */
+static bool sameCartridge(const CARTRIDGE &cart, int map, uint32 headerOffset, uint8 mapMode)
+{
+    return map == cart.map && headerOffset == cart.headerOffset && 0 == strcmp(CARTRIDGE_TITLE, cart.title)
+           && mapMode == cart.mapMode && 0x02 == cart.romType && 0x00100000 == cart.romSize
+           && 0x2000 == cart.ramSize && 0x01 == cart.region && 0x1234 == cart.checksum
+           && 0xEDCB == cart.complement && 0x8000 == cart.resetVector;
+}
+
+/* LoROM, HiROM and ExHiROM headers are found where their maps put them, the ExHiROM one at $40FFC0 over the copy
+   of it that such cartridges keep at $FFC0, an image without a header or too small for one is not identified,
+   and the checksum mirrors the part of the image beyond the largest power of two. */
+uint32 testCartridge()
+{
+    uint32 failures = 0;
+    uint8 *image = (uint8 *)malloc(CARTRIDGE_EXHIROM_SIZE);
+    if (NULL == image) {
+        return 1;
+    }
+    CARTRIDGE cart;
+
+    memset(image, 0x00, CARTRIDGE_CHECK_SIZE);
+    putHeader(image, 0x007FC0, 0x20, 0x000000);
+    MEDIA media = imageMedia(image, CARTRIDGE_CHECK_SIZE);
+    TEST_CHECK(analyzeCartridge(&media, &cart));
+    TEST_CHECK(sameCartridge(cart, CARTRIDGE_MAP_LOROM, 0x007FC0, 0x20) && 15 == cart.score);
+    image[0x007FC0 + CARTRIDGE_HEADER_COMPLEMENT] ^= 0x01;
+    TEST_CHECK(analyzeCartridge(&media, &cart) && CARTRIDGE_MAP_LOROM == cart.map && 11 == cart.score);
+
+    memset(image, 0x00, CARTRIDGE_CHECK_SIZE);
+    putHeader(image, 0x00FFC0, 0x31, 0x008000);
+    TEST_CHECK(analyzeCartridge(&media, &cart));
+    TEST_CHECK(sameCartridge(cart, CARTRIDGE_MAP_HIROM, 0x00FFC0, 0x31) && 15 == cart.score);
+
+    /* The map mode tells a HiROM header from the copy of it at $7FC0 where LoROM would have it. */
+    putHeader(image, 0x007FC0, 0x31, 0x000000);
+    TEST_CHECK(analyzeCartridge(&media, &cart));
+    TEST_CHECK(sameCartridge(cart, CARTRIDGE_MAP_HIROM, 0x00FFC0, 0x31) && 15 == cart.score);
+
+    memset(image, 0x00, CARTRIDGE_EXHIROM_SIZE);
+    putHeader(image, 0x40FFC0, 0x25, 0x408000);
+    putHeader(image, 0x00FFC0, 0x25, 0x408000);
+    media = imageMedia(image, CARTRIDGE_EXHIROM_SIZE);
+    TEST_CHECK(analyzeCartridge(&media, &cart));
+    TEST_CHECK(sameCartridge(cart, CARTRIDGE_MAP_EXHIROM, 0x40FFC0, 0x25) && 15 == cart.score);
+
+    /* The ExHiROM header lies past the end of a 4MB image. */
+    media = imageMedia(image, 0x00400000);
+    TEST_CHECK(analyzeCartridge(&media, &cart));
+    TEST_CHECK(sameCartridge(cart, CARTRIDGE_MAP_HIROM, 0x00FFC0, 0x25) && cart.score < 15);
+
+    memset(image, 0x00, CARTRIDGE_CHECK_SIZE);
+    media = imageMedia(image, CARTRIDGE_CHECK_SIZE);
+    TEST_CHECK(!analyzeCartridge(&media, &cart) && CARTRIDGE_MAP_UNKNOWN == cart.map);
+    putHeader(image, 0x007FC0, 0x20, 0x000000);
+    media = imageMedia(image, 0x7FF0);
+    TEST_CHECK(!analyzeCartridge(&media, &cart) && CARTRIDGE_MAP_UNKNOWN == cart.map);
+
+    uint32 state = 0x2545F491;
+    for (uint32 i = 0; i < CARTRIDGE_MIRROR_SIZE; ++i) {
+        state = state * 1103515245 + 12345;
+        image[i] = (uint8)(state >> 16);
+    }
+    uint32 sum = 0;
+    for (uint32 i = 0; i < 0x00100000; ++i) {
+        sum += image[i];
+    }
+    media = imageMedia(image, 0x00100000);
+    TEST_CHECK((uint16)sum == cartridgeChecksum(&media));
+    for (uint32 i = 0x00100000; i < 0x00200000; ++i) {
+        sum += image[0x00100000 + (i - 0x00100000) % (CARTRIDGE_MIRROR_SIZE - 0x00100000)];
+    }
+    media = imageMedia(image, CARTRIDGE_MIRROR_SIZE);
+    TEST_CHECK((uint16)sum == cartridgeChecksum(&media));
+
+    free(image);
+    return failures;
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "Tests/Test.hpp"
+
+/* ROM written by the session checks into the working directory, removed when they are done. */
+#define GAMEBOY_ROM_PATH        "sines-gameboy.gb"
+#define GAMEBOY_ROM_SIZE        0x8000
+
+/* Blocks of one shape, each counting its runs in its own byte of work RAM before jumping to the next. */
+static const uint8 SESSION_BLOCK[] = {
+    0x21, 0x00, 0xC0,                   /* ld hl, 0xC000 + counter */
+    0x34,                               /* inc (hl) */
+    0xC3, 0x00, 0x00,                   /* jp next */
+};
+
+/* The blocks of the ROM, from 0x0000: the loop runs 0x0810, which keeps its place in the block cache, then 0x0200,
+   0x0400 and 0x0600, which share one and evict each other. */
+static const uint16 SESSION_BLOCKS[] = { 0x0000, 0x0810, 0x0200, 0x0400, 0x0600 };
+static const uint16 SESSION_NEXT[] = { 0x0810, 0x0200, 0x0400, 0x0600, 0x0810 };
+
+/* Returning a session to a snapshot replays it as it ran, whether its blocks run interpreted or translated. */
+uint32 testGameBoy()
+{
+    uint32 failures = 0;
+    static uint8 rom[GAMEBOY_ROM_SIZE];
+    memset(rom, 0x00, sizeof(rom));
+    for (uint32 i = 0; i < sizeof(SESSION_BLOCKS) / sizeof(SESSION_BLOCKS[0]); ++i) {
+        uint8 *block = rom + SESSION_BLOCKS[i];
+        memcpy(block, SESSION_BLOCK, sizeof(SESSION_BLOCK));
+        block[1] = (uint8)i;
+        block[5] = (uint8)SESSION_NEXT[i];
+        block[6] = (uint8)(SESSION_NEXT[i] >> 8);
+    }
+
+    FILE *file = fopen(GAMEBOY_ROM_PATH, "wb");
+    if (NULL == file) {
+        return 1;
+    }
+    bool written = sizeof(rom) == fwrite(rom, 1, sizeof(rom), file);
+    TEST_CHECK(0 == fclose(file) && written);
+    failures += checkSnapshotBlocks(GAMEBOY_ROM_PATH);
+    failures += checkSnapshotJit(GAMEBOY_ROM_PATH);
+    remove(GAMEBOY_ROM_PATH);
+    return failures;
+}
@@ -0,0 +1,15 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+/* The LR35902 core timing every data access through the access hook, eager flags and the computed ALU, see
+   LR35902Variant.cpp. */
+#undef LR35902_FLAGS
+#undef LR35902_ALU
+#undef LR35902_TIMING
+#define LR35902_FLAGS           LR35902_FLAGS_EAGER
+#define LR35902_ALU             LR35902_ALU_COMPUTED
+#define LR35902_TIMING          LR35902_TIMING_ACCESS
+#define SiNES                   SiNESAccessTimed
+#define LR35902_VARIANT(NAME)   NAME##Access
+#include "Tests/LR35902Variant.cpp"
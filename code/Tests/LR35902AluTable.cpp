@@ -0,0 +1,12 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+/* The LR35902 core with eager flags, the table driven ALU, see LR35902Variant.cpp. */
+#undef LR35902_FLAGS
+#undef LR35902_ALU
+#define LR35902_FLAGS           LR35902_FLAGS_EAGER
+#define LR35902_ALU             LR35902_ALU_TABLE
+#define SiNES                   SiNESAluTable
+#define LR35902_VARIANT(NAME)   NAME##AluTable
+#include "Tests/LR35902Variant.cpp"
@@ -0,0 +1,16 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+/* The LR35902 core running decoded blocks interpreted with eager flags, the computed ALU, see
+   LR35902Variant.cpp. */
+#undef LR35902_FLAGS
+#undef LR35902_ALU
+#undef LR35902_JIT
+#define LR35902_FLAGS           LR35902_FLAGS_EAGER
+#define LR35902_ALU             LR35902_ALU_COMPUTED
+#define LR35902_JIT             0
+#define LR35902_VARIANT_BLOCKS
+#define SiNES                   SiNESBlocks
+#define LR35902_VARIANT(NAME)   NAME##Blocks
+#include "Tests/LR35902Variant.cpp"
@@ -0,0 +1,17 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+/* The LR35902 core with eager flags, the computed ALU, the dispatch table and op timing, the reference of the
+   other variants, see LR35902Variant.cpp. */
+#undef LR35902_FLAGS
+#undef LR35902_ALU
+#undef LR35902_DISPATCH
+#undef LR35902_TIMING
+#define LR35902_FLAGS           LR35902_FLAGS_EAGER
+#define LR35902_ALU             LR35902_ALU_COMPUTED
+#define LR35902_DISPATCH        LR35902_DISPATCH_TABLE
+#define LR35902_TIMING          LR35902_TIMING_OP
+#define SiNES                   SiNESEager
+#define LR35902_VARIANT(NAME)   NAME##Eager
+#include "Tests/LR35902Variant.cpp"
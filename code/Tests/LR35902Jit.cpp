@@ -0,0 +1,20 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+/* The LR35902 core running translated blocks with eager flags, the computed ALU, see LR35902Variant.cpp.  Hosts
+   without the translator run the decoded blocks interpreted. */
+#undef LR35902_FLAGS
+#undef LR35902_ALU
+#undef LR35902_JIT
+#define LR35902_FLAGS           LR35902_FLAGS_EAGER
+#define LR35902_ALU             LR35902_ALU_COMPUTED
+#if defined(_M_X64) || defined(__x86_64__)
+    #define LR35902_JIT         1
+#else
+    #define LR35902_JIT         0
+#endif
+#define LR35902_VARIANT_BLOCKS
+#define SiNES                   SiNESJit
+#define LR35902_VARIANT(NAME)   NAME##Jit
+#include "Tests/LR35902Variant.cpp"
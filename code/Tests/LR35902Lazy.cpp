@@ -0,0 +1,12 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+/* The LR35902 core with lazy flags, the computed ALU, see LR35902Variant.cpp. */
+#undef LR35902_FLAGS
+#undef LR35902_ALU
+#define LR35902_FLAGS           LR35902_FLAGS_LAZY
+#define LR35902_ALU             LR35902_ALU_COMPUTED
+#define SiNES                   SiNESLazy
+#define LR35902_VARIANT(NAME)   NAME##Lazy
+#include "Tests/LR35902Variant.cpp"
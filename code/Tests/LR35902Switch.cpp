@@ -0,0 +1,14 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+/* The LR35902 core with eager flags, the computed ALU and the op code switch, see LR35902Variant.cpp. */
+#undef LR35902_FLAGS
+#undef LR35902_ALU
+#undef LR35902_DISPATCH
+#define LR35902_FLAGS           LR35902_FLAGS_EAGER
+#define LR35902_ALU             LR35902_ALU_COMPUTED
+#define LR35902_DISPATCH        LR35902_DISPATCH_SWITCH
+#define SiNES                   SiNESSwitch
+#define LR35902_VARIANT(NAME)   NAME##Switch
+#include "Tests/LR35902Variant.cpp"
@@ -0,0 +1,836 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#include <string.h>
+#include "Tests/Test.hpp"
+
+/* Programs and ops of the differential tests. */
+#define FLAGS_PROGRAMS          16
+#define FLAGS_ITERATIONS        2000
+#define FLAGS_RUN               4       // Most random ops between two logs.
+#define FLAGS_SKIPS             8       // One in this many ops is a conditional branch over an inc.
+#define FLAGS_LOG               0x8000  // Registers logged after each iteration, 8 bytes per iteration.
+
+/* Next value of a xorshift generator, the programs are the same on every host. */
+static uint32 nextRandom(uint32 &state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+/* Check if an op may appear in a random program: no control flow, halt, stop or interrupt state. */
+static bool randomOp(uint8 op)
+{
+    if (op < 0x40) {
+        return 0x10 != op && 0x18 != op && 0x20 != (op & 0xE7);        /* stop, jr and jr cc */
+    }
+    if (op < 0xC0) {
+        return 0x76 != op;                                              /* halt */
+    }
+    switch (op) {
+        case 0xC1: case 0xD1: case 0xE1: case 0xF1:                     /* pop rr */
+        case 0xC5: case 0xD5: case 0xE5: case 0xF5:                     /* push rr */
+        case 0xC6: case 0xCE: case 0xD6: case 0xDE:                     /* add, adc, sub, sbc n */
+        case 0xE6: case 0xEE: case 0xF6: case 0xFE:                     /* and, xor, or, cp n */
+        case 0xE0: case 0xF0: case 0xE2: case 0xF2:                     /* ldh and ld (c) */
+        case 0xEA: case 0xFA: case 0xE8: case 0xF8: case 0xCB:          /* ld (nn), add sp, ld hl,sp+n, CB */
+            return true;
+        default:
+            return false;
+    }
+}
+
+/* Length of an op allowed by randomOp, with its operand. */
+static uint32 opLength(uint8 op)
+{
+    if (0xCB == op || 0xE0 == op || 0xF0 == op || 0xE8 == op || 0xF8 == op) {
+        return 2;
+    }
+    if (0xEA == op || 0xFA == op || (op < 0x40 && 0x01 == (op & 0x0F)) || 0x08 == op) {
+        return 3;
+    }
+    if ((op < 0x40 && 0x06 == (op & 0x07)) || (op >= 0xC0 && 0x06 == (op & 0x07))) {
+        return 2;
+    }
+    return 1;
+}
+
+/* Build a program of runs of random ops, each run followed by a log of AF, BC, DE and HL pushed below its own
+   slot, and ending in a jr to itself.  Returns the number of ops, counting the ops branched over. */
+static uint32 buildProgram(uint8 *memory, uint32 seed)
+{
+    uint32 state = seed;
+    uint32 pc = 0;
+    uint32 ops = 0;
+    memset(memory, 0x00, 0x10000);
+    for (uint32 i = 0; i < FLAGS_ITERATIONS && pc + FLAGS_RUN * 4 + 9 <= 0x8000; ++i) {
+        /* Runs of ops between the logs leave deferred flags to the ops that read them. */
+        uint32 run = 1 + nextRandom(state) % FLAGS_RUN;
+        for (uint32 n = 0; n < run; ++n) {
+            if (0 == nextRandom(state) % FLAGS_SKIPS) {
+                /* jr cc or jp cc over an inc of B, C, D, E, H or L, the log shows which way it went. */
+                uint8 cc = (uint8)((nextRandom(state) & 0x03) << 3);
+                uint8 inc = (uint8)(0x04 | ((nextRandom(state) % 6) << 3));
+                if (nextRandom(state) & 0x01) {
+                    memory[pc++] = 0x20 | cc;
+                    memory[pc++] = 0x01;
+                } else {
+                    uint16 target = (uint16)(pc + 4);
+                    memory[pc++] = 0xC2 | cc;
+                    memory[pc++] = (uint8)target;
+                    memory[pc++] = (uint8)(target >> 8);
+                }
+                memory[pc++] = inc;
+                ops += 2;
+                continue;
+            }
+            uint8 op = 0;
+            do {
+                op = (uint8)nextRandom(state);
+            } while (!randomOp(op));
+            uint32 length = opLength(op);
+            memory[pc++] = op;
+            for (uint32 b = 1; b < length; ++b) {
+                memory[pc++] = (uint8)nextRandom(state);
+            }
+            ++ops;
+        }
+        ops += 5;
+
+        uint16 slot = (uint16)(FLAGS_LOG + 8 * (i + 1));
+        memory[pc++] = 0x31;                                            /* ld sp, slot */
+        memory[pc++] = (uint8)slot;
+        memory[pc++] = (uint8)(slot >> 8);
+        memory[pc++] = 0xF5;                                            /* push af */
+        memory[pc++] = 0xC5;                                            /* push bc */
+        memory[pc++] = 0xD5;                                            /* push de */
+        memory[pc++] = 0xE5;                                            /* push hl */
+    }
+    memory[pc++] = 0x18;                                                /* jr to itself */
+    memory[pc++] = 0xFE;
+    return ops;
+}
+
+/* Compare the memory left by a variant against the reference and report the first iteration that differs. */
+static bool sameTrace(const char *variant, uint32 seed, const uint8 *reference, const uint8 *memory)
+{
+    for (uint32 addr = 0x8000; addr < 0x10000; ++addr) {
+        if (reference[addr] != memory[addr]) {
+            printf("%s: program %u differs at 0x%04X (iteration %u): 0x%02X, expected 0x%02X\n", variant, seed,
+                   addr, (addr - FLAGS_LOG) / 8, memory[addr], reference[addr]);
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Random programs give the same registers, flags and memory with eager and lazy flags and the table ALU. */
+uint32 testLR35902Flags()
+{
+    uint32 failures = 0;
+    static uint8 program[0x10000];
+    static uint8 reference[0x10000];
+    static uint8 memory[0x10000];
+    for (uint32 seed = 1; seed <= FLAGS_PROGRAMS; ++seed) {
+        uint32 ops = buildProgram(program, seed * 0x9E3779B9);
+        memcpy(reference, program, sizeof(program));
+        traceEager(reference, ops);
+
+        memcpy(memory, program, sizeof(program));
+        traceLazy(memory, ops);
+        TEST_CHECK(sameTrace("lazy flags", seed, reference, memory));
+
+        memcpy(memory, program, sizeof(program));
+        traceAluTable(memory, ops);
+        TEST_CHECK(sameTrace("table ALU", seed, reference, memory));
+    }
+    return failures;
+}
+
+/* Random programs give the same registers, flags and memory through the op code switch as through the dispatch
+   table. */
+uint32 testLR35902Dispatch()
+{
+    uint32 failures = 0;
+    static uint8 program[0x10000];
+    static uint8 reference[0x10000];
+    static uint8 memory[0x10000];
+    for (uint32 seed = 1; seed <= FLAGS_PROGRAMS; ++seed) {
+        uint32 ops = buildProgram(program, seed * 0x9E3779B9);
+        memcpy(reference, program, sizeof(program));
+        traceEager(reference, ops);
+
+        memcpy(memory, program, sizeof(program));
+        traceSwitch(memory, ops);
+        TEST_CHECK(sameTrace("switch dispatch", seed, reference, memory));
+    }
+    return failures;
+}
+
+/* Random programs give the same registers, flags and memory through interpreted and translated blocks as op by
+   op. */
+uint32 testLR35902Jit()
+{
+    uint32 failures = 0;
+    static uint8 program[0x10000];
+    static uint8 reference[0x10000];
+    static uint8 memory[0x10000];
+    for (uint32 seed = 1; seed <= FLAGS_PROGRAMS; ++seed) {
+        uint32 ops = buildProgram(program, seed * 0x9E3779B9);
+        memcpy(reference, program, sizeof(program));
+        traceEager(reference, ops);
+
+        memcpy(memory, program, sizeof(program));
+        traceBlocks(memory, ops);
+        TEST_CHECK(sameTrace("blocks", seed, reference, memory));
+
+        memcpy(memory, program, sizeof(program));
+        traceJit(memory, ops);
+        TEST_CHECK(sameTrace("jit", seed, reference, memory));
+
+        memcpy(memory, program, sizeof(program));
+        traceJitLazy(memory, ops);
+        TEST_CHECK(sameTrace("jit lazy flags", seed, reference, memory));
+    }
+    return failures;
+}
+
+/* Ops with memory operands, conditional branches taken and not, calls and returns, with the clock cycles of each. */
+static const uint8 TIMING_PROGRAM[] = {
+    0x31, 0x00, 0xD0,                   /* 0x0000: ld sp, 0xD000        12 */
+    0x06, 0x02,                         /* 0x0003: ld b, 0x02            8 */
+    0x05, 0x20, 0xFD,                   /* 0x0005: dec b; jr nz, 0x0005  4 + 12, then 4 + 8 */
+    0xCD, 0x10, 0x00,                   /* 0x0008: call 0x0010          24 */
+    0x18, 0xFE,                         /* 0x000B: jr 0x000B */
+};
+static const uint8 TIMING_CALL[] = {
+    0x21, 0x00, 0xC0,                   /* 0x0010: ld hl, 0xC000        12 */
+    0x34, 0xCB, 0x46, 0xCB, 0x16,       /* 0x0013: inc (hl); bit 0, (hl); rl (hl)   12 + 12 + 16 */
+    0xC5, 0xE1,                         /* 0x0018: push bc; pop hl      16 + 12 */
+    0xC8, 0xC9,                         /* 0x001A: ret z; ret           8 + 16 */
+};
+#define TIMING_OPS              15
+#define TIMING_CYCLES           176
+
+/* Check the memory left by the timing program. */
+static bool timingRan(const uint8 *memory)
+{
+    return 0x02 == memory[0xC000] && 0x0B == memory[0xCFFE] && 0x00 == memory[0xCFFF];
+}
+
+/* Every op takes the clock cycles of its row in the timing tables, with the taken cycles of a taken branch, when
+   counted once per op and when the accesses are timed. */
+uint32 testLR35902Timing()
+{
+    uint32 failures = 0;
+    static uint8 program[0x10000];
+    static uint8 memory[0x10000];
+    memset(program, 0x00, sizeof(program));
+    memcpy(program, TIMING_PROGRAM, sizeof(TIMING_PROGRAM));
+    memcpy(program + 0x10, TIMING_CALL, sizeof(TIMING_CALL));
+
+    memcpy(memory, program, sizeof(program));
+    TEST_CHECK(TIMING_CYCLES == traceEager(memory, TIMING_OPS));
+    TEST_CHECK(timingRan(memory));
+
+    memcpy(memory, program, sizeof(program));
+    TEST_CHECK(TIMING_CYCLES == traceAccess(memory, TIMING_OPS));
+    TEST_CHECK(timingRan(memory));
+
+    memcpy(memory, program, sizeof(program));
+    traceUntimed(memory, TIMING_OPS);
+    TEST_CHECK(timingRan(memory));
+    return failures;
+}
+
+/* ei takes effect after the next op, then the highest priority interrupt enabled in IE is taken: its IF bit is
+   cleared, the PC pushed and its handler run.  The handler logs B and IF. */
+static const uint8 INTERRUPT_PROGRAM[] = {
+    0x31, 0x00, 0xD0,                   /* 0x0000: ld sp, 0xD000 */
+    0x3E, 0x04, 0xE0, 0xFF,             /* 0x0003: ld a, 0x04; ldh (0xFF), a    IE: timer */
+    0x3E, 0x05, 0xE0, 0x0F,             /* 0x0007: ld a, 0x05; ldh (0x0F), a    IF: timer and vblank */
+    0xFB,                               /* 0x000B: ei */
+    0x04, 0x04,                         /* 0x000C: inc b; inc b */
+    0x18, 0xFE,                         /* 0x000E: jr 0x000E */
+};
+static const uint8 INTERRUPT_VBLANK[] = {
+    0x3E, 0xFF, 0xEA, 0x02, 0xC0,       /* 0x0040: ld a, 0xFF; ld (0xC002), a */
+    0x18, 0xFE,                         /* 0x0045: jr 0x0045 */
+};
+static const uint8 INTERRUPT_TIMER[] = {
+    0x78, 0xEA, 0x00, 0xC0,             /* 0x0050: ld a, b; ld (0xC000), a */
+    0xF0, 0x0F, 0xEA, 0x01, 0xC0,       /* 0x0054: ldh a, (0x0F); ld (0xC001), a */
+    0x18, 0xFE,                         /* 0x0059: jr 0x0059 */
+};
+#define INTERRUPT_OPS           40
+
+/* Check the memory left by the interrupt program. */
+static bool interruptTaken(const char *variant, const uint8 *memory)
+{
+    bool taken = 0x01 == memory[0xC000]                                 /* after the first inc b */
+                 && 0x01 == memory[0xC001]                              /* vblank is left requested */
+                 && 0x00 == memory[0xC002]                              /* and was not taken */
+                 && 0x0D == memory[0xCFFE] && 0x00 == memory[0xCFFF];   /* returns to the second inc b */
+    if (!taken) {
+        printf("%s: B 0x%02X, IF 0x%02X, vblank 0x%02X, return 0x%02X%02X\n", variant, memory[0xC000],
+               memory[0xC001], memory[0xC002], memory[0xCFFF], memory[0xCFFE]);
+    }
+    return taken;
+}
+
+/* Interrupts are taken op by op and between blocks, where each ends the run it is taken in. */
+uint32 testLR35902Interrupts()
+{
+    uint32 failures = 0;
+    static uint8 program[0x10000];
+    static uint8 memory[0x10000];
+    memset(program, 0x00, sizeof(program));
+    memcpy(program, INTERRUPT_PROGRAM, sizeof(INTERRUPT_PROGRAM));
+    memcpy(program + 0x40, INTERRUPT_VBLANK, sizeof(INTERRUPT_VBLANK));
+    memcpy(program + 0x50, INTERRUPT_TIMER, sizeof(INTERRUPT_TIMER));
+
+    memcpy(memory, program, sizeof(program));
+    traceEager(memory, INTERRUPT_OPS);
+    TEST_CHECK(interruptTaken("op by op", memory));
+
+    memcpy(memory, program, sizeof(program));
+    traceJit(memory, INTERRUPT_OPS);
+    TEST_CHECK(interruptTaken("blocks", memory));
+    failures += checkEventsBlocks() + checkEventsJit();
+    return failures;
+}
+
+/* An undefined op locks the processor up, the store after it never runs. */
+static const uint8 LOCKUP_PROGRAM[] = {
+    0x3E, 0x01, 0xEA, 0x00, 0xC0,       /* 0x0000: ld a, 0x01; ld (0xC000), a */
+    0xD3,                               /* 0x0005: undefined */
+    0x3E, 0x02, 0xEA, 0x00, 0xC0,       /* 0x0006: ld a, 0x02; ld (0xC000), a */
+    0x18, 0xFE,                         /* 0x000B: jr 0x000B */
+};
+#define LOCKUP_OPS              8
+
+/* An undefined op stops the processor op by op and between blocks. */
+uint32 testLR35902Lockup()
+{
+    uint32 failures = 0;
+    static uint8 memory[0x10000];
+    memset(memory, 0x00, sizeof(memory));
+    memcpy(memory, LOCKUP_PROGRAM, sizeof(LOCKUP_PROGRAM));
+    traceEager(memory, LOCKUP_OPS);
+    TEST_CHECK(0x01 == memory[0xC000]);
+
+    memset(memory, 0x00, sizeof(memory));
+    memcpy(memory, LOCKUP_PROGRAM, sizeof(LOCKUP_PROGRAM));
+    traceJit(memory, LOCKUP_OPS);
+    TEST_CHECK(0x01 == memory[0xC000]);
+    return failures;
+}
+
+/* A loop in work RAM rewrites its own immediate through echo RAM, the next iteration logs the new value. */
+static const uint8 MIRROR_PROGRAM[] = {
+    0xC3, 0x00, 0xC0,                   /* 0x0000: jp 0xC000 */
+};
+static const uint8 MIRROR_LOOP[] = {
+    0x3E, 0x05, 0xEA, 0x00, 0xD0,       /* 0xC000: ld a, 0x05; ld (0xD000), a */
+    0x3E, 0x07, 0xEA, 0x01, 0xE0,       /* 0xC005: ld a, 0x07; ld (0xE001), a    the immediate at 0xC001 */
+    0xC3, 0x00, 0xC0,                   /* 0xC00A: jp 0xC000 */
+};
+#define MIRROR_OPS              16
+
+/* Writes through a mirror drop the blocks decoded from the memory it mirrors. */
+uint32 testLR35902Mirror()
+{
+    uint32 failures = 0;
+    static uint8 memory[0x10000];
+    memset(memory, 0x00, sizeof(memory));
+    memcpy(memory, MIRROR_PROGRAM, sizeof(MIRROR_PROGRAM));
+    memcpy(memory + 0xC000, MIRROR_LOOP, sizeof(MIRROR_LOOP));
+    traceEager(memory, MIRROR_OPS);
+    TEST_CHECK(0x07 == memory[0xD000]);
+
+    memset(memory, 0x00, sizeof(memory));
+    memcpy(memory, MIRROR_PROGRAM, sizeof(MIRROR_PROGRAM));
+    memcpy(memory + 0xC000, MIRROR_LOOP, sizeof(MIRROR_LOOP));
+    traceJit(memory, MIRROR_OPS);
+    TEST_CHECK(0x07 == memory[0xD000]);
+    return failures;
+}
+
+/* A ROM bank switched on the bus between two runs at the same PC runs its own ops, interpreted and translated. */
+uint32 testLR35902Banks()
+{
+    return checkBanksBlocks() + checkBanksJit();
+}
+
+/* A halted processor skips to the next scheduled interrupt and waits out the rest of a budget in one step, with
+   the cycles it skipped counted, interpreted and translated. */
+uint32 testLR35902Halt()
+{
+    return checkHaltBlocks() + checkHaltJit();
+}
+
+/* Idle skipping fast-forwards polling loops, but never one polling DIV, TIMA, STAT or LY, interpreted and
+   translated. */
+uint32 testLR35902Idle()
+{
+    return checkIdleBlocks() + checkIdleJit();
+}
+
+/* Every loop the block decoder fuses, each followed by a log of AF, BC, DE and HL, in a pass that starts over.  The
+   timer handler logs the registers it interrupted to 0xC0F0 through a fused copy of its own. */
+static const uint8 FUSION_PROGRAM[] = {
+    0x31, 0x00, 0xE0,                   /* 0x0100: ld sp, 0xE000 */
+    0x3E, 0x04, 0xE0, 0xFF, 0xFB,       /* 0x0103: ld a, 0x04; ldh (0xFF), a; ei     IE: timer */
+    0x21, 0x00, 0x10, 0x11, 0x00, 0xC1, /* 0x0108: ld hl, 0x1000; ld de, 0xC100 */
+    0x01, 0x00, 0x03,                   /* 0x010E: ld bc, 0x0300 */
+    0x2A, 0x12, 0x13, 0x0B,             /* 0x0111: ld a, (hl+); ld (de), a; inc de; dec bc */
+    0x78, 0xB1, 0x20, 0xF8,             /* 0x0115: ld a, b; or c; jr nz, 0x0111 */
+    0xF5, 0xC5, 0xD5, 0xE5,             /* 0x0119: push af; push bc; push de; push hl */
+    0x21, 0x00, 0xC1, 0x11, 0x01, 0xC1, /* 0x011D: ld hl, 0xC100; ld de, 0xC101          one byte ahead */
+    0x06, 0x90,                         /* 0x0123: ld b, 0x90 */
+    0x2A, 0x12, 0x13, 0x05, 0x20, 0xFA, /* 0x0125: ld a, (hl+); ld (de), a; inc de; dec b; jr nz, 0x0125 */
+    0xF5, 0xC5, 0xD5, 0xE5,             /* 0x012B: push af; push bc; push de; push hl */
+    0x21, 0x00, 0xC4, 0x01, 0x34, 0x02, /* 0x012F: ld hl, 0xC400; ld bc, 0x0234 */
+    0xAF, 0x22, 0x0B,                   /* 0x0135: xor a; ld (hl+), a; dec bc */
+    0x78, 0xB1, 0x20, 0xF9,             /* 0x0138: ld a, b; or c; jr nz, 0x0135 */
+    0xF5, 0xC5, 0xD5, 0xE5,             /* 0x013C: push af; push bc; push de; push hl */
+    0x3E, 0x5A, 0x21, 0xFF, 0xC9,       /* 0x0140: ld a, 0x5A; ld hl, 0xC9FF */
+    0x1E, 0xC0,                         /* 0x0145: ld e, 0xC0 */
+    0x32, 0x1D, 0x20, 0xFC,             /* 0x0147: ld (hl-), a; dec e; jr nz, 0x0147 */
+    0xF5, 0xC5, 0xD5, 0xE5,             /* 0x014B: push af; push bc; push de; push hl */
+    0x21, 0x80, 0xCA, 0x0E, 0x00,       /* 0x014F: ld hl, 0xCA80; ld c, 0x00              256 times */
+    0x22, 0x0D, 0x20, 0xFC,             /* 0x0154: ld (hl+), a; dec c; jr nz, 0x0154 */
+    0xF5, 0xC5, 0xD5, 0xE5,             /* 0x0158: push af; push bc; push de; push hl */
+    0x16, 0x00,                         /* 0x015C: ld d, 0x00 */
+    0x15, 0x20, 0xFD,                   /* 0x015E: dec d; jr nz, 0x015E */
+    0xF5, 0xC5, 0xD5, 0xE5,             /* 0x0161: push af; push bc; push de; push hl */
+    0xC3, 0x00, 0x01,                   /* 0x0165: jp 0x0100 */
+};
+static const uint8 FUSION_TIMER[] = {
+    0xF5, 0xC5, 0xD5, 0xE5,             /* 0x0050: push af; push bc; push de; push hl */
+    0xF8, 0x00, 0x11, 0xF0, 0xC0,       /* 0x0054: ld hl, sp+0; ld de, 0xC0F0 */
+    0x06, 0x08,                         /* 0x0059: ld b, 0x08 */
+    0x2A, 0x12, 0x13, 0x05, 0x20, 0xFA, /* 0x005B: ld a, (hl+); ld (de), a; inc de; dec b; jr nz, 0x005B */
+    0xE1, 0xD1, 0xC1, 0xF1, 0xD9,       /* 0x0061: pop hl; pop de; pop bc; pop af; reti */
+};
+#define FUSION_RUNS             16
+#define FUSION_SLICES           120
+#define FUSION_BUDGET           997     // Cycles of a slice of the first run, each run takes longer slices.
+#define FUSION_INTERRUPT        1000    // Cycle of the timer interrupt of the first run, each run takes it later.
+
+/* Run the fusion program through a block variant and compare it with the unfused reference. */
+static bool sameFusion(const char *variant, uint32 run, const uint8 *reference, uint64 referenceCycles,
+                       const uint8 *memory, uint64 cycles, uint64 taken, uint64 fused)
+{
+    for (uint32 addr = 0x8000; addr < 0x10000; ++addr) {
+        if (reference[addr] != memory[addr]) {
+            printf("%s: run %u differs at 0x%04X: 0x%02X, expected 0x%02X\n", variant, run, addr, memory[addr],
+                   reference[addr]);
+            return false;
+        }
+    }
+    if (referenceCycles != cycles || 1 != taken || 0 == fused) {
+        printf("%s: run %u took %llu cycles, expected %llu, %llu interrupts, %llu iterations fused\n", variant, run,
+               (unsigned long long)cycles, (unsigned long long)referenceCycles, (unsigned long long)taken,
+               (unsigned long long)fused);
+        return false;
+    }
+    return true;
+}
+
+/* Fused copy, fill and countdown loops leave the same memory, registers and cycles as the loops run a block per
+   iteration, through interpreted and translated blocks, when the budget of a run or a pending interrupt stops
+   them part way. */
+uint32 testLR35902Fusion()
+{
+    uint32 failures = 0;
+    static uint8 program[0x10000];
+    static uint8 reference[0x10000];
+    static uint8 memory[0x10000];
+    memset(program, 0x00, sizeof(program));
+    program[0x0000] = 0xC3;                                             /* jp 0x0100 */
+    program[0x0001] = 0x00;
+    program[0x0002] = 0x01;
+    memcpy(program + 0x0050, FUSION_TIMER, sizeof(FUSION_TIMER));
+    memcpy(program + 0x0100, FUSION_PROGRAM, sizeof(FUSION_PROGRAM));
+    for (uint32 i = 0; i < 0x0300; ++i) {
+        program[0x1000 + i] = (uint8)(i * 13 + (i >> 8));
+    }
+
+    for (uint32 run = 0; run < FUSION_RUNS; ++run) {
+        uint32 budget = FUSION_BUDGET + run * 613;
+        uint64 interrupt = FUSION_INTERRUPT + run * 5003;
+        uint64 taken = 0;
+        uint64 fused = 0;
+        memcpy(reference, program, sizeof(program));
+        uint64 cycles = sliceUnfused(reference, FUSION_SLICES, budget, interrupt, taken, fused);
+        TEST_CHECK(1 == taken && 0 == fused);
+
+        memcpy(memory, program, sizeof(program));
+        uint64 blocks = sliceBlocks(memory, FUSION_SLICES, budget, interrupt, taken, fused);
+        TEST_CHECK(sameFusion("blocks", run, reference, cycles, memory, blocks, taken, fused));
+
+        memcpy(memory, program, sizeof(program));
+        uint64 jit = sliceJit(memory, FUSION_SLICES, budget, interrupt, taken, fused);
+        TEST_CHECK(sameFusion("jit", run, reference, cycles, memory, jit, taken, fused));
+
+        memcpy(memory, program, sizeof(program));
+        uint64 lazy = sliceJitLazy(memory, FUSION_SLICES, budget, interrupt, taken, fused);
+        TEST_CHECK(sameFusion("jit lazy flags", run, reference, cycles, memory, lazy, taken, fused));
+    }
+    return failures;
+}
+
+/* Pairs loaded, incremented, added and pushed as 16 bits, and their halves read and written as 8 bits. */
+static const uint8 REGISTERS_PROGRAM[] = {
+    0x31, 0x00, 0xD0,                   /* 0x0000: ld sp, 0xD000 */
+    0x01, 0x34, 0x12,                   /* 0x0003: ld bc, 0x1234 */
+    0x78, 0xEA, 0x00, 0xC0,             /* 0x0006: ld a, b; ld (0xC000), a */
+    0x79, 0xEA, 0x01, 0xC0,             /* 0x000A: ld a, c; ld (0xC001), a */
+    0x0E, 0xFF, 0x03, 0xC5,             /* 0x000E: ld c, 0xFF; inc bc; push bc          0x1300 */
+    0x11, 0xCD, 0xAB,                   /* 0x0012: ld de, 0xABCD */
+    0x14, 0x1C, 0xD5,                   /* 0x0015: inc d; inc e; push de                0xACCE */
+    0x21, 0xFF, 0x00, 0x19,             /* 0x0018: ld hl, 0x00FF; add hl, de            0xADCD */
+    0x7C, 0xEA, 0x02, 0xC0,             /* 0x001C: ld a, h; ld (0xC002), a */
+    0x7D, 0xEA, 0x03, 0xC0,             /* 0x0020: ld a, l; ld (0xC003), a */
+    0x0C, 0xE1,                         /* 0x0024: inc c; pop hl                        BC 0x1301, HL 0xACCE */
+    0x26, 0x77, 0xE5, 0xF1,             /* 0x0026: ld h, 0x77; push hl; pop af          AF 0x77C0 */
+    0xF5, 0xC5,                         /* 0x002A: push af; push bc */
+    0x18, 0xFE,                         /* 0x002C: jr 0x002C */
+};
+#define REGISTERS_OPS           30
+
+/* Check the memory left by the register program. */
+static bool registersKept(const char *variant, const uint8 *memory)
+{
+    static const uint8 LOG[] = { 0x12, 0x34, 0xAD, 0xCD };
+    static const uint8 STACK[] = { 0x01, 0x13, 0xC0, 0x77, 0x00, 0x13 };
+    bool kept = 0 == memcmp(memory + 0xC000, LOG, sizeof(LOG)) && 0 == memcmp(memory + 0xCFFA, STACK, sizeof(STACK));
+    if (!kept) {
+        printf("%s: log %02X %02X %02X %02X, stack %02X%02X %02X%02X %02X%02X\n", variant, memory[0xC000],
+               memory[0xC001], memory[0xC002], memory[0xC003], memory[0xCFFB], memory[0xCFFA], memory[0xCFFD],
+               memory[0xCFFC], memory[0xCFFF], memory[0xCFFE]);
+    }
+    return kept;
+}
+
+/* The halves of BC, DE, HL and AF are the high and low bytes of the pairs on every host, op by op and through
+   interpreted and translated blocks, and the low nibble of F stays clear. */
+uint32 testLR35902Registers()
+{
+    uint32 failures = 0;
+    static uint8 memory[0x10000];
+    memset(memory, 0x00, sizeof(memory));
+    memcpy(memory, REGISTERS_PROGRAM, sizeof(REGISTERS_PROGRAM));
+    traceEager(memory, REGISTERS_OPS);
+    TEST_CHECK(registersKept("eager flags", memory));
+
+    memset(memory, 0x00, sizeof(memory));
+    memcpy(memory, REGISTERS_PROGRAM, sizeof(REGISTERS_PROGRAM));
+    traceLazy(memory, REGISTERS_OPS);
+    TEST_CHECK(registersKept("lazy flags", memory));
+
+    memset(memory, 0x00, sizeof(memory));
+    memcpy(memory, REGISTERS_PROGRAM, sizeof(REGISTERS_PROGRAM));
+    traceBlocks(memory, REGISTERS_OPS);
+    TEST_CHECK(registersKept("blocks", memory));
+
+    memset(memory, 0x00, sizeof(memory));
+    memcpy(memory, REGISTERS_PROGRAM, sizeof(REGISTERS_PROGRAM));
+    traceJit(memory, REGISTERS_OPS);
+    TEST_CHECK(registersKept("jit", memory));
+    return failures;
+}
+
+/* Register values and F values every CB op is run with, F in the high nibble as pop af leaves it. */
+static const uint8 CB_VALUES[] = { 0x00, 0x01, 0x80, 0xFF, 0x5A, 0xA5, 0x0F, 0x71 };
+static const uint8 CB_FLAGS[] = { 0x00, 0x10, 0xE0, 0xF0 };
+#define CB_CASES                (sizeof(CB_VALUES) * sizeof(CB_FLAGS))
+#define CB_CASE_OPS             11
+#define CB_STATE                0xC000  // F, A, C, B, E, D, L, H of each case, as pop af, bc, de and hl take them.
+#define CB_MEMORY               0xC400  // The (hl) byte of each case.
+#define CB_LOG                  0xC800  // The registers after each case, as push af, bc, de and hl leave them.
+
+/* Offset of each CB register operand in the state of a case, 0xFF for (hl). */
+static const uint8 CB_OFFSETS[8] = { 3, 2, 5, 4, 7, 6, 0xFF, 1 };
+
+/* Reference model of a CB op: the result of an operand and the flags it leaves. */
+static uint8 cbReference(uint8 op, uint8 value, uint8 &f)
+{
+    uint8 bit = (uint8)((op >> 3) & 0x07);
+    uint8 carryIn = (f & 0x10) ? 1 : 0;
+    uint8 carry = 0;
+    uint8 result = value;
+    switch (op >> 6) {
+        case 0:
+            switch (bit) {
+                case 0: carry = value >> 7; result = (uint8)((value << 1) | carry); break;         /* rlc */
+                case 1: carry = value & 0x01; result = (uint8)((value >> 1) | (carry << 7)); break; /* rrc */
+                case 2: carry = value >> 7; result = (uint8)((value << 1) | carryIn); break;       /* rl */
+                case 3: carry = value & 0x01; result = (uint8)((value >> 1) | (carryIn << 7)); break; /* rr */
+                case 4: carry = value >> 7; result = (uint8)(value << 1); break;                   /* sla */
+                case 5: carry = value & 0x01; result = (uint8)((value >> 1) | (value & 0x80)); break; /* sra */
+                case 6: result = (uint8)((value << 4) | (value >> 4)); break;                      /* swap */
+                default: carry = value & 0x01; result = (uint8)(value >> 1); break;                /* srl */
+            }
+            f = (uint8)((0 == result ? 0x80 : 0x00) | (carry ? 0x10 : 0x00));
+            return result;
+        case 1:
+            f = (uint8)((f & 0x10) | 0x20 | (((value >> bit) & 0x01) ? 0x00 : 0x80));            /* bit */
+            return value;
+        case 2:
+            return (uint8)(value & ~(0x01 << bit));                                                /* res */
+        default:
+            return (uint8)(value | (0x01 << bit));                                                 /* set */
+    }
+}
+
+/* Build the program running a CB op over every case, and the registers the reference model expects after each
+   followed by the (hl) bytes. */
+static void buildCbProgram(uint8 *memory, uint8 op, uint8 *expected)
+{
+    uint8 target = CB_OFFSETS[op & 0x07];
+    uint32 pc = 0;
+    memset(memory, 0x00, 0x10000);
+    for (uint32 i = 0; i < CB_CASES; ++i) {
+        uint8 value = CB_VALUES[i / sizeof(CB_FLAGS)];
+        uint8 *state = memory + CB_STATE + 8 * i;
+        memset(state + 1, value, 7);
+        state[0] = CB_FLAGS[i % sizeof(CB_FLAGS)];
+        if (0xFF == target) {
+            uint16 addr = (uint16)(CB_MEMORY + i);
+            state[6] = (uint8)addr;
+            state[7] = (uint8)(addr >> 8);
+            memory[addr] = value;
+        }
+        memcpy(expected + 8 * i, state, 8);
+        uint8 result = cbReference(op, value, expected[8 * i]);
+        expected[8 * CB_CASES + i] = (0xFF == target) ? result : 0x00;
+        if (0xFF != target) {
+            expected[8 * i + target] = result;
+        }
+
+        uint16 log = (uint16)(CB_LOG + 8 * i + 8);
+        memory[pc++] = 0x31;                                            /* ld sp, state */
+        memory[pc++] = (uint8)(CB_STATE + 8 * i);
+        memory[pc++] = (uint8)((CB_STATE + 8 * i) >> 8);
+        memory[pc++] = 0xF1;                                            /* pop af; pop bc; pop de; pop hl */
+        memory[pc++] = 0xC1;
+        memory[pc++] = 0xD1;
+        memory[pc++] = 0xE1;
+        memory[pc++] = 0xCB;
+        memory[pc++] = op;
+        memory[pc++] = 0x31;                                            /* ld sp, log */
+        memory[pc++] = (uint8)log;
+        memory[pc++] = (uint8)(log >> 8);
+        memory[pc++] = 0xE5;                                            /* push hl; push de; push bc; push af */
+        memory[pc++] = 0xD5;
+        memory[pc++] = 0xC5;
+        memory[pc++] = 0xF5;
+    }
+    memory[pc++] = 0x18;                                                /* jr to itself */
+    memory[pc++] = 0xFE;
+}
+
+/* Compare the registers and (hl) bytes a variant left after a CB op against the reference model. */
+static bool sameCb(const char *variant, uint8 op, const uint8 *expected, const uint8 *memory)
+{
+    for (uint32 i = 0; i < CB_CASES; ++i) {
+        const uint8 *log = memory + CB_LOG + 8 * i;
+        if (0 != memcmp(log, expected + 8 * i, 8) || memory[CB_MEMORY + i] != expected[8 * CB_CASES + i]) {
+            printf("%s: cb 0x%02X of 0x%02X with F 0x%02X: AF %02X%02X, expected %02X%02X\n", variant, op,
+                   CB_VALUES[i / sizeof(CB_FLAGS)], CB_FLAGS[i % sizeof(CB_FLAGS)], log[1], log[0],
+                   expected[8 * i + 1], expected[8 * i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Every CB op gives the results and flags of the reference model over a set of operands and flags, op by op
+   with eager and lazy flags, the table ALU and the op code switch, and through translated blocks. */
+uint32 testLR35902Cb()
+{
+    uint32 failures = 0;
+    static uint8 program[0x10000];
+    static uint8 memory[0x10000];
+    static uint8 expected[9 * CB_CASES];
+    for (uint32 op = 0; op < 0x100; ++op) {
+        buildCbProgram(program, (uint8)op, expected);
+
+        memcpy(memory, program, sizeof(program));
+        traceEager(memory, CB_CASES * CB_CASE_OPS);
+        TEST_CHECK(sameCb("eager flags", (uint8)op, expected, memory));
+
+        memcpy(memory, program, sizeof(program));
+        traceLazy(memory, CB_CASES * CB_CASE_OPS);
+        TEST_CHECK(sameCb("lazy flags", (uint8)op, expected, memory));
+
+        memcpy(memory, program, sizeof(program));
+        traceAluTable(memory, CB_CASES * CB_CASE_OPS);
+        TEST_CHECK(sameCb("table ALU", (uint8)op, expected, memory));
+
+        memcpy(memory, program, sizeof(program));
+        traceSwitch(memory, CB_CASES * CB_CASE_OPS);
+        TEST_CHECK(sameCb("switch dispatch", (uint8)op, expected, memory));
+
+        memcpy(memory, program, sizeof(program));
+        traceJit(memory, CB_CASES * CB_CASE_OPS);
+        TEST_CHECK(sameCb("jit", (uint8)op, expected, memory));
+    }
+    return failures;
+}
+
+/* A mix of loads, 8 and 16 bit arithmetic, CB ops, stack ops, calls and branches for the benchmarks.  Each pass
+   transforms 64 bytes from 0xC100 into 0xC200 and counts itself in 0xC000-0xC001. */
+static const uint8 BENCH_PROGRAM[] = {
+    0x31, 0x00, 0xD0,                   /* 0x0000: ld sp, 0xD000 */
+    0x21, 0x00, 0xC1,                   /* 0x0003: ld hl, 0xC100 */
+    0x11, 0x00, 0xC2,                   /* 0x0006: ld de, 0xC200 */
+    0x06, 0x40,                         /* 0x0009: ld b, 0x40 */
+    0x2A, 0x4F, 0x81,                   /* 0x000B: ld a, (hl+); ld c, a; add a, c */
+    0xCE, 0x05, 0xA9,                   /* 0x000E: adc a, 0x05; xor c */
+    0xCB, 0x37, 0xCB, 0x11,             /* 0x0011: swap a; rl c */
+    0x91, 0x27, 0x12, 0x13,             /* 0x0015: sub c; daa; ld (de), a; inc de */
+    0xC5, 0xCD, 0x40, 0x00, 0xC1,       /* 0x0019: push bc; call 0x0040; pop bc */
+    0x05, 0x20, 0xEA,                   /* 0x001E: dec b; jr nz, 0x000B */
+    0xFA, 0x00, 0xC0, 0xC6, 0x01,       /* 0x0021: ld a, (0xC000); add a, 0x01 */
+    0xEA, 0x00, 0xC0,                   /* 0x0026: ld (0xC000), a */
+    0xFA, 0x01, 0xC0, 0xCE, 0x00,       /* 0x0029: ld a, (0xC001); adc a, 0x00 */
+    0xEA, 0x01, 0xC0,                   /* 0x002E: ld (0xC001), a */
+    0xC3, 0x03, 0x00,                   /* 0x0031: jp 0x0003 */
+};
+static const uint8 BENCH_CALL[] = {
+    0xCB, 0x7F, 0xCB, 0x87, 0x17, 0xC9, /* 0x0040: bit 7, a; res 0, a; rla; ret */
+};
+#define BENCH_PASSES            20000
+
+/* The 16 bit load, inc, dec, add, push and pop ops, 64 times a pass. */
+static const uint8 PAIRS_PROGRAM[] = {
+    0x31, 0x00, 0xD0,                   /* 0x0000: ld sp, 0xD000 */
+    0x01, 0x00, 0x00,                   /* 0x0003: ld bc, 0x0000 */
+    0x11, 0x01, 0x00,                   /* 0x0006: ld de, 0x0001 */
+    0x21, 0x00, 0xC1,                   /* 0x0009: ld hl, 0xC100 */
+    0x3E, 0x40,                         /* 0x000C: ld a, 0x40 */
+    0x03, 0x13, 0x09, 0x19,             /* 0x000E: inc bc; inc de; add hl, bc; add hl, de */
+    0xC5, 0xD5, 0xE5,                   /* 0x0012: push bc; push de; push hl */
+    0xE1, 0xD1, 0xC1,                   /* 0x0015: pop hl; pop de; pop bc */
+    0x2B, 0x1B,                         /* 0x0018: dec hl; dec de */
+    0x3D, 0x20, 0xF1,                   /* 0x001A: dec a; jr nz, 0x000E */
+    0xFA, 0x00, 0xC0, 0xC6, 0x01,       /* 0x001D: ld a, (0xC000); add a, 0x01 */
+    0xEA, 0x00, 0xC0,                   /* 0x0022: ld (0xC000), a */
+    0xFA, 0x01, 0xC0, 0xCE, 0x00,       /* 0x0025: ld a, (0xC001); adc a, 0x00 */
+    0xEA, 0x01, 0xC0,                   /* 0x002A: ld (0xC001), a */
+    0xC3, 0x03, 0x00,                   /* 0x002D: jp 0x0003 */
+};
+
+/* Rotates, shifts, swaps and bit ops on registers and (hl), 64 times a pass. */
+static const uint8 CB_PROGRAM[] = {
+    0x31, 0x00, 0xD0,                   /* 0x0000: ld sp, 0xD000 */
+    0x21, 0x00, 0xC1,                   /* 0x0003: ld hl, 0xC100 */
+    0x16, 0x40,                         /* 0x0006: ld d, 0x40 */
+    0xCB, 0x37, 0xCB, 0x00,             /* 0x0008: swap a; rlc b */
+    0xCB, 0x19, 0xCB, 0x23,             /* 0x000C: rr c; sla e */
+    0xCB, 0x46, 0xCB, 0xC6,             /* 0x0010: bit 0, (hl); set 0, (hl) */
+    0xCB, 0x86, 0xCB, 0x7F,             /* 0x0014: res 0, (hl); bit 7, a */
+    0xCB, 0x38, 0xCB, 0x29,             /* 0x0018: srl b; sra c */
+    0xCB, 0xFB, 0xCB, 0x8F,             /* 0x001C: set 7, e; res 1, a */
+    0x15, 0x20, 0xE5,                   /* 0x0020: dec d; jr nz, 0x0008 */
+    0xFA, 0x00, 0xC0, 0xC6, 0x01,       /* 0x0023: ld a, (0xC000); add a, 0x01 */
+    0xEA, 0x00, 0xC0,                   /* 0x0028: ld (0xC000), a */
+    0xFA, 0x01, 0xC0, 0xCE, 0x00,       /* 0x002B: ld a, (0xC001); adc a, 0x00 */
+    0xEA, 0x01, 0xC0,                   /* 0x0030: ld (0xC001), a */
+    0xC3, 0x03, 0x00,                   /* 0x0033: jp 0x0003 */
+};
+
+/* A looping program for the benchmarks, with any routine it calls at 0x0040 and the ops of one pass. */
+typedef struct _BENCH_LOOP {
+    const uint8    *program;
+    uint32          size;
+    const uint8    *call;
+    uint32          callSize;
+    uint32          passOps;
+} BENCH_LOOP;
+static const BENCH_LOOP BENCH_MIX = {
+    BENCH_PROGRAM, sizeof(BENCH_PROGRAM), BENCH_CALL, sizeof(BENCH_CALL), 3 + 0x40 * 20 + 7
+};
+static const BENCH_LOOP BENCH_PAIRS = {
+    PAIRS_PROGRAM, sizeof(PAIRS_PROGRAM), NULL, 0, 4 + 0x40 * 14 + 7
+};
+static const BENCH_LOOP BENCH_CB = {
+    CB_PROGRAM, sizeof(CB_PROGRAM), NULL, 0, 2 + 0x40 * 14 + 7
+};
+
+/* A variant of the core run over a benchmark program. */
+typedef uint32 (*LR35902_RUN_FN)(uint8 *memory, uint32 passes);
+
+/* Measure the ops per second of a variant over a benchmark program, with the size of its shared tables. */
+static void benchLoop(const char *variant, LR35902_RUN_FN run, const BENCH_LOOP &loop)
+{
+    static uint8 memory[0x10000];
+    memset(memory, 0x00, sizeof(memory));
+    memcpy(memory, loop.program, loop.size);
+    if (NULL != loop.call) {
+        memcpy(memory + 0x40, loop.call, loop.callSize);
+    }
+    double start = BENCH_CLOCK_MS();
+    uint32 shared = run(memory, BENCH_PASSES);
+    double ms = BENCH_CLOCK_MS() - start;
+    printf("lr35902 %-24s %8.1f Mops/s %8.1f KB tables\n", variant,
+           (double)BENCH_PASSES * loop.passOps / ms / 1000.0, shared / 1024.0);
+}
+
+/* Measure the ops per second of a variant over the mixed benchmark program. */
+static void benchVariant(const char *variant, LR35902_RUN_FN run)
+{
+    benchLoop(variant, run, BENCH_MIX);
+}
+
+/* Ops per second op by op through the dispatch table and through the op code switch. */
+void benchLR35902Dispatch()
+{
+    benchVariant("dispatch table", &runEager);
+    benchVariant("dispatch switch", &runSwitch);
+}
+
+/* Ops per second op by op with the computed ALU and the table ALU, against the tables each reads. */
+void benchLR35902Alu()
+{
+    benchVariant("alu computed", &runEager);
+    benchVariant("alu table", &runAluTable);
+}
+
+/* Ops per second op by op, through interpreted blocks and through translated blocks. */
+void benchLR35902Jit()
+{
+    benchVariant("op by op", &runEager);
+    benchVariant("blocks", &runBlocks);
+    benchVariant("jit", &runJit);
+    benchVariant("jit lazy flags", &runJitLazy);
+}
+
+/* Ops per second op by op without a cycle counter, counting cycles per op and timing every access. */
+void benchLR35902Timing()
+{
+    benchVariant("untimed", &runUntimed);
+    benchVariant("timing per op", &runEager);
+    benchVariant("timing per access", &runAccess);
+}
+
+/* Ops per second of the 16 bit register pair ops, op by op and through translated blocks. */
+void benchLR35902Registers()
+{
+    benchLoop("pairs op by op", &runEager, BENCH_PAIRS);
+    benchLoop("pairs jit", &runJit, BENCH_PAIRS);
+}
+
+/* Ops per second of a loop of CB ops through the dispatch table, the op code switch and translated blocks. */
+void benchLR35902Cb()
+{
+    benchLoop("cb dispatch table", &runEager, BENCH_CB);
+    benchLoop("cb dispatch switch", &runSwitch, BENCH_CB);
+    benchLoop("cb jit", &runJit, BENCH_CB);
+}
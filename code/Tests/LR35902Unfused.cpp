@@ -0,0 +1,18 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+/* The LR35902 core running decoded blocks interpreted with eager flags, the computed ALU and no fused loops, the
+   reference of the fusion check, see LR35902Variant.cpp. */
+#undef LR35902_FLAGS
+#undef LR35902_ALU
+#undef LR35902_JIT
+#undef LR35902_FUSION
+#define LR35902_FLAGS           LR35902_FLAGS_EAGER
+#define LR35902_ALU             LR35902_ALU_COMPUTED
+#define LR35902_JIT             0
+#define LR35902_FUSION          0
+#define LR35902_VARIANT_BLOCKS
+#define SiNES                   SiNESUnfused
+#define LR35902_VARIANT(NAME)   NAME##Unfused
+#include "Tests/LR35902Variant.cpp"
@@ -0,0 +1,360 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+/*
+One build variant of the LR35902 core for the differential tests.
+
+Included by LR35902Eager.cpp, LR35902Switch.cpp, LR35902Lazy.cpp, LR35902AluTable.cpp, LR35902Access.cpp,
+LR35902Untimed.cpp, LR35902Blocks.cpp, LR35902Unfused.cpp, LR35902Jit.cpp and LR35902JitLazy.cpp after they pick the
+build options and rename the SiNES namespace, so every variant of the core links into the one test executable.
+LR35902_VARIANT(NAME) names the functions of the variant, the block variants also define the checks of the block
+cache.
+*/
+
+#include <stdlib.h>
+#include "Tests/Test.hpp"
+#include "Processors/Processor.cpp"
+#include "Memory/Arena.cpp"
+#include "Memory/Bus.cpp"
+#include "Processors/Nintendo/LR35902/alu.cpp"
+#include "Processors/Nintendo/LR35902/LR35902.cpp"
+#ifdef LR35902_VARIANT_BLOCKS
+    #include "Systems/Nintendo/GameBoy.cpp"
+#endif
+
+/* Most clock cycles of an op in the test programs, the budget of a run through blocks. */
+#define VARIANT_OP_CYCLES       24
+
+/* Ops run between checks of the pass counter of a benchmark, or that many times VARIANT_OP_CYCLES through blocks. */
+#define VARIANT_SLICE           1000
+
+/* Attach flat memory with echo RAM and switch on what the variant runs blocks through. */
+static void attach(SiNES::Processors::Nintendo::LR35902 &cpu, uint8 *memory)
+{
+    cpu.attachMemory(memory);
+    cpu.getBus().map(0xE0, 0x1E, memory + 0xC000, true);
+#if defined(LR35902_VARIANT_BLOCKS) && LR35902_JIT
+    cpu.setJit(true);
+#endif
+}
+
+/* Run ops of a program from 0x0000 over flat memory, op by op or through runUntil with LR35902_VARIANT_BLOCKS, and
+   return the clock cycles they took, 0 without a master cycle counter. */
+uint64 LR35902_VARIANT(trace)(uint8 *memory, uint32 ops)
+{
+    SiNES::Processors::Nintendo::LR35902 cpu;
+    attach(cpu, memory);
+#ifdef LR35902_VARIANT_BLOCKS
+    cpu.runUntil(0, ops * VARIANT_OP_CYCLES);
+#else
+    for (uint32 i = 0; i < ops; ++i) {
+        cpu.execOp();
+    }
+#endif
+#if LR35902_TIMING != LR35902_TIMING_NONE
+    return cpu.cycleCount();
+#else
+    return 0;
+#endif
+}
+
+/* Run a looping program from 0x0000 until the pass counter it keeps at 0xC000 reaches a count, and return the
+   bytes of the tables the variant shares between processors. */
+uint32 LR35902_VARIANT(run)(uint8 *memory, uint32 passes)
+{
+    SiNES::Processors::Nintendo::LR35902 cpu;
+    SiNES::Processors::PROCESSOR_MEMORY usage;
+    attach(cpu, memory);
+    while ((uint32)(memory[0xC000] | (memory[0xC001] << 8)) < passes) {
+#ifdef LR35902_VARIANT_BLOCKS
+        cpu.runUntil(0, VARIANT_SLICE * VARIANT_OP_CYCLES);
+#else
+        for (uint32 i = 0; i < VARIANT_SLICE; ++i) {
+            cpu.execOp();
+        }
+#endif
+    }
+    cpu.memoryUsage(usage);
+    return usage.shared;
+}
+
+#ifdef LR35902_VARIANT_BLOCKS
+/* Run a program from 0x0000 over flat memory through runUntil for a number of slices of a cycle budget, with the
+   timer interrupt scheduled at a cycle, and return the clock cycles taken.  The interrupts taken and the loop
+   iterations run in bulk are counted out. */
+uint64 LR35902_VARIANT(slice)(uint8 *memory, uint32 slices, uint32 budget, uint64 interrupt, uint64 &taken,
+                              uint64 &fused)
+{
+    SiNES::Processors::Nintendo::LR35902 cpu;
+    attach(cpu, memory);
+    cpu.schedule(LR35902_INT_TIMER, interrupt);
+    for (uint32 i = 0; i < slices; ++i) {
+        cpu.runUntil(0, budget);
+    }
+    taken = cpu.getStats().interrupts;
+    fused = cpu.getStats().fusedIterations;
+    return cpu.cycleCount();
+}
+
+/* Size of the ROM image of the bank check, bank 0 and the switchable banks 1 and 2. */
+#define VARIANT_ROM_SIZE        0xC000
+
+/* Run the ROM of the bank check for a slice and return the value the bank mapped at 0x4000 logged to 0xC000. */
+static uint8 runBank(SiNES::Processors::Nintendo::LR35902 &cpu, uint8 *ram)
+{
+    ram[0x4000] = 0x00;
+    cpu.runUntil(0, VARIANT_SLICE);
+    return ram[0x4000];
+}
+
+/* Switching the ROM bank on the bus runs the ops of the new bank at the same PC, and switching back runs the old
+   bank again.  Bank 0 jumps to 0x4010, where every bank logs its number and jumps back, the two blocks sitting
+   apart in the block cache. */
+uint32 LR35902_VARIANT(checkBanks)()
+{
+    static const uint8 BANK_0[] = {
+        0xC3, 0x10, 0x40,                   /* 0x0000: jp 0x4010 */
+    };
+    static const uint8 BANK_N[] = {
+        0x3E, 0x00, 0xEA, 0x00, 0xC0,       /* 0x4010: ld a, n; ld (0xC000), a */
+        0xC3, 0x00, 0x00,                   /* 0x4015: jp 0x0000 */
+    };
+    uint32 failures = 0;
+    static uint8 rom[VARIANT_ROM_SIZE];
+    static uint8 ram[0x8000];
+    memset(rom, 0x00, sizeof(rom));
+    memset(ram, 0x00, sizeof(ram));
+    memcpy(rom, BANK_0, sizeof(BANK_0));
+    for (uint32 bank = 1; bank < VARIANT_ROM_SIZE / 0x4000; ++bank) {
+        memcpy(rom + bank * 0x4000 + 0x10, BANK_N, sizeof(BANK_N));
+        rom[bank * 0x4000 + 0x11] = (uint8)bank;
+    }
+
+    SiNES::Processors::Nintendo::LR35902 cpu;
+    cpu.attachRom(rom, sizeof(rom));
+    cpu.attachRam(ram);
+#if LR35902_JIT
+    cpu.setJit(true);
+#endif
+    TEST_CHECK(0x01 == runBank(cpu, ram));
+    cpu.getBus().map(0x40, 0x40, rom + 0x8000, false);
+    TEST_CHECK(0x02 == runBank(cpu, ram));
+    cpu.getBus().map(0x40, 0x40, rom + 0x4000, false);
+    TEST_CHECK(0x01 == runBank(cpu, ram));
+    return failures;
+}
+
+#undef VARIANT_ROM_SIZE
+
+/* A loop with the vblank and timer interrupts enabled, each handler counts itself in 0xC000. */
+static const uint8 EVENTS_PROGRAM[] = {
+    0x31, 0x00, 0xD0,                   /* 0x0000: ld sp, 0xD000 */
+    0x3E, 0x05, 0xE0, 0xFF,             /* 0x0003: ld a, 0x05; ldh (0xFF), a    IE: timer and vblank */
+    0xFB,                               /* 0x0007: ei */
+    0x00, 0x18, 0xFD,                   /* 0x0008: nop; jr 0x0008 */
+};
+static const uint8 EVENTS_HANDLER[] = {
+    0x21, 0x00, 0xC0, 0x34, 0xD9,       /* 0x0040 and 0x0050: ld hl, 0xC000; inc (hl); reti */
+};
+
+/* Each taken interrupt ends the run it is taken in, and a plain loop of runs goes on to the next one without
+   clearing the event. */
+uint32 LR35902_VARIANT(checkEvents)()
+{
+    uint32 failures = 0;
+    static uint8 memory[0x10000];
+    memset(memory, 0x00, sizeof(memory));
+    memcpy(memory, EVENTS_PROGRAM, sizeof(EVENTS_PROGRAM));
+    memcpy(memory + 0x40, EVENTS_HANDLER, sizeof(EVENTS_HANDLER));
+    memcpy(memory + 0x50, EVENTS_HANDLER, sizeof(EVENTS_HANDLER));
+
+    SiNES::Processors::Nintendo::LR35902 cpu;
+    attach(cpu, memory);
+    cpu.schedule(LR35902_INT_VBLANK, 200);
+    cpu.schedule(LR35902_INT_TIMER, 400);
+    for (uint32 i = 0; i < VARIANT_SLICE && memory[0xC000] < 2; ++i) {
+        cpu.run(VARIANT_OP_CYCLES * 4);
+    }
+    TEST_CHECK(2 == memory[0xC000] && 2 == cpu.getStats().interrupts);
+    TEST_CHECK(0 != (cpu.pendingEvents() & PROCESSOR_EVENT_INTERRUPT));
+    return failures;
+}
+
+/* A halt the timer wakes, its handler counts itself in 0xC000 and returns to a loop back into the halt. */
+static const uint8 HALT_PROGRAM[] = {
+    0x31, 0x00, 0xD0,                   /* 0x0000: ld sp, 0xD000                        12 */
+    0x3E, 0x04, 0xE0, 0xFF,             /* 0x0003: ld a, 0x04; ldh (0xFF), a    IE: timer   8 + 12 */
+    0xFB,                               /* 0x0007: ei                                    4 */
+    0x76, 0x18, 0xFD,                   /* 0x0008: halt; jr 0x0008                       4, then 12 + 4 */
+};
+#define HALT_VBLANK             5000    // Cycle of the vblank interrupt, which IE leaves off.
+#define HALT_TIMER              10000   // Cycle of the timer interrupt.
+#define HALT_SLICE              3000
+#define HALT_SLICES             7
+#define HALT_AWAKE              (40 + 20 + 40 + 16)     // Cycles run: up to the halt, the interrupt, the handler.
+
+/* A halted processor fast-forwards to the next scheduled cycle, past a source IE leaves off, wakes for the timer
+   on its cycle and takes it, then waits out every budget to the cycle with the halt cycles counted. */
+uint32 LR35902_VARIANT(checkHalt)()
+{
+    uint32 failures = 0;
+    static uint8 memory[0x10000];
+    memset(memory, 0x00, sizeof(memory));
+    memcpy(memory, HALT_PROGRAM, sizeof(HALT_PROGRAM));
+    memcpy(memory + 0x50, EVENTS_HANDLER, sizeof(EVENTS_HANDLER));
+
+    SiNES::Processors::Nintendo::LR35902 cpu;
+    attach(cpu, memory);
+    cpu.schedule(LR35902_INT_VBLANK, HALT_VBLANK);
+    cpu.schedule(LR35902_INT_TIMER, HALT_TIMER);
+    TEST_CHECK(HALT_TIMER + 20 == cpu.runUntil(PROCESSOR_EVENT_INTERRUPT, HALT_SLICE * HALT_SLICES));
+    TEST_CHECK(HALT_TIMER - 40 == cpu.getStats().haltCycles);
+    for (uint32 i = 0; i < HALT_SLICES; ++i) {
+        TEST_CHECK(HALT_SLICE == cpu.runUntil(0, HALT_SLICE));
+        TEST_CHECK(HALT_TIMER + 20 + (uint64)HALT_SLICE * (i + 1) == cpu.cycleCount());
+    }
+    TEST_CHECK(HALT_TIMER + HALT_SLICE * HALT_SLICES + 20 - HALT_AWAKE == cpu.getStats().haltCycles);
+    TEST_CHECK(1 == memory[0xC000] && 1 == cpu.getStats().interrupts);
+    TEST_CHECK(0x01 == (memory[0xFF0F] & 0x05));
+    return failures;
+}
+
+#undef HALT_VBLANK
+#undef HALT_TIMER
+#undef HALT_SLICE
+#undef HALT_SLICES
+#undef HALT_AWAKE
+
+/* Polling loops from 0x0000, reading memory that changes only at scheduled cycles or a register that counts with
+   the clock: DIV, TIMA, STAT and LY by address, through HL, C and an absolute address. */
+typedef struct _IDLE_LOOP {
+    uint8   code[8];
+    uint32  size;
+    bool    idle;       // The loop is skipped.
+} IDLE_LOOP;
+static const IDLE_LOOP IDLE_LOOPS[] = {
+    { { 0xF0, 0x80, 0xFE, 0x01, 0x20, 0xFA }, 6, true },              /* ldh a, (0x80); cp 0x01; jr nz */
+    { { 0xF0, 0x04, 0xFE, 0x01, 0x20, 0xFA }, 6, false },             /* ldh a, (DIV) */
+    { { 0xF0, 0x05, 0xFE, 0x01, 0x20, 0xFA }, 6, false },             /* ldh a, (TIMA) */
+    { { 0xF0, 0x41, 0xFE, 0x01, 0x20, 0xFA }, 6, false },             /* ldh a, (STAT) */
+    { { 0xF0, 0x44, 0xFE, 0x01, 0x20, 0xFA }, 6, false },             /* ldh a, (LY) */
+    { { 0x21, 0x00, 0xC0, 0x7E, 0xFE, 0x01, 0x20, 0xFB }, 8, true },  /* ld hl, 0xC000; ld a, (hl); cp; jr nz */
+    { { 0x21, 0x44, 0xFF, 0x7E, 0xFE, 0x01, 0x20, 0xFB }, 8, false }, /* ld hl, LY; ld a, (hl) */
+    { { 0x0E, 0x05, 0xF2, 0xFE, 0x01, 0x20, 0xFB }, 7, false },       /* ld c, TIMA; ld a, (c) */
+    { { 0xFA, 0x41, 0xFF, 0xFE, 0x01, 0x20, 0xF9 }, 7, false },       /* ld a, (STAT) */
+};
+#define IDLE_BUDGET             20000
+
+/* The first loop waits for the timer handler to set 0xFF80. */
+static const uint8 IDLE_PROGRAM[] = {
+    0x31, 0x00, 0xD0,                   /* 0x0000: ld sp, 0xD000 */
+    0x3E, 0x04, 0xE0, 0xFF, 0xFB,       /* 0x0003: ld a, 0x04; ldh (0xFF), a; ei     IE: timer */
+    0xF0, 0x80, 0xA7, 0x28, 0xFB,       /* 0x0008: ldh a, (0x80); and a; jr z, 0x0008 */
+    0x18, 0xFE,                         /* 0x000D: jr 0x000D */
+};
+static const uint8 IDLE_TIMER[] = {
+    0x3E, 0x01, 0xE0, 0x80, 0xD9,       /* 0x0050: ld a, 0x01; ldh (0x80), a; reti */
+};
+#define IDLE_TIMER_CYCLE        10000
+
+/* Idle skipping fast-forwards a polling loop to the end of the budget or the next scheduled cycle, where the
+   interrupt it waits for is taken on its cycle, and never skips a loop polling a clocked register. */
+uint32 LR35902_VARIANT(checkIdle)()
+{
+    uint32 failures = 0;
+    static uint8 memory[0x10000];
+    for (uint32 i = 0; i < sizeof(IDLE_LOOPS) / sizeof(IDLE_LOOPS[0]); ++i) {
+        const IDLE_LOOP &loop = IDLE_LOOPS[i];
+        memset(memory, 0x00, sizeof(memory));
+        memcpy(memory, loop.code, loop.size);
+        SiNES::Processors::Nintendo::LR35902 cpu;
+        attach(cpu, memory);
+        cpu.setIdleSkip(true);
+        cpu.runUntil(0, IDLE_BUDGET);
+        if (loop.idle) {
+            TEST_CHECK(IDLE_BUDGET == cpu.cycleCount());
+            TEST_CHECK(1 == cpu.getStats().idleLoops && cpu.getStats().idleCycles > IDLE_BUDGET / 2);
+        } else {
+            TEST_CHECK(0 == cpu.getStats().idleLoops && 0 == cpu.getStats().idleCycles);
+        }
+    }
+
+    memset(memory, 0x00, sizeof(memory));
+    memcpy(memory, IDLE_PROGRAM, sizeof(IDLE_PROGRAM));
+    memcpy(memory + 0x50, IDLE_TIMER, sizeof(IDLE_TIMER));
+    SiNES::Processors::Nintendo::LR35902 cpu;
+    attach(cpu, memory);
+    cpu.setIdleSkip(true);
+    cpu.schedule(LR35902_INT_TIMER, IDLE_TIMER_CYCLE);
+    TEST_CHECK(IDLE_TIMER_CYCLE + 20 == cpu.runUntil(PROCESSOR_EVENT_INTERRUPT, IDLE_BUDGET));
+    TEST_CHECK(1 == cpu.getStats().idleLoops && 1 == cpu.getStats().interrupts);
+    cpu.runUntil(0, IDLE_BUDGET);
+    TEST_CHECK(0x01 == memory[0xFF80] && 2 == cpu.getStats().idleLoops);
+    return failures;
+}
+
+#undef IDLE_BUDGET
+#undef IDLE_TIMER_CYCLE
+
+/* Slices of the snapshot check run before the first snapshot, and the longest replay, in steps of a few flushes of
+   the code cache. */
+#define SNAPSHOT_SLICES         40
+#define SNAPSHOT_STEP           4
+
+/* Run a session for a number of slices and log its counters at 0xC000-0xC004 and its cycle count. */
+static uint64 runSession(SiNES::Systems::Nintendo::GameBoy &gb, uint32 slices, uint8 *counters)
+{
+    SiNES::Processors::Nintendo::LR35902 *cpu = gb.getCpu();
+    for (uint32 i = 0; i < slices; ++i) {
+        cpu->runUntil(0, VARIANT_SLICE * VARIANT_OP_CYCLES);
+    }
+    for (uint32 i = 0; i < 5; ++i) {
+        counters[i] = cpu->getBus().read8((uint16)(0xC000 + i));
+    }
+    return cpu->cycleCount();
+}
+
+/* A session of the ROM of GameBoyTest.cpp replays the same after returning to a snapshot.  Three of the blocks it
+   runs evict each other from the block cache, so their translations fill and flush the code cache between the
+   snapshot and the restore.  Over replays of growing length, a flush leaves the code of another block where the
+   snapshot holds the translation of the block that stays cached. */
+uint32 LR35902_VARIANT(checkSnapshot)(const char *path)
+{
+    uint32 failures = 0;
+    SiNES::Systems::Nintendo::GameBoy gb;
+    if (!gb.load((usz)path, NULL, false)) {
+        return 1;
+    }
+#if LR35902_JIT
+    gb.getCpu()->setJit(true);
+#endif
+    uint8 counters[3][5];
+    uint32 size = gb.snapshotSize();
+    uint8 *snapshot = (uint8 *)malloc(size);
+    if (NULL == snapshot) {
+        return 1;
+    }
+    runSession(gb, SNAPSHOT_SLICES, counters[0]);
+    for (uint32 slices = SNAPSHOT_STEP; slices <= SNAPSHOT_SLICES; slices += SNAPSHOT_STEP) {
+        uint64 start = runSession(gb, 0, counters[0]);
+        gb.snapshot(snapshot);
+        uint64 end = runSession(gb, slices, counters[1]);
+        TEST_CHECK(end > start && 0 != memcmp(counters[0], counters[1], sizeof(counters[0])));
+        gb.restore(snapshot);
+        TEST_CHECK(start == runSession(gb, 0, counters[2]));
+        TEST_CHECK(0 == memcmp(counters[0], counters[2], sizeof(counters[0])));
+        TEST_CHECK(end == runSession(gb, slices, counters[2]));
+        TEST_CHECK(0 == memcmp(counters[1], counters[2], sizeof(counters[1])));
+    }
+    TEST_CHECK(size == gb.snapshotSize() && NULL != gb.getFramebuffer());
+    free(snapshot);
+    return failures;
+}
+
+#undef SNAPSHOT_SLICES
+#undef SNAPSHOT_STEP
+#endif
+
+#undef VARIANT_OP_CYCLES
+#undef VARIANT_SLICE
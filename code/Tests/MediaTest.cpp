@@ -0,0 +1,242 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "Tests/Test.hpp"
+#include "Media/Crc32.hpp"
+#include "Media/Media.hpp"
+
+/* Files written by the media checks and benchmarks into the working directory, removed when they are done. */
+#define MEDIA_RAW_PATH          "sines-media.sfc"
+#define MEDIA_GZIP_PATH         "sines-media.sfc.gz"
+#define MEDIA_ZIP_PATH          "sines-media.zip"
+
+/* Size of the image of the checks, eight banks, and of the benchmark, a 1MB cartridge. */
+#define MEDIA_CHECK_SIZE        (8 * MEDIA_BANK_SIZE)
+#define MEDIA_BENCH_SIZE        0x00100000
+
+/* Bits of a DEFLATE stream, least significant first. */
+typedef struct _BIT_WRITER {
+    uint8  *out;
+    uint32  pos;
+    uint32  bits;
+    uint32  count;
+} BIT_WRITER;
+
+static void putBits(BIT_WRITER &writer, uint32 value, uint32 count)
+{
+    writer.bits |= value << writer.count;
+    writer.count += count;
+    while (writer.count >= 8) {
+        writer.out[writer.pos++] = (uint8)writer.bits;
+        writer.bits >>= 8;
+        writer.count -= 8;
+    }
+}
+
+/* Put a Huffman code, which DEFLATE packs most significant bit first. */
+static void putCode(BIT_WRITER &writer, uint32 code, uint32 length)
+{
+    for (uint32 i = length; i > 0; --i) {
+        putBits(writer, (code >> (i - 1)) & 0x01, 1);
+    }
+}
+
+/* Put a symbol of the fixed literal/length code. */
+static void putSymbol(BIT_WRITER &writer, uint32 symbol)
+{
+    if (symbol < 144) {
+        putCode(writer, 0x30 + symbol, 8);
+    } else if (symbol < 256) {
+        putCode(writer, 0x190 + symbol - 144, 9);
+    } else if (symbol < 280) {
+        putCode(writer, symbol - 256, 7);
+    } else {
+        putCode(writer, 0xC0 + symbol - 280, 8);
+    }
+}
+
+static void putLong(uint8 *out, uint32 value)
+{
+    out[0] = (uint8)value;
+    out[1] = (uint8)(value >> 8);
+    out[2] = (uint8)(value >> 16);
+    out[3] = (uint8)(value >> 24);
+}
+
+/* Wrap data in a gzip member of one fixed Huffman block, runs of a repeated byte as matches of 258 bytes at
+   distance 1 and everything else as literals.  The output holds at least 2 * size + 32 bytes, returns its
+   size. */
+static uint32 gzipFixed(const uint8 *data, uint32 size, uint8 *out)
+{
+    static const uint8 HEADER[10] = { 0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03 };
+    memcpy(out, HEADER, sizeof(HEADER));
+    BIT_WRITER writer = { out, sizeof(HEADER), 0, 0 };
+    putBits(writer, 0x03, 3);                               /* last block, fixed codes */
+    for (uint32 i = 0; i < size; ) {
+        uint32 run = 0;
+        while (i > 0 && run < 258 && i + run < size && data[i + run] == data[i - 1]) {
+            ++run;
+        }
+        if (258 == run) {
+            putSymbol(writer, 285);                         /* length 258 */
+            putCode(writer, 0, 5);                          /* distance 1 */
+            i += run;
+            continue;
+        }
+        putSymbol(writer, data[i++]);
+    }
+    putSymbol(writer, 256);
+    putBits(writer, 0, 7);
+    uint32 pos = writer.pos;
+    putLong(out + pos, crc32(0, data, size));
+    putLong(out + pos + 4, size);
+    return pos + 8;
+}
+
+/* Fill an image with runs of noise and of repeated bytes, a run crossing every bank boundary. */
+static void fillImage(uint8 *image, uint32 size)
+{
+    uint32 state = 0x2545F491;
+    for (uint32 i = 0; i < size; ++i) {
+        state = state * 1103515245 + 12345;
+        bool repeat = ((i + 0x400) & 0x1FFF) < 0x800;
+        image[i] = repeat ? (uint8)(i >> 13) : (uint8)(state >> 16);
+    }
+}
+
+/* Write a file, returns false if it could not be written. */
+static bool writeFile(const char *path, const uint8 *data, uint32 size)
+{
+    FILE *file = fopen(path, "wb");
+    if (NULL == file) {
+        return false;
+    }
+    bool written = size == fwrite(data, 1, size, file);
+    return 0 == fclose(file) && written;
+}
+
+/* Check if media loaded with the image. */
+static bool sameImage(const MEDIA &media, int format, const uint8 *image, uint32 size)
+{
+    return NULL != media.image && format == media.format && size == media.size && size == media.ready
+           && 0 == memcmp(media.image, image, size);
+}
+
+/* Raw and gzip images load the same bytes, eagerly and a bank at a time, and a gzip member that claims a size
+   past the limits or whose CRC does not match fails to load, as does a truncated zip. */
+uint32 testMedia()
+{
+    uint32 failures = 0;
+    uint8 *image = (uint8 *)malloc(MEDIA_CHECK_SIZE);
+    uint8 *gzip = (uint8 *)malloc(2 * MEDIA_CHECK_SIZE + 32);
+    if (NULL == image || NULL == gzip) {
+        free(image);
+        free(gzip);
+        return 1;
+    }
+    fillImage(image, MEDIA_CHECK_SIZE);
+    uint32 gzipSize = gzipFixed(image, MEDIA_CHECK_SIZE, gzip);
+    TEST_CHECK(gzipSize < MEDIA_CHECK_SIZE);
+    TEST_CHECK(writeFile(MEDIA_RAW_PATH, image, MEDIA_CHECK_SIZE));
+    TEST_CHECK(writeFile(MEDIA_GZIP_PATH, gzip, gzipSize));
+
+    MEDIA media = loadMedia((usz)MEDIA_RAW_PATH);
+    TEST_CHECK(sameImage(media, MEDIA_FORMAT_RAW, image, MEDIA_CHECK_SIZE) && NULL == media.buffer);
+    unloadMedia(&media);
+
+    media = loadMedia((usz)MEDIA_GZIP_PATH);
+    TEST_CHECK(sameImage(media, MEDIA_FORMAT_GZIP, image, MEDIA_CHECK_SIZE));
+    unloadMedia(&media);
+
+    /* Banks touched out of order inflate the stream up to their end. */
+    media = loadMediaEx((usz)MEDIA_GZIP_PATH, MEDIA_LOAD_LAZY);
+    TEST_CHECK(NULL != media.image && 0 == media.ready);
+    const uint8 *bank = mediaBank(&media, 2);
+    TEST_CHECK(NULL != bank && 0 == memcmp(bank, image + 2 * MEDIA_BANK_SIZE, MEDIA_BANK_SIZE));
+    TEST_CHECK(media.ready >= 3 * MEDIA_BANK_SIZE && media.ready < MEDIA_CHECK_SIZE);
+    bank = mediaBank(&media, 0);
+    TEST_CHECK(NULL != bank && 0 == memcmp(bank, image, MEDIA_BANK_SIZE));
+    TEST_CHECK(mediaEnsure(&media, MEDIA_CHECK_SIZE));
+    TEST_CHECK(sameImage(media, MEDIA_FORMAT_GZIP, image, MEDIA_CHECK_SIZE) && NULL == media.pInflate);
+    TEST_CHECK(NULL == mediaBank(&media, MEDIA_CHECK_SIZE / MEDIA_BANK_SIZE));
+    unloadMedia(&media);
+
+    /* A size past MEDIA_MAX_SIZE, a size the stream cannot reach and a wrong CRC. */
+    putLong(gzip + gzipSize - 4, MEDIA_MAX_SIZE + 1);
+    TEST_CHECK(writeFile(MEDIA_GZIP_PATH, gzip, gzipSize));
+    media = loadMedia((usz)MEDIA_GZIP_PATH);
+    TEST_CHECK(NULL == media.image);
+    unloadMedia(&media);
+
+    putLong(gzip + gzipSize - 4, MEDIA_CHECK_SIZE + 1);
+    TEST_CHECK(writeFile(MEDIA_GZIP_PATH, gzip, gzipSize));
+    media = loadMedia((usz)MEDIA_GZIP_PATH);
+    TEST_CHECK(NULL == media.image);
+    unloadMedia(&media);
+
+    putLong(gzip + gzipSize - 4, MEDIA_CHECK_SIZE);
+    gzip[gzipSize - 8] ^= 0x01;
+    TEST_CHECK(writeFile(MEDIA_GZIP_PATH, gzip, gzipSize));
+    media = loadMedia((usz)MEDIA_GZIP_PATH);
+    TEST_CHECK(NULL == media.image);
+    unloadMedia(&media);
+
+    /* A zip shorter than a central directory entry, whose directory offset points far past its end. */
+    static const uint8 TRUNCATED_ZIP[] = {
+        0x50, 0x4B, 0x03, 0x04,                             /* local header signature */
+        0x50, 0x4B, 0x05, 0x06, 0x00, 0x00, 0x00, 0x00,     /* end of central directory */
+        0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,     /* one entry */
+        0xF0, 0xFF, 0xFF, 0x7F, 0x00, 0x00,                 /* directory at 0x7FFFFFF0, no comment */
+    };
+    TEST_CHECK(writeFile(MEDIA_ZIP_PATH, TRUNCATED_ZIP, sizeof(TRUNCATED_ZIP)));
+    media = loadMedia((usz)MEDIA_ZIP_PATH);
+    TEST_CHECK(NULL == media.image);
+    unloadMedia(&media);
+
+    remove(MEDIA_RAW_PATH);
+    remove(MEDIA_GZIP_PATH);
+    remove(MEDIA_ZIP_PATH);
+    free(gzip);
+    free(image);
+    return failures;
+}
+
+#define MEDIA_BENCH_LOADS       20
+
+/* Measure the milliseconds to load a file and read its first bank. */
+static void benchLoad(const char *kind, const char *path, uint32 flags)
+{
+    double start = BENCH_CLOCK_MS();
+    for (uint32 i = 0; i < MEDIA_BENCH_LOADS; ++i) {
+        MEDIA media = loadMediaEx((usz)path, flags);
+        mediaBank(&media, 0);
+        unloadMedia(&media);
+    }
+    double ms = (BENCH_CLOCK_MS() - start) / MEDIA_BENCH_LOADS;
+    printf("media %-10s %8.3f ms cold start %8.1f MB/s\n", kind, ms, MEDIA_BENCH_SIZE / ms / 1000.0);
+}
+
+/* Cold start of a 1MB image, raw, inflated at load and inflated a bank at a time. */
+void benchMedia()
+{
+    uint8 *image = (uint8 *)malloc(MEDIA_BENCH_SIZE);
+    uint8 *gzip = (uint8 *)malloc(2 * MEDIA_BENCH_SIZE + 32);
+    if (NULL != image && NULL != gzip) {
+        fillImage(image, MEDIA_BENCH_SIZE);
+        uint32 gzipSize = gzipFixed(image, MEDIA_BENCH_SIZE, gzip);
+        if (writeFile(MEDIA_RAW_PATH, image, MEDIA_BENCH_SIZE) && writeFile(MEDIA_GZIP_PATH, gzip, gzipSize)) {
+            benchLoad("raw", MEDIA_RAW_PATH, 0);
+            benchLoad("gzip", MEDIA_GZIP_PATH, 0);
+            benchLoad("gzip lazy", MEDIA_GZIP_PATH, MEDIA_LOAD_LAZY);
+        }
+        remove(MEDIA_RAW_PATH);
+        remove(MEDIA_GZIP_PATH);
+    }
+    free(gzip);
+    free(image);
+}
+
+#undef MEDIA_BENCH_LOADS
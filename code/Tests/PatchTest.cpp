@@ -0,0 +1,234 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "Tests/Test.hpp"
+#include "Media/Crc32.hpp"
+#include "Media/Media.hpp"
+#include "Media/Patch.hpp"
+
+/* Files written by the patch checks into the working directory, removed when they are done. */
+#define PATCH_BASE_PATH         "sines-patch.sfc"
+#define PATCH_IPS_PATH          "sines-patch.ips"
+#define PATCH_BPS_PATH          "sines-patch.bps"
+
+/* Size of the base image, and the most a patched image or a patch of the checks grows to. */
+#define PATCH_BASE_SIZE         0x00010000
+#define PATCH_MAX_SIZE          0x00020000
+
+/* A patch as it is built. */
+typedef struct _PATCH_WRITER {
+    uint8  *out;
+    uint32  pos;
+} PATCH_WRITER;
+
+static void putBytes(PATCH_WRITER &writer, const void *data, uint32 size)
+{
+    memcpy(writer.out + writer.pos, data, size);
+    writer.pos += size;
+}
+
+/* Put an IPS record, big endian, a run of one byte if run is set. */
+static void putIps(PATCH_WRITER &writer, uint32 offset, uint32 size, const uint8 *data, bool run)
+{
+    uint8 record[7] = { (uint8)(offset >> 16), (uint8)(offset >> 8), (uint8)offset, 0, 0, 0, 0 };
+    if (run) {
+        record[5] = (uint8)(size >> 8);
+        record[6] = (uint8)size;
+        putBytes(writer, record, 7);
+        putBytes(writer, data, 1);
+    } else {
+        record[3] = (uint8)(size >> 8);
+        record[4] = (uint8)size;
+        putBytes(writer, record, 5);
+        putBytes(writer, data, size);
+    }
+}
+
+/* Put a BPS variable length number. */
+static void putNumber(PATCH_WRITER &writer, uint32 value)
+{
+    for (;;) {
+        uint8 x = (uint8)(value & 0x7F);
+        value >>= 7;
+        if (0 == value) {
+            writer.out[writer.pos++] = 0x80 | x;
+            return;
+        }
+        writer.out[writer.pos++] = x;
+        --value;
+    }
+}
+
+/* Put a BPS action, with the relative offset of a copy, negative if back is set. */
+static void putAction(PATCH_WRITER &writer, uint32 action, uint32 length)
+{
+    putNumber(writer, ((length - 1) << 2) | action);
+}
+static void putCopy(PATCH_WRITER &writer, uint32 action, uint32 length, uint32 offset, bool back)
+{
+    putAction(writer, action, length);
+    putNumber(writer, (offset << 1) | (back ? 1 : 0));
+}
+
+static void putLong(PATCH_WRITER &writer, uint32 value)
+{
+    uint8 data[4] = { (uint8)value, (uint8)(value >> 8), (uint8)(value >> 16), (uint8)(value >> 24) };
+    putBytes(writer, data, 4);
+}
+
+/* Write a file, returns false if it could not be written. */
+static bool writePatchFile(const char *path, const uint8 *data, uint32 size)
+{
+    FILE *file = fopen(path, "wb");
+    if (NULL == file) {
+        return false;
+    }
+    bool written = size == fwrite(data, 1, size, file);
+    return 0 == fclose(file) && written;
+}
+
+/* Check a patch loads over the base image as the expected image, and that the base file is left alone. */
+static bool samePatched(const char *patchPath, const uint8 *expected, uint32 size, const uint8 *base)
+{
+    MEDIA media = loadPatchedMedia((usz)PATCH_BASE_PATH, (usz)patchPath, 0);
+    bool same = NULL != media.image && size == media.size && size == media.ready
+                && 0 == memcmp(media.image, expected, size);
+    unloadMedia(&media);
+    media = loadMedia((usz)PATCH_BASE_PATH);
+    same = same && NULL != media.image && 0 == memcmp(media.image, base, PATCH_BASE_SIZE);
+    unloadMedia(&media);
+    return same;
+}
+
+/* Check a patch does not load over the base image. */
+static bool rejected(const char *patchPath)
+{
+    MEDIA media = loadPatchedMedia((usz)PATCH_BASE_PATH, (usz)patchPath, 0);
+    bool failed = NULL == media.image;
+    unloadMedia(&media);
+    return failed;
+}
+
+/* IPS patches write their records and runs in place, grow the image to their last record with zeros before it,
+   and cut it to the size after their EOF.  BPS patches read from the patch, copy from anywhere in the source and
+   repeat bytes already written, and are rejected when their own, source or target CRC does not match. */
+uint32 testPatch()
+{
+    uint32 failures = 0;
+    uint8 *base = (uint8 *)malloc(PATCH_BASE_SIZE);
+    uint8 *expected = (uint8 *)malloc(PATCH_MAX_SIZE);
+    uint8 *patch = (uint8 *)malloc(PATCH_MAX_SIZE);
+    if (NULL == base || NULL == expected || NULL == patch) {
+        free(base);
+        free(expected);
+        free(patch);
+        return 1;
+    }
+    uint32 state = 0x2545F491;
+    for (uint32 i = 0; i < PATCH_BASE_SIZE; ++i) {
+        state = state * 1103515245 + 12345;
+        base[i] = (uint8)(state >> 16);
+    }
+    TEST_CHECK(writePatchFile(PATCH_BASE_PATH, base, PATCH_BASE_SIZE));
+    static const uint8 DATA[] = { 'S', 'i', 'N', 'E', 'S', 0x00, 0xFF, 0x5A };
+    PATCH_INFO info;
+
+    /* A record and a run, in place. */
+    PATCH_WRITER writer = { patch, 0 };
+    putBytes(writer, "PATCH", 5);
+    putIps(writer, 0x0100, sizeof(DATA), DATA, false);
+    putIps(writer, 0x2000, 0x0300, DATA + 7, true);
+    putBytes(writer, "EOF", 3);
+    memcpy(expected, base, PATCH_BASE_SIZE);
+    memcpy(expected + 0x0100, DATA, sizeof(DATA));
+    memset(expected + 0x2000, DATA[7], 0x0300);
+    TEST_CHECK(inspectPatch(patch, writer.pos, PATCH_BASE_SIZE, &info));
+    TEST_CHECK(PATCH_FORMAT_IPS == info.format && PATCH_BASE_SIZE == info.targetSize && !info.hasCrc);
+    TEST_CHECK(writePatchFile(PATCH_IPS_PATH, patch, writer.pos));
+    TEST_CHECK(samePatched(PATCH_IPS_PATH, expected, PATCH_BASE_SIZE, base));
+
+    /* Records past the end grow the image, zero filled up to them. */
+    writer.pos = 0;
+    putBytes(writer, "PATCH", 5);
+    putIps(writer, 0x10100, sizeof(DATA), DATA, false);
+    putIps(writer, 0x10100 + sizeof(DATA), 0x0020, DATA + 4, true);
+    putBytes(writer, "EOF", 3);
+    memcpy(expected, base, PATCH_BASE_SIZE);
+    memset(expected + PATCH_BASE_SIZE, 0x00, 0x0100);
+    memcpy(expected + 0x10100, DATA, sizeof(DATA));
+    memset(expected + 0x10100 + sizeof(DATA), DATA[4], 0x0020);
+    TEST_CHECK(inspectPatch(patch, writer.pos, PATCH_BASE_SIZE, &info));
+    TEST_CHECK(0x10128 == info.targetSize);
+    TEST_CHECK(writePatchFile(PATCH_IPS_PATH, patch, writer.pos));
+    TEST_CHECK(samePatched(PATCH_IPS_PATH, expected, 0x10128, base));
+
+    /* A size after the EOF cuts the image, records past it are dropped. */
+    writer.pos = 0;
+    putBytes(writer, "PATCH", 5);
+    putIps(writer, 0x0010, sizeof(DATA), DATA, false);
+    putIps(writer, 0x9000, sizeof(DATA), DATA, false);
+    putBytes(writer, "EOF\x00\x80\x00", 6);
+    memcpy(expected, base, 0x8000);
+    memcpy(expected + 0x0010, DATA, sizeof(DATA));
+    TEST_CHECK(inspectPatch(patch, writer.pos, PATCH_BASE_SIZE, &info));
+    TEST_CHECK(0x8000 == info.targetSize);
+    TEST_CHECK(writePatchFile(PATCH_IPS_PATH, patch, writer.pos));
+    TEST_CHECK(samePatched(PATCH_IPS_PATH, expected, 0x8000, base));
+
+    /* Source, patch, a source copy forward, a target copy repeating the 3 bytes before it, and a source copy
+       back to the rest of the image. */
+    writer.pos = 0;
+    putBytes(writer, "BPS1", 4);
+    putNumber(writer, PATCH_BASE_SIZE);
+    putNumber(writer, PATCH_BASE_SIZE);
+    putNumber(writer, 0);
+    putAction(writer, 0, 0x1000);
+    putAction(writer, 1, sizeof(DATA));
+    putBytes(writer, DATA, sizeof(DATA));
+    putCopy(writer, 2, 0x1000, 0x8000, false);
+    putCopy(writer, 3, 0x0100, 0x2005, false);
+    putCopy(writer, 2, PATCH_BASE_SIZE - 0x2108, 0x9000 - 0x2108, true);
+    memcpy(expected, base, PATCH_BASE_SIZE);
+    memcpy(expected + 0x1000, DATA, sizeof(DATA));
+    memcpy(expected + 0x1008, base + 0x8000, 0x1000);
+    for (uint32 i = 0; i < 0x0100; ++i) {
+        expected[0x2008 + i] = expected[0x2005 + i % 3];
+    }
+    uint32 actions = writer.pos;
+    putLong(writer, crc32(0, base, PATCH_BASE_SIZE));
+    putLong(writer, crc32(0, expected, PATCH_BASE_SIZE));
+    putLong(writer, crc32(0, patch, writer.pos));
+    TEST_CHECK(inspectPatch(patch, writer.pos, PATCH_BASE_SIZE, &info));
+    TEST_CHECK(PATCH_FORMAT_BPS == info.format && PATCH_BASE_SIZE == info.targetSize && info.hasCrc);
+    TEST_CHECK(!inspectPatch(patch, writer.pos, PATCH_BASE_SIZE - 1, &info));
+    TEST_CHECK(writePatchFile(PATCH_BPS_PATH, patch, writer.pos));
+    TEST_CHECK(samePatched(PATCH_BPS_PATH, expected, PATCH_BASE_SIZE, base));
+
+    /* A corrupt patch, then patches with their own CRC fixed up over the wrong source and target CRCs. */
+    uint32 size = writer.pos;
+    patch[actions - 1] ^= 0x01;
+    TEST_CHECK(!inspectPatch(patch, size, PATCH_BASE_SIZE, &info));
+    TEST_CHECK(writePatchFile(PATCH_BPS_PATH, patch, size));
+    TEST_CHECK(rejected(PATCH_BPS_PATH));
+    patch[actions - 1] ^= 0x01;
+    for (uint32 i = 0; i < 2; ++i) {
+        patch[actions + 4 * i] ^= 0x01;
+        writer.pos = size - 4;
+        putLong(writer, crc32(0, patch, writer.pos));
+        TEST_CHECK(inspectPatch(patch, size, PATCH_BASE_SIZE, &info));
+        TEST_CHECK(writePatchFile(PATCH_BPS_PATH, patch, size));
+        TEST_CHECK(rejected(PATCH_BPS_PATH));
+        patch[actions + 4 * i] ^= 0x01;
+    }
+
+    remove(PATCH_BASE_PATH);
+    remove(PATCH_IPS_PATH);
+    remove(PATCH_BPS_PATH);
+    free(patch);
+    free(expected);
+    free(base);
+    return failures;
+}
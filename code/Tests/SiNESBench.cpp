@@ -0,0 +1,55 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#include <string.h>
+#include "Tests/Test.hpp"
+
+/* Benchmarks by name. */
+typedef struct _BENCH {
+    const char *name;
+    BENCH_FN    fn;
+} BENCH;
+
+static const BENCH BENCHES[] = {
+    { "lr35902-dispatch",   &benchLR35902Dispatch },
+    { "lr35902-alu",        &benchLR35902Alu },
+    { "lr35902-jit",        &benchLR35902Jit },
+    { "lr35902-timing",     &benchLR35902Timing },
+    { "lr35902-registers",  &benchLR35902Registers },
+    { "lr35902-cb",         &benchLR35902Cb },
+    { "bus",                &benchBus },
+    { "media",              &benchMedia },
+    { "w65c816",            &benchW65C816 },
+    { "dma",                &benchDma },
+    { "hdma",               &benchHdma },
+};
+
+/**
+ * Run the named benchmarks, or every benchmark without arguments.
+ *
+ * @param argc      [IN]        Number of arguments.
+ * @param argv      [IN]        The program and the names of the benchmarks to run.
+ *
+ * @return 0 if a benchmark ran, 1 if none matched.
+ */
+int main(int argc, char **argv)
+{
+    uint32 run = 0;
+    for (uint32 i = 0; i < sizeof(BENCHES) / sizeof(BENCHES[0]); ++i) {
+        bool selected = (argc < 2);
+        for (int arg = 1; arg < argc; ++arg) {
+            selected = selected || 0 == strcmp(argv[arg], BENCHES[i].name);
+        }
+        if (!selected) {
+            continue;
+        }
+        BENCHES[i].fn();
+        ++run;
+    }
+    if (0 == run) {
+        printf("no benchmark matched\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#include <string.h>
+#include "Tests/Test.hpp"
+
+/* Tests by name. */
+typedef struct _TEST {
+    const char *name;
+    TEST_FN     fn;
+} TEST;
+
+static const TEST TESTS[] = {
+    { "lr35902-flags",      &testLR35902Flags },
+    { "lr35902-dispatch",   &testLR35902Dispatch },
+    { "lr35902-timing",     &testLR35902Timing },
+    { "lr35902-registers",  &testLR35902Registers },
+    { "lr35902-cb",         &testLR35902Cb },
+    { "lr35902-jit",        &testLR35902Jit },
+    { "lr35902-interrupts", &testLR35902Interrupts },
+    { "lr35902-lockup",     &testLR35902Lockup },
+    { "lr35902-mirror",     &testLR35902Mirror },
+    { "lr35902-banks",      &testLR35902Banks },
+    { "lr35902-fusion",     &testLR35902Fusion },
+    { "lr35902-halt",       &testLR35902Halt },
+    { "lr35902-idle",       &testLR35902Idle },
+    { "bus",                &testBus },
+    { "arena",              &testArena },
+    { "gameboy",            &testGameBoy },
+    { "media",              &testMedia },
+    { "cartridge",          &testCartridge },
+    { "patch",              &testPatch },
+    { "title",              &testTitle },
+    { "w65c816",            &testW65C816 },
+    { "w65c816-blocks",     &testW65C816Blocks },
+    { "dma",                &testDma },
+    { "hdma",               &testHdma },
+};
+
+/**
+ * Run the named tests, or every test without arguments.
+ *
+ * @param argc      [IN]        Number of arguments.
+ * @param argv      [IN]        The program and the names of the tests to run.
+ *
+ * @return 0 if every check passed, 1 otherwise.
+ */
+int main(int argc, char **argv)
+{
+    uint32 failures = 0;
+    uint32 run = 0;
+    for (uint32 i = 0; i < sizeof(TESTS) / sizeof(TESTS[0]); ++i) {
+        bool selected = (argc < 2);
+        for (int arg = 1; arg < argc; ++arg) {
+            selected = selected || 0 == strcmp(argv[arg], TESTS[i].name);
+        }
+        if (!selected) {
+            continue;
+        }
+        uint32 failed = TESTS[i].fn();
+        printf("%-24s %s\n", TESTS[i].name, (0 == failed) ? "passed" : "FAILED");
+        failures += failed;
+        ++run;
+    }
+    if (0 == run) {
+        printf("no test matched\n");
+        return 1;
+    }
+    return (0 == failures) ? 0 : 1;
+}
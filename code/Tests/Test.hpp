@@ -0,0 +1,138 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#ifndef SINES_TEST_H                /* START: HEADER GUARD */
+#define SINES_TEST_H
+
+#include <stdio.h>
+#include <time.h>
+#include "xplat/types.hpp"
+
+/* Check a condition, a failure is reported with its location and counted in the failures of the test. */
+#define TEST_CHECK(COND)                                                                    \
+    do {                                                                                    \
+        if (!(COND)) {                                                                      \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #COND);                 \
+            ++failures;                                                                     \
+        }                                                                                   \
+    } while (0)
+
+/* Processor time in milliseconds, for the benchmarks. */
+#define BENCH_CLOCK_MS()        ((double)clock() * 1000.0 / CLOCKS_PER_SEC)
+
+/* A test, returns the number of failed checks. */
+typedef uint32 (*TEST_FN)();
+
+/* A benchmark, prints its measurements. */
+typedef void (*BENCH_FN)();
+
+/* Tests run by sines-test, see SiNESTest.cpp. */
+uint32 testLR35902Flags();
+uint32 testLR35902Dispatch();
+uint32 testLR35902Timing();
+uint32 testLR35902Registers();
+uint32 testLR35902Cb();
+uint32 testLR35902Jit();
+uint32 testLR35902Interrupts();
+uint32 testLR35902Lockup();
+uint32 testLR35902Mirror();
+uint32 testLR35902Banks();
+uint32 testLR35902Fusion();
+uint32 testLR35902Halt();
+uint32 testLR35902Idle();
+uint32 testBus();
+uint32 testArena();
+uint32 testGameBoy();
+uint32 testMedia();
+uint32 testCartridge();
+uint32 testPatch();
+uint32 testTitle();
+uint32 testW65C816();
+uint32 testW65C816Blocks();
+uint32 testDma();
+uint32 testHdma();
+
+/* Benchmarks run by sines-bench, see SiNESBench.cpp. */
+void benchLR35902Dispatch();
+void benchLR35902Alu();
+void benchLR35902Jit();
+void benchLR35902Timing();
+void benchLR35902Registers();
+void benchLR35902Cb();
+void benchBus();
+void benchMedia();
+void benchW65C816();
+void benchDma();
+void benchHdma();
+
+/* Run ops of a program from 0x0000 through one build variant of the LR35902 core, see LR35902Variant.cpp.
+   The memory is attached flat, 0x0000-0x7FFF read only, with 0xE000-0xFDFF mirroring 0xC000-0xDDFF as echo RAM
+   does on the Game Boy, and return the clock cycles taken (0 without a cycle counter).  The block variants run
+   whole blocks for a cycle budget of at least that many ops, so the program has to end in a loop that leaves the
+   memory alone.  The run functions
+   run a looping program for the benchmarks until the pass counter it keeps at 0xC000 reaches a count, and return
+   the bytes of the tables the variant shares between processors. */
+uint64 traceEager(uint8 *memory, uint32 ops);
+uint32 runEager(uint8 *memory, uint32 passes);
+uint64 traceSwitch(uint8 *memory, uint32 ops);
+uint32 runSwitch(uint8 *memory, uint32 passes);
+uint64 traceLazy(uint8 *memory, uint32 ops);
+uint32 runLazy(uint8 *memory, uint32 passes);
+uint64 traceAluTable(uint8 *memory, uint32 ops);
+uint32 runAluTable(uint8 *memory, uint32 passes);
+uint64 traceAccess(uint8 *memory, uint32 ops);
+uint32 runAccess(uint8 *memory, uint32 passes);
+uint64 traceUntimed(uint8 *memory, uint32 ops);
+uint32 runUntimed(uint8 *memory, uint32 passes);
+uint64 traceBlocks(uint8 *memory, uint32 ops);
+uint32 runBlocks(uint8 *memory, uint32 passes);
+uint64 traceJit(uint8 *memory, uint32 ops);
+uint32 runJit(uint8 *memory, uint32 passes);
+uint64 traceJitLazy(uint8 *memory, uint32 ops);
+uint32 runJitLazy(uint8 *memory, uint32 passes);
+
+/* Run a program from 0x0000 through runUntil in slices of a cycle budget with the timer interrupt scheduled, through
+   a block variant of the LR35902 core, see LR35902Variant.cpp.  Returns the clock cycles taken and counts the
+   interrupts taken and the loop iterations run fused. */
+uint64 sliceBlocks(uint8 *memory, uint32 slices, uint32 budget, uint64 interrupt, uint64 &taken, uint64 &fused);
+uint64 sliceUnfused(uint8 *memory, uint32 slices, uint32 budget, uint64 interrupt, uint64 &taken, uint64 &fused);
+uint64 sliceJit(uint8 *memory, uint32 slices, uint32 budget, uint64 interrupt, uint64 &taken, uint64 &fused);
+uint64 sliceJitLazy(uint8 *memory, uint32 slices, uint32 budget, uint64 interrupt, uint64 &taken, uint64 &fused);
+
+/* Run the block cache checks of a block variant of the LR35902 core, see LR35902Variant.cpp. */
+uint32 checkBanksBlocks();
+uint32 checkBanksJit();
+uint32 checkEventsBlocks();
+uint32 checkEventsJit();
+uint32 checkHaltBlocks();
+uint32 checkHaltJit();
+uint32 checkIdleBlocks();
+uint32 checkIdleJit();
+
+/* Run the snapshot check of a block variant of the LR35902 core on a session of a ROM, see LR35902Variant.cpp. */
+uint32 checkSnapshotBlocks(const char *path);
+uint32 checkSnapshotJit(const char *path);
+
+/* Run the functional and block cache checks of one build variant of the 65c816 core, and measure its speed, see
+   W65C816Variant.cpp. */
+uint32 checkW65C816Access();
+void benchW65C816Access(const char *variant);
+uint32 checkW65C816Fixed();
+void benchW65C816Fixed(const char *variant);
+uint32 checkBlocksAccess();
+uint32 checkBlocksFixed();
+
+/* Run the DMA checks with the processor of one build variant, and measure the transfers, see W65C816Variant.cpp. */
+uint32 checkDmaAccess();
+void benchDmaAccess(const char *variant);
+uint32 checkDmaFixed();
+void benchDmaFixed(const char *variant);
+
+/* Run the HDMA checks with the processor of one build variant, and measure the lines, see W65C816Variant.cpp. */
+uint32 checkHdmaAccess();
+void benchHdmaAccess(const char *variant);
+uint32 checkHdmaFixed();
+void benchHdmaFixed(const char *variant);
+
+#endif                              /* END: HEADER GUARD */
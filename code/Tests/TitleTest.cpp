@@ -0,0 +1,91 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "Tests/Test.hpp"
+#include "Media/Title.hpp"
+
+/* Files written by the title checks into the working directory, removed when they are done. */
+#define TITLE_IMAGE_PATH        "sines-title.sfc"
+#define TITLE_PATCH_PATH        "sines-title.ips"
+#define TITLE_MISSING_PATH      "sines-title-missing.sfc"
+#define TITLE_IMAGE_SIZE        0x8000
+
+/* A LoROM header at $7FC0 with its reset vector on a sei at $8000. */
+static const uint8 TITLE_HEADER[] = {
+    'S', 'I', 'N', 'E', 'S', ' ', 'T', 'I', 'T', 'L', 'E', ' ', 'C', 'H', 'E', 'C', 'K', ' ', ' ', ' ', ' ',
+    0x20, 0x00, 0x08, 0x00, 0x01, 0x00, 0x00, 0xCB, 0xED, 0x34, 0x12,
+};
+
+/* An IPS patch writing 0x42 over the first byte. */
+static const uint8 TITLE_PATCH[] = {
+    'P', 'A', 'T', 'C', 'H', 0x00, 0x00, 0x00, 0x00, 0x01, 0x42, 'E', 'O', 'F',
+};
+
+/* Write the image with a byte at its start, returns false if it could not be written. */
+static bool writeTitle(uint8 *image, uint8 first)
+{
+    image[0] = first;
+    FILE *file = fopen(TITLE_IMAGE_PATH, "wb");
+    if (NULL == file) {
+        return false;
+    }
+    bool written = TITLE_IMAGE_SIZE == fwrite(image, 1, TITLE_IMAGE_SIZE, file);
+    return 0 == fclose(file) && written;
+}
+
+/* Holders of one image and patch share one title with its cartridge identified, another patch or none is
+   another title, a title stays loaded until its last holder releases it, and is loaded again from the file
+   when it is acquired after that. */
+uint32 testTitle()
+{
+    uint32 failures = 0;
+    static uint8 image[TITLE_IMAGE_SIZE];
+    memset(image, 0x00, sizeof(image));
+    memcpy(image + 0x7FC0, TITLE_HEADER, sizeof(TITLE_HEADER));
+    image[0x7FFC] = 0x00;
+    image[0x7FFD] = 0x80;
+    TEST_CHECK(writeTitle(image, 0x78));
+    FILE *file = fopen(TITLE_PATCH_PATH, "wb");
+    if (NULL == file) {
+        return failures + 1;
+    }
+    bool written = sizeof(TITLE_PATCH) == fwrite(TITLE_PATCH, 1, sizeof(TITLE_PATCH), file);
+    TEST_CHECK(0 == fclose(file) && written);
+
+    LPTITLE pTitle = acquireTitle((usz)TITLE_IMAGE_PATH, NULL);
+    LPTITLE pShared = acquireTitle((usz)TITLE_IMAGE_PATH, NULL);
+    LPTITLE pPatched = acquireTitle((usz)TITLE_IMAGE_PATH, (usz)TITLE_PATCH_PATH);
+    TEST_CHECK(NULL == acquireTitle((usz)TITLE_MISSING_PATH, NULL));
+    if (NULL == pTitle || NULL == pPatched) {
+        remove(TITLE_IMAGE_PATH);
+        remove(TITLE_PATCH_PATH);
+        return failures + 1;
+    }
+    TEST_CHECK(pShared == pTitle && 2 == pTitle->refs && pPatched != pTitle && 1 == pPatched->refs);
+    TEST_CHECK(pTitle->hasCart && CARTRIDGE_MAP_LOROM == pTitle->cart.map && 15 == pTitle->cart.score);
+    TEST_CHECK(0 == strcmp("SINES TITLE CHECK    ", pTitle->cart.title));
+    TEST_CHECK(TITLE_IMAGE_SIZE == pTitle->media.size && 0 == memcmp(pTitle->media.image, image, TITLE_IMAGE_SIZE));
+    TEST_CHECK(0x42 == pPatched->media.image[0] && 0 == memcmp(pPatched->media.image + 1, image + 1, 0x7FFF));
+    TEST_CHECK(pPatched->hasCart && 13 == pPatched->cart.score);
+    TEST_CHECK(titleBytes(pTitle) >= sizeof(TITLE));
+
+    releaseTitle(pShared);
+    TEST_CHECK(1 == pTitle->refs && 0x78 == pTitle->media.image[0]);
+    releaseTitle(pTitle);
+    releaseTitle(pPatched);
+
+    /* Released titles are gone, the image is read again. */
+    TEST_CHECK(writeTitle(image, 0x18));
+    pTitle = acquireTitle((usz)TITLE_IMAGE_PATH, NULL);
+    TEST_CHECK(NULL != pTitle && 1 == pTitle->refs && 0x18 == pTitle->media.image[0]);
+    if (NULL != pTitle) {
+        releaseTitle(pTitle);
+    }
+
+    remove(TITLE_IMAGE_PATH);
+    remove(TITLE_PATCH_PATH);
+    return failures;
+}
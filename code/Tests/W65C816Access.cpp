@@ -0,0 +1,10 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+/* The 65c816 core timing each memory access by its address, see W65C816Variant.cpp. */
+#undef W65C816_TIMING
+#define W65C816_TIMING          W65C816_TIMING_ACCESS
+#define SiNES                   SiNESAccess
+#define W65C816_VARIANT(NAME)   NAME##Access
+#include "Tests/W65C816Variant.cpp"
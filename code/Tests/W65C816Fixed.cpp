@@ -0,0 +1,10 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+/* The 65c816 core timing every cycle at W65C816_FIXED_SPEED, see W65C816Variant.cpp. */
+#undef W65C816_TIMING
+#define W65C816_TIMING          W65C816_TIMING_FIXED
+#define SiNES                   SiNESFixed
+#define W65C816_VARIANT(NAME)   NAME##Fixed
+#include "Tests/W65C816Variant.cpp"
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+#include "Tests/Test.hpp"
+
+/* Arithmetic, block moves, calls and interrupts give the same memory in every variant, and
+   each variant takes the cycles of its timing model. */
+uint32 testW65C816()
+{
+    uint32 failures = 0;
+    failures += checkW65C816Access();
+    failures += checkW65C816Fixed();
+    return failures;
+}
+
+/* Writes into decoded code, directly or through a mirror, other memory mapped over it and mode switches between
+   runs of the same code run the ops the memory and mode hold, in every variant. */
+uint32 testW65C816Blocks()
+{
+    uint32 failures = 0;
+    failures += checkBlocksAccess();
+    failures += checkBlocksFixed();
+    return failures;
+}
+
+/* Ops per second of the 65c816, op by op through the mode tables and through the block cache, with every access
+   timed by its address and with every cycle at the fixed speed. */
+void benchW65C816()
+{
+    benchW65C816Access("access");
+    benchW65C816Fixed("fixed");
+}
+
+/* Bulk VRAM transfers leave the same VRAM, registers and stall as byte by byte transfers, and fixed and B bus to
+   A bus transfers move their bytes, under either timing model. */
+uint32 testDma()
+{
+    uint32 failures = 0;
+    failures += checkDmaAccess();
+    failures += checkDmaFixed();
+    return failures;
+}
+
+/* Bytes per second of DMA into VRAM, one byte at a time through the B bus handlers and copied in bulk. */
+void benchDma()
+{
+    benchDmaAccess("access");
+}
+
+/* HDMA lines read ahead write and stall as the lines evaluated as they run, through a table rewritten in the middle
+   of the frame, under either timing model. */
+uint32 testHdma()
+{
+    uint32 failures = 0;
+    failures += checkHdmaAccess();
+    failures += checkHdmaFixed();
+    return failures;
+}
+
+/* Lines per second of HDMA, read ahead at the start of the frame and evaluated as each line runs. */
+void benchHdma()
+{
+    benchHdmaAccess("access");
+}
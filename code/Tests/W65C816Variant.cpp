@@ -0,0 +1,765 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+/*
+One build variant of the 65c816 core for the tests and benchmarks.
+
+Included by W65C816Access.cpp and W65C816Fixed.cpp after they pick the build options and rename the SiNES
+namespace, so every variant of the core links into the one executable.  W65C816_VARIANT(NAME) names the functions
+of the variant.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "Tests/Test.hpp"
+#include "Processors/Processor.cpp"
+#include "Memory/Arena.cpp"
+#include "Memory/LongBus.cpp"
+#include "Processors/Nintendo/5A22/65c816.cpp"
+#include "Processors/Nintendo/5A22/dma.cpp"
+
+using SiNES::Processors::Nintendo::W65C816;
+using SiNES::Processors::Nintendo::DMA;
+using SiNES::Processors::Nintendo::DMA_B_BUS;
+using SiNES::Processors::Nintendo::HDMA_WRITE;
+
+/* Size of the flat memory the programs run over, all 24 bits of address space. */
+#define VARIANT_MEMORY          0x01000000
+
+/* Map flat memory over the whole bus and reset into a program at $00:8000. */
+static void boot(W65C816 &cpu, uint8 *memory)
+{
+    cpu.getBus().map(0, LONG_BUS_PAGE_COUNT, memory, true);
+    memory[W65C816_VECTOR_RESET] = 0x00;
+    memory[W65C816_VECTOR_RESET + 1] = 0x80;
+    cpu.reset();
+}
+
+/* Native mode decimal and binary arithmetic at both accumulator widths, with the flags they leave. */
+static const uint8 ARITHMETIC_PROGRAM[] = {
+    0x18, 0xFB,                         /* clc; xce */
+    0xC2, 0x30,                         /* rep #$30 */
+    0xF8,                               /* sed */
+    0xA9, 0x34, 0x12,                   /* lda #$1234 */
+    0x18, 0x69, 0x78, 0x56,             /* clc; adc #$5678          $2000: 6912 */
+    0x8D, 0x00, 0x20,                   /* sta $2000 */
+    0xE2, 0x20,                         /* sep #$20 */
+    0xA9, 0x58,                         /* lda #$58 */
+    0x38, 0x69, 0x46,                   /* sec; adc #$46            $2002: 05 and carry */
+    0x8D, 0x02, 0x20,                   /* sta $2002 */
+    0x08, 0x68, 0x8D, 0x03, 0x20,       /* php; pla; sta $2003 */
+    0xA9, 0x12, 0x38, 0xE9, 0x21,       /* lda #$12; sec; sbc #$21  $2004: 91 and borrow */
+    0x8D, 0x04, 0x20,                   /* sta $2004 */
+    0x08, 0x68, 0x8D, 0x05, 0x20,       /* php; pla; sta $2005 */
+    0xD8,                               /* cld */
+    0xA9, 0x80, 0x18, 0x69, 0x80,       /* lda #$80; clc; adc #$80  $2006: 00 with Z, V and C */
+    0x8D, 0x06, 0x20,                   /* sta $2006 */
+    0x08, 0x68, 0x8D, 0x07, 0x20,       /* php; pla; sta $2007 */
+    0xDB,                               /* stp */
+};
+
+/* Block moves and calls with 16 bit index registers, then xba with an 8 bit accumulator. */
+static const uint8 MOVE_PROGRAM[] = {
+    0x18, 0xFB, 0xC2, 0x30,             /* clc; xce; rep #$30 */
+    0xA9, 0x07, 0x00,                   /* lda #$0007               8 bytes */
+    0xA2, 0x00, 0x30,                   /* ldx #$3000 */
+    0xA0, 0x00, 0x40,                   /* ldy #$4000 */
+    0x54, 0x01, 0x02,                   /* mvn $01,$02              $02:3000 to $01:4000 */
+    0x8B, 0xE2, 0x20, 0x68,             /* phb; sep #$20; pla */
+    0x8F, 0x10, 0x20, 0x00,             /* sta $002010              the destination bank */
+    0x4B, 0xAB,                         /* phk; plb */
+    0x8E, 0x40, 0x20,                   /* stx $2040 */
+    0x8C, 0x42, 0x20,                   /* sty $2042 */
+    0xC2, 0x20,                         /* rep #$20 */
+    0x20, 0x40, 0x80,                   /* jsr $8040 */
+    0x22, 0x00, 0x90, 0x00,             /* jsl $009000 */
+    0xE2, 0x30,                         /* sep #$30 */
+    0xA9, 0xAB, 0xEB, 0xA9, 0xCD,       /* lda #$AB; xba; lda #$CD */
+    0xC2, 0x20, 0x8D, 0x20, 0x20,       /* rep #$20; sta $2020 */
+    0xDB,                               /* stp */
+};
+static const uint8 MOVE_SOURCE[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+static const uint8 MOVE_NEAR[] = { 0xA9, 0x11, 0x22, 0x8D, 0x30, 0x20, 0x60 };  /* $8040: sta $2030; rts */
+static const uint8 MOVE_FAR[] = { 0xA9, 0x33, 0x44, 0x8D, 0x32, 0x20, 0x6B };   /* $9000: sta $2032; rtl */
+
+/* brk in emulation and native mode, then wai until the host asserts the IRQ line. */
+static const uint8 INTERRUPT_PROGRAM[] = {
+    0xA2, 0x00, 0xA0, 0x00,             /* ldx #0; ldy #0 */
+    0x00, 0x99,                         /* brk                      emulation, to $A000 */
+    0xE8,                               /* inx */
+    0x18, 0xFB,                         /* clc; xce */
+    0x00, 0x98,                         /* brk                      native, to $A100 */
+    0xE8,                               /* inx */
+    0x58, 0xCB,                         /* cli; wai */
+    0xE8,                               /* inx                      after the IRQ handler at $A200 */
+    0x8E, 0x50, 0x20,                   /* stx $2050 */
+    0x8C, 0x51, 0x20,                   /* sty $2051 */
+    0xDB,                               /* stp */
+};
+static const uint8 INTERRUPT_BRK[] = { 0xC8, 0x40 };            /* iny; rti */
+static const uint8 INTERRUPT_IRQ[] = { 0xC8, 0xC8, 0x40 };      /* iny; iny; rti */
+
+/* An emulation mode loop taking IRQs, the handler at $A300 counts them. */
+static const uint8 IRQ_LOOP[] = { 0x58, 0x80, 0xFE };           /* cli; bra */
+static const uint8 IRQ_COUNT[] = { 0xEE, 0x70, 0x20, 0x40 };    /* inc $2070; rti */
+
+/* A countdown loop and indexed loads within and across a page, in emulation mode. */
+static const uint8 TIMING_PROGRAM[] = {
+    0xA2, 0x05,                         /* ldx #5                   2 */
+    0xCA,                               /* dex                      2, 5 times */
+    0xD0, 0xFD,                         /* bne                      3 taken 4 times, 2 once */
+    0xBD, 0xFF, 0x20,                   /* lda $20FF,x              4 */
+    0xA2, 0x01,                         /* ldx #1                   2 */
+    0xBD, 0xFF, 0x20,                   /* lda $20FF,x              5, crosses into $2100 */
+    0xDB,                               /* stp                      3 */
+};
+static const uint8 TIMING_JUMP[] = {
+    0x5C, 0x00, 0x80, 0x80,             /* jml $808000 */
+};
+#define TIMING_OPS              32      // Ops stepped, past the stp of either entry.
+#if W65C816_TIMING == W65C816_TIMING_ACCESS
+    /* 26 fetches from slow ROM at 8, the reads of $20FF and $2100 at 6, 10 internal cycles at 6.  FastROM
+       fetches the 26 bytes of the program at 6. */
+    #define TIMING_CYCLES       292
+    #define TIMING_FASTROM      (26 * 2)
+#else
+    #define TIMING_CYCLES       (40 * W65C816_FIXED_SPEED)
+    #define TIMING_FASTROM      0
+#endif
+
+/* Step a program from the reset vector op by op with a MEMSEL value and return the master cycles it took. */
+static uint64 timeProgram(uint8 *memory, uint8 memsel)
+{
+    W65C816 cpu;
+    boot(cpu, memory);
+    cpu.setMemsel(memsel);
+    uint64 start = cpu.cycleCount();
+    for (uint32 i = 0; i < TIMING_OPS; ++i) {
+        cpu.execOp();
+    }
+    return cpu.cycleCount() - start;
+}
+
+/* Run the functional checks of the 65c816 through this variant. */
+uint32 W65C816_VARIANT(checkW65C816)()
+{
+    uint32 failures = 0;
+    uint8 *memory = (uint8 *)calloc(VARIANT_MEMORY, 1);
+    if (NULL == memory) {
+        return 1;
+    }
+
+    {
+        W65C816 cpu;
+        memcpy(memory + 0x8000, ARITHMETIC_PROGRAM, sizeof(ARITHMETIC_PROGRAM));
+        boot(cpu, memory);
+        cpu.runUntil(0, 10000);
+        TEST_CHECK(0x12 == memory[0x2000] && 0x69 == memory[0x2001]);
+        TEST_CHECK(0x05 == memory[0x2002] && (memory[0x2003] & 0x01));
+        TEST_CHECK(0x91 == memory[0x2004] && !(memory[0x2005] & 0x01));
+        TEST_CHECK(0x00 == memory[0x2006] && 0x43 == (memory[0x2007] & 0x43));
+        TEST_CHECK(cpu.getStats().modeSwitches >= 3);
+    }
+
+    memset(memory, 0x00, VARIANT_MEMORY);
+    {
+        W65C816 cpu;
+        memcpy(memory + 0x8000, MOVE_PROGRAM, sizeof(MOVE_PROGRAM));
+        memcpy(memory + 0x8040, MOVE_NEAR, sizeof(MOVE_NEAR));
+        memcpy(memory + 0x9000, MOVE_FAR, sizeof(MOVE_FAR));
+        memcpy(memory + 0x023000, MOVE_SOURCE, sizeof(MOVE_SOURCE));
+        boot(cpu, memory);
+        cpu.runUntil(0, 10000);
+        TEST_CHECK(0 == memcmp(memory + 0x014000, MOVE_SOURCE, sizeof(MOVE_SOURCE)) && 0x00 == memory[0x014008]);
+        TEST_CHECK(0x01 == memory[0x2010]);
+        TEST_CHECK(0x08 == memory[0x2040] && 0x30 == memory[0x2041]);
+        TEST_CHECK(0x08 == memory[0x2042] && 0x40 == memory[0x2043]);
+        TEST_CHECK(0x11 == memory[0x2030] && 0x22 == memory[0x2031]);
+        TEST_CHECK(0x33 == memory[0x2032] && 0x44 == memory[0x2033]);
+        TEST_CHECK(0xCD == memory[0x2020] && 0xAB == memory[0x2021]);
+    }
+
+    memset(memory, 0x00, VARIANT_MEMORY);
+    {
+        W65C816 cpu;
+        memcpy(memory + 0x8000, INTERRUPT_PROGRAM, sizeof(INTERRUPT_PROGRAM));
+        memcpy(memory + 0xA000, INTERRUPT_BRK, sizeof(INTERRUPT_BRK));
+        memcpy(memory + 0xA100, INTERRUPT_BRK, sizeof(INTERRUPT_BRK));
+        memcpy(memory + 0xA200, INTERRUPT_IRQ, sizeof(INTERRUPT_IRQ));
+        memory[W65C816_VECTOR_E_IRQ + 1] = 0xA0;
+        memory[W65C816_VECTOR_BRK + 1] = 0xA1;
+        memory[W65C816_VECTOR_IRQ + 1] = 0xA2;
+        boot(cpu, memory);
+
+        /* A waiting processor spends the whole budget until the IRQ, which ends the run it is taken in. */
+        TEST_CHECK(1000 <= cpu.runUntil(0, 1000));
+        TEST_CHECK(1000 <= cpu.runUntil(0, 1000) && 0x00 == memory[0x2050]);
+        cpu.setIrq(true);
+        cpu.runUntil(PROCESSOR_EVENT_INTERRUPT, 1000);
+        cpu.setIrq(false);
+        TEST_CHECK(0 != (cpu.pendingEvents() & PROCESSOR_EVENT_INTERRUPT));
+        cpu.clearEvents(PROCESSOR_EVENT_ALL);
+        cpu.runUntil(0, 1000);
+        TEST_CHECK(0x03 == memory[0x2050] && 0x04 == memory[0x2051]);
+        TEST_CHECK(1 == cpu.getStats().interrupts);
+    }
+
+    /* Each IRQ ends the run it is taken in, and the next run goes on into its handler without clearing the event. */
+    memset(memory, 0x00, VARIANT_MEMORY);
+    {
+        W65C816 cpu;
+        memcpy(memory + 0x8000, IRQ_LOOP, sizeof(IRQ_LOOP));
+        memcpy(memory + 0xA300, IRQ_COUNT, sizeof(IRQ_COUNT));
+        memory[W65C816_VECTOR_E_IRQ + 1] = 0xA3;
+        boot(cpu, memory);
+        for (uint32 i = 0; i < 2; ++i) {
+            cpu.setIrq(true);
+            cpu.run(1000);
+            cpu.setIrq(false);
+            cpu.run(1000);
+        }
+        TEST_CHECK(0x02 == memory[0x2070] && 2 == cpu.getStats().interrupts);
+        TEST_CHECK(0 != (cpu.pendingEvents() & PROCESSOR_EVENT_INTERRUPT));
+    }
+
+    /* Cycles by the timing model of the variant, and FastROM only speeds up banks $80-$FF. */
+    memset(memory, 0x00, VARIANT_MEMORY);
+    memcpy(memory + 0x8000, TIMING_PROGRAM, sizeof(TIMING_PROGRAM));
+    memcpy(memory + 0x808000, TIMING_PROGRAM, sizeof(TIMING_PROGRAM));
+    TEST_CHECK(TIMING_CYCLES == timeProgram(memory, 0x00));
+    TEST_CHECK(TIMING_CYCLES == timeProgram(memory, W65C816_MEMSEL_FASTROM));
+    memcpy(memory + 0x8000, TIMING_JUMP, sizeof(TIMING_JUMP));
+    TEST_CHECK(TIMING_FASTROM == timeProgram(memory, 0x00) - timeProgram(memory, W65C816_MEMSEL_FASTROM));
+
+    free(memory);
+    return failures;
+}
+
+/* Code at $00:0300 patching ops later in its own block, directly and through the $7E:0000 mirror. */
+static const uint8 PATCH_PROGRAM[] = {
+    0x4C, 0x00, 0x03,                   /* $8000: jmp $0300 */
+};
+static const uint8 PATCH_CODE[] = {
+    0xA9, 0x01,                         /* $0300: lda #1 */
+    0x8D, 0x09, 0x03,                   /* sta $0309                patches the lda below */
+    0xEA, 0xEA, 0xEA,                   /* nop; nop; nop */
+    0xA9, 0xFF,                         /* $0308: lda #$FF */
+    0x8D, 0x00, 0x04,                   /* sta $0400 */
+    0xA9, 0x02,                         /* lda #2 */
+    0x8F, 0x15, 0x03, 0x7E,             /* sta $7E0315              patches through the mirror */
+    0xEA,                               /* nop */
+    0xA9, 0xFF,                         /* $0314: lda #$FF */
+    0x8D, 0x01, 0x04,                   /* sta $0401 */
+    0xDB,                               /* stp */
+};
+
+/* A subroutine at $00:9100 called with an 8 bit and then a 16 bit accumulator, which decodes the bytes after the
+   lda into other ops: lda #$34; nop in one mode and lda #$EA34 in the other. */
+static const uint8 MODE_PROGRAM[] = {
+    0x18, 0xFB, 0xE2, 0x20,             /* clc; xce; sep #$20 */
+    0x20, 0x00, 0x91,                   /* jsr $9100 */
+    0xAD, 0x00, 0x20, 0x8D, 0x10, 0x20, /* lda $2000; sta $2010 */
+    0xC2, 0x20,                         /* rep #$20 */
+    0x20, 0x00, 0x91,                   /* jsr $9100 */
+    0xDB,                               /* stp */
+};
+static const uint8 MODE_CODE[] = {
+    0xA9, 0x34, 0xEA,                   /* $9100: lda #$34; nop or lda #$EA34 */
+    0x8D, 0x00, 0x20,                   /* sta $2000 */
+    0x60,                               /* rts */
+};
+
+/* A loop calling a subroutine at $00:5100 in a writable page, which logs its number. */
+static const uint8 REMAP_PROGRAM[] = {
+    0x20, 0x00, 0x51,                   /* $8000: jsr $5100 */
+    0x80, 0xFB,                         /* bra $8000 */
+};
+static const uint8 REMAP_CODE[] = {
+    0xA9, 0x00,                         /* $5100: lda #n */
+    0x8D, 0x60, 0x20,                   /* sta $2060 */
+    0x60,                               /* rts */
+};
+
+/* Run the block cache checks of the 65c816 through this variant. */
+uint32 W65C816_VARIANT(checkBlocks)()
+{
+    uint32 failures = 0;
+    uint8 *memory = (uint8 *)calloc(VARIANT_MEMORY, 1);
+    if (NULL == memory) {
+        return 1;
+    }
+
+    /* Writes into a decoded block drop it, directly and through a mirror of its memory. */
+    {
+        W65C816 cpu;
+        memcpy(memory + 0x8000, PATCH_PROGRAM, sizeof(PATCH_PROGRAM));
+        memcpy(memory + 0x0300, PATCH_CODE, sizeof(PATCH_CODE));
+        boot(cpu, memory);
+        cpu.getBus().map(LONG_BUS_PAGE(0x7E, 0x0000), 1, memory, true);
+        cpu.runUntil(0, 10000);
+        TEST_CHECK(0x01 == memory[0x0400] && 0x02 == memory[0x0401]);
+        TEST_CHECK(2 <= cpu.getStats().codeWrites);
+    }
+
+    /* The same PBR:PC decodes again after rep and sep change M, as blocks are keyed by (M, X, E). */
+    memset(memory, 0x00, VARIANT_MEMORY);
+    {
+        W65C816 cpu;
+        memcpy(memory + 0x8000, MODE_PROGRAM, sizeof(MODE_PROGRAM));
+        memcpy(memory + 0x9100, MODE_CODE, sizeof(MODE_CODE));
+        boot(cpu, memory);
+        cpu.runUntil(0, 10000);
+        TEST_CHECK(0x34 == memory[0x2010]);
+        TEST_CHECK(0x34 == memory[0x2000] && 0xEA == memory[0x2001]);
+    }
+
+    /* Mapping other memory over decoded code between two runs runs the code of the new memory. */
+    memset(memory, 0x00, VARIANT_MEMORY);
+    {
+        W65C816 cpu;
+        static uint8 other[LONG_BUS_PAGE_SIZE];
+        memcpy(memory + 0x8000, REMAP_PROGRAM, sizeof(REMAP_PROGRAM));
+        memcpy(memory + 0x5100, REMAP_CODE, sizeof(REMAP_CODE));
+        memcpy(other + 0x0100, REMAP_CODE, sizeof(REMAP_CODE));
+        memory[0x5101] = 0x01;
+        other[0x0101] = 0x02;
+        boot(cpu, memory);
+        cpu.runUntil(0, 1000);
+        TEST_CHECK(0x01 == memory[0x2060]);
+        cpu.getBus().map(LONG_BUS_PAGE(0x00, 0x5000), 1, other, true);
+        cpu.runUntil(0, 1000);
+        TEST_CHECK(0x02 == memory[0x2060]);
+    }
+
+    free(memory);
+    return failures;
+}
+
+/* A 16 bit loop adding one to every word of a 4KB buffer, 7 ops per word, counting the passes in $0000. */
+static const uint8 BENCH_PROGRAM[] = {
+    0x18, 0xFB, 0xC2, 0x30,             /* clc; xce; rep #$30 */
+    0xA2, 0x00, 0x00,                   /* $8004: ldx #0 */
+    0xBD, 0x00, 0x10,                   /* $8007: lda $1000,x */
+    0x69, 0x01, 0x00,                   /* adc #1 */
+    0x9D, 0x00, 0x10,                   /* sta $1000,x */
+    0xE8, 0xE8,                         /* inx; inx */
+    0xE0, 0x00, 0x10,                   /* cpx #$1000 */
+    0xD0, 0xF0,                         /* bne $8007 */
+    0xEE, 0x00, 0x00,                   /* inc $0000 */
+    0x80, 0xE8,                         /* bra $8004 */
+};
+#define BENCH_PASSES            2000
+#define BENCH_PASS_OPS          (7 * 0x0800 + 3)
+#define BENCH_SLICE             10000   // Master cycles, or an eighth as many ops, run between checks of the passes.
+
+/* Measure ops per second of this variant, op by op or through the block cache, and the master cycles per op. */
+void W65C816_VARIANT(benchW65C816)(const char *variant)
+{
+    uint8 *memory = (uint8 *)calloc(VARIANT_MEMORY, 1);
+    if (NULL == memory) {
+        return;
+    }
+    for (uint32 blocks = 0; blocks < 2; ++blocks) {
+        memset(memory, 0x00, 0x10000);
+        memcpy(memory + 0x8000, BENCH_PROGRAM, sizeof(BENCH_PROGRAM));
+        W65C816 cpu;
+        boot(cpu, memory);
+        double start = BENCH_CLOCK_MS();
+        while ((uint32)(memory[0] | (memory[1] << 8)) < BENCH_PASSES) {
+            if (blocks) {
+                cpu.runUntil(0, BENCH_SLICE);
+                continue;
+            }
+            for (uint32 i = 0; i < BENCH_SLICE / 8; ++i) {
+                cpu.execOp();
+            }
+        }
+        double ms = BENCH_CLOCK_MS() - start;
+        double ops = (double)BENCH_PASSES * BENCH_PASS_OPS;
+        printf("w65c816 %-10s %-12s %8.1f Mops/s %6.1f master cycles/op\n", variant, blocks ? "blocks" : "op by op",
+               ops / ms / 1000.0, (double)cpu.cycleCount() / ops);
+    }
+    free(memory);
+}
+
+/* The VRAM and CGRAM ports of the PPU for the DMA checks, VRAM incrementing by a word after its high byte. */
+typedef struct _DMA_PPU {
+    uint8   vram[0x10000];
+    uint16  vramAddr;
+    uint8   cgram[0x200];
+    uint16  cgramAddr;
+    uint8   port05;     // Read from $2105.
+    uint32  done;       // Bulk transfers reported done.
+} DMA_PPU;
+
+static uint8 dmaRead(void *context, uint8 port)
+{
+    return (0x05 == port) ? ((DMA_PPU *)context)->port05 : 0x00;
+}
+
+static void dmaWrite(void *context, uint8 port, uint8 value)
+{
+    DMA_PPU *ppu = (DMA_PPU *)context;
+    if (0x18 == port) {
+        ppu->vram[(uint16)(ppu->vramAddr * 2)] = value;
+    } else if (0x19 == port) {
+        ppu->vram[(uint16)(ppu->vramAddr * 2 + 1)] = value;
+        ++ppu->vramAddr;
+    } else if (0x22 == port) {
+        ppu->cgram[ppu->cgramAddr++ & 0x1FF] = value;
+    }
+}
+
+/* Copy mode 1 runs into VRAM, a word aligned run that does not wrap with memcpy and the rest byte by byte. */
+static uint32 dmaBulk(void *context, uint8 port, uint8 mode, uint32 index, const uint8 *data, uint32 count)
+{
+    DMA_PPU *ppu = (DMA_PPU *)context;
+    if (0x18 != port || 1 != mode) {
+        return 0;
+    }
+    uint32 offset = (uint16)(ppu->vramAddr * 2);
+    if (!(index & 1) && !(count & 1) && offset + count <= sizeof(ppu->vram)) {
+        memcpy(ppu->vram + offset, data, count);
+        ppu->vramAddr += count / 2;
+        return count;
+    }
+    for (uint32 i = 0; i < count; ++i) {
+        dmaWrite(context, ((index + i) & 1) ? 0x19 : 0x18, data[i]);
+    }
+    return count;
+}
+
+static void dmaDone(void *context, uint8 port)
+{
+    (void)port;
+    ++((DMA_PPU *)context)->done;
+}
+
+/* Set up channel 0 for a mode 1 transfer into VRAM from an A bus address. */
+static void dmaVram(DMA &dma, uint32 addr, uint16 count)
+{
+    dma.writeRegister(0x4300, 0x01);
+    dma.writeRegister(0x4301, 0x18);
+    dma.writeRegister(0x4302, (uint8)addr);
+    dma.writeRegister(0x4303, (uint8)(addr >> 8));
+    dma.writeRegister(0x4304, (uint8)(addr >> 16));
+    dma.writeRegister(0x4305, (uint8)count);
+    dma.writeRegister(0x4306, (uint8)(count >> 8));
+}
+
+/* Run the DMA checks with the processor of this variant: the bulk path leaves the same VRAM as the per byte
+   path, and fixed sources and B bus to A bus transfers go through the handlers. */
+uint32 W65C816_VARIANT(checkDma)()
+{
+    uint32 failures = 0;
+    uint8 *memory = (uint8 *)malloc(VARIANT_MEMORY);
+    DMA_PPU *ppus = (DMA_PPU *)calloc(2, sizeof(DMA_PPU));
+    if (NULL == memory || NULL == ppus) {
+        free(memory);
+        free(ppus);
+        return 1;
+    }
+    for (uint32 i = 0; i < VARIANT_MEMORY; ++i) {
+        memory[i] = (uint8)(i * 7 + (i >> 8));
+    }
+
+    W65C816 cpu;
+    cpu.getBus().map(0, LONG_BUS_PAGE_COUNT, memory, true);
+    DMA dma(cpu);
+    DMA_B_BUS slow = { &dmaRead, &dmaWrite, NULL, &dmaDone, &ppus[0] };
+    DMA_B_BUS fast = { &dmaRead, &dmaWrite, &dmaBulk, &dmaDone, &ppus[1] };
+
+    /* 64KB from $C1:2345, the A bus address wraps in its bank back to where it started. */
+    for (uint32 bulk = 0; bulk < 2; ++bulk) {
+        dma.setBBus(bulk ? fast : slow);
+        dmaVram(dma, 0xC12345, 0x0000);
+        uint64 start = cpu.cycleCount();
+        uint32 cycles = dma.start(0x01);
+        TEST_CHECK(cycles >= DMA_START_CYCLES + DMA_CHANNEL_CYCLES + DMA_BYTE_CYCLES * 0x10000);
+        TEST_CHECK(cycles < 8 + DMA_START_CYCLES + DMA_CHANNEL_CYCLES + DMA_BYTE_CYCLES * 0x10000);
+        TEST_CHECK(cycles == cpu.cycleCount() - start);
+        TEST_CHECK(0x45 == dma.readRegister(0x4302) && 0x23 == dma.readRegister(0x4303));
+        TEST_CHECK(0x00 == dma.readRegister(0x4305) && 0x00 == dma.readRegister(0x4306));
+    }
+    TEST_CHECK(0 == memcmp(ppus[0].vram, ppus[1].vram, sizeof(ppus[0].vram)));
+    TEST_CHECK(ppus[0].vram[0] == memory[0xC12345] && ppus[0].vram[0xFFFF] == memory[0xC12344]);
+    TEST_CHECK(ppus[0].vramAddr == ppus[1].vramAddr);
+    TEST_CHECK(0 == ppus[0].done && 1 == ppus[1].done);
+    TEST_CHECK(0x10000 == dma.getStats().bulkBytes);
+
+    /* A fixed source fills CGRAM with one byte. */
+    dma.writeRegister(0x4310, 0x08);
+    dma.writeRegister(0x4311, 0x22);
+    dma.writeRegister(0x4312, 0x00);
+    dma.writeRegister(0x4313, 0x80);
+    dma.writeRegister(0x4314, 0x00);
+    dma.writeRegister(0x4315, 0x00);
+    dma.writeRegister(0x4316, 0x02);
+    dma.start(0x02);
+    uint32 filled = 0;
+    for (uint32 i = 0; i < sizeof(ppus[1].cgram); ++i) {
+        filled += (memory[0x8000] == ppus[1].cgram[i]);
+    }
+    TEST_CHECK(sizeof(ppus[1].cgram) == filled);
+
+    /* $2105 into $7E:0110 down to $7E:0101, started through MDMAEN. */
+    dma.writeRegister(0x4320, 0x90);
+    dma.writeRegister(0x4321, 0x05);
+    dma.writeRegister(0x4322, 0x10);
+    dma.writeRegister(0x4323, 0x01);
+    dma.writeRegister(0x4324, 0x7E);
+    dma.writeRegister(0x4325, 0x10);
+    dma.writeRegister(0x4326, 0x00);
+    ppus[1].port05 = 0x5A;
+    dma.writeRegister(DMA_REG_MDMAEN, 0x04);
+    TEST_CHECK(0x5A == memory[0x7E0110] && 0x5A == memory[0x7E0101] && 0x5A != memory[0x7E0100]);
+    TEST_CHECK(0x00 == dma.readRegister(0x4322) && 0x01 == dma.readRegister(0x4323));
+    TEST_CHECK(4 == dma.getStats().transfers);
+
+    free(ppus);
+    free(memory);
+    return failures;
+}
+
+#define DMA_BENCH_TRANSFERS     1000
+#define DMA_BENCH_BYTES         0x8000
+
+/* Measure the bytes per second of VRAM transfers, one byte at a time through the handlers and in bulk. */
+void W65C816_VARIANT(benchDma)(const char *variant)
+{
+    uint8 *memory = (uint8 *)calloc(VARIANT_MEMORY, 1);
+    DMA_PPU *ppu = (DMA_PPU *)calloc(1, sizeof(DMA_PPU));
+    if (NULL == memory || NULL == ppu) {
+        free(memory);
+        free(ppu);
+        return;
+    }
+    W65C816 cpu;
+    cpu.getBus().map(0, LONG_BUS_PAGE_COUNT, memory, true);
+    DMA dma(cpu);
+    for (uint32 bulk = 0; bulk < 2; ++bulk) {
+        DMA_B_BUS bus = { &dmaRead, &dmaWrite, bulk ? &dmaBulk : NULL, &dmaDone, ppu };
+        dma.setBBus(bus);
+        double start = BENCH_CLOCK_MS();
+        for (uint32 i = 0; i < DMA_BENCH_TRANSFERS; ++i) {
+            dmaVram(dma, 0xC08000, DMA_BENCH_BYTES);
+            dma.start(0x01);
+        }
+        double ms = BENCH_CLOCK_MS() - start;
+        printf("dma %-14s %-12s %8.1f MB/s\n", variant, bulk ? "bulk" : "per byte",
+               (double)DMA_BENCH_TRANSFERS * DMA_BENCH_BYTES / ms / 1000.0);
+    }
+    free(ppu);
+    free(memory);
+}
+
+/* HDMA tables of the checks: channel 0 direct to one port with a repeated run, channel 1 indirect to the two VRAM
+   data ports from bank $7F, channel 2 direct to two ports twice for eight repeated lines. */
+static const uint8 HDMA_TABLE0[] = { 0x03, 0xA1, 0x82, 0xB1, 0xB2, 0x01, 0xC1, 0x00 };            /* $00:1000 */
+static const uint8 HDMA_TABLE1[] = { 0x84, 0x00, 0x30, 0x03, 0x10, 0x30, 0x00 };                /* $7E:2000 */
+static const uint8 HDMA_TABLE2[] = { 0x88 };                                                    /* $00:1100 */
+#define HDMA_LINES              12
+
+/* The output of the lines of a frame. */
+typedef struct _HDMA_OUTPUT {
+    uint32      count[HDMA_MAX_LINES];
+    uint32      cycles[HDMA_MAX_LINES];
+    HDMA_WRITE  writes[HDMA_MAX_LINES][HDMA_MAX_WRITES];
+} HDMA_OUTPUT;
+
+/* Write the HDMA tables and their data, and set up and enable channels 0-2. */
+static void hdmaSetup(DMA &dma, uint8 *memory)
+{
+    for (uint32 i = 0; i < 0x40; ++i) {
+        memory[0x7F3000 + i] = (uint8)(0x30 + i);
+        memory[0x001101 + i] = (uint8)(0x80 + i);
+    }
+    memcpy(memory + 0x001000, HDMA_TABLE0, sizeof(HDMA_TABLE0));
+    memcpy(memory + 0x7E2000, HDMA_TABLE1, sizeof(HDMA_TABLE1));
+    memcpy(memory + 0x001100, HDMA_TABLE2, sizeof(HDMA_TABLE2));
+    memory[0x001101 + 32] = 0x00;
+    static const uint8 REGISTERS[3][8] = {
+        { 0x00, 0x0D, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00 },
+        { 0x41, 0x18, 0x00, 0x20, 0x7E, 0x00, 0x00, 0x7F },
+        { 0x03, 0x0F, 0x00, 0x11, 0x00, 0x00, 0x00, 0x00 },
+    };
+    for (uint32 c = 0; c < 3; ++c) {
+        for (uint32 r = 0; r < 8; ++r) {
+            dma.writeRegister((uint16)(0x4300 | (c << 4) | r), REGISTERS[c][r]);
+        }
+    }
+    dma.writeRegister(DMA_REG_HDMAEN, 0x07);
+}
+
+/* Run lines of the frame and record what each wrote and stalled for. */
+static void hdmaRecord(W65C816 &cpu, DMA &dma, HDMA_OUTPUT &output, uint32 first, uint32 lines)
+{
+    for (uint32 line = first; line < first + lines; ++line) {
+        const HDMA_WRITE *writes = NULL;
+        uint64 start = cpu.cycleCount();
+        output.count[line] = dma.hdmaLine(&writes);
+        memcpy(output.writes[line], writes, output.count[line] * sizeof(HDMA_WRITE));
+        output.cycles[line] = (uint32)(cpu.cycleCount() - start);
+    }
+}
+
+/* Check that two controllers hold the same channel registers. */
+static bool hdmaSameRegisters(DMA &left, DMA &right)
+{
+    for (uint16 addr = 0x4300; addr < 0x4330; ++addr) {
+        if (left.readRegister(addr) != right.readRegister(addr)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Run the HDMA checks with the processor of this variant: the lines read ahead write and stall as the lines
+   evaluated as they run, in the direct, indirect and repeat modes, and a table written in the middle of the
+   frame switches the rest of it to the new table with the registers brought up to date. */
+uint32 W65C816_VARIANT(checkHdma)()
+{
+    uint32 failures = 0;
+    uint8 *memory[2] = { (uint8 *)calloc(VARIANT_MEMORY, 1), (uint8 *)calloc(VARIANT_MEMORY, 1) };
+    HDMA_OUTPUT *output = (HDMA_OUTPUT *)calloc(2, sizeof(HDMA_OUTPUT));
+    if (NULL == memory[0] || NULL == memory[1] || NULL == output) {
+        free(memory[0]);
+        free(memory[1]);
+        free(output);
+        return 1;
+    }
+
+    /* Controller 0 reads ahead, rewriting the plain storage register of a channel forces controller 1 live. */
+    W65C816 cpu[2];
+    DMA *dma[2];
+    for (uint32 i = 0; i < 2; ++i) {
+        cpu[i].getBus().map(0, LONG_BUS_PAGE_COUNT, memory[i], true);
+        dma[i] = new DMA(cpu[i]);
+        hdmaSetup(*dma[i], memory[i]);
+    }
+    for (uint32 frame = 0; frame < 2; ++frame) {
+        uint64 live = dma[0]->getStats().hdmaLive;
+        for (uint32 i = 0; i < 2; ++i) {
+            dma[i]->hdmaFrame(HDMA_LINES);
+        }
+        dma[1]->writeRegister(0x430B, dma[1]->readRegister(0x430B));
+        TEST_CHECK(dma[1]->getStats().hdmaLive == dma[1]->getStats().hdmaFrames);
+
+        if (0 == frame) {
+            /* Reading the registers in the middle of the frame replays the lines run so far. */
+            uint64 syncs = dma[0]->getStats().hdmaSyncs;
+            hdmaRecord(cpu[0], *dma[0], output[0], 0, 5);
+            hdmaRecord(cpu[1], *dma[1], output[1], 0, 5);
+            TEST_CHECK(hdmaSameRegisters(*dma[0], *dma[1]));
+            TEST_CHECK(syncs + 1 == dma[0]->getStats().hdmaSyncs);
+            hdmaRecord(cpu[0], *dma[0], output[0], 5, HDMA_LINES - 5);
+            hdmaRecord(cpu[1], *dma[1], output[1], 5, HDMA_LINES - 5);
+            TEST_CHECK(live == dma[0]->getStats().hdmaLive);
+        } else {
+            /* Rewrite the last entry of channel 0 and the second count of channel 1 after line 2. */
+            hdmaRecord(cpu[0], *dma[0], output[0], 0, 3);
+            hdmaRecord(cpu[1], *dma[1], output[1], 0, 3);
+            for (uint32 i = 0; i < 2; ++i) {
+                cpu[i].getBus().write8(0x001006, 0xD1);
+                cpu[i].getBus().write8(0x7E2003, 0x82);
+            }
+            TEST_CHECK(live + 1 == dma[0]->getStats().hdmaLive);
+            hdmaRecord(cpu[0], *dma[0], output[0], 3, HDMA_LINES - 3);
+            hdmaRecord(cpu[1], *dma[1], output[1], 3, HDMA_LINES - 3);
+        }
+
+        for (uint32 line = 0; line < HDMA_LINES; ++line) {
+            TEST_CHECK(output[0].count[line] == output[1].count[line]);
+            TEST_CHECK(0 == memcmp(output[0].writes[line], output[1].writes[line],
+                                   output[0].count[line] * sizeof(HDMA_WRITE)));
+            TEST_CHECK(output[0].cycles[line] == output[1].cycles[line]);
+        }
+        TEST_CHECK(hdmaSameRegisters(*dma[0], *dma[1]));
+
+        /* Line 0 writes channel 0, both VRAM ports from $7F:3000 and two ports twice, in channel order. */
+        const HDMA_WRITE *writes = output[0].writes[0];
+        TEST_CHECK(7 == output[0].count[0]);
+        TEST_CHECK(0x0D == writes[0].port && 0xA1 == writes[0].value);
+        TEST_CHECK(0x18 == writes[1].port && 0x30 == writes[1].value && 0x19 == writes[2].port);
+        TEST_CHECK(0x0F == writes[3].port && 0x10 == writes[5].port && 0x80 == writes[3].value);
+        TEST_CHECK(HDMA_LINE_CYCLES + 3 * DMA_CHANNEL_CYCLES + 7 * DMA_BYTE_CYCLES == output[0].cycles[0]);
+
+        /* Line 3 also loads the next indirect address of channel 1. */
+        TEST_CHECK(HDMA_LINE_CYCLES + 3 * DMA_CHANNEL_CYCLES + 7 * DMA_BYTE_CYCLES + DMA_BYTE_CYCLES +
+                   HDMA_INDIRECT_CYCLES == output[0].cycles[3]);
+
+        /* Channel 0 skips lines 1 and 2, repeats on 3 and 4 and writes its last entry on line 5. */
+        TEST_CHECK(6 == output[0].count[1] && 0x18 == output[0].writes[1][0].port);
+        TEST_CHECK(0xB1 == output[0].writes[3][0].value && 0xB2 == output[0].writes[4][0].value);
+        TEST_CHECK((frame ? 0xD1 : 0xC1) == output[0].writes[5][0].value);
+
+        /* Channel 1 moves to $7F:3010 on line 4 for one line, or repeats on line 5 once rewritten, and channel 2
+           ends after line 7. */
+        TEST_CHECK(0x40 == output[0].writes[4][1].value);
+        TEST_CHECK(6 == output[0].count[2] && 7 == output[0].count[3] && 7 == output[0].count[4]);
+        TEST_CHECK((frame ? 7 : 5) == output[0].count[5]);
+        TEST_CHECK(4 == output[0].count[6] && 4 == output[0].count[7] && 0 == output[0].count[8]);
+
+    }
+
+    delete dma[0];
+    delete dma[1];
+    free(output);
+    free(memory[0]);
+    free(memory[1]);
+    return failures;
+}
+
+#define HDMA_BENCH_FRAMES       20000
+#define HDMA_BENCH_LINES        224
+
+/* Measure the lines per second of HDMA on three channels, read ahead at the start of the frame and evaluated as
+   each line runs. */
+void W65C816_VARIANT(benchHdma)(const char *variant)
+{
+    uint8 *memory = (uint8 *)calloc(VARIANT_MEMORY, 1);
+    if (NULL == memory) {
+        return;
+    }
+    W65C816 cpu;
+    cpu.getBus().map(0, LONG_BUS_PAGE_COUNT, memory, true);
+    DMA dma(cpu);
+    hdmaSetup(dma, memory);
+
+    /* Every channel repeats on every line of the frame. */
+    memory[0x001000] = 0xFF;
+    memory[0x7E2000] = 0xFF;
+    memory[0x001100] = 0xFF;
+    for (uint32 live = 0; live < 2; ++live) {
+        uint32 writes = 0;
+        double start = BENCH_CLOCK_MS();
+        for (uint32 frame = 0; frame < HDMA_BENCH_FRAMES; ++frame) {
+            dma.hdmaFrame(HDMA_BENCH_LINES);
+            if (live) {
+                dma.writeRegister(0x430B, 0x00);
+            }
+            for (uint32 line = 0; line < HDMA_BENCH_LINES; ++line) {
+                const HDMA_WRITE *list = NULL;
+                writes += dma.hdmaLine(&list);
+            }
+        }
+        double ms = BENCH_CLOCK_MS() - start;
+        printf("hdma %-13s %-12s %8.1f Mlines/s (%u writes)\n", variant, live ? "live" : "read ahead",
+               (double)HDMA_BENCH_FRAMES * HDMA_BENCH_LINES / ms / 1000.0, writes);
+    }
+    free(memory);
+}
+
+#undef TIMING_FASTROM
+#undef DMA_BENCH_TRANSFERS
+#undef DMA_BENCH_BYTES
+#undef HDMA_BENCH_FRAMES
+#undef HDMA_BENCH_LINES
+#undef HDMA_LINES
+#undef TIMING_CYCLES
+#undef TIMING_OPS
+#undef BENCH_SLICE
+#undef BENCH_PASS_OPS
+#undef BENCH_PASSES
+#undef VARIANT_MEMORY
@@ -0,0 +1,296 @@
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+/*
+sines-index: build the metadata index of a ROM library.
+
+    sines-index <library directory> [index file]
+
+Walks the library directory, reuses the entries of files whose path, modification time and size are unchanged
+since the last run, and hashes and analyzes the rest in parallel across the cores.  The index is written to
+<library directory>/sines.idx unless another path is given.
+*/
+
+#include "xplat/platform.hpp"
+#include "xplat/types.hpp"
+#include "Media/RomIndex.hpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <string>
+#ifndef WIN32
+    #include <dirent.h>
+    #include <pthread.h>
+    #include <sys/stat.h>
+    #include <time.h>
+#endif
+
+#define INDEX_DEFAULT_NAME  "sines.idx"
+
+/* A file of the library. */
+typedef struct _LIBRARY_FILE {
+    std::string     path;   // Path relative to the library directory.
+    uint64          mtime;  // Modification time.
+    uint32          size;   // Size in bytes.
+} LIBRARY_FILE;
+
+/* Work shared by the hashing threads. */
+typedef struct _INDEX_WORK {
+    const char             *root;       // The library directory.
+    ROM_INDEX_ENTRY        *entries;    // Entries to fill.
+    volatile long           next;       // Next entry to claim.
+    long                    count;      // Number of entries.
+} INDEX_WORK;
+
+/* Read a monotonic clock in milliseconds. */
+static double clockMs()
+{
+#ifdef WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart * 1000.0 / (double)frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1000.0 + (double)now.tv_nsec / 1000000.0;
+#endif
+}
+
+/* Check if a file name ends in one of a list of lower case extensions, in any case. */
+static bool hasExtension(const char *name, const char * const *extensions, size_t count)
+{
+    size_t length = strlen(name);
+    for (size_t i = 0; i < count; ++i) {
+        size_t extLength = strlen(extensions[i]);
+        if (length > extLength) {
+            const char *ext = name + length - extLength;
+            size_t j = 0;
+            while (j < extLength && (ext[j] | 0x20) == extensions[i][j]) {
+                ++j;
+            }
+            if (j == extLength) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/* Check if a file name has a ROM image or archive extension. */
+static bool isRomName(const char *name)
+{
+    static const char * const EXTENSIONS[] = { ".smc", ".sfc", ".swc", ".fig", ".gb", ".gbc", ".gz", ".zip" };
+    return hasExtension(name, EXTENSIONS, sizeof(EXTENSIONS) / sizeof(EXTENSIONS[0]));
+}
+
+/* Check if a file name is a Game Boy image, which has no SNES header to analyze. */
+static bool isGameBoyName(const char *name)
+{
+    static const char * const EXTENSIONS[] = { ".gb", ".gbc" };
+    return hasExtension(name, EXTENSIONS, sizeof(EXTENSIONS) / sizeof(EXTENSIONS[0]));
+}
+
+/* Collect the ROM images below a directory. */
+static void walkLibrary(const std::string &root, const std::string &relative, std::vector<LIBRARY_FILE> &files)
+{
+    std::string dir = relative.empty() ? root : root + "/" + relative;
+#ifdef WIN32
+    WIN32_FIND_DATAA data;
+    HANDLE hFind = FindFirstFileA((dir + "/*").c_str(), &data);
+    if (INVALID_HANDLE_VALUE == hFind) {
+        return;
+    }
+    do {
+        const char *name = data.cFileName;
+        if ('.' == name[0]) {
+            continue;
+        }
+        std::string path = relative.empty() ? name : relative + "/" + name;
+        if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+            walkLibrary(root, path, files);
+        } else if (isRomName(name) && path.size() < ROM_INDEX_PATH_SIZE) {
+            LIBRARY_FILE file;
+            file.path = path;
+            file.mtime = ((uint64)data.ftLastWriteTime.dwHighDateTime << 32) | data.ftLastWriteTime.dwLowDateTime;
+            file.size = data.nFileSizeLow;
+            files.push_back(file);
+        }
+    } while (FindNextFileA(hFind, &data));
+    FindClose(hFind);
+#else
+    DIR *pDir = opendir(dir.c_str());
+    if (NULL == pDir) {
+        return;
+    }
+    struct dirent *pEntry;
+    while (NULL != (pEntry = readdir(pDir))) {
+        const char *name = pEntry->d_name;
+        if ('.' == name[0]) {
+            continue;
+        }
+        std::string path = relative.empty() ? name : relative + "/" + name;
+        struct stat info;
+        if (0 != stat((root + "/" + path).c_str(), &info)) {
+            continue;
+        }
+        if (S_ISDIR(info.st_mode)) {
+            walkLibrary(root, path, files);
+        } else if (S_ISREG(info.st_mode) && isRomName(name) && path.size() < ROM_INDEX_PATH_SIZE) {
+            LIBRARY_FILE file;
+            file.path = path;
+            file.mtime = (uint64)info.st_mtime;
+            file.size = (uint32)info.st_size;
+            files.push_back(file);
+        }
+    }
+    closedir(pDir);
+#endif
+}
+
+/* Claim the next entry to hash, -1 when the work is done. */
+static long claimEntry(INDEX_WORK *pWork)
+{
+#ifdef WIN32
+    long index = InterlockedIncrement(&pWork->next) - 1;
+#else
+    long index = __sync_fetch_and_add(&pWork->next, 1);
+#endif
+    return index < pWork->count ? index : -1;
+}
+
+/* Hashing thread: map, hash and analyze entries until none are left.  Game Boy images are only hashed. */
+#ifdef WIN32
+static DWORD WINAPI hashEntries(LPVOID context)
+#else
+static void *hashEntries(void *context)
+#endif
+{
+    INDEX_WORK *pWork = (INDEX_WORK *)context;
+    long index;
+    while (-1 != (index = claimEntry(pWork))) {
+        ROM_INDEX_ENTRY &entry = pWork->entries[index];
+        std::string path = std::string(pWork->root) + "/" + entry.path;
+        MEDIA media = loadMedia((usz)path.c_str());
+        if (NULL != media.image) {
+            indexMedia(&media, &entry, !isGameBoyName(entry.path));
+        }
+        unloadMedia(&media);
+    }
+    return 0;
+}
+
+/* Count the cores to hash on. */
+static uint32 coreCount()
+{
+#ifdef WIN32
+    SYSTEM_INFO system;
+    GetSystemInfo(&system);
+    long cores = system.dwNumberOfProcessors;
+#else
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    return cores > 0 ? (uint32)cores : 1;
+}
+
+/* Hash entries on every core. */
+static void hashParallel(INDEX_WORK *pWork)
+{
+    uint32 threads = coreCount();
+    if ((long)threads > pWork->count) {
+        threads = pWork->count > 0 ? (uint32)pWork->count : 1;
+    }
+#ifdef WIN32
+    std::vector<HANDLE> handles;
+    for (uint32 i = 1; i < threads; ++i) {
+        HANDLE hThread = CreateThread(NULL, 0, hashEntries, pWork, 0, NULL);
+        if (NULL != hThread) {
+            handles.push_back(hThread);
+        }
+    }
+    hashEntries(pWork);
+    for (size_t i = 0; i < handles.size(); ++i) {
+        WaitForSingleObject(handles[i], INFINITE);
+        CloseHandle(handles[i]);
+    }
+#else
+    std::vector<pthread_t> handles;
+    for (uint32 i = 1; i < threads; ++i) {
+        pthread_t thread;
+        if (0 == pthread_create(&thread, NULL, hashEntries, pWork)) {
+            handles.push_back(thread);
+        }
+    }
+    hashEntries(pWork);
+    for (size_t i = 0; i < handles.size(); ++i) {
+        pthread_join(handles[i], NULL);
+    }
+#endif
+}
+
+/**
+ * Entry point for the index tool.
+ *
+ * @param argc : int        [IN]    The number of arguments in the array.
+ * @param argv : char**     [IN]    The library directory and optionally the index path.
+ */
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        fprintf(stderr, "usage: sines-index <library directory> [index file]\n");
+        return 1;
+    }
+    std::string root = argv[1];
+    std::string indexPath = (argc > 2) ? argv[2] : root + "/" + INDEX_DEFAULT_NAME;
+    double start = clockMs();
+
+    std::vector<LIBRARY_FILE> files;
+    walkLibrary(root, "", files);
+
+    /* Reuse unchanged entries, the old index is closed before it is replaced.  Entries of files that failed to
+       load are not found, so they are hashed again. */
+    ROM_INDEX index;
+    openRomIndex((usz)indexPath.c_str(), &index);
+    std::vector<ROM_INDEX_ENTRY> entries(files.size());
+    std::vector<ROM_INDEX_ENTRY> stale;
+    std::vector<size_t> staleSlots;
+    for (size_t i = 0; i < files.size(); ++i) {
+        const ROM_INDEX_ENTRY *old = findRomIndex(&index, files[i].path.c_str());
+        if (NULL != old && old->mtime == files[i].mtime && old->size == files[i].size) {
+            entries[i] = *old;
+            continue;
+        }
+        ROM_INDEX_ENTRY entry;
+        memset(&entry, 0x00, sizeof(entry));
+        strcpy(entry.path, files[i].path.c_str());
+        entry.mtime = files[i].mtime;
+        entry.size = files[i].size;
+        stale.push_back(entry);
+        staleSlots.push_back(i);
+    }
+    closeRomIndex(&index);
+
+    INDEX_WORK work;
+    work.root = root.c_str();
+    work.entries = stale.empty() ? NULL : &stale[0];
+    work.next = 0;
+    work.count = (long)stale.size();
+    hashParallel(&work);
+
+    uint32 failed = 0;
+    for (size_t i = 0; i < stale.size(); ++i) {
+        entries[staleSlots[i]] = stale[i];
+        failed += stale[i].valid ? 0 : 1;
+    }
+
+    int written = writeRomIndex((usz)indexPath.c_str(), entries.empty() ? NULL : &entries[0], (uint32)entries.size());
+    printf("%u files, %u reused, %u hashed, %u failed in %.1f ms\n", (uint32)files.size(),
+           (uint32)(files.size() - stale.size()), (uint32)stale.size(), failed, clockMs() - start);
+    if (!written) {
+        fprintf(stderr, "sines-index: could not write %s\n", indexPath.c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -1,13 +1,27 @@
-/*
- * Copyright 2013 Jason M. Baker
- */
-
-typedef unsigned char *     usz;
-
-/* Integer types. */
-typedef unsigned char       uint8;
-typedef unsigned short      uint16;
-
-#ifndef NULL
-    #define NULL (LR35902_OP_FN)0
+/*
+ * Copyright 2013 Jason M. Baker
+ */
+
+typedef unsigned char *     usz;
+
+/* Integer types. */
+typedef signed char         int8;
+typedef unsigned char       uint8;
+typedef signed short        int16;
+typedef unsigned short      uint16;
+typedef signed int          int32;
+typedef unsigned int        uint32;
+typedef unsigned long long  uint64;
+
+/* Host byte order, may be overridden on the compiler command line. */
+#ifndef SINES_BIG_ENDIAN
+    #if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        #define SINES_BIG_ENDIAN 1
+    #else
+        #define SINES_BIG_ENDIAN 0
+    #endif
+#endif
+
+#ifndef NULL
+    #define NULL (LR35902_OP_FN)0
 #endif
\ No newline at end of file